@@ -257,7 +257,8 @@
 	delete[] $1;
 };
 
-%apply (double const *valuesIn3) { (double const *eyeValuesIn3), (double const *lookatValuesIn3), (double const *upVectorValuesIn3) };
+%apply (double const *valuesIn3) { (double const *eyeValuesIn3), (double const *lookatValuesIn3), (double const *upVectorValuesIn3),
+	(double const *centreValuesIn3), (double const *sizeValuesIn3) };
 
 // array getter in-handler expects an integer array size only
 // and allocates array to accept output; see argout-handler
@@ -248,11 +248,19 @@ ZINC_API cmzn_element_id cmzn_mesh_find_element_by_identifier(cmzn_mesh_id mesh,
  * order with respect to the mesh's chart. The term identifies which of the
  * possible differential operator terms are available for the order and
  * dimension of the mesh.
+ * Second derivatives are supported by finite element fields with tensor
+ * product bases, xi and constant fields, and fields computed from them by
+ * add, scale, multiply, divide, component, concatenate, dot product,
+ * magnitude and 3-component cross product operators. Evaluating other
+ * fields with second derivatives returns CMZN_ERROR_NOT_IMPLEMENTED.
  *
  * @param mesh  Handle to the mesh to get differential operator from.
- * @param order  The order of the derivative. Currently must be 1.
+ * @param order  The order of the derivative: 1 or 2.
  * @param term  Which of the (dimensions)^order differential operators is
- * required, starting at 1. For order 1, corresponds to a chart axis.
+ * required, starting at 1. For order 1, corresponds to a chart axis. For
+ * order 2, term (i - 1)*dimension + j gives the mixed derivative with
+ * respect to chart axes i and j, e.g. for a 2-D mesh terms 1-4 are
+ * d2/dxi1dxi1, d2/dxi1dxi2, d2/dxi2dxi1 and d2/dxi2dxi2.
  * @return  Handle to differential operator, or NULL/invalid handle on failure.
  */
 ZINC_API cmzn_differentialoperator_id cmzn_mesh_get_chart_differentialoperator(
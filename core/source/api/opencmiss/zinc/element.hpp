@@ -222,7 +222,8 @@ public:
 	{
 		QUADRATURE_RULE_INVALID = CMZN_ELEMENT_QUADRATURE_RULE_INVALID,
 		QUADRATURE_RULE_GAUSSIAN = CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN,
-		QUADRATURE_RULE_MIDPOINT = CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT
+		QUADRATURE_RULE_MIDPOINT = CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT,
+		QUADRATURE_RULE_ADAPTIVE = CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE
 	};
 
 	cmzn_element_id getId() const
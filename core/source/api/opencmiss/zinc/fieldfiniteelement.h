@@ -369,6 +369,55 @@ ZINC_API int cmzn_field_find_mesh_location_set_search_mode(
 	cmzn_field_find_mesh_location_id find_mesh_location_field,
 	enum cmzn_field_find_mesh_location_search_mode search_mode);
 
+/**
+ * Finds mesh locations for many source field values at once, according to
+ * the search mode. Points are searched in order along a space-filling curve
+ * so each search starts from the element and xi found for a nearby point,
+ * which is much faster for spatially coherent points such as a data cloud or
+ * points tracked over time. Time is taken from the field cache; its location
+ * is not changed. Statistics for the batch can then be obtained with
+ * cmzn_field_find_mesh_location_get_batch_statistics.
+ *
+ * @param find_mesh_location_field  The field to find locations with.
+ * @param cache  Field cache supplying time and evaluation state.
+ * @param points_count  The number of points to find locations for.
+ * @param source_values_in  Array of points_count*(number of components of
+ * source field) values, with values for each point consecutive.
+ * @param elements_out  Array of points_count to receive element handles, or
+ * NULL for points with no location found. Caller is responsible for
+ * destroying each non-NULL handle.
+ * @param xi_out  Array of points_count*(mesh dimension) to receive xi for
+ * each point, set to zero where no location is found.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_field_find_mesh_location_find_batch(
+	cmzn_field_find_mesh_location_id find_mesh_location_field,
+	cmzn_fieldcache_id cache, int points_count, const double *source_values_in,
+	cmzn_element_id *elements_out, double *xi_out);
+
+/**
+ * Gets statistics for the last batch find performed by the find_mesh_location
+ * field. Element visits include elements walked through and elements tried
+ * by full searches; points whose values repeat the previous point's values
+ * add no visits or iterations.
+ *
+ * @param find_mesh_location_field  The field to query.
+ * @param points_count_out  Address to return number of points in batch.
+ * @param found_count_out  Address to return number of points located.
+ * @param fallback_count_out  Address to return number of points for which
+ * walking from the previous location failed, requiring a search of all
+ * elements.
+ * @param average_element_visits_out  Address to return average number of
+ * elements visited per point.
+ * @param average_iterations_out  Address to return average number of
+ * Newton iterations per point.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_field_find_mesh_location_get_batch_statistics(
+	cmzn_field_find_mesh_location_id find_mesh_location_field,
+	int *points_count_out, int *found_count_out, int *fallback_count_out,
+	double *average_element_visits_out, double *average_iterations_out);
+
 /**
  * Creates a field which represents and returns node values/derivatives.
  *
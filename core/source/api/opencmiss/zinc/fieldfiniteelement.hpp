@@ -160,6 +160,31 @@ public:
 			reinterpret_cast<cmzn_field_find_mesh_location_id>(id),
 			static_cast<cmzn_field_find_mesh_location_search_mode>(searchMode));
 	}
+
+	int findBatch(const Fieldcache& cache, int pointsCount, const double *sourceValuesIn,
+		Element *elementsOut, double *xiOut)
+	{
+		cmzn_element_id *elementIds = ((pointsCount > 0) && elementsOut) ?
+			new cmzn_element_id[pointsCount]() : 0;
+		int result = cmzn_field_find_mesh_location_find_batch(
+			reinterpret_cast<cmzn_field_find_mesh_location_id>(id), cache.getId(),
+			pointsCount, sourceValuesIn, elementIds, xiOut);
+		if (elementIds)
+		{
+			for (int i = 0; i < pointsCount; ++i)
+				elementsOut[i] = Element(elementIds[i]);
+			delete[] elementIds;
+		}
+		return result;
+	}
+
+	int getBatchStatistics(int& pointsCount, int& foundCount, int& fallbackCount,
+		double& averageElementVisits, double& averageIterations)
+	{
+		return cmzn_field_find_mesh_location_get_batch_statistics(
+			reinterpret_cast<cmzn_field_find_mesh_location_id>(id), &pointsCount,
+			&foundCount, &fallbackCount, &averageElementVisits, &averageIterations);
+	}
 };
 
 class FieldNodeValue : public Field
@@ -471,6 +471,25 @@ ZINC_API int cmzn_field_image_set_wrap_mode(cmzn_field_image_id image_field,
 ZINC_API char *cmzn_field_image_get_property(cmzn_field_image_id image,
 	const char* property);
 
+/**
+ * Evaluates the image field at many texture coordinates at once, as given
+ * directly rather than by the domain field, using the current filter and wrap
+ * modes and output range. This avoids per-location overheads when sampling the
+ * image at many points, e.g. all nodes or quadrature points in image-based
+ * registration.
+ *
+ * @param image_field  The image field to evaluate.
+ * @param points_count  The number of locations to evaluate at.
+ * @param texture_coordinates_in  Array of points_count*(number of components
+ * of domain field) texture coordinates, with coordinates for each point
+ * consecutive.
+ * @param values_out  Array of points_count*(number of components of image
+ * field) to receive values, with values for each point consecutive.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_field_image_evaluate_batch(cmzn_field_image_id image_field,
+	int points_count, const double *texture_coordinates_in, double *values_out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -219,6 +219,12 @@ public:
 		return cmzn_field_image_get_property(getDerivedId(), property);
 	}
 
+	int evaluateBatch(int pointsCount, const double *textureCoordinatesIn, double *valuesOut)
+	{
+		return cmzn_field_image_evaluate_batch(getDerivedId(), pointsCount,
+			textureCoordinatesIn, valuesOut);
+	}
+
 	inline StreaminformationImage createStreaminformationImage();
 
 };
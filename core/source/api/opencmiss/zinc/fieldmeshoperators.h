@@ -161,6 +161,56 @@ ZINC_API int cmzn_field_mesh_integral_set_element_quadrature_rule(
 	cmzn_field_mesh_integral_id mesh_integral_field,
 	enum cmzn_element_quadrature_rule quadrature_rule);
 
+/**
+ * Get the relative tolerance used with adaptive element quadrature.
+ * @see cmzn_field_mesh_integral_set_relative_tolerance
+ *
+ * @param mesh_integral_field  Handle to mesh integral field to query.
+ * @return  The relative tolerance, or 0.0 if bad argument.
+ */
+ZINC_API double cmzn_field_mesh_integral_get_relative_tolerance(
+	cmzn_field_mesh_integral_id mesh_integral_field);
+
+/**
+ * Set the relative tolerance used with adaptive element quadrature. The
+ * integral over an element is accepted when the change in each component from
+ * the next lower order is no more than this tolerance times the integral of
+ * its absolute value. Default 1.0E-6.
+ * @see CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE
+ *
+ * @param mesh_integral_field  Handle to mesh integral field to modify.
+ * @param relative_tolerance  The relative tolerance > 0.0.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_mesh_integral_set_relative_tolerance(
+	cmzn_field_mesh_integral_id mesh_integral_field, double relative_tolerance);
+
+/**
+ * Query whether the mesh integral field caches the element geometry factors
+ * dL, dA or dV at quadrature points.
+ * @see cmzn_field_mesh_integral_set_geometry_cached
+ *
+ * @param mesh_integral_field  Handle to mesh integral field to query.
+ * @return  Boolean true if geometry is cached, false if not or bad argument.
+ */
+ZINC_API bool cmzn_field_mesh_integral_is_geometry_cached(
+	cmzn_field_mesh_integral_id mesh_integral_field);
+
+/**
+ * Set whether the mesh integral field caches the element geometry factors
+ * dL, dA or dV at quadrature points, so repeat evaluations only evaluate the
+ * integrand. Cached values are discarded when the coordinate field, mesh,
+ * quadrature rule or numbers of points change, or time differs. Not used with
+ * adaptive quadrature. Costs memory proportional to the number of elements
+ * times quadrature points. Default false.
+ *
+ * @param mesh_integral_field  Handle to mesh integral field to modify.
+ * @param geometry_cached  Boolean true to cache geometry, false to not.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_mesh_integral_set_geometry_cached(
+	cmzn_field_mesh_integral_id mesh_integral_field, bool geometry_cached);
+
 /**
  * Creates a specialisation of the mesh integral field that integrates the
  * squares of the components of the integrand field. Note that the 
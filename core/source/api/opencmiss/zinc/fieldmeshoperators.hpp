@@ -61,6 +61,28 @@ public:
 		return cmzn_field_mesh_integral_set_element_quadrature_rule(getDerivedId(),
 			static_cast<cmzn_element_quadrature_rule>(quadratureRule));
 	}
+
+	double getRelativeTolerance()
+	{
+		return cmzn_field_mesh_integral_get_relative_tolerance(getDerivedId());
+	}
+
+	int setRelativeTolerance(double relativeTolerance)
+	{
+		return cmzn_field_mesh_integral_set_relative_tolerance(getDerivedId(),
+			relativeTolerance);
+	}
+
+	bool isGeometryCached()
+	{
+		return cmzn_field_mesh_integral_is_geometry_cached(getDerivedId());
+	}
+
+	int setGeometryCached(bool geometryCached)
+	{
+		return cmzn_field_mesh_integral_set_geometry_cached(getDerivedId(),
+			geometryCached);
+	}
 };
 
 /**
@@ -129,6 +129,72 @@ ZINC_API cmzn_fieldmodulenotifier_id cmzn_fieldmodule_create_fieldmodulenotifier
  */
 ZINC_API int cmzn_fieldmodule_define_all_faces(cmzn_fieldmodule_id fieldmodule);
 
+/**
+ * Query whether evaluations of fields in the field module's region are being
+ * profiled.
+ *
+ * @param fieldmodule  Handle to the field module to query.
+ * @return  Boolean true if profiling is enabled, otherwise false.
+ */
+ZINC_API bool cmzn_fieldmodule_is_profiling_enabled(cmzn_fieldmodule_id fieldmodule);
+
+/**
+ * Set whether evaluations of fields in the field module's region are profiled.
+ * While enabled, each request to evaluate a field through any field cache for
+ * the region is counted as a hit if answered from the cache of previously
+ * evaluated values, otherwise as a miss which is evaluated and timed.
+ * Profiling is off by default; recorded profiles are kept when it is disabled
+ * and accumulate when re-enabled until reset.
+ * @see cmzn_fieldmodule_reset_profiling
+ *
+ * @param fieldmodule  Handle to the field module to modify.
+ * @param enabled  Boolean true to enable profiling, false to disable.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_fieldmodule_set_profiling_enabled(cmzn_fieldmodule_id fieldmodule,
+	bool enabled);
+
+/**
+ * Clear profiles recorded for all fields in the field module's region.
+ *
+ * @param fieldmodule  Handle to the field module to modify.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_fieldmodule_reset_profiling(cmzn_fieldmodule_id fieldmodule);
+
+/**
+ * Get the profile recorded for a field since profiling was enabled or last
+ * reset. Values are zero if the field has not been evaluated while profiling.
+ * Any output argument may be NULL if not required.
+ *
+ * @param fieldmodule  Handle to the field module the field belongs to.
+ * @param field  The field to get the profile of.
+ * @param cache_hits_out  On success, the number of evaluations answered from
+ * the field cache. Limited to the maximum int value.
+ * @param cache_misses_out  On success, the number of evaluations which were
+ * computed. Limited to the maximum int value.
+ * @param inclusive_time_out  On success, total time in seconds spent computing
+ * the field, including evaluating its source fields.
+ * @param exclusive_time_out  On success, total time in seconds spent computing
+ * the field, excluding time evaluating source fields which were computed.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_fieldmodule_get_field_profile(cmzn_fieldmodule_id fieldmodule,
+	cmzn_field_id field, int *cache_hits_out, int *cache_misses_out,
+	double *inclusive_time_out, double *exclusive_time_out);
+
+/**
+ * Get a report of the profiles of all fields in the field module which have
+ * been evaluated while profiling, as a tab-separated table with a header line
+ * and one line per field in order of decreasing exclusive time.
+ * @see cmzn_fieldmodule_get_field_profile
+ *
+ * @param fieldmodule  Handle to the field module to report on.
+ * @return  On success: allocated string containing report. Up to caller to
+ * free using cmzn_deallocate(). Returns NULL on failure.
+ */
+ZINC_API char *cmzn_fieldmodule_get_profile_report(cmzn_fieldmodule_id fieldmodule);
+
 /**
  * Gets the region this field module can create fields for.
  *
@@ -181,6 +181,33 @@ public:
 		return cmzn_fieldmodule_define_all_faces(id);
 	}
 
+	bool isProfilingEnabled()
+	{
+		return cmzn_fieldmodule_is_profiling_enabled(id);
+	}
+
+	int setProfilingEnabled(bool enabled)
+	{
+		return cmzn_fieldmodule_set_profiling_enabled(id, enabled);
+	}
+
+	int resetProfiling()
+	{
+		return cmzn_fieldmodule_reset_profiling(id);
+	}
+
+	int getFieldProfile(const Field& field, int *cacheHitsOut, int *cacheMissesOut,
+		double *inclusiveTimeOut, double *exclusiveTimeOut)
+	{
+		return cmzn_fieldmodule_get_field_profile(id, field.getId(),
+			cacheHitsOut, cacheMissesOut, inclusiveTimeOut, exclusiveTimeOut);
+	}
+
+	char *getProfileReport()
+	{
+		return cmzn_fieldmodule_get_profile_report(id);
+	}
+
 	Field findFieldByName(const char *fieldName)
 	{
 		return Field(cmzn_fieldmodule_find_field_by_name(id, fieldName));
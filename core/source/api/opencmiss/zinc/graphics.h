@@ -351,6 +351,50 @@ ZINC_API cmzn_field_id cmzn_graphics_get_texture_coordinate_field(
 ZINC_API int cmzn_graphics_set_texture_coordinate_field(cmzn_graphics_id graphics,
 	cmzn_field_id texture_coordinate_field);
 
+/**
+ * Query whether the time cache is enabled for the graphics.
+ *
+ * @param graphics  The graphics to query.
+ * @return  Boolean true if the time cache is enabled, otherwise false.
+ */
+ZINC_API bool cmzn_graphics_is_time_cache_enabled(cmzn_graphics_id graphics);
+
+/**
+ * Set whether time-dependent graphics keep the graphics built at each time
+ * so that returning to that time, e.g. when looping an animation, reuses the
+ * cached graphics instead of rebuilding them. The cache is cleared whenever
+ * the graphics or any fields they depend on change, and older entries are
+ * discarded to keep memory use under the time cache memory limit.
+ * Disabled by default. Disabling frees any cached graphics.
+ *
+ * @param graphics  The graphics to modify.
+ * @param enabled  Boolean true to enable, false to disable.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_set_time_cache_enabled(cmzn_graphics_id graphics,
+	bool enabled);
+
+/**
+ * Get the approximate limit on memory used by cached graphics for other
+ * times when the time cache is enabled.
+ *
+ * @param graphics  The graphics to query.
+ * @return  The memory limit in megabytes, or 0 if bad argument.
+ */
+ZINC_API int cmzn_graphics_get_time_cache_memory_limit(cmzn_graphics_id graphics);
+
+/**
+ * Set the approximate limit on memory used by cached graphics for other
+ * times when the time cache is enabled. Least recently used times are
+ * discarded first when over the limit. The default value is 256.
+ *
+ * @param graphics  The graphics to modify.
+ * @param memory_limit  The memory limit in megabytes. Value > 0.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_set_time_cache_memory_limit(cmzn_graphics_id graphics,
+	int memory_limit);
+
 /**
  * Return status of graphics visibility flag attribute.
  *
@@ -760,6 +804,54 @@ ZINC_API int cmzn_graphics_streamlines_set_colour_data_type(
 	cmzn_graphics_streamlines_id streamlines,
 	enum cmzn_graphics_streamlines_colour_data_type streamlines_colour_data_type);
 
+/**
+ * Gets the method used to integrate streamlines through the stream vector
+ * field.
+ *
+ * @param streamlines  The streamlines graphics to query.
+ * @return  The current integration method, or
+ * CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID on error.
+ */
+ZINC_API enum cmzn_graphics_streamlines_integration_method
+	cmzn_graphics_streamlines_get_integration_method(
+		cmzn_graphics_streamlines_id streamlines);
+
+/**
+ * Sets the method used to integrate streamlines through the stream vector
+ * field. Default is improved Euler.
+ * @see cmzn_graphics_streamlines_integration_method
+ *
+ * @param streamlines  The streamlines graphics to modify.
+ * @param integration_method  The new integration method.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_streamlines_set_integration_method(
+	cmzn_graphics_streamlines_id streamlines,
+	enum cmzn_graphics_streamlines_integration_method integration_method);
+
+/**
+ * Gets the error tolerance controlling the step size when integrating
+ * streamlines.
+ *
+ * @param streamlines  The streamlines graphics to query.
+ * @return  The integration tolerance, or 0.0 if invalid streamlines graphics.
+ */
+ZINC_API double cmzn_graphics_streamlines_get_integration_tolerance(
+	cmzn_graphics_streamlines_id streamlines);
+
+/**
+ * Sets the error tolerance controlling the step size when integrating
+ * streamlines. This is the maximum estimated error in element xi coordinates
+ * permitted for each step; smaller values give more accurate streamlines at
+ * the cost of more steps. Default value is 1.0E-4.
+ *
+ * @param streamlines  The streamlines graphics to modify.
+ * @param tolerance  The new integration tolerance > 0.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_streamlines_set_integration_tolerance(
+	cmzn_graphics_streamlines_id streamlines, double tolerance);
+
 /**
  * Gets the vector field the streamline is tracking along.
  *
@@ -863,6 +955,50 @@ ZINC_C_INLINE cmzn_graphics_id cmzn_graphics_surfaces_base_cast(cmzn_graphics_su
  */
 ZINC_API int cmzn_graphics_surfaces_destroy(cmzn_graphics_surfaces_id *surfaces_address);
 
+/**
+ * Query whether surfaces reuse data field values evaluated at points on
+ * element edges shared with neighbouring surface elements.
+ *
+ * @param surfaces  The surfaces graphics to query.
+ * @return  Boolean true if shared edge evaluation is on, otherwise false.
+ */
+ZINC_API bool cmzn_graphics_surfaces_is_shared_edge_evaluation(
+	cmzn_graphics_surfaces_id surfaces);
+
+/**
+ * Gets the number of data field evaluations made at points on shared element
+ * edges, and the number avoided by reusing them, in the last build of the
+ * surfaces. Both are zero if shared edge evaluation was off or there was no
+ * data field.
+ *
+ * @param surfaces  The surfaces graphics to query.
+ * @param evaluation_count_out  Address to return number of edge points at
+ * which the data field was evaluated.
+ * @param reuse_count_out  Address to return number of edge points at which
+ * previously evaluated data values were reused.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_surfaces_get_shared_edge_statistics(
+	cmzn_graphics_surfaces_id surfaces, int *evaluation_count_out,
+	int *reuse_count_out);
+
+/**
+ * Set whether surfaces evaluate the data field once at points on element
+ * edges shared with neighbouring surface elements through common line faces,
+ * reusing the values for each element. This reduces the cost of colouring
+ * surfaces by expensive data fields, but is only appropriate for data fields
+ * which are continuous across element boundaries. Requires the mesh to have
+ * line faces defined. Default is false: evaluate data at all points of each
+ * element.
+ *
+ * @param surfaces  The surfaces graphics to modify.
+ * @param shared_edge_evaluation  Boolean true to reuse edge point data, false
+ * to evaluate it separately for each element.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_surfaces_set_shared_edge_evaluation(
+	cmzn_graphics_surfaces_id surfaces, bool shared_edge_evaluation);
+
 /**
  * If the graphics produces lines or extrusions then returns a handle to the
  * line attribute object for specifying section profile and scaling.
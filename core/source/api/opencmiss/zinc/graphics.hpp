@@ -190,6 +190,26 @@ public:
 		return cmzn_graphics_set_texture_coordinate_field(id, textureCoordinateField.getId());
 	}
 
+	bool isTimeCacheEnabled()
+	{
+		return cmzn_graphics_is_time_cache_enabled(id);
+	}
+
+	int setTimeCacheEnabled(bool enabled)
+	{
+		return cmzn_graphics_set_time_cache_enabled(id, enabled);
+	}
+
+	int getTimeCacheMemoryLimit()
+	{
+		return cmzn_graphics_get_time_cache_memory_limit(id);
+	}
+
+	int setTimeCacheMemoryLimit(int memoryLimit)
+	{
+		return cmzn_graphics_set_time_cache_memory_limit(id, memoryLimit);
+	}
+
 	Material getMaterial()
 	{
 		return Material(cmzn_graphics_get_material(id));
@@ -441,6 +461,13 @@ public:
 		COLOUR_DATA_TYPE_TRAVEL_TIME = CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_TRAVEL_TIME
 	};
 
+	enum IntegrationMethod
+	{
+		INTEGRATION_METHOD_INVALID = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID,
+		INTEGRATION_METHOD_IMPROVED_EULER = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER,
+		INTEGRATION_METHOD_RUNGE_KUTTA_45 = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45
+	};
+
 	enum TrackDirection
 	{
 		TRACK_DIRECTION_INVALID = CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_INVALID,
@@ -459,6 +486,28 @@ public:
 			static_cast<cmzn_graphics_streamlines_colour_data_type>(dataType));
 	}
 
+	IntegrationMethod getIntegrationMethod()
+	{
+		return static_cast<IntegrationMethod>(
+			cmzn_graphics_streamlines_get_integration_method(this->getDerivedId()));
+	}
+
+	int setIntegrationMethod(IntegrationMethod integrationMethod)
+	{
+		return cmzn_graphics_streamlines_set_integration_method(this->getDerivedId(),
+			static_cast<cmzn_graphics_streamlines_integration_method>(integrationMethod));
+	}
+
+	double getIntegrationTolerance()
+	{
+		return cmzn_graphics_streamlines_get_integration_tolerance(this->getDerivedId());
+	}
+
+	int setIntegrationTolerance(double tolerance)
+	{
+		return cmzn_graphics_streamlines_set_integration_tolerance(this->getDerivedId(), tolerance);
+	}
+
 	Field getStreamVectorField()
 	{
 		return Field(cmzn_graphics_streamlines_get_stream_vector_field(this->getDerivedId()));
@@ -499,12 +548,33 @@ friend class Scene;
 private:
 	explicit GraphicsSurfaces(cmzn_graphics_id graphics_id) : Graphics(graphics_id) {}
 
+	inline cmzn_graphics_surfaces_id getDerivedId()
+	{
+		return reinterpret_cast<cmzn_graphics_surfaces_id>(this->id);
+	}
+
 public:
 	GraphicsSurfaces() : Graphics(0) {}
 
 	explicit GraphicsSurfaces(cmzn_graphics_surfaces_id surfaces_id)
 		: Graphics(reinterpret_cast<cmzn_graphics_id>(surfaces_id))
 	{}
+
+	bool isSharedEdgeEvaluation()
+	{
+		return cmzn_graphics_surfaces_is_shared_edge_evaluation(getDerivedId());
+	}
+
+	int getSharedEdgeStatistics(int& evaluationCount, int& reuseCount)
+	{
+		return cmzn_graphics_surfaces_get_shared_edge_statistics(getDerivedId(),
+			&evaluationCount, &reuseCount);
+	}
+
+	int setSharedEdgeEvaluation(bool sharedEdgeEvaluation)
+	{
+		return cmzn_graphics_surfaces_set_shared_edge_evaluation(getDerivedId(), sharedEdgeEvaluation);
+	}
 };
 
 inline GraphicsContours Graphics::castContours()
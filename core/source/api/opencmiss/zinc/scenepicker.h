@@ -176,6 +176,22 @@ ZINC_API int cmzn_scenepicker_add_picked_nodes_to_field_group(
 ZINC_API int cmzn_scenepicker_add_picked_elements_to_field_group(
 	cmzn_scenepicker_id scenepicker, cmzn_field_group_id group);
 
+/**
+ * Set the picking volume to an axis-aligned box in world coordinates,
+ * independent of any scene viewer. Graphics in window-relative scene
+ * coordinate systems are not picked with this volume. Picking renders to
+ * the OpenGL select buffer if there is a current OpenGL context, otherwise
+ * it is performed without rendering on the same graphics primitives.
+ *
+ * @param scenepicker  The scene picker to be modified.
+ * @param centreValuesIn3  Array of 3 coordinates of the centre of the box.
+ * @param sizeValuesIn3  Array of 3 positive sizes of the box in x, y and z.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_scenepicker_set_picking_volume_box(
+	cmzn_scenepicker_id scenepicker, const double *centreValuesIn3,
+	const double *sizeValuesIn3);
+
 /**
  * Return the centre of the picking volume in world coordinates.
  *
@@ -137,6 +137,11 @@ public:
 		return cmzn_scenepicker_set_scenefilter(id, filter.getId());
 	}
 
+	int setPickingVolumeBox(const double *centreValuesIn3, const double *sizeValuesIn3)
+	{
+		return cmzn_scenepicker_set_picking_volume_box(id, centreValuesIn3, sizeValuesIn3);
+	}
+
 	int getPickingVolumeCentre(double *coordinateValuesOut3)
 	{
 		return cmzn_scenepicker_get_picking_volume_centre(id, coordinateValuesOut3);
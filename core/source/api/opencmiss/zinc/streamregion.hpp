@@ -51,7 +51,9 @@ public:
 		FILE_FORMAT_INVALID = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_INVALID,
 		FILE_FORMAT_AUTOMATIC = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC,
 		FILE_FORMAT_EX = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX,
-		FILE_FORMAT_FIELDML = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML
+		FILE_FORMAT_FIELDML = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML,
+		FILE_FORMAT_EX_BINARY = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY,
+		FILE_FORMAT_FIELDML_BINARY = CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY
 	};
 
 	enum RecursionMode
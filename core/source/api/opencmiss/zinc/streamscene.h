@@ -312,6 +312,30 @@ ZINC_API int cmzn_streaminformation_scene_set_output_time_dependent_normals(
 	cmzn_streaminformation_scene_id streaminformation,
 	int outputTimeDependentNormals);
 
+/**
+ * Get whether vertex attributes are quantised in binary export formats.
+ *
+ * @param streaminformation  The streaminformation_scene to query.
+ * @return  Boolean true if quantised, otherwise false.
+ */
+ZINC_API bool cmzn_streaminformation_scene_is_quantised(
+	cmzn_streaminformation_scene_id streaminformation);
+
+/**
+ * Set whether vertex attributes are quantised in binary export formats,
+ * reducing the size of the export. Positions are stored as 16-bit integers
+ * scaled to each graphics' bounding box, normals as 8-bit integers and
+ * colours as 8 bits per channel. Values at later time steps, data values and
+ * indices are not quantised. Requires the client to support the glTF
+ * KHR_mesh_quantization extension. The default is false.
+ *
+ * @param streaminformation  The streaminformation_scene to modify.
+ * @param quantised  The new quantised state.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_streaminformation_scene_set_quantised(
+	cmzn_streaminformation_scene_id streaminformation, bool quantised);
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,7 +52,8 @@ public:
 	{
 		IO_FORMAT_INVALID = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_INVALID,
 		IO_FORMAT_THREEJS = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS,
-		IO_FORMAT_DESCRIPTION = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION
+		IO_FORMAT_DESCRIPTION = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION,
+		IO_FORMAT_GLTF_BINARY = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY
 	};
 
 	Scenefilter getScenefilter()
@@ -160,6 +161,16 @@ public:
 		return cmzn_streaminformation_scene_set_output_time_dependent_normals(getDerivedId(),
 				outputTimeDependentNormals);
 	}
+
+	bool isQuantised()
+	{
+		return cmzn_streaminformation_scene_is_quantised(getDerivedId());
+	}
+
+	int setQuantised(bool quantised)
+	{
+		return cmzn_streaminformation_scene_set_quantised(getDerivedId(), quantised);
+	}
 };
 
 inline StreaminformationScene Streaminformation::castScene()
@@ -89,6 +89,28 @@ ZINC_API double cmzn_timesequence_get_time(cmzn_timesequence_id timesequence,
 ZINC_API int cmzn_timesequence_set_time(cmzn_timesequence_id timesequence,
 	int time_index, double time);
 
+/**
+ * Set values varying with the time sequence to be held in a scratch file
+ * instead of memory, with only a limited number of times resident at once.
+ * Times are loaded on demand as they are evaluated or assigned, and the next
+ * time is read ahead in the background when stepping through times for
+ * animation. Only real-valued fields may be defined with a paged time
+ * sequence. The scratch file is deleted when the time sequence is destroyed.
+ * This can only be done while the time sequence is not in use by other
+ * objects, and should be done after all times are set; parameters must be
+ * reassigned if the number of times changes.
+ *
+ * @param timesequence  The time sequence to modify.
+ * @param file_name  The name of the scratch file to create, replacing any
+ * existing file of that name, or NULL to hold values in memory again.
+ * @param maximum_resident_times  The maximum number of times held in memory,
+ * at least 2. At least 3 are needed for reading ahead.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT if invalid
+ * argument or in use, or CMZN_ERROR_GENERAL if failed to create file.
+ */
+ZINC_API int cmzn_timesequence_set_paged_storage(cmzn_timesequence_id timesequence,
+	const char *file_name, int maximum_resident_times);
+
 #ifdef __cplusplus
 }
 #endif
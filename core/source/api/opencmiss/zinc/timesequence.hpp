@@ -79,6 +79,11 @@ public:
 		return cmzn_timesequence_set_time(id, timeIndex, time);
 	}
 
+	int setPagedStorage(const char *fileName, int maximumResidentTimes)
+	{
+		return cmzn_timesequence_set_paged_storage(id, fileName, maximumResidentTimes);
+	}
+
 };
 
 inline bool operator==(const Timesequence& a, const Timesequence& b)
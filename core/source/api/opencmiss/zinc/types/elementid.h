@@ -178,9 +178,18 @@ enum cmzn_element_quadrature_rule
 		     Currently limited to a maximum of 4 points in each element direction.
 		     Triangles and tetrahedra have symmetric point arrangements for an
 		     equal polynomial degree in each axis. */
-	CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT = 2
+	CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT = 2,
 		/*!< Sample at mid-points of equal-sized cells in element local xi chart,
 		     with equal weights. Also called the rectangle rule. */
+	CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE = 3
+		/*!< Gaussian quadrature with the number of points chosen per element
+		     to meet a relative tolerance. The order is increased up to 4 points
+		     per element axis, then line, square and cube elements are
+		     subdivided into up to 8 equal intervals per axis. Other shapes
+		     stop at 4 points, with a warning if the tolerance is not met.
+		     The number of points is the initial order. Only the integral
+		     itself adapts; individual least-squares terms use the fixed
+		     Gaussian rule. */
 };
 
 /**
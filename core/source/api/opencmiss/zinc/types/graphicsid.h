@@ -111,6 +111,25 @@ enum cmzn_graphics_streamlines_track_direction
 	/*!< the reverse of stream_vector_field is tracked */
 };
 
+/**
+ * Enumeration giving the method used to integrate streamlines through the
+ * stream vector field.
+ *
+ * @see cmzn_graphics_streamlines_set_integration_method
+ */
+enum cmzn_graphics_streamlines_integration_method
+{
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID = 0,
+	/*!< Unspecified integration method */
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER = 1,
+	/*!< Adaptive step improved Euler method, with step size chosen by comparing
+	 * a whole step with two half steps. The default. */
+	CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45 = 2
+	/*!< Embedded Runge-Kutta 4(5) method of Dormand and Prince, with step size
+	 * chosen from the difference between the 4th and 5th order solutions.
+	 * Generally takes far fewer steps than improved Euler for the same accuracy. */
+};
+
 /**
  * @brief Surfaces visualise 2-D elements in the model.
  *
@@ -63,8 +63,18 @@ enum cmzn_streaminformation_region_file_format
 	 * .ex* -> EX format; .fieldml -> FieldML */
 	CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX = 2,
 	/*!< Zinc/Cmgui EX format */
-	CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML = 3
+	CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML = 3,
 	/*!< Latest supported FieldML format */
+	CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY = 4,
+	/*!< EX format with real node parameters, element scale factors and grid
+	 * values stored as raw little-endian binary, for fast save and load of
+	 * large models. Only written if explicitly requested; read as EX format */
+	CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY = 5
+	/*!< FieldML format with node parameter and element connectivity arrays
+	 * written to an external raw little-endian binary resource named after the
+	 * file with .bin appended, for fast save and load of large models. Only
+	 * written if explicitly requested; read as FieldML format. Not supported
+	 * for memory resources. */
 };
 
 enum cmzn_streaminformation_region_recursion_mode
@@ -57,8 +57,13 @@ enum cmzn_streaminformation_scene_io_format
 	/*!< Unspecified attribute */
 	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS = 1,
 	/*!< Export scene into ThreeJS compatible JSON file.*/
-	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION = 2
+	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION = 2,
 	/*!< Import/export scene configurations into the scene */
+	CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY = 3
+	/*!< Export scene surfaces into binary glTF 2.0 (GLB) files loadable by
+	 * three.js GLTFLoader, with the same options as THREEJS format. Each file
+	 * has a compact JSON header and vertex data in a single binary buffer.
+	 * Time steps are exported as morph targets. */
 };
 
 #endif
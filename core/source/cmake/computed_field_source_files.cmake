@@ -30,6 +30,7 @@ SET( COMPUTED_FIELD_CORE_SRCS
 	source/computed_field/differential_operator.cpp
 	source/computed_field/field_cache.cpp
 	source/computed_field/field_module.cpp
+	source/computed_field/field_profiler.cpp
 	source/computed_field/fieldsmoothingprivate.cpp
 	source/computed_field/computed_field_find_xi.cpp
 	source/computed_field/computed_field_finite_element.cpp
@@ -58,6 +59,7 @@ SET( COMPUTED_FIELD_CORE_HDRS
 	source/computed_field/differential_operator.hpp
 	source/computed_field/field_cache.hpp
 	source/computed_field/field_module.hpp
+	source/computed_field/field_profiler.hpp
 	source/computed_field/fieldsmoothingprivate.hpp
 	source/computed_field/computed_field_find_xi.h
 	source/computed_field/computed_field_finite_element.h
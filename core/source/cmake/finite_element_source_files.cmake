@@ -19,6 +19,7 @@ SET( FINITE_ELEMENT_CORE_SRCS
 	source/finite_element/finite_element_nodeset.cpp
 	source/finite_element/finite_element_region.cpp
 	source/finite_element/finite_element_time.cpp
+	source/finite_element/finite_element_time_series_store.cpp
 	source/finite_element/import_finite_element.cpp )
 SET( FINITE_ELEMENT_CORE_HDRS
 	source/finite_element/export_finite_element.h
@@ -32,6 +33,7 @@ SET( FINITE_ELEMENT_CORE_HDRS
 	source/finite_element/finite_element.h
 	source/finite_element/finite_element_basis.h
 	source/finite_element/finite_element_time.h
+	source/finite_element/finite_element_time_series_store.hpp
 	source/finite_element/import_finite_element.h )
 
 SET( FINITE_ELEMENT_GRAPHICS_SRCS
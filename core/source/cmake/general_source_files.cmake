@@ -38,6 +38,7 @@ SET( GENERAL_HDRS
 	source/general/any_object_private.h
 	source/general/any_object_prototype.h
 	source/general/block_array.hpp
+	source/general/byte_order.hpp
 	source/general/callback.h
 	source/general/callback_class.hpp
 	source/general/callback_private.h
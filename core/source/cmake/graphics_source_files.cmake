@@ -25,6 +25,7 @@ SET( GRAPHICS_SRCS
 	source/graphics/complex.cpp
 	source/graphics/element_point_ranges.cpp
 	source/graphics/environment_map.cpp
+	source/graphics/gltf_export.cpp
 	source/graphics/glyph.cpp
 	source/graphics/glyph_axes.cpp
 	source/graphics/glyph_circular.cpp
@@ -72,7 +73,9 @@ SET( GRAPHICS_HDRS
 	source/graphics/colour.h
 	source/graphics/complex.h
 	source/graphics/element_point_ranges.h
+	source/graphics/element_scalar_range_index.hpp
 	source/graphics/environment_map.h
+	source/graphics/gltf_export.hpp
 	source/graphics/glyph.hpp
 	source/graphics/glyph_axes.hpp
 	source/graphics/glyph_circular.hpp
@@ -119,6 +122,7 @@ IF( ${GRAPHICS_API} MATCHES OPENGL_GRAPHICS )
 		source/graphics/font.cpp
 		source/graphics/graphics_library.cpp
 		source/graphics/graphics_object.cpp
+		source/graphics/graphics_object_bvh.cpp
 		source/graphics/light.cpp
 		source/graphics/render.cpp
 		source/graphics/render_gl.cpp
@@ -128,6 +132,7 @@ IF( ${GRAPHICS_API} MATCHES OPENGL_GRAPHICS )
 	SET( GRAPHICS_HDRS ${GRAPHICS_HDRS}
 		source/graphics/font.h
 		source/graphics/graphics_library.h
+		source/graphics/graphics_object_bvh.hpp
 		source/graphics/light.hpp
 		source/graphics/render.hpp
 		source/graphics/render_gl.h
@@ -1432,6 +1432,24 @@ int cmzn_field_evaluate_derivative(cmzn_field_id field,
 			int element_dimension = element_xi_location->get_dimension();
 			if (element_dimension == differential_operator->getDimension())
 			{
+				if (2 == differential_operator->getOrder())
+				{
+					RealFieldValueCache *valueCache = field->evaluateWithSecondDerivatives(*cache, element_dimension);
+					if (!valueCache)
+					{
+						// distinguish fields not supporting second derivatives
+						return (field->evaluateWithDerivatives(*cache, element_dimension)) ?
+							CMZN_ERROR_NOT_IMPLEMENTED : CMZN_ERROR_ARGUMENT;
+					}
+					const int number_of_second_derivatives = element_dimension*element_dimension;
+					FE_value *second_derivative = valueCache->second_derivatives + (differential_operator->getTerm() - 1);
+					for (int i = 0; i < field->number_of_components; i++)
+					{
+						values[i] = *second_derivative;
+						second_derivative += number_of_second_derivatives;
+					}
+					return CMZN_OK;
+				}
 				FieldValueCache *valueCache = field->evaluateWithDerivatives(*cache, element_dimension);
 				if (valueCache)
 				{
@@ -3051,6 +3069,12 @@ struct cmzn_region *Computed_field_manager_get_region(
 	return MANAGER_GET_OWNER(Computed_field)(manager);
 }
 
+bool Computed_field_manager_is_caching_changes(
+	struct MANAGER(Computed_field) *manager)
+{
+	return (manager) && (0 < manager->cache);
+}
+
 const cmzn_set_cmzn_field &Computed_field_manager_get_fields(
 	struct MANAGER(Computed_field) *manager)
 {
@@ -333,6 +333,32 @@ int Computed_field_multiply_components::evaluate(cmzn_fieldcache& cache, FieldVa
 				}
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() &&
+				source1Cache->second_derivatives_valid && source2Cache->second_derivatives_valid)
+			{
+				FE_value *second_derivative = valueCache.getSecondDerivatives();
+				const FE_value *second_derivative1 = source1Cache->second_derivatives;
+				const FE_value *second_derivative2 = source2Cache->second_derivatives;
+				for (i = 0; i < field->number_of_components; i++)
+				{
+					const FE_value *derivative1 = source1Cache->derivatives + i*number_of_xi;
+					const FE_value *derivative2 = source2Cache->derivatives + i*number_of_xi;
+					for (j = 0; j < number_of_xi; j++)
+					{
+						for (int k = 0; k < number_of_xi; k++)
+						{
+							*second_derivative =
+								(*second_derivative1)*source2Cache->values[i] +
+								derivative1[j]*derivative2[k] + derivative1[k]*derivative2[j] +
+								source1Cache->values[i]*(*second_derivative2);
+							second_derivative++;
+							second_derivative1++;
+							second_derivative2++;
+						}
+					}
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
@@ -562,6 +588,32 @@ int Computed_field_divide_components::evaluate(cmzn_fieldcache& cache, FieldValu
 				}
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() &&
+				source1Cache->second_derivatives_valid && source2Cache->second_derivatives_valid)
+			{
+				// w = u/v: w_jk = (u_jk - w_j.v_k - w_k.v_j - w.v_jk)/v
+				FE_value *second_derivative = valueCache.getSecondDerivatives();
+				const FE_value *second_derivative1 = source1Cache->second_derivatives;
+				const FE_value *second_derivative2 = source2Cache->second_derivatives;
+				for (i = 0; i < field->number_of_components; i++)
+				{
+					const FE_value *result_derivative = valueCache.derivatives + i*number_of_xi;
+					const FE_value *derivative2 = source2Cache->derivatives + i*number_of_xi;
+					for (j = 0; j < number_of_xi; j++)
+					{
+						for (int k = 0; k < number_of_xi; k++)
+						{
+							*second_derivative = ((*second_derivative1) -
+								result_derivative[j]*derivative2[k] - result_derivative[k]*derivative2[j] -
+								valueCache.values[i]*(*second_derivative2)) / source2Cache->values[i];
+							second_derivative++;
+							second_derivative1++;
+							second_derivative2++;
+						}
+					}
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
@@ -785,6 +837,21 @@ int Computed_field_add::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValu
 				temp2++;
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() &&
+				source1Cache->second_derivatives_valid && source2Cache->second_derivatives_valid)
+			{
+				temp = valueCache.getSecondDerivatives();
+				temp1 = source1Cache->second_derivatives;
+				temp2 = source2Cache->second_derivatives;
+				for (int i = (field->number_of_components*number_of_xi*number_of_xi); 0 < i; i--)
+				{
+					(*temp) = field->source_values[0]*(*temp1) + field->source_values[1]*(*temp2);
+					temp++;
+					temp1++;
+					temp2++;
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
@@ -1050,6 +1117,21 @@ int Computed_field_scale::evaluate(cmzn_fieldcache& cache, FieldValueCache& inVa
 				}
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() && sourceCache->second_derivatives_valid)
+			{
+				temp = valueCache.getSecondDerivatives();
+				temp2 = sourceCache->second_derivatives;
+				for (i=0;i<field->number_of_components;i++)
+				{
+					for (j=number_of_xi*number_of_xi;j>0;j--)
+					{
+						(*temp)=field->source_values[i]*(*temp2);
+						temp++;
+						temp2++;
+					}
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
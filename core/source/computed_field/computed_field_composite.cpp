@@ -207,6 +207,7 @@ int Computed_field_composite::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 		fixedValueCache : new RealFieldValueCache*[field->number_of_source_fields];
 	int return_code = 1;
 	int number_of_derivatives = cache.getRequestedDerivatives();
+	bool second_derivatives = cache.getRequestedSecondDerivatives();
 	for (int i = 0; i < field->number_of_source_fields; ++i)
 	{
 		sourceValueCache[i] = RealFieldValueCache::cast(getSourceField(i)->evaluate(cache));
@@ -217,12 +218,19 @@ int Computed_field_composite::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 		}
 		if (number_of_derivatives && !sourceValueCache[i]->derivatives_valid)
 			number_of_derivatives = 0;
+		if (second_derivatives && !sourceValueCache[i]->second_derivatives_valid)
+			second_derivatives = false;
 	}
 	if (return_code)
 	{
 		RealFieldValueCache& valueCache = RealFieldValueCache::cast(inValueCache);
 		valueCache.derivatives_valid = number_of_derivatives;
 		FE_value *destination = number_of_derivatives ? valueCache.derivatives : 0;
+		const int number_of_second_derivatives = number_of_derivatives*number_of_derivatives;
+		if (!number_of_derivatives)
+			second_derivatives = false;
+		FE_value *second_destination = second_derivatives ? valueCache.getSecondDerivatives() : 0;
+		valueCache.second_derivatives_valid = second_derivatives ? 1 : 0;
 		for (int i=0;i<field->number_of_components;i++)
 		{
 			if (0 <= source_field_numbers[i])
@@ -241,6 +249,17 @@ int Computed_field_composite::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 						source++;
 					}
 				}
+				if (second_derivatives)
+				{
+					FE_value *source = sourceValueCache[source_field_numbers[i]]->second_derivatives +
+						source_value_numbers[i]*number_of_second_derivatives;
+					for (int j=0;j<number_of_second_derivatives;j++)
+					{
+						*second_destination = *source;
+						second_destination++;
+						source++;
+					}
+				}
 			}
 			else
 			{
@@ -253,6 +272,14 @@ int Computed_field_composite::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 						destination++;
 					}
 				}
+				if (second_derivatives)
+				{
+					for (int j=0;j<number_of_second_derivatives;j++)
+					{
+						*second_destination = 0.0;
+						second_destination++;
+					}
+				}
 			}
 		}
 	}
@@ -23,8 +23,10 @@ lookup of the element.
 #include "computed_field/computed_field_find_xi.h"
 #include "computed_field/computed_field_find_xi_private.hpp"
 #include "finite_element/finite_element_discretization.h"
+#include "finite_element/finite_element_mesh.hpp"
 #include "finite_element/finite_element_region.h"
 #include "general/message.h"
+#include "mesh/cmiss_element_private.hpp"
 
 #define MAX_FIND_XI_ITERATIONS 50
 
@@ -147,6 +149,7 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
 								data->xi[i] += b[i];
 							}
 							iterations++;
+							data->iterations++;
 							if (!converged)
 							{
 								FE_element_shape_limit_xi_to_element(shape,
@@ -260,8 +263,179 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
 	return (return_code);
 } /* Computed_field_iterative_element_conditional */
 
+/* limit on damped Newton step in xi, so each step moves at most about one element */
+#define MAX_FIND_XI_WALK_STEP 1.0
+
+int Computed_field_find_element_xi_by_walking(struct FE_element *start_element,
+	struct Computed_field_iterative_find_element_xi_data *data,
+	cmzn_mesh_id search_mesh, int max_element_visits,
+	struct FE_element **element_address)
+{
+	if (!((start_element) && (data) && (search_mesh) && (element_address)))
+	{
+		display_message(ERROR_MESSAGE,
+			"Computed_field_find_element_xi_by_walking.  Invalid argument(s)");
+		return 0;
+	}
+	*element_address = 0;
+	const int number_of_xi = get_FE_element_dimension(start_element);
+	if (number_of_xi > data->number_of_values)
+		return 0;
+	if (data->found_number_of_xi != number_of_xi)
+	{
+		FE_value *derivatives;
+		if (!REALLOCATE(derivatives, data->found_derivatives, FE_value,
+			data->number_of_values * number_of_xi))
+		{
+			display_message(ERROR_MESSAGE,
+				"Computed_field_find_element_xi_by_walking.  "
+				"Unable to allocate derivative storage");
+			return 0;
+		}
+		data->found_derivatives = derivatives;
+		data->found_number_of_xi = number_of_xi;
+	}
+	FE_value *values = data->found_values;
+	FE_value *derivatives = data->found_derivatives;
+	struct FE_element *element = start_element;
+	FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS], last_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	if (data->start_with_data_xi)
+	{
+		for (int i = 0; i < number_of_xi; i++)
+			xi[i] = data->xi[i];
+	}
+	else
+	{
+		int number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS], number_of_xi_points_created[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		FE_value_triple *xi_points;
+		for (int i = 0; i < number_of_xi; i++)
+			number_in_xi[i] = 1;
+		if (FE_element_shape_get_xi_points_cell_centres(get_FE_element_shape(element),
+			number_in_xi, number_of_xi_points_created, &xi_points))
+		{
+			for (int i = 0; i < number_of_xi; i++)
+				xi[i] = xi_points[0][i];
+			DEALLOCATE(xi_points);
+		}
+		else
+		{
+			for (int i = 0; i < number_of_xi; i++)
+				xi[i] = 0.5;
+		}
+	}
+	double a[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		b[MAXIMUM_ELEMENT_XI_DIMENSIONS], d, sum;
+	FE_value increment[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	int indx[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	int element_visits = 1;
+	++data->element_visits;
+	for (int iterations = 0; iterations < MAX_FIND_XI_ITERATIONS; ++iterations)
+	{
+		++data->iterations;
+		if (!((CMZN_OK == cmzn_fieldcache_set_mesh_location(data->field_cache, element, number_of_xi, xi)) &&
+			(CMZN_OK == cmzn_field_evaluate_real_with_derivatives(data->field, data->field_cache,
+				data->number_of_values, values, number_of_xi, derivatives))))
+			return 0;
+		/* Gauss-Newton step from analytic dx/dxi, as in Computed_field_iterative_element_conditional */
+		for (int i = 0; i < number_of_xi; i++)
+		{
+			for (int j = 0; j < number_of_xi; j++)
+			{
+				sum = 0.0;
+				for (int k = 0; k < data->number_of_values; k++)
+				{
+					sum += (double)derivatives[k*number_of_xi + j] *
+						(double)derivatives[k*number_of_xi + i];
+				}
+				a[i*number_of_xi + j] = sum;
+			}
+			sum = 0.0;
+			for (int k = 0; k < data->number_of_values; k++)
+			{
+				sum += (double)derivatives[k*number_of_xi + i] *
+					((double)data->values[k] - (double)values[k]);
+			}
+			b[i] = sum;
+		}
+		if (!(LU_decompose(number_of_xi, a, indx, &d,/*singular_tolerance*/1.0e-12) &&
+			LU_backsubstitute(number_of_xi, a, indx, b)))
+			return 0;
+		int converged = 1;
+		double max_step = 0.0;
+		for (int i = 0; i < number_of_xi; i++)
+		{
+			if (fabs(b[i]) > data->xi_tolerance)
+				converged = 0;
+			if (fabs(b[i]) > max_step)
+				max_step = fabs(b[i]);
+		}
+		if (converged)
+		{
+			/* if field has more components than xi-directions, must
+				check all components have converged; see Computed_field_iterative_element_conditional */
+			if (data->number_of_values > number_of_xi)
+			{
+				for (int k = 0; k < data->number_of_values; k++)
+				{
+					sum = 0.0;
+					for (int i = 0; i < number_of_xi; i++)
+						sum += (double)derivatives[k*number_of_xi + i] * b[i];
+					if (2.0*fabs(sum) < fabs((double)data->values[k] - (double)values[k]))
+						return 0;
+				}
+			}
+			for (int i = 0; i < number_of_xi; i++)
+				data->xi[i] = xi[i] + b[i];
+			FE_element_shape_limit_xi_to_element(get_FE_element_shape(element),
+				data->xi, data->xi_tolerance);
+			*element_address = element;
+			return 1;
+		}
+		/* damp step and walk it, crossing faces into neighbouring elements */
+		const double scale = (max_step > MAX_FIND_XI_WALK_STEP) ? MAX_FIND_XI_WALK_STEP / max_step : 1.0;
+		for (int i = 0; i < number_of_xi; i++)
+		{
+			increment[i] = static_cast<FE_value>(scale*b[i]);
+			last_xi[i] = xi[i];
+		}
+		struct FE_element *last_element = element;
+		if (!FE_element_xi_increment(&element, xi, increment))
+			return 0;
+		if (element != last_element)
+		{
+			++element_visits;
+			++data->element_visits;
+			if ((element_visits > max_element_visits) ||
+				(number_of_xi != get_FE_element_dimension(element)) ||
+				(!cmzn_mesh_contains_element(search_mesh, element)))
+				return 0;
+		}
+		else
+		{
+			/* give up if xi not changed; solution is outside mesh boundary */
+			int moved = 0;
+			for (int i = 0; i < number_of_xi; i++)
+			{
+				if (fabs(xi[i] - last_xi[i]) > data->xi_tolerance)
+				{
+					moved = 1;
+					break;
+				}
+			}
+			if (!moved)
+				return 0;
+		}
+	}
+	return 0;
+}
+
+#undef MAX_FIND_XI_WALK_STEP
 #undef MAX_FIND_XI_ITERATIONS
 
+/* maximum number of elements visited when walking to the location before
+	falling back to searching all elements */
+#define MAX_FIND_XI_ELEMENT_VISITS 12
+
 int Computed_field_perform_find_element_xi(struct Computed_field *field,
 	cmzn_fieldcache_id field_cache,
 	const FE_value *values, int number_of_values,
@@ -374,6 +548,9 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 		{
 			if (cache->valid_values)
 			{
+				cache->search_element_visits = 0;
+				cache->search_iterations = 0;
+				cache->search_fallback = 0;
 				/* This could even be valid if *element is NULL */
 				*element_address = cache->element;
 				if (*element_address)
@@ -405,36 +582,51 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 				find_element_xi_data.nearest_element = (struct FE_element *)NULL;
 				find_element_xi_data.nearest_element_distance_squared = 0.0;
 				find_element_xi_data.start_with_data_xi = 0;
+				find_element_xi_data.element_visits = 0;
+				find_element_xi_data.iterations = 0;
+				cache->search_fallback = 0;
 
 				if (search_mesh)
 				{
 					*element_address = (struct FE_element *)NULL;
 
-					/* Try the cached element first if it is in the mesh */
+					/* Walk from the cached element if it is in the mesh, starting
+						with the xi that worked before, otherwise from the first element */
+					cmzn_element_id start_element = 0;
 					if (cache->element &&
 						cmzn_mesh_contains_element(search_mesh, cache->element))
 					{
-						/* Start with the xi that worked before too */
+						start_element = cache->element;
 						number_of_xi = get_FE_element_dimension(cache->element);
 						for (i = 0 ; i < number_of_xi ; i++)
 						{
 							find_element_xi_data.xi[i] = cache->xi[i];
 						}
 						find_element_xi_data.start_with_data_xi = 1;
-						if (Computed_field_iterative_element_conditional(
-							cache->element, &find_element_xi_data))
-						{
-							*element_address = cache->element;
-						}
-						find_element_xi_data.start_with_data_xi = 0;
 					}
+					else
+					{
+						cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(search_mesh);
+						start_element = cmzn_elementiterator_next_non_access(iterator);
+						cmzn_elementiterator_destroy(&iterator);
+					}
+					/* walking needs face mesh to find neighbours */
+					FE_mesh *fe_mesh = cmzn_mesh_get_FE_mesh_internal(search_mesh);
+					if (start_element && fe_mesh && fe_mesh->getFaceMesh())
+					{
+						Computed_field_find_element_xi_by_walking(start_element, &find_element_xi_data,
+							search_mesh, MAX_FIND_XI_ELEMENT_VISITS, element_address);
+					}
+					find_element_xi_data.start_with_data_xi = 0;
 					/* Now try every element */
 					if (!*element_address)
 					{
+						cache->search_fallback = 1;
 						cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(search_mesh);
 						cmzn_element_id element = 0;
 						while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
 						{
+							++find_element_xi_data.element_visits;
 							if (Computed_field_iterative_element_conditional(element, &find_element_xi_data))
 							{
 								*element_address = element;
@@ -446,6 +638,7 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 				}
 				else
 				{
+					++find_element_xi_data.element_visits;
 					if ((!Computed_field_iterative_element_conditional(
 						*element_address, &find_element_xi_data)))
 					{
@@ -498,6 +691,8 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 				}
 				cache->set_search_mesh(search_mesh);
 				cache->valid_values = 1;
+				cache->search_element_visits = find_element_xi_data.element_visits;
+				cache->search_iterations = find_element_xi_data.iterations;
 			}
 		}
 		else
@@ -523,6 +718,28 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 	return (return_code);
 } /* Computed_field_perform_find_element_xi */
 
+#undef MAX_FIND_XI_ELEMENT_VISITS
+
+int Computed_field_get_find_element_xi_statistics(struct Computed_field *field,
+	cmzn_fieldcache_id field_cache, int *element_visits, int *iterations,
+	int *fallback)
+{
+	if (!(field && field_cache && element_visits && iterations && fallback))
+	{
+		display_message(ERROR_MESSAGE,
+			"Computed_field_get_find_element_xi_statistics.  Invalid argument(s)");
+		return 0;
+	}
+	RealFieldValueCache *valueCache = dynamic_cast<RealFieldValueCache*>(field->getValueCache(*field_cache));
+	if (!(valueCache && valueCache->find_element_xi_cache && valueCache->find_element_xi_cache->cache_data))
+		return 0;
+	Computed_field_find_element_xi_base_cache *cache = valueCache->find_element_xi_cache->cache_data;
+	*element_visits = cache->search_element_visits;
+	*iterations = cache->search_iterations;
+	*fallback = cache->search_fallback;
+	return 1;
+}
+
 struct Computed_field_find_element_xi_cache
 	*CREATE(Computed_field_find_element_xi_cache)(
 		Computed_field_find_element_xi_base_cache *cache_data)
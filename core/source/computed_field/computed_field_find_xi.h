@@ -57,6 +57,22 @@ int Computed_field_perform_find_element_xi(struct Computed_field *field,
 	struct FE_element **element_address, FE_value *xi,
 	cmzn_mesh_id search_mesh, int find_nearest);
 
+/**
+ * Get statistics for the last search performed by
+ * Computed_field_perform_find_element_xi for field in field_cache. All values
+ * are zero if the last result was taken from the find element xi cache.
+ *
+ * @param element_visits  On success, set to the number of elements searched,
+ * including those walked through.
+ * @param iterations  On success, set to the total number of Newton iterations.
+ * @param fallback  On success, set to 1 if the search fell back to checking
+ * every element in the mesh, otherwise 0.
+ * @return  1 on success, 0 if field has not performed a search in field_cache.
+ */
+int Computed_field_get_find_element_xi_statistics(struct Computed_field *field,
+	cmzn_fieldcache_id field_cache, int *element_visits, int *iterations,
+	int *fallback);
+
 int DESTROY(Computed_field_find_element_xi_cache)
 	  (struct Computed_field_find_element_xi_cache **cache_address);
 /*******************************************************************************
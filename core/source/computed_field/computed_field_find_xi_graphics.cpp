@@ -236,6 +236,8 @@ int Computed_field_find_element_xi_special(struct Computed_field *field,
 		find_element_xi_data.nearest_element_distance_squared = 0.0;
 		find_element_xi_data.start_with_data_xi = 0;
 		find_element_xi_data.time = 0;
+		find_element_xi_data.element_visits = 0;
+		find_element_xi_data.iterations = 0;
 		if (ALLOCATE(find_element_xi_data.found_values, FE_value, number_of_values))
 		{
 			cache = (Computed_field_find_element_xi_graphics_cache*)NULL;
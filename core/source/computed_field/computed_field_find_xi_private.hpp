@@ -27,6 +27,10 @@ public:
 	int in_perform_find_element_xi;
 	FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
 	/* Warn when trying to destroy this cache as it is being filled in */
+	/* statistics for the last search; all zero if values were found in cache */
+	int search_element_visits;
+	int search_iterations;
+	int search_fallback;
 	
 	Computed_field_find_element_xi_base_cache() :
 		search_mesh(0),
@@ -36,7 +40,10 @@ public:
 		time(0),
 		values((FE_value *)NULL),
 		working_values((FE_value *)NULL),
-		in_perform_find_element_xi(0)
+		in_perform_find_element_xi(0),
+		search_element_visits(0),
+		search_iterations(0),
+		search_fallback(0)
 	{
 	}
 	
@@ -119,6 +126,9 @@ matches the <field> in this structure or one of its source fields.
 	double nearest_element_distance_squared;
 	int start_with_data_xi;
 	double time;
+	/* counters incremented by searches, for statistics */
+	int element_visits;
+	int iterations;
 }; /* Computed_field_iterative_find_element_xi_data */
 
 int Computed_field_iterative_element_conditional(struct FE_element *element,
@@ -133,4 +143,25 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
  * @return  1 if a valid element xi is found.
  */
 
+/**
+ * Searches for location with matching field values by damped Gauss-Newton
+ * iteration using the analytic derivatives of the field w.r.t. xi, walking
+ * into neighbouring elements across faces when xi leaves the current element.
+ * Starts in start_element at data->xi if data->start_with_data_xi is set,
+ * otherwise at its centre. Gives up if the walk leaves the search mesh, visits
+ * more than max_element_visits elements, or stalls on a mesh boundary. Does
+ * not update the nearest location in data.
+ * Important note: same restrictions on <data> values as for
+ * Computed_field_iterative_element_conditional.
+ *
+ * @param search_mesh  Mesh all visited elements must be in.
+ * @param element_address  On success set to element found, otherwise 0. Xi
+ * is returned in data->xi.
+ * @return  1 if a valid element xi is found, otherwise 0.
+ */
+int Computed_field_find_element_xi_by_walking(struct FE_element *start_element,
+	struct Computed_field_iterative_find_element_xi_data *data,
+	cmzn_mesh_id search_mesh, int max_element_visits,
+	struct FE_element **element_address);
+
 #endif /* !defined (COMPUTED_FIELD_FIND_XI_PRIVATE_HPP) */
@@ -11,7 +11,10 @@ Implements a number of basic component wise operations on computed fields.
 * This Source Code Form is subject to the terms of the Mozilla Public
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include <algorithm>
 #include <math.h>
+#include <utility>
+#include <vector>
 #include "opencmiss/zinc/fieldmodule.h"
 #include "opencmiss/zinc/fieldfiniteelement.h"
 #include "computed_field/computed_field.h"
@@ -713,6 +716,11 @@ int Computed_field_finite_element::evaluate(cmzn_fieldcache& cache, FieldValueCa
 									feValueCache.fe_element_field_values,xi,feValueCache.values,
 									feValueCache.derivatives);
 								feValueCache.derivatives_valid = (0<number_of_derivatives);
+								if (return_code && cache.getRequestedSecondDerivatives())
+								{
+									feValueCache.second_derivatives_valid = (CMZN_OK == calculate_FE_element_field_second_derivatives(-1,
+										feValueCache.fe_element_field_values, xi, feValueCache.getSecondDerivatives()));
+								}
 							}
 							else
 							{
@@ -1041,6 +1049,13 @@ enum FieldAssignmentResult Computed_field_finite_element::assign(cmzn_fieldcache
 	{
 		FE_node *node = node_location->get_node();
 		FE_value time = node_location->get_time();
+		// set all components with one change notification in usual case
+		if ((FE_VALUE_VALUE == value_type) && set_FE_nodal_field_FE_value_values_all_versions(
+			fe_field, node, valueCache.values, time))
+		{
+			valueCache.derivatives_valid = 0;
+			return result;
+		}
 		for (int i=0;i<field->number_of_components;i++)
 		{
 			/* set values all versions; to set values for selected version only,
@@ -1524,6 +1539,65 @@ int Computed_field_get_type_finite_element(struct Computed_field *field,
 	return 0;
 }
 
+int Computed_field_finite_element_assign_element_grid_values(
+	struct Computed_field *field, struct FE_element *element,
+	int number_of_points, const FE_value *xi_points, const FE_value *values)
+{
+	FE_field *fe_field = 0;
+	if (!(Computed_field_get_type_finite_element(field, &fe_field) && element &&
+		(0 <= number_of_points) && ((0 == number_of_points) || (xi_points && values)) &&
+		(FE_VALUE_VALUE == get_FE_field_value_type(fe_field)) &&
+		FE_element_field_is_grid_based(element, fe_field)))
+	{
+		return 0;
+	}
+	const int number_of_components = field->number_of_components;
+	const int element_dimension = get_FE_element_dimension(element);
+	FE_element_shape *element_shape = get_FE_element_shape(element);
+	int grid_map_number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS], indices[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	int return_code = 1;
+	for (int k = 0; (k < number_of_components) && return_code; ++k)
+	{
+		/* ignore non-grid-based components */
+		if (!get_FE_element_field_component_grid_map_number_in_xi(element,
+			fe_field, /*component_number*/k, grid_map_number_in_xi))
+		{
+			continue;
+		}
+		FE_value *grid_values = 0;
+		if (!get_FE_element_field_component_grid_FE_value_values(element, fe_field, k, &grid_values))
+		{
+			display_message(ERROR_MESSAGE, "Computed_field_finite_element_assign_element_grid_values.  "
+				"Unable to get old grid FE_value values");
+			return 0;
+		}
+		for (int p = 0; p < number_of_points; ++p)
+		{
+			if (!FE_element_shape_get_indices_for_xi_location_in_cell_corners(element_shape,
+				grid_map_number_in_xi, xi_points + p*MAXIMUM_ELEMENT_XI_DIMENSIONS, indices))
+			{
+				display_message(ERROR_MESSAGE, "Computed_field_finite_element_assign_element_grid_values.  "
+					"Element locations do not coincide with grid");
+				return_code = 0;
+				break;
+			}
+			int offset = indices[element_dimension - 1];
+			for (int i = element_dimension - 2; i >= 0; --i)
+				offset = offset*(grid_map_number_in_xi[i] + 1) + indices[i];
+			grid_values[offset] = values[p*number_of_components + k];
+		}
+		if (return_code && !set_FE_element_field_component_grid_FE_value_values(
+			element, fe_field, k, grid_values))
+		{
+			display_message(ERROR_MESSAGE, "Computed_field_finite_element_assign_element_grid_values.  "
+				"Unable to set finite element grid FE_value values");
+			return_code = 0;
+		}
+		DEALLOCATE(grid_values);
+	}
+	return return_code;
+}
+
 namespace {
 
 const char computed_field_cmiss_number_type_string[] = "cmiss_number";
@@ -2991,13 +3065,24 @@ class Computed_field_find_mesh_location : public Computed_field_core
 private:
 	cmzn_mesh_id mesh;
 	enum cmzn_field_find_mesh_location_search_mode search_mode;
+	// statistics totals from last call to find_batch
+	int batchPointsCount;
+	int batchFoundCount;
+	int batchFallbackCount;
+	int batchElementVisits;
+	int batchIterations;
 
 public:
 
 	Computed_field_find_mesh_location(cmzn_mesh_id mesh) :
 		Computed_field_core(),
 		mesh(cmzn_mesh_access(mesh)),
-		search_mode(CMZN_FIELD_FIND_MESH_LOCATION_SEARCH_MODE_EXACT)
+		search_mode(CMZN_FIELD_FIND_MESH_LOCATION_SEARCH_MODE_EXACT),
+		batchPointsCount(0),
+		batchFoundCount(0),
+		batchFallbackCount(0),
+		batchElementVisits(0),
+		batchIterations(0)
 	{
 	};
 
@@ -3033,6 +3118,21 @@ public:
 		return CMZN_OK;
 	}
 
+	int find_batch(cmzn_fieldcache& cache, int pointsCount, const double *valuesIn,
+		cmzn_element_id *elementsOut, double *xiOut);
+
+	void get_batch_statistics(int& pointsCount, int& foundCount, int& fallbackCount,
+		double& averageElementVisits, double& averageIterations) const
+	{
+		pointsCount = this->batchPointsCount;
+		foundCount = this->batchFoundCount;
+		fallbackCount = this->batchFallbackCount;
+		averageElementVisits = (this->batchPointsCount > 0) ?
+			static_cast<double>(this->batchElementVisits) / static_cast<double>(this->batchPointsCount) : 0.0;
+		averageIterations = (this->batchPointsCount > 0) ?
+			static_cast<double>(this->batchIterations) / static_cast<double>(this->batchPointsCount) : 0.0;
+	}
+
 private:
 	Computed_field_core *copy();
 
@@ -3149,6 +3249,118 @@ int Computed_field_find_mesh_location::evaluate(cmzn_fieldcache& cache, FieldVal
 	return (return_code);
 }
 
+/** Spread lowest 10 bits of value so there are 2 zero bits between each */
+static inline unsigned int Morton_code_spread_bits(unsigned int value)
+{
+	value &= 0x3ff;
+	value = (value | (value << 16)) & 0x030000ff;
+	value = (value | (value << 8)) & 0x0300f00f;
+	value = (value | (value << 4)) & 0x030c30c3;
+	value = (value | (value << 2)) & 0x09249249;
+	return value;
+}
+
+/**
+ * Find mesh locations for many source field values. Points are searched in
+ * order along a Z-order space-filling curve through up to the first 3
+ * components, so each search walks from the element and xi found for the
+ * previous, nearby point via the find element xi cache.
+ * Records statistics for the batch, retrieved with get_batch_statistics.
+ * @param valuesIn  pointsCount*componentsCount source field values.
+ * @param elementsOut  Array of pointsCount to receive accessed element handles
+ * or 0 if not found. Caller must destroy.
+ * @param xiOut  Array of pointsCount*mesh dimension to receive xi.
+ */
+int Computed_field_find_mesh_location::find_batch(cmzn_fieldcache& cache,
+	int pointsCount, const double *valuesIn, cmzn_element_id *elementsOut, double *xiOut)
+{
+	const int componentsCount = this->get_source_field()->number_of_components;
+	const int dimension = cmzn_mesh_get_dimension(this->mesh);
+	this->batchPointsCount = 0;
+	this->batchFoundCount = 0;
+	this->batchFallbackCount = 0;
+	this->batchElementVisits = 0;
+	this->batchIterations = 0;
+	if (pointsCount == 0)
+		return CMZN_OK;
+	for (int p = 0; p < pointsCount; ++p)
+		elementsOut[p] = 0;
+	MeshLocationFieldValueCache *valueCache = MeshLocationFieldValueCache::cast(this->field->getValueCache(cache));
+	if (!valueCache)
+		return CMZN_ERROR_GENERAL;
+	cmzn_fieldcache& extraCache = *valueCache->getExtraCache();
+	extraCache.setTime(cache.getTime());
+	// quantise to 10 bits per component over bounding box to get Morton code
+	const int sortComponentsCount = (componentsCount < 3) ? componentsCount : 3;
+	double minimums[3], scales[3];
+	for (int c = 0; c < sortComponentsCount; ++c)
+	{
+		double minimum = valuesIn[c];
+		double maximum = valuesIn[c];
+		for (int p = 1; p < pointsCount; ++p)
+		{
+			const double value = valuesIn[p*componentsCount + c];
+			if (value < minimum)
+				minimum = value;
+			else if (value > maximum)
+				maximum = value;
+		}
+		minimums[c] = minimum;
+		scales[c] = (maximum > minimum) ? 1023.0 / (maximum - minimum) : 0.0;
+	}
+	std::vector<std::pair<unsigned int, int> > order(pointsCount);
+	for (int p = 0; p < pointsCount; ++p)
+	{
+		unsigned int code = 0;
+		for (int c = 0; c < sortComponentsCount; ++c)
+		{
+			const unsigned int quantised = static_cast<unsigned int>(
+				(valuesIn[p*componentsCount + c] - minimums[c])*scales[c]);
+			code |= Morton_code_spread_bits(quantised) << c;
+		}
+		order[p] = std::make_pair(code, p);
+	}
+	std::sort(order.begin(), order.end());
+	const int find_nearest = (this->search_mode != CMZN_FIELD_FIND_MESH_LOCATION_SEARCH_MODE_EXACT);
+	cmzn_field *meshField = this->get_mesh_field();
+	int element_visits, iterations, fallback;
+	for (int i = 0; i < pointsCount; ++i)
+	{
+		const int p = order[i].second;
+		cmzn_element_id element = 0;
+		double *xi = xiOut + p*dimension;
+		if (!Computed_field_find_element_xi(meshField, &extraCache,
+			valuesIn + p*componentsCount, componentsCount, &element, xi,
+			this->mesh, /*propagate_field*/0, find_nearest))
+		{
+			display_message(ERROR_MESSAGE, "FieldFindMeshLocation findBatch.  Search failed");
+			for (int q = 0; q < pointsCount; ++q)
+				if (elementsOut[q])
+					cmzn_element_destroy(&elementsOut[q]);
+			return CMZN_ERROR_GENERAL;
+		}
+		if (element)
+		{
+			elementsOut[p] = cmzn_element_access(element);
+			++this->batchFoundCount;
+		}
+		else
+		{
+			for (int d = 0; d < dimension; ++d)
+				xi[d] = 0.0;
+		}
+		++this->batchPointsCount;
+		if (Computed_field_get_find_element_xi_statistics(meshField, &extraCache,
+			&element_visits, &iterations, &fallback))
+		{
+			this->batchElementVisits += element_visits;
+			this->batchIterations += iterations;
+			this->batchFallbackCount += fallback;
+		}
+	}
+	return CMZN_OK;
+}
+
 int Computed_field_find_mesh_location::list()
 {
 	int return_code = 0;
@@ -3342,6 +3554,36 @@ int cmzn_field_find_mesh_location_set_search_mode(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_field_find_mesh_location_find_batch(
+	cmzn_field_find_mesh_location_id find_mesh_location_field,
+	cmzn_fieldcache_id cache, int points_count, const double *source_values_in,
+	cmzn_element_id *elements_out, double *xi_out)
+{
+	if (find_mesh_location_field && cache && (0 <= points_count) &&
+		((0 == points_count) || (source_values_in && elements_out && xi_out)))
+	{
+		return find_mesh_location_field->get_core()->find_batch(*cache,
+			points_count, source_values_in, elements_out, xi_out);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_field_find_mesh_location_get_batch_statistics(
+	cmzn_field_find_mesh_location_id find_mesh_location_field,
+	int *points_count_out, int *found_count_out, int *fallback_count_out,
+	double *average_element_visits_out, double *average_iterations_out)
+{
+	if (find_mesh_location_field && points_count_out && found_count_out &&
+		fallback_count_out && average_element_visits_out && average_iterations_out)
+	{
+		find_mesh_location_field->get_core()->get_batch_statistics(*points_count_out,
+			*found_count_out, *fallback_count_out, *average_element_visits_out,
+			*average_iterations_out);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 namespace {
 
 const char computed_field_xi_coordinates_type_string[] = "xi_coordinates";
@@ -3429,6 +3671,8 @@ int Computed_field_xi_coordinates::evaluate(cmzn_fieldcache& cache, FieldValueCa
 		/* derivatives are always calculated since they are merely part of
 			the identity matrix */
 		valueCache.derivatives_valid=1;
+		if (cache.getRequestedSecondDerivatives())
+			valueCache.zeroSecondDerivatives(element_dimension);
 		return 1;
 	}
 	return 0;
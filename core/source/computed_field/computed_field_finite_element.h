@@ -56,6 +56,23 @@ wrapper for an FE_field.
 int Computed_field_get_type_finite_element(struct Computed_field *field,
 	struct FE_field **fe_field);
 
+/**
+ * Assigns values of a grid-based, FE_value finite element field at points in
+ * element, getting and setting the grid values of each component once rather
+ * than for every point. Components which are not grid-based are ignored.
+ *
+ * @param xi_points  Array of number_of_points xi locations, each with
+ * MAXIMUM_ELEMENT_XI_DIMENSIONS values. Must coincide with grid points.
+ * @param values  Array of number_of_points*number_of_components values, with
+ * components varying fastest.
+ * @return  1 on success, 0 on failure or if field is not a grid-based
+ * FE_value finite element field in element, in which case values should be
+ * assigned individually through a field cache.
+ */
+int Computed_field_finite_element_assign_element_grid_values(
+	struct Computed_field *field, struct FE_element *element,
+	int number_of_points, const FE_value *xi_points, const FE_value *values);
+
 /*******************************************************************************
  * Iterator/conditional function returning true if <field> is the finite_element
  * computed field wrapper for the FE_field.
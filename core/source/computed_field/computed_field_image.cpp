@@ -174,6 +174,9 @@ public:
 		return (1);
 	}
 
+	int evaluate_texture_coordinates(int points_count,
+		const double *texture_coordinates, double *values);
+
 private:
 
 	int evaluate_texture_from_source_field();
@@ -433,61 +436,78 @@ int Computed_field_image::evaluate_texture_from_source_field()
 	return (return_code);
 } /* Computed_field_image::evaluate_texture_from_source_field */
 
-int Computed_field_image::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
+/**
+ * Samples the texture at points_count texture coordinates, each with the
+ * number of components of the domain field, and scales them to the output
+ * range. Points are sampled in fixed size chunks to avoid allocating memory.
+ * @param values  Array to receive field number of components values per point.
+ * @return  1 on success, 0 on failure.
+ */
+int Computed_field_image::evaluate_texture_coordinates(int points_count,
+	const double *texture_coordinates, double *values)
 {
 	check_evaluate_texture();
-	if (texture)
+	if (!texture)
 	{
-		RealFieldValueCache *sourceCache = RealFieldValueCache::cast(getSourceField(0)->evaluate(cache));
-		if (sourceCache)
+		display_message(ERROR_MESSAGE,
+			"Computed_field_image::evaluate_texture_coordinates.  No texture");
+		return 0;
+	}
+	const int number_of_texture_coordinates = field->source_fields[0]->number_of_components;
+	const int number_of_components = field->number_of_components;
+	const int number_of_texture_components = Texture_get_number_of_components(texture);
+	if ((3 < number_of_texture_coordinates) || (4 < number_of_texture_components) ||
+		(number_of_texture_components < number_of_components))
+	{
+		display_message(ERROR_MESSAGE,
+			"Computed_field_image::evaluate_texture_coordinates.  Unsupported texture");
+		return 0;
+	}
+	const int chunk_size = 64;
+	double chunk_texture_coordinates[3*chunk_size];
+	double chunk_texture_values[4*chunk_size];
+	const double range = maximum - minimum;
+	for (int start = 0; start < points_count; start += chunk_size)
+	{
+		const int chunk_count = (points_count - start < chunk_size) ? (points_count - start) : chunk_size;
+		const double *source_coordinates = texture_coordinates + start*number_of_texture_coordinates;
+		for (int p = 0; p < chunk_count; ++p)
 		{
-			RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
-			double texture_values[4];
-			FE_value texture_coordinate[3];
-			texture_coordinate[0] = 0.0;
-			texture_coordinate[1] = 0.0;
-			texture_coordinate[2] = 0.0;
-			for (int i = 0; i < field->source_fields[0]->number_of_components; i++)
-			{
-				texture_coordinate[i] = sourceCache->values[i];
-			}
-			Texture_get_pixel_values(texture,
-				texture_coordinate[0], texture_coordinate[1], texture_coordinate[2],
-				texture_values);
-			int number_of_components = field->number_of_components;
-			if (minimum == 0.0)
+			for (int i = 0; i < 3; ++i)
 			{
-				if (maximum == 1.0)
-				{
-					for (int i = 0 ; i < number_of_components ; i++)
-					{
-						valueCache.values[i] =  texture_values[i];
-					}
-				}
-				else
-				{
-					for (int i = 0 ; i < number_of_components ; i++)
-					{
-						valueCache.values[i] =  texture_values[i] * maximum;
-					}
-				}
+				chunk_texture_coordinates[p*3 + i] = (i < number_of_texture_coordinates) ?
+					source_coordinates[p*number_of_texture_coordinates + i] : 0.0;
 			}
-			else
+		}
+		if (!Texture_get_pixel_values_batch(texture, chunk_count,
+			chunk_texture_coordinates, chunk_texture_values))
+		{
+			return 0;
+		}
+		double *chunk_values = values + start*number_of_components;
+		for (int p = 0; p < chunk_count; ++p)
+		{
+			for (int i = 0; i < number_of_components; i++)
 			{
-				for (int i = 0 ; i < number_of_components ; i++)
-				{
-					valueCache.values[i] =  minimum +
-						texture_values[i] * (maximum - minimum);
-				}
+				chunk_values[p*number_of_components + i] = minimum +
+					chunk_texture_values[p*number_of_texture_components + i]*range;
 			}
-			valueCache.derivatives_valid = 0;
-			return 1;
 		}
 	}
-	else
+	return 1;
+}
+
+int Computed_field_image::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
+{
+	RealFieldValueCache *sourceCache = RealFieldValueCache::cast(getSourceField(0)->evaluate(cache));
+	if (sourceCache)
 	{
-		display_message(ERROR_MESSAGE,
-			"Computed_field_image::evaluate.  No texture");
+		RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
+		if (evaluate_texture_coordinates(1, sourceCache->values, valueCache.values))
+		{
+			valueCache.derivatives_valid = 0;
+			return 1;
+		}
 	}
 	return 0;
 }
@@ -1836,6 +1856,20 @@ char *cmzn_field_image_get_property(cmzn_field_image_id image,
 	return Texture_get_property(texture, property);
 }
 
+int cmzn_field_image_evaluate_batch(cmzn_field_image_id image_field,
+	int points_count, const double *texture_coordinates_in, double *values_out)
+{
+	if ((image_field) && (0 <= points_count) &&
+		((0 == points_count) || ((texture_coordinates_in) && (values_out))))
+	{
+		Computed_field_image *image_core = Computed_field_image_core_cast(image_field);
+		if (image_core->evaluate_texture_coordinates(points_count, texture_coordinates_in, values_out))
+			return CMZN_OK;
+		return CMZN_ERROR_GENERAL;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 class cmzn_field_image_filter_mode_conversion
 {
 public:
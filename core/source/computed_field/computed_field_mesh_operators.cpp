@@ -28,6 +28,92 @@ namespace {
 
 const char computed_field_mesh_integral_type_string[] = "mesh_integral";
 
+// levels 1-4 use that many Gauss points per axis; higher levels use 4 points
+// in 2, 4 and 8 subdivisions per axis
+const int ADAPTIVE_QUADRATURE_MAXIMUM_LEVEL = 7;
+// simplex and wedge rules are not subdivided so have no distinct higher levels
+const int ADAPTIVE_QUADRATURE_MAXIMUM_UNSUBDIVIDED_LEVEL = 4;
+
+/**
+ * Cache of dL (1-D), dA (2-D) or dV (3-D) at all quadrature points of each
+ * element, in flat arrays indexed by element. Valid for a fixed mesh,
+ * coordinate field, quadrature rule, numbers of points and time.
+ */
+class MeshIntegralGeometryCache
+{
+	// offset of first dLAV for element index in dLAVs, or -1 if not cached
+	std::vector<int> elementOffsets;
+	std::vector<FE_value> dLAVs;
+	// offset of element being recorded, or -1 if not recording
+	int recordOffset;
+	FE_value time;
+
+public:
+	MeshIntegralGeometryCache() :
+		recordOffset(-1),
+		time(0.0)
+	{
+	}
+
+	void clear()
+	{
+		this->elementOffsets.clear();
+		this->dLAVs.clear();
+		this->recordOffset = -1;
+	}
+
+	/** Clears cache if for a different time */
+	void setTime(FE_value timeIn)
+	{
+		if (timeIn != this->time)
+		{
+			this->clear();
+			this->time = timeIn;
+		}
+	}
+
+	/** @return  Cached dLAVs for element index, or 0 if none */
+	const FE_value *getElementDLAVs(DsLabelIndex elementIndex) const
+	{
+		if ((0 <= elementIndex) && (elementIndex < static_cast<DsLabelIndex>(this->elementOffsets.size())))
+		{
+			const int offset = this->elementOffsets[elementIndex];
+			if (0 <= offset)
+				return &(this->dLAVs[offset]);
+		}
+		return 0;
+	}
+
+	void beginElement()
+	{
+		this->recordOffset = static_cast<int>(this->dLAVs.size());
+	}
+
+	void addDLAV(FE_value dLAV)
+	{
+		this->dLAVs.push_back(dLAV);
+	}
+
+	/**
+	 * Finish recording element. Discards dLAVs recorded for it if not
+	 * successful or no points recorded.
+	 */
+	void endElement(DsLabelIndex elementIndex, bool success)
+	{
+		if (this->recordOffset < 0)
+			return;
+		if (success && (0 <= elementIndex) && (this->recordOffset < static_cast<int>(this->dLAVs.size())))
+		{
+			if (static_cast<DsLabelIndex>(this->elementOffsets.size()) <= elementIndex)
+				this->elementOffsets.resize(elementIndex + 1, -1);
+			this->elementOffsets[elementIndex] = this->recordOffset;
+		}
+		else
+			this->dLAVs.resize(this->recordOffset);
+		this->recordOffset = -1;
+	}
+};
+
 // assumes there are two source fields: 1. integrand and 2. coordinate
 class Computed_field_mesh_integral : public Computed_field_core
 {
@@ -35,12 +121,22 @@ protected:
 	cmzn_mesh_id mesh;
 	cmzn_element_quadrature_rule quadratureRule;
 	std::vector<int> numbersOfPoints;
+	double relativeTolerance;
+	// adaptive quadrature level last converged at for each element index, or 0
+	std::vector<unsigned char> elementLevels;
+	// set once warned that adaptive quadrature did not converge, until settings change
+	bool nonConvergenceReported;
+	bool geometryCached;
+	MeshIntegralGeometryCache geometryCache;
 
 public:
 	Computed_field_mesh_integral(cmzn_mesh_id meshIn) :
 		Computed_field_core(),
 		mesh(cmzn_mesh_access(meshIn)),
-		quadratureRule(CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN)
+		quadratureRule(CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN),
+		relativeTolerance(1.0E-6),
+		nonConvergenceReported(false),
+		geometryCached(false)
 	{
 		numbersOfPoints.push_back(1);
 	}
@@ -120,8 +216,14 @@ public:
 					change = true;
 				}
 			}
-			if (change && this->field)
-				Computed_field_changed(this->field);
+			if (change)
+			{
+				this->elementLevels.clear();
+				this->nonConvergenceReported = false;
+				this->geometryCache.clear();
+				if (this->field)
+					Computed_field_changed(this->field);
+			}
 			return CMZN_OK;
 		}
 		return CMZN_ERROR_ARGUMENT;
@@ -135,11 +237,15 @@ public:
 	int setElementQuadratureRule(cmzn_element_quadrature_rule quadratureRuleIn)
 	{
 		if ((quadratureRuleIn == CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN) ||
-			(quadratureRuleIn == CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT))
+			(quadratureRuleIn == CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT) ||
+			(quadratureRuleIn == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE))
 		{
 			if (this->quadratureRule != quadratureRuleIn)
 			{
 				this->quadratureRule = quadratureRuleIn;
+				this->elementLevels.clear();
+				this->nonConvergenceReported = false;
+				this->geometryCache.clear();
 				Computed_field_changed(this->field);
 			}
 			return CMZN_OK;
@@ -147,9 +253,64 @@ public:
 		return CMZN_ERROR_ARGUMENT;
 	}
 
+	double getRelativeTolerance() const
+	{
+		return this->relativeTolerance;
+	}
+
+	int setRelativeTolerance(double relativeToleranceIn)
+	{
+		if (relativeToleranceIn > 0.0)
+		{
+			if (this->relativeTolerance != relativeToleranceIn)
+			{
+				this->relativeTolerance = relativeToleranceIn;
+				this->elementLevels.clear();
+				this->nonConvergenceReported = false;
+				if (this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE)
+					Computed_field_changed(this->field);
+			}
+			return CMZN_OK;
+		}
+		return CMZN_ERROR_ARGUMENT;
+	}
+
+	bool isGeometryCached() const
+	{
+		return this->geometryCached;
+	}
+
+	int setGeometryCached(bool geometryCachedIn)
+	{
+		if (geometryCachedIn != this->geometryCached)
+		{
+			this->geometryCached = geometryCachedIn;
+			this->geometryCache.clear();
+		}
+		return CMZN_OK;
+	}
+
+	/**
+	 * Get the geometry cache for evaluating at time, if enabled and usable.
+	 * Not usable with adaptive quadrature, or between begin/end change as
+	 * coordinate changes are not yet known.
+	 * @return  Geometry cache or 0 if not in use.
+	 */
+	MeshIntegralGeometryCache *getGeometryCache(FE_value time)
+	{
+		if ((!this->geometryCached) ||
+			(this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE) ||
+			Computed_field_manager_is_caching_changes(this->field->manager) ||
+			FE_region_is_caching_changes(cmzn_mesh_get_FE_region_internal(this->mesh)))
+			return 0;
+		this->geometryCache.setTime(time);
+		return &this->geometryCache;
+	}
+
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
 	// if the mesh is a mesh group, also need to propagate changes from it
+	// clears geometry cache if mesh or coordinate field changes
 	virtual int check_dependency()
 	{
 		int return_code = Computed_field_core::check_dependency();
@@ -163,11 +324,25 @@ public:
 				return_code = this->field->manager_change_status;
 			}
 		}
+		if (return_code & MANAGER_CHANGE_RESULT(Computed_field))
+		{
+			cmzn_field_element_group *elementGroupField = cmzn_mesh_get_element_group_field_internal(this->mesh);
+			if ((getSourceField(1)->core->check_dependency() & MANAGER_CHANGE_RESULT(Computed_field)) ||
+				(elementGroupField && (MANAGER_CHANGE_NONE(Computed_field) !=
+					cmzn_field_element_group_base_cast(elementGroupField)->manager_change_status)))
+				this->geometryCache.clear();
+		}
 		return return_code;
 	}
 
 protected:
 	template <class ProcessTerm> int evaluateTerms(ProcessTerm &processTerm);
+
+	template <class ProcessTerm> bool integrateElementLevel(ProcessTerm &processTerm,
+		IntegrationPointsCache **levelCaches, cmzn_element *element, int level,
+		FE_value *levelValues, FE_value *levelAbsValues);
+
+	template <class ProcessTerm> int evaluateTermsAdaptive(ProcessTerm &processTerm, FE_value *values);
 };
 
 template <class ProcessTerm> int Computed_field_mesh_integral::evaluateTerms(ProcessTerm &processTerm)
@@ -186,8 +361,134 @@ template <class ProcessTerm> int Computed_field_mesh_integral::evaluateTerms(Pro
 		}
 		processTerm.setElement(element);
 		shapePoints->forEachPoint(processTerm);
+		processTerm.endElement();
+	}
+	cmzn_elementiterator_destroy(&iterator);
+	return result;
+}
+
+/**
+ * Integrate processTerm over element with Gaussian quadrature for level,
+ * putting integral and integral of absolute values of terms in the supplied
+ * arrays. Creates points cache for level on first use.
+ */
+template <class ProcessTerm> bool Computed_field_mesh_integral::integrateElementLevel(
+	ProcessTerm &processTerm, IntegrationPointsCache **levelCaches, cmzn_element *element,
+	int level, FE_value *levelValues, FE_value *levelAbsValues)
+{
+	IntegrationPointsCache *&levelCache = levelCaches[level - 1];
+	if (!levelCache)
+	{
+		const int numberOfPoints = (level < 4) ? level : 4;
+		const int subdivisions = (level <= 4) ? 1 : (1 << (level - 4));
+		levelCache = new IntegrationPointsCache(CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN,
+			1, &numberOfPoints, subdivisions);
+	}
+	IntegrationShapePoints *shapePoints = levelCache->getPoints(element);
+	if (!shapePoints)
+		return false;
+	processTerm.setValues(levelValues, levelAbsValues);
+	shapePoints->forEachPoint(processTerm);
+	return true;
+}
+
+/**
+ * Integrate each element at increasing quadrature levels until the change
+ * from the previous level is within the relative tolerance of the integral
+ * of absolute values, or the maximum level for the element shape is reached.
+ * Starts from the level last converged at for the element, else from the
+ * numbers of points. Warns once if any element did not converge.
+ * @param values  Array to add integral to; must be initialised.
+ */
+template <class ProcessTerm> int Computed_field_mesh_integral::evaluateTermsAdaptive(
+	ProcessTerm &processTerm, FE_value *values)
+{
+	const int componentsCount = this->field->number_of_components;
+	std::vector<FE_value> work(4*componentsCount);
+	FE_value *coarseValues = &(work[0]);
+	FE_value *coarseAbsValues = coarseValues + componentsCount;
+	FE_value *fineValues = coarseAbsValues + componentsCount;
+	FE_value *fineAbsValues = fineValues + componentsCount;
+	IntegrationPointsCache *levelCaches[ADAPTIVE_QUADRATURE_MAXIMUM_LEVEL];
+	for (int i = 0; i < ADAPTIVE_QUADRATURE_MAXIMUM_LEVEL; ++i)
+		levelCaches[i] = 0;
+	int initialLevel = 2;
+	for (size_t i = 0; i < this->numbersOfPoints.size(); ++i)
+		if (this->numbersOfPoints[i] > initialLevel)
+			initialLevel = (this->numbersOfPoints[i] < 4) ? this->numbersOfPoints[i] : 4;
+	const DsLabelIndex levelsSize = static_cast<DsLabelIndex>(this->elementLevels.size());
+	int nonConvergedCount = 0;
+	int result = 1;
+	cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(mesh);
+	cmzn_element_id element = 0;
+	while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
+	{
+		const DsLabelIndex elementIndex = get_FE_element_index(element);
+		const cmzn_element_shape_type shapeType = cmzn_element_get_shape_type(element);
+		const int maximumLevel = ((shapeType == CMZN_ELEMENT_SHAPE_TYPE_LINE) ||
+			(shapeType == CMZN_ELEMENT_SHAPE_TYPE_SQUARE) || (shapeType == CMZN_ELEMENT_SHAPE_TYPE_CUBE)) ?
+			ADAPTIVE_QUADRATURE_MAXIMUM_LEVEL : ADAPTIVE_QUADRATURE_MAXIMUM_UNSUBDIVIDED_LEVEL;
+		int level = initialLevel;
+		if ((0 <= elementIndex) && (elementIndex < levelsSize) && (0 != this->elementLevels[elementIndex]))
+			level = this->elementLevels[elementIndex];
+		if (level > maximumLevel)
+			level = maximumLevel;
+		processTerm.setElement(element);
+		if (!this->integrateElementLevel(processTerm, levelCaches, element, level - 1, coarseValues, coarseAbsValues))
+		{
+			result = 0;
+			break;
+		}
+		while (true)
+		{
+			if (!this->integrateElementLevel(processTerm, levelCaches, element, level, fineValues, fineAbsValues))
+			{
+				result = 0;
+				break;
+			}
+			bool converged = true;
+			for (int i = 0; i < componentsCount; ++i)
+				if (fabs(fineValues[i] - coarseValues[i]) > this->relativeTolerance*fineAbsValues[i])
+				{
+					converged = false;
+					break;
+				}
+			if (converged)
+				break;
+			if (level == maximumLevel)
+			{
+				++nonConvergedCount;
+				break;
+			}
+			FE_value *tmp = coarseValues;
+			coarseValues = fineValues;
+			fineValues = tmp;
+			tmp = coarseAbsValues;
+			coarseAbsValues = fineAbsValues;
+			fineAbsValues = tmp;
+			++level;
+		}
+		if (!result)
+			break;
+		for (int i = 0; i < componentsCount; ++i)
+			values[i] += fineValues[i];
+		if (0 <= elementIndex)
+		{
+			if (static_cast<DsLabelIndex>(this->elementLevels.size()) <= elementIndex)
+				this->elementLevels.resize(elementIndex + 1, 0);
+			this->elementLevels[elementIndex] = static_cast<unsigned char>(level);
+		}
 	}
 	cmzn_elementiterator_destroy(&iterator);
+	for (int i = 0; i < ADAPTIVE_QUADRATURE_MAXIMUM_LEVEL; ++i)
+		delete levelCaches[i];
+	if (result && (0 < nonConvergedCount) && (!this->nonConvergenceReported))
+	{
+		display_message(WARNING_MESSAGE, "Field %s evaluate.  Adaptive quadrature did not converge "
+			"to relative tolerance %g in %d element(s); highest available rule used.",
+			this->field->name, this->relativeTolerance, nonConvergedCount);
+		this->nonConvergenceReported = true;
+	}
 	return result;
 }
 
@@ -202,6 +503,10 @@ protected:
 	cmzn_field *coordinateField;
 	const int coordinatesCount;
 	cmzn_element *element;
+	MeshIntegralGeometryCache *geometryCache; // optional
+	DsLabelIndex elementIndex;
+	const FE_value *elementDLAVs; // next cached dLAV in element, or 0 if not cached
+	bool elementSuccess;
 
 public:
 	IntegralTermBase(Computed_field_mesh_integral& meshIntegralIn, cmzn_fieldcache& parentCache, RealFieldValueCache& valueCache) :
@@ -212,7 +517,11 @@ public:
 		integrandField(meshIntegral.getSourceField(0)),
 		coordinateField(meshIntegral.getSourceField(1)),
 		coordinatesCount(coordinateField->number_of_components),
-		element(0)
+		element(0),
+		geometryCache(meshIntegralIn.getGeometryCache(parentCache.getTime())),
+		elementIndex(DS_LABEL_INDEX_INVALID),
+		elementDLAVs(0),
+		elementSuccess(true)
 	{
 		cache.setTime(parentCache.getTime());
 	}
@@ -220,6 +529,21 @@ public:
 	void setElement(cmzn_element *elementIn)
 	{
 		element = elementIn;
+		this->elementSuccess = true;
+		if (this->geometryCache)
+		{
+			this->elementIndex = get_FE_element_index(elementIn);
+			this->elementDLAVs = this->geometryCache->getElementDLAVs(this->elementIndex);
+			if (!this->elementDLAVs)
+				this->geometryCache->beginElement();
+		}
+	}
+
+	/** Call after processing all points in element to record geometry if caching */
+	void endElement()
+	{
+		if ((this->geometryCache) && (!this->elementDLAVs))
+			this->geometryCache->endElement(this->elementIndex, this->elementSuccess);
 	}
 
 	/** @return pointer to integrand values */
@@ -227,6 +551,16 @@ public:
 	{
 		this->cache.setMeshLocation(this->element, xi);
 		RealFieldValueCache *integrandValueCache = RealFieldValueCache::cast(integrandField->evaluate(cache));
+		if (this->elementDLAVs)
+		{
+			if (integrandValueCache)
+			{
+				dLAV = *(this->elementDLAVs);
+				++(this->elementDLAVs);
+				return integrandValueCache->values;
+			}
+			return 0;
+		}
 		RealFieldValueCache *coordinateValueCache = coordinateField->evaluateWithDerivatives(cache, dimension);
 		if (integrandValueCache && coordinateValueCache)
 		{
@@ -260,9 +594,12 @@ public:
 					dx_dxi[6]*(dx_dxi[1]*dx_dxi[5] - dx_dxi[4]*dx_dxi[2]));
 				break;
 			}
+			if (this->geometryCache)
+				this->geometryCache->addDLAV(dLAV);
 			return integrandValueCache->values;
 		}
 		// abandon elements where integrand or coordinates not defined
+		this->elementSuccess = false;
 		return 0;
 	}
 };
@@ -270,18 +607,32 @@ public:
 class IntegralTermSum : public IntegralTermBase
 {
 	FE_value *values;
+	FE_value *absValues; // optional sum of absolute values of terms
 
 public:
 	IntegralTermSum(Computed_field_mesh_integral& meshIntegralIn,
 			cmzn_fieldcache& parentCache, RealFieldValueCache& valueCache) :
 		IntegralTermBase(meshIntegralIn, parentCache, valueCache),
-		values(valueCache.values)
+		values(valueCache.values),
+		absValues(0)
 	{
 		for (int i = 0; i < componentsCount; i++)
 			values[i] = 0;
 		valueCache.derivatives_valid = 0;
 	}
 
+	/** Redirect sums to zeroed valuesIn and optional absValuesIn. */
+	void setValues(FE_value *valuesIn, FE_value *absValuesIn)
+	{
+		this->values = valuesIn;
+		this->absValues = absValuesIn;
+		for (int i = 0; i < this->componentsCount; ++i)
+			this->values[i] = 0.0;
+		if (this->absValues)
+			for (int i = 0; i < this->componentsCount; ++i)
+				this->absValues[i] = 0.0;
+	}
+
 	inline bool operator()(FE_value *xi, FE_value weight)
 	{
 		FE_value dLAV;
@@ -291,6 +642,9 @@ public:
 			const FE_value weight_dLAV = weight*dLAV;
 			for (int i = 0; i < this->componentsCount; ++i)
 				this->values[i] += integrandValues[i]*weight_dLAV;
+			if (this->absValues)
+				for (int i = 0; i < this->componentsCount; ++i)
+					this->absValues[i] += fabs(integrandValues[i]*weight_dLAV);
 			return true;
 		}
 		return false;
@@ -304,7 +658,10 @@ public:
 
 int Computed_field_mesh_integral::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
-	IntegralTermSum sumTerms(*this, cache, RealFieldValueCache::cast(inValueCache));
+	RealFieldValueCache& valueCache = RealFieldValueCache::cast(inValueCache);
+	IntegralTermSum sumTerms(*this, cache, valueCache);
+	if (this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE)
+		return this->evaluateTermsAdaptive(sumTerms, valueCache.values);
 	return this->evaluateTerms(sumTerms);
 }
 
@@ -347,6 +704,8 @@ int Computed_field_mesh_integral::list()
 		this->appendNumbersOfPointsString(&numbersOfPointsString, &error);
 		display_message(INFORMATION_MESSAGE, "    numbers of points: %s\n", numbersOfPointsString);
 		DEALLOCATE(numbersOfPointsString);
+		if (this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE)
+			display_message(INFORMATION_MESSAGE, "    relative tolerance: %g\n", this->relativeTolerance);
 		return 1;
 	}
 	return 0;
@@ -375,6 +734,12 @@ char *Computed_field_mesh_integral::get_command_string()
 		append_string(&command_string, " numbers_of_points \"", &error);
 		this->appendNumbersOfPointsString(&command_string, &error);
 		append_string(&command_string, "\"", &error);
+		if (this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE)
+		{
+			char temp[40];
+			sprintf(temp, " relative_tolerance %g", this->relativeTolerance);
+			append_string(&command_string, temp, &error);
+		}
 	}
 	return (command_string);
 }
@@ -513,18 +878,32 @@ int Computed_field_mesh_integral_squares::evaluate_sum_square_terms(
 class IntegralTermSumSquares : public IntegralTermBase
 {
 	FE_value *values;
+	FE_value *absValues; // optional sum of absolute values of terms
 
 public:
 	IntegralTermSumSquares(Computed_field_mesh_integral& meshIntegralIn,
 			cmzn_fieldcache& parentCache, RealFieldValueCache& valueCache) :
 		IntegralTermBase(meshIntegralIn, parentCache, valueCache),
-		values(valueCache.values)
+		values(valueCache.values),
+		absValues(0)
 	{
 		for (int i = 0; i < componentsCount; i++)
 			values[i] = 0;
 		valueCache.derivatives_valid = 0;
 	}
 
+	/** Redirect sums to zeroed valuesIn and optional absValuesIn. */
+	void setValues(FE_value *valuesIn, FE_value *absValuesIn)
+	{
+		this->values = valuesIn;
+		this->absValues = absValuesIn;
+		for (int i = 0; i < this->componentsCount; ++i)
+			this->values[i] = 0.0;
+		if (this->absValues)
+			for (int i = 0; i < this->componentsCount; ++i)
+				this->absValues[i] = 0.0;
+	}
+
 	inline bool operator()(FE_value *xi, FE_value weight)
 	{
 		FE_value dLAV;
@@ -534,6 +913,9 @@ public:
 			const FE_value weight_dLAV = weight*dLAV;
 			for (int i = 0; i < this->componentsCount; ++i)
 				this->values[i] += (integrandValues[i]*integrandValues[i])*weight_dLAV;
+			if (this->absValues)
+				for (int i = 0; i < this->componentsCount; ++i)
+					this->absValues[i] += fabs((integrandValues[i]*integrandValues[i])*weight_dLAV);
 			return true;
 		}
 		return false;
@@ -547,7 +929,10 @@ public:
 
 int Computed_field_mesh_integral_squares::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
-	IntegralTermSumSquares sumSquares(*this, cache, RealFieldValueCache::cast(inValueCache));
+	RealFieldValueCache& valueCache = RealFieldValueCache::cast(inValueCache);
+	IntegralTermSumSquares sumSquares(*this, cache, valueCache);
+	if (this->quadratureRule == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE)
+		return this->evaluateTermsAdaptive(sumSquares, valueCache.values);
 	return this->evaluateTerms(sumSquares);
 }
 
@@ -647,6 +1032,50 @@ int cmzn_field_mesh_integral_set_element_quadrature_rule(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+double cmzn_field_mesh_integral_get_relative_tolerance(
+	cmzn_field_mesh_integral_id mesh_integral_field)
+{
+	if (mesh_integral_field)
+	{
+		Computed_field_mesh_integral *mesh_integral_core = Computed_field_mesh_integral_core_cast(mesh_integral_field);
+		return mesh_integral_core->getRelativeTolerance();
+	}
+	return 0.0;
+}
+
+int cmzn_field_mesh_integral_set_relative_tolerance(
+	cmzn_field_mesh_integral_id mesh_integral_field, double relative_tolerance)
+{
+	if (mesh_integral_field)
+	{
+		Computed_field_mesh_integral *mesh_integral_core = Computed_field_mesh_integral_core_cast(mesh_integral_field);
+		return mesh_integral_core->setRelativeTolerance(relative_tolerance);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_field_mesh_integral_is_geometry_cached(
+	cmzn_field_mesh_integral_id mesh_integral_field)
+{
+	if (mesh_integral_field)
+	{
+		Computed_field_mesh_integral *mesh_integral_core = Computed_field_mesh_integral_core_cast(mesh_integral_field);
+		return mesh_integral_core->isGeometryCached();
+	}
+	return false;
+}
+
+int cmzn_field_mesh_integral_set_geometry_cached(
+	cmzn_field_mesh_integral_id mesh_integral_field, bool geometry_cached)
+{
+	if (mesh_integral_field)
+	{
+		Computed_field_mesh_integral *mesh_integral_core = Computed_field_mesh_integral_core_cast(mesh_integral_field);
+		return mesh_integral_core->setGeometryCached(geometry_cached);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_field_id cmzn_fieldmodule_create_field_mesh_integral_squares(
 	cmzn_fieldmodule_id field_module, cmzn_field_id integrand_field,
 	cmzn_field_id coordinate_field, cmzn_mesh_id mesh)
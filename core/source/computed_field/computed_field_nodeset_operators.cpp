@@ -10,6 +10,9 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <set>
+#include <vector>
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/computed_field_nodeset_operators.hpp"
 #include "computed_field/field_module.hpp"
@@ -21,6 +24,8 @@
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/message.h"
+#include "finite_element/finite_element_mesh.hpp"
+#include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
 using namespace std;
 
@@ -32,15 +37,155 @@ namespace {
 
 const char computed_field_nodeset_operator_type_string[] = "nodeset_operator";
 
+/**
+ * Aggregates of source field values over a set of nodes: number of nodes,
+ * number of nodes the source field is defined at, and per-component sum, sum
+ * of squares, minimum and maximum. Used for whole nodesets and blocks of them.
+ */
+class NodesetOperatorAggregate
+{
+	int nodeCount;
+	int termCount;
+	// sums, sums of squares, minimums then maximums, each componentsCount long
+	std::vector<FE_value> values;
+
+public:
+	NodesetOperatorAggregate() :
+		nodeCount(0),
+		termCount(0)
+	{
+	}
+
+	void reset(int componentsCount)
+	{
+		this->nodeCount = 0;
+		this->termCount = 0;
+		this->values.assign(4*componentsCount, 0.0);
+	}
+
+	int getNodeCount() const
+	{
+		return this->nodeCount;
+	}
+
+	int getTermCount() const
+	{
+		return this->termCount;
+	}
+
+	const FE_value *getSums() const
+	{
+		return &(this->values[0]);
+	}
+
+	const FE_value *getSumSquares(int componentsCount) const
+	{
+		return &(this->values[componentsCount]);
+	}
+
+	const FE_value *getMinimums(int componentsCount) const
+	{
+		return &(this->values[2*componentsCount]);
+	}
+
+	const FE_value *getMaximums(int componentsCount) const
+	{
+		return &(this->values[3*componentsCount]);
+	}
+
+	/** Record a node in the set at which the source field may not be defined */
+	void addNode()
+	{
+		++(this->nodeCount);
+	}
+
+	/** Add values of the source field at a node */
+	void addTerm(int componentsCount, const FE_value *termValues)
+	{
+		FE_value *sums = &(this->values[0]);
+		FE_value *sumSquares = sums + componentsCount;
+		FE_value *minimums = sumSquares + componentsCount;
+		FE_value *maximums = minimums + componentsCount;
+		for (int i = 0; i < componentsCount; ++i)
+		{
+			const FE_value value = termValues[i];
+			sums[i] += value;
+			sumSquares[i] += value*value;
+			if ((0 == this->termCount) || (value < minimums[i]))
+				minimums[i] = value;
+			if ((0 == this->termCount) || (value > maximums[i]))
+				maximums[i] = value;
+		}
+		++(this->termCount);
+	}
+
+	/** Combine aggregates from a disjoint set of nodes into this */
+	void merge(int componentsCount, const NodesetOperatorAggregate& source)
+	{
+		this->nodeCount += source.nodeCount;
+		if (0 == source.termCount)
+			return;
+		FE_value *sums = &(this->values[0]);
+		FE_value *sumSquares = sums + componentsCount;
+		FE_value *minimums = sumSquares + componentsCount;
+		FE_value *maximums = minimums + componentsCount;
+		const FE_value *sourceSums = &(source.values[0]);
+		const FE_value *sourceSumSquares = sourceSums + componentsCount;
+		const FE_value *sourceMinimums = sourceSumSquares + componentsCount;
+		const FE_value *sourceMaximums = sourceMinimums + componentsCount;
+		for (int i = 0; i < componentsCount; ++i)
+		{
+			sums[i] += sourceSums[i];
+			sumSquares[i] += sourceSumSquares[i];
+			if ((0 == this->termCount) || (sourceMinimums[i] < minimums[i]))
+				minimums[i] = sourceMinimums[i];
+			if ((0 == this->termCount) || (sourceMaximums[i] > maximums[i]))
+				maximums[i] = sourceMaximums[i];
+		}
+		this->termCount += source.termCount;
+	}
+
+};
+
 class Computed_field_nodeset_operator : public Computed_field_core
 {
 protected:
 	cmzn_nodeset_id nodeset;
 
+private:
+	typedef std::map<int, NodesetOperatorAggregate> BlockMap;
+
+	// nodes are aggregated in blocks of consecutive identifiers so only blocks
+	// containing changed nodes need to be re-evaluated
+	static const int blockShift = 8;
+	// map from identifier >> blockShift to aggregate for block; no empty blocks
+	BlockMap blocks;
+	// keys of blocks with changed nodes, to re-evaluate on next evaluate
+	std::set<int> changedBlocks;
+	// false if blocks need complete re-evaluation
+	bool blocksValid;
+	// time blocks were evaluated at
+	FE_value blocksTime;
+
+	void invalidateBlocks()
+	{
+		this->blocks.clear();
+		this->changedBlocks.clear();
+		this->blocksValid = false;
+	}
+
+	static int FE_node_add_changed_block(struct FE_node *node, int change, void *operator_void);
+
+	void nodesetPartialChange();
+
+	void evaluateBlock(cmzn_fieldcache& extraCache, int blockKey, NodesetOperatorAggregate& aggregate);
+
 public:
 	Computed_field_nodeset_operator(cmzn_nodeset_id nodeset_in) :
 		Computed_field_core(),
-		nodeset(cmzn_nodeset_access(nodeset_in))
+		nodeset(cmzn_nodeset_access(nodeset_in)),
+		blocksValid(false),
+		blocksTime(0.0)
 	{
 	}
 
@@ -81,6 +226,7 @@ public:
 	char* get_command_string();
 
 	// if the nodeset is a nodeset group, also need to propagate changes from it
+	// also invalidates aggregates for blocks of nodes which have changed
 	virtual int check_dependency()
 	{
 		int return_code = Computed_field_core::check_dependency();
@@ -94,10 +240,165 @@ public:
 				return_code = this->field->manager_change_status;
 			}
 		}
+		if (return_code & (MANAGER_CHANGE_DEFINITION(Computed_field) | MANAGER_CHANGE_FULL_RESULT(Computed_field)))
+			this->invalidateBlocks();
+		else if (return_code & MANAGER_CHANGE_PARTIAL_RESULT(Computed_field))
+			this->nodesetPartialChange();
 		return return_code;
 	}
+
+	/**
+	 * Get aggregates of source field over all nodes in nodeset. Outside of
+	 * begin/end change, only blocks of nodes changed since the last evaluation
+	 * are re-evaluated.
+	 */
+	void evaluateAggregate(cmzn_fieldcache& cache, FieldValueCache& inValueCache,
+		NodesetOperatorAggregate& aggregate);
 };
 
+int Computed_field_nodeset_operator::FE_node_add_changed_block(struct FE_node *node,
+	int change, void *operator_void)
+{
+	USE_PARAMETER(change);
+	Computed_field_nodeset_operator *nodesetOperator =
+		static_cast<Computed_field_nodeset_operator *>(operator_void);
+	const int identifier = get_FE_node_identifier(node);
+	if (identifier < 0)
+		return 0;
+	nodesetOperator->changedBlocks.insert(identifier >> blockShift);
+	return 1;
+}
+
+/**
+ * Called when the source field has a partial change. Records blocks containing
+ * nodes in the node change log as needing re-evaluation. Falls back to full
+ * re-evaluation for all-change, identifier changes or mesh changes which may
+ * affect values at nodes not in the change log.
+ */
+void Computed_field_nodeset_operator::nodesetPartialChange()
+{
+	if (!this->blocksValid)
+		return;
+	FE_nodeset *fe_nodeset = cmzn_nodeset_get_FE_nodeset_internal(this->nodeset);
+	FE_region *fe_region = fe_nodeset->get_FE_region();
+	CHANGE_LOG(FE_node) *nodeChanges = fe_nodeset->getChangeLog();
+	int nodeChangeSummary = 0;
+	bool allChange = (!fe_region) || CHANGE_LOG_IS_ALL_CHANGE(FE_node)(nodeChanges) ||
+		(!CHANGE_LOG_GET_CHANGE_SUMMARY(FE_node)(nodeChanges, &nodeChangeSummary)) ||
+		(nodeChangeSummary & CHANGE_LOG_OBJECT_IDENTIFIER_CHANGED(FE_node));
+	if (!allChange)
+	{
+		const cmzn_field_domain_type otherDomainType =
+			(fe_nodeset->getFieldDomainType() == CMZN_FIELD_DOMAIN_TYPE_DATAPOINTS) ?
+			CMZN_FIELD_DOMAIN_TYPE_NODES : CMZN_FIELD_DOMAIN_TYPE_DATAPOINTS;
+		FE_nodeset *otherNodeset = FE_region_find_FE_nodeset_by_field_domain_type(fe_region, otherDomainType);
+		int otherChangeSummary = 0;
+		if (otherNodeset)
+			CHANGE_LOG_GET_CHANGE_SUMMARY(FE_node)(otherNodeset->getChangeLog(), &otherChangeSummary);
+		allChange = (0 != otherChangeSummary);
+		for (int dimension = 1; (!allChange) && (dimension <= MAXIMUM_ELEMENT_XI_DIMENSIONS); ++dimension)
+		{
+			FE_mesh *fe_mesh = FE_region_find_FE_mesh_by_dimension(fe_region, dimension);
+			allChange = (fe_mesh) && (0 != fe_mesh->getChangeLog()->getChangeSummary());
+		}
+	}
+	if (allChange || (!CHANGE_LOG_FOR_EACH_OBJECT(FE_node)(nodeChanges,
+		Computed_field_nodeset_operator::FE_node_add_changed_block, (void *)this)))
+	{
+		this->invalidateBlocks();
+	}
+}
+
+/** Evaluates aggregate over nodes in nodeset in block with blockKey. */
+void Computed_field_nodeset_operator::evaluateBlock(cmzn_fieldcache& extraCache,
+	int blockKey, NodesetOperatorAggregate& aggregate)
+{
+	const int number_of_components = field->number_of_components;
+	aggregate.reset(number_of_components);
+	FE_nodeset *fe_nodeset = cmzn_nodeset_get_FE_nodeset_internal(this->nodeset);
+	const bool isGroup = (0 != cmzn_nodeset_get_node_group_field_internal(this->nodeset));
+	cmzn_field_id sourceField = getSourceField(0);
+	const int firstIdentifier = blockKey << blockShift;
+	const int limitIdentifier = firstIdentifier + (1 << blockShift);
+	for (int identifier = firstIdentifier; identifier < limitIdentifier; ++identifier)
+	{
+		FE_node *node = fe_nodeset->findNodeByIdentifier(identifier);
+		if (node && ((!isGroup) || cmzn_nodeset_contains_node(this->nodeset, node)))
+		{
+			aggregate.addNode();
+			extraCache.setNode(node);
+			RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
+			if (sourceValueCache)
+				aggregate.addTerm(number_of_components, sourceValueCache->values);
+		}
+	}
+}
+
+void Computed_field_nodeset_operator::evaluateAggregate(cmzn_fieldcache& cache,
+	FieldValueCache& inValueCache, NodesetOperatorAggregate& aggregate)
+{
+	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
+	const FE_value time = cache.getTime();
+	extraCache.setTime(time);
+	const int number_of_components = field->number_of_components;
+	aggregate.reset(number_of_components);
+	cmzn_field_id sourceField = getSourceField(0);
+	// can't trust or update blocks between begin/end change as change logs and
+	// field dependencies are not yet up to date
+	const bool cachingChanges = Computed_field_manager_is_caching_changes(field->manager) ||
+		FE_region_is_caching_changes(cmzn_nodeset_get_FE_nodeset_internal(this->nodeset)->get_FE_region());
+	if (cachingChanges || (!this->blocksValid) || (time != this->blocksTime))
+	{
+		if (!cachingChanges)
+		{
+			this->invalidateBlocks();
+		}
+		cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
+		cmzn_node_id node = 0;
+		NodesetOperatorAggregate *block = &aggregate;
+		int blockKey = 0;
+		while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+		{
+			if (!cachingChanges)
+			{
+				const int nodeBlockKey = get_FE_node_identifier(node) >> blockShift;
+				if ((block == &aggregate) || (nodeBlockKey != blockKey))
+				{
+					blockKey = nodeBlockKey;
+					std::pair<BlockMap::iterator, bool> result =
+						this->blocks.insert(BlockMap::value_type(blockKey, NodesetOperatorAggregate()));
+					block = &(result.first->second);
+					if (result.second)
+						block->reset(number_of_components);
+				}
+			}
+			block->addNode();
+			extraCache.setNode(node);
+			RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
+			if (sourceValueCache)
+				block->addTerm(number_of_components, sourceValueCache->values);
+		}
+		cmzn_nodeiterator_destroy(&iterator);
+		if (cachingChanges)
+			return;
+		this->blocksValid = true;
+		this->blocksTime = time;
+	}
+	else
+	{
+		for (std::set<int>::iterator iter = this->changedBlocks.begin(); iter != this->changedBlocks.end(); ++iter)
+		{
+			NodesetOperatorAggregate& block = this->blocks[*iter];
+			this->evaluateBlock(extraCache, *iter, block);
+			if (0 == block.getNodeCount())
+				this->blocks.erase(*iter);
+		}
+	}
+	this->changedBlocks.clear();
+	for (BlockMap::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		aggregate.merge(number_of_components, iter->second);
+}
+
 bool Computed_field_nodeset_operator::is_defined_at_location(cmzn_fieldcache& cache)
 {
 	// Checks if source field is defined at a node in nodeset
@@ -198,35 +499,16 @@ protected:
 int Computed_field_nodeset_sum::evaluate_sum(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
-	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
-	extraCache.setTime(cache.getTime());
-	int number_of_terms = 0;
+	NodesetOperatorAggregate aggregate;
+	this->evaluateAggregate(cache, inValueCache, aggregate);
 	const int number_of_components = field->number_of_components;
-	FE_value *values = valueCache.values;
-	cmzn_field_id sourceField = getSourceField(0);
-	int i;
-	for (i = 0; i < number_of_components; i++)
-	{
-		values[i] = 0;
-	}
-	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
-	cmzn_node_id node = 0;
-	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	const FE_value *sums = aggregate.getSums();
+	for (int i = 0; i < number_of_components; i++)
 	{
-		extraCache.setNode(node);
-		RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
-		if (sourceValueCache)
-		{
-			for (i = 0 ; i < number_of_components ; i++)
-			{
-				values[i] += sourceValueCache->values[i];
-			}
-			++number_of_terms;
-		}
+		valueCache.values[i] = sums[i];
 	}
-	cmzn_nodeiterator_destroy(&iterator);
 	valueCache.derivatives_valid = 0;
-	return number_of_terms;
+	return aggregate.getTermCount();
 }
 
 const char computed_field_nodeset_mean_type_string[] = "nodeset_mean";
@@ -391,35 +673,16 @@ int Computed_field_nodeset_sum_squares::evaluate_sum_square_terms(
 int Computed_field_nodeset_sum_squares::evaluate_sum_squares(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
-	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
-	extraCache.setTime(cache.getTime());
-	int number_of_terms = 0;
+	NodesetOperatorAggregate aggregate;
+	this->evaluateAggregate(cache, inValueCache, aggregate);
 	const int number_of_components = field->number_of_components;
-	FE_value *values = valueCache.values;
-	cmzn_field_id sourceField = getSourceField(0);
-	int i;
-	for (i = 0; i < number_of_components; i++)
-	{
-		values[i] = 0;
-	}
-	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
-	cmzn_node_id node = 0;
-	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	const FE_value *sumSquares = aggregate.getSumSquares(number_of_components);
+	for (int i = 0; i < number_of_components; i++)
 	{
-		extraCache.setNode(node);
-		RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
-		if (sourceValueCache)
-		{
-			for (i = 0 ; i < number_of_components ; i++)
-			{
-				values[i] += sourceValueCache->values[i]*sourceValueCache->values[i];
-			}
-			++number_of_terms;
-		}
+		valueCache.values[i] = sumSquares[i];
 	}
-	cmzn_nodeiterator_destroy(&iterator);
 	valueCache.derivatives_valid = 0;
-	return number_of_terms;
+	return aggregate.getTermCount();
 }
 
 const char computed_field_nodeset_mean_squares_type_string[] = "nodeset_mean_squares";
@@ -533,41 +796,19 @@ public:
 int Computed_field_nodeset_minimum::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
-	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
-	extraCache.setTime(cache.getTime());
-	cmzn_field_id sourceField = getSourceField(0);
-
-	bool initialise = true;
-	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
-	int node_count = 0;
-	cmzn_node_id node = 0;
-	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	NodesetOperatorAggregate aggregate;
+	this->evaluateAggregate(cache, inValueCache, aggregate);
+	const int number_of_components = field->number_of_components;
+	if (0 < aggregate.getTermCount())
 	{
-		node_count++;
-		extraCache.setNode(node);
-		RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
-		if (sourceValueCache)
+		const FE_value *minimums = aggregate.getMinimums(number_of_components);
+		for (int i = 0; i < number_of_components; i++)
 		{
-			for (int i = 0 ; i < field->number_of_components ; i++)
-			{
-				if (initialise)
-				{
-					valueCache.values[i] = sourceValueCache->values[i];
-				}
-				else if (sourceValueCache->values[i] < valueCache.values[i])
-				{
-					valueCache.values[i] = sourceValueCache->values[i];
-				}
-			}
-			if (initialise)
-			{
-				initialise = false;
-			}
+			valueCache.values[i] = minimums[i];
 		}
 	}
-	cmzn_nodeiterator_destroy(&iterator);
-
-	if (node_count > 0)
+	valueCache.derivatives_valid = 0;
+	if (aggregate.getNodeCount() > 0)
 	{
 		return 1;
 	}
@@ -611,41 +852,19 @@ public:
 int Computed_field_nodeset_maximum::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
 	RealFieldValueCache &valueCache = RealFieldValueCache::cast(inValueCache);
-	cmzn_fieldcache& extraCache = *(inValueCache.getExtraCache());
-	extraCache.setTime(cache.getTime());
-	cmzn_field_id sourceField = getSourceField(0);
-
-	bool initialise = true;
-	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
-	int node_count = 0;
-	cmzn_node_id node = 0;
-	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	NodesetOperatorAggregate aggregate;
+	this->evaluateAggregate(cache, inValueCache, aggregate);
+	const int number_of_components = field->number_of_components;
+	if (0 < aggregate.getTermCount())
 	{
-		node_count++;
-		extraCache.setNode(node);
-		RealFieldValueCache* sourceValueCache = static_cast<RealFieldValueCache*>(sourceField->evaluate(extraCache));
-		if (sourceValueCache)
+		const FE_value *maximums = aggregate.getMaximums(number_of_components);
+		for (int i = 0; i < number_of_components; i++)
 		{
-			for (int i = 0 ; i < field->number_of_components ; i++)
-			{
-				if (initialise)
-				{
-					valueCache.values[i] = sourceValueCache->values[i];
-				}
-				else if (sourceValueCache->values[i] > valueCache.values[i])
-				{
-					valueCache.values[i] = sourceValueCache->values[i];
-				}
-			}
-			if (initialise)
-			{
-				initialise = false;
-			}
+			valueCache.values[i] = maximums[i];
 		}
 	}
-	cmzn_nodeiterator_destroy(&iterator);
-
-	if (node_count > 0)
+	valueCache.derivatives_valid = 0;
+	if (aggregate.getNodeCount() > 0)
 	{
 		return 1;
 	}
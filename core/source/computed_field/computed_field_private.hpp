@@ -22,6 +22,7 @@ Types used only internally to computed fields.
 #include "general/cmiss_set.hpp"
 #include "computed_field/field_location.hpp"
 #include "computed_field/field_cache.hpp"
+#include "computed_field/field_profiler.hpp"
 #include "computed_field/computed_field.h"
 #include "general/debug.h"
 #include "general/manager_private.h"
@@ -535,12 +536,35 @@ DESCRIPTION :
 		return 0;
 	}
 
+	/**
+	 * Evaluate with first and second derivatives w.r.t. element xi.
+	 * @param numberOfDerivatives  positive number of xi dimension of element location
+	 * @return  Value cache with valid first and second derivatives, or 0 if
+	 * failed or field does not support second derivatives.
+	 */
+	inline RealFieldValueCache *evaluateWithSecondDerivatives(cmzn_fieldcache& cache, int numberOfDerivatives)
+	{
+		int requestedDerivatives = cache.getRequestedDerivatives();
+		bool requestedSecondDerivatives = cache.getRequestedSecondDerivatives();
+		cache.setRequestedDerivatives(numberOfDerivatives);
+		cache.setRequestedSecondDerivatives(true);
+		RealFieldValueCache *valueCache = RealFieldValueCache::cast(evaluate(cache));
+		cache.setRequestedDerivatives(requestedDerivatives);
+		cache.setRequestedSecondDerivatives(requestedSecondDerivatives);
+		if (valueCache && valueCache->derivatives_valid && valueCache->second_derivatives_valid)
+			return valueCache;
+		return 0;
+	}
+
 	inline FieldValueCache *evaluateNoDerivatives(cmzn_fieldcache& cache)
 	{
 		int requestedDerivatives = cache.getRequestedDerivatives();
+		bool requestedSecondDerivatives = cache.getRequestedSecondDerivatives();
 		cache.setRequestedDerivatives(0);
+		cache.setRequestedSecondDerivatives(false);
 		FieldValueCache *valueCache = evaluate(cache);
 		cache.setRequestedDerivatives(requestedDerivatives);
+		cache.setRequestedSecondDerivatives(requestedSecondDerivatives);
 		return valueCache;
 	}
 
@@ -658,10 +682,16 @@ FULL_DECLARE_MANAGER_TYPE_WITH_OWNER(Computed_field, struct cmzn_region, struct
 inline FieldValueCache *Computed_field::evaluate(cmzn_fieldcache& cache)
 {
 	FieldValueCache *valueCache = getValueCache(cache);
+	FieldProfiler *profiler = cache.getProfiler();
 	// GRC: move derivatives to a separate value cache in future
 	if ((valueCache->evaluationCounter < cache.getLocationCounter()) ||
-		(cache.getRequestedDerivatives() && (!valueCache->hasDerivatives())))
+		(cache.getRequestedDerivatives() && ((!valueCache->hasDerivatives()) ||
+			(cache.getRequestedSecondDerivatives() && (!valueCache->hasSecondDerivatives())))))
 	{
+		if (profiler)
+			profiler->beginEvaluation(this->cache_index);
+		// only field types supporting second derivatives set them valid
+		valueCache->second_derivatives_valid = 0;
 		if (core->evaluate(cache, *valueCache))
 		{
 			// this disables field value caching between manager begin/end change
@@ -670,7 +700,11 @@ inline FieldValueCache *Computed_field::evaluate(cmzn_fieldcache& cache)
 		}
 		else
 			valueCache = 0;
+		if (profiler)
+			profiler->endEvaluation();
 	}
+	else if (profiler)
+		profiler->recordCacheHit(this->cache_index);
 	return valueCache;
 }
 
@@ -802,6 +836,16 @@ struct cmzn_region *Computed_field_manager_get_region(
 const cmzn_set_cmzn_field &Computed_field_manager_get_fields(
 	struct MANAGER(Computed_field) *manager);
 
+/**
+ * Query whether the field manager is caching changes, i.e. between begin and
+ * end cache, so field dependencies have not yet been updated.
+ *
+ * @param manager  Computed field manager.
+ * @return  True if caching changes, otherwise false.
+ */
+bool Computed_field_manager_is_caching_changes(
+	struct MANAGER(Computed_field) *manager);
+
 /**
  * Record that field data has changed.
  * Notify clients if not caching changes.
@@ -255,6 +255,21 @@ int Computed_field_element_group::addElementsConditional(cmzn_field_id condition
 	return return_code;
 }
 
+int Computed_field_element_group::adoptElements(Computed_field_element_group& source)
+{
+	if ((source.fe_mesh->getDimension() != this->fe_mesh->getDimension()) || (!this->isEmpty()))
+		return CMZN_ERROR_ARGUMENT;
+	if (source.isEmpty())
+		return CMZN_OK;
+	this->invalidateIterators();
+	source.invalidateIterators();
+	// swaps indexes but keeps labels of each group
+	this->labelsGroup->swap(*source.labelsGroup);
+	change_detail.changeAdd();
+	update();
+	return CMZN_OK;
+}
+
 int Computed_field_element_group::removeObject(cmzn_element *object)
 {
 	if (!isElementCompatible(object))
@@ -330,6 +330,11 @@ public:
 
 		int addElementIdentifierRange(DsLabelIdentifier first, DsLabelIdentifier last);
 
+		/** Take all elements from source group, whose mesh contents have been
+		 * adopted by this group's mesh so element indexes are unchanged.
+		 * This group must be empty. Source group is left empty. */
+		int adoptElements(Computed_field_element_group& source);
+
 		int removeObject(cmzn_element *object);
 
 		/** add any elements from master mesh for which conditional_field is true */
@@ -15,6 +15,7 @@ Functions for updating values of one computed field from those of another.
 #include "opencmiss/zinc/fieldmodule.h"
 #include "opencmiss/zinc/status.h"
 #include "computed_field/computed_field.h"
+#include "computed_field/computed_field_finite_element.h"
 #include "computed_field/computed_field_update.h"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_region.h"
@@ -23,6 +24,7 @@ Functions for updating values of one computed field from those of another.
 #include "general/message.h"
 #include "mesh/cmiss_element_private.hpp"
 #include "mesh/cmiss_node_private.hpp"
+#include <vector>
 
 int cmzn_nodeset_assign_field_from_source(
 	cmzn_nodeset_id nodeset, cmzn_field_id destination_field,
@@ -146,6 +148,9 @@ struct cmzn_element_assign_grid_field_from_source_data
 	struct Computed_field *destination_field;
 	struct Element_point_ranges_selection *element_point_ranges_selection;
 	struct Computed_field *group_field;
+	// xi and source values at grid points in current element, to assign together
+	std::vector<FE_value> xi_points;
+	std::vector<FE_value> point_values;
 };
 
 int cmzn_element_assign_grid_field_from_source_sub(
@@ -252,6 +257,10 @@ int cmzn_element_assign_grid_field_from_source_sub(
 				{
 					if (element_point_ranges)
 					{
+						/* evaluate source at all points before assigning all at once
+							so grid values are got and set once per element */
+						data->xi_points.clear();
+						data->point_values.clear();
 						selected_ranges = 
 							Element_point_ranges_get_ranges(element_point_ranges);
 						
@@ -276,13 +285,29 @@ int cmzn_element_assign_grid_field_from_source_sub(
 											(CMZN_OK == cmzn_field_evaluate_real(data->source_field,
 												data->field_cache, number_of_components, values)))
 										{
-											cmzn_field_assign_real(data->destination_field,
-												data->field_cache, number_of_components, values);
+											data->xi_points.insert(data->xi_points.end(), xi, xi + MAXIMUM_ELEMENT_XI_DIMENSIONS);
+											data->point_values.insert(data->point_values.end(), values, values + number_of_components);
 										}
 									}
 								}
 							}
 						}
+						const int number_of_points = static_cast<int>(data->xi_points.size()) / MAXIMUM_ELEMENT_XI_DIMENSIONS;
+						if ((0 < number_of_points) && (!Computed_field_finite_element_assign_element_grid_values(
+							data->destination_field, element, number_of_points,
+							data->xi_points.data(), data->point_values.data())))
+						{
+							/* not a finite element grid field: assign through cache */
+							for (int p = 0; p < number_of_points; ++p)
+							{
+								if (CMZN_OK == cmzn_fieldcache_set_mesh_location(data->field_cache,
+									element, MAXIMUM_ELEMENT_XI_DIMENSIONS, data->xi_points.data() + p*MAXIMUM_ELEMENT_XI_DIMENSIONS))
+								{
+									cmzn_field_assign_real(data->destination_field, data->field_cache,
+										number_of_components, data->point_values.data() + p*number_of_components);
+								}
+							}
+						}
 					}
 					data->success_count++;
 					DEALLOCATE(values);
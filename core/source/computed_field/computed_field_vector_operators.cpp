@@ -406,6 +406,43 @@ int Computed_field_cross_product::evaluate(cmzn_fieldcache& cache, FieldValueCac
 			} break;
 		}
 		valueCache.derivatives_valid = 1;
+		if ((3 == field->number_of_components) && cache.getRequestedSecondDerivatives() &&
+			sourceCache[0]->second_derivatives_valid && sourceCache[1]->second_derivatives_valid)
+		{
+			// (u x v)_jk = u_jk x v + u_j x v_k + u_k x v_j + u x v_jk
+			FE_value *second_derivatives = valueCache.getSecondDerivatives();
+			const int number_of_second_derivatives = number_of_xi*number_of_xi;
+			for (int j = 0 ; j < number_of_xi ; j++)
+			{
+				for (int k = 0 ; k < number_of_xi ; k++)
+				{
+					const int jk = j*number_of_xi + k;
+					for (int i = 0 ; i < 3 ; i++)
+					{
+						temp_vector[i] = sourceCache[0]->second_derivatives[i*number_of_second_derivatives + jk];
+						temp_vector[i + 3] = sourceCache[1]->second_derivatives[i*number_of_second_derivatives + jk];
+						temp_vector[i + 6] = sourceCache[0]->derivatives[i * number_of_xi + j];
+						temp_vector[i + 9] = sourceCache[1]->derivatives[i * number_of_xi + k];
+					}
+					FE_value sum_vector[3], product_vector[3];
+					cross_product_FE_value_vector3(temp_vector, sourceCache[1]->values, sum_vector);
+					cross_product_FE_value_vector3(sourceCache[0]->values, temp_vector + 3, product_vector);
+					for (int i = 0 ; i < 3 ; i++)
+						sum_vector[i] += product_vector[i];
+					cross_product_FE_value_vector3(temp_vector + 6, temp_vector + 9, product_vector);
+					for (int i = 0 ; i < 3 ; i++)
+					{
+						sum_vector[i] += product_vector[i];
+						temp_vector[i + 6] = sourceCache[0]->derivatives[i * number_of_xi + k];
+						temp_vector[i + 9] = sourceCache[1]->derivatives[i * number_of_xi + j];
+					}
+					cross_product_FE_value_vector3(temp_vector + 6, temp_vector + 9, product_vector);
+					for (int i = 0 ; i < 3 ; i++)
+						second_derivatives[i*number_of_second_derivatives + jk] = sum_vector[i] + product_vector[i];
+				}
+			}
+			valueCache.second_derivatives_valid = 1;
+		}
 	}
 	else
 	{
@@ -663,6 +700,33 @@ int Computed_field_dot_product::evaluate(cmzn_fieldcache& cache, FieldValueCache
 				temp++;
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() &&
+				source1Cache->second_derivatives_valid && source2Cache->second_derivatives_valid)
+			{
+				FE_value *second_derivatives = valueCache.getSecondDerivatives();
+				const int number_of_second_derivatives = number_of_xi*number_of_xi;
+				for (int jk=0;jk<number_of_second_derivatives;jk++)
+					second_derivatives[jk] = 0.0;
+				for (int i=0;i < vector_number_of_components;i++)
+				{
+					const FE_value *derivative1 = source1Cache->derivatives + i*number_of_xi;
+					const FE_value *derivative2 = source2Cache->derivatives + i*number_of_xi;
+					const FE_value *second_derivative1 = source1Cache->second_derivatives + i*number_of_second_derivatives;
+					const FE_value *second_derivative2 = source2Cache->second_derivatives + i*number_of_second_derivatives;
+					for (int j=0;j<number_of_xi;j++)
+					{
+						for (int k=0;k<number_of_xi;k++)
+						{
+							const int jk = j*number_of_xi + k;
+							second_derivatives[jk] +=
+								second_derivative1[jk]*source2Cache->values[i] +
+								derivative1[j]*derivative2[k] + derivative1[k]*derivative2[j] +
+								source1Cache->values[i]*second_derivative2[jk];
+						}
+					}
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
@@ -877,6 +941,28 @@ int Computed_field_magnitude::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 				valueCache.derivatives[j] = sum / valueCache.values[0];
 			}
 			valueCache.derivatives_valid = 1;
+			if (cache.getRequestedSecondDerivatives() && sourceCache->second_derivatives_valid)
+			{
+				// m = |u|: m_jk = (sum(u_j.u_k + u.u_jk) - m_j.m_k)/m
+				FE_value *second_derivatives = valueCache.getSecondDerivatives();
+				const FE_value *source_second_derivatives = sourceCache->second_derivatives;
+				const int number_of_second_derivatives = number_of_xi*number_of_xi;
+				for (int j=0;j<number_of_xi;j++)
+				{
+					for (int k=0;k<number_of_xi;k++)
+					{
+						sum = 0.0;
+						for (int i=0;i<source_number_of_components;i++)
+						{
+							sum += source_derivatives[i*number_of_xi+j]*source_derivatives[i*number_of_xi+k] +
+								source_values[i]*source_second_derivatives[i*number_of_second_derivatives + j*number_of_xi + k];
+						}
+						second_derivatives[j*number_of_xi + k] = (sum -
+							valueCache.derivatives[j]*valueCache.derivatives[k]) / valueCache.values[0];
+					}
+				}
+				valueCache.second_derivatives_valid = 1;
+			}
 		}
 		else
 		{
@@ -17,21 +17,23 @@
 #include "finite_element/finite_element_region.h"
 
 /**
- * For now can only represent a differential differential_operator give first derivatives
- * with respect to differential_operator elements of given dimension from fe_region.
+ * For now can only represent a differential differential_operator giving first or
+ * second derivatives with respect to xi of elements of given dimension from fe_region.
  */
 struct cmzn_differentialoperator
 {
 private:
 	FE_region *fe_region;
 	int dimension;
-	int term; // which derivative for multiple dimensions, 1 = d/dx1
+	int order; // 1 or 2
+	int term; // which derivative for multiple dimensions, 1 = d/dx1; for order 2, (i-1)*dimension + j = d2/dxi.dxj
 	int access_count;
 
 public:
-	cmzn_differentialoperator(FE_region *fe_region, int dimension, int term) :
+	cmzn_differentialoperator(FE_region *fe_region, int dimension, int order, int term) :
 		fe_region(ACCESS(FE_region)(fe_region)),
 		dimension(dimension),
+		order(order),
 		term(term),
 		access_count(1)
 	{
@@ -55,6 +57,7 @@ public:
 	}
 
 	int getDimension() const { return dimension; }
+	int getOrder() const { return order; }
 	FE_region *getFeRegion() const { return fe_region; }
 	int getTerm() const { return term; }
 
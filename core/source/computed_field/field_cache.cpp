@@ -39,6 +39,7 @@ RealFieldValueCache::~RealFieldValueCache()
 	}
 	delete[] values;
 	delete[] derivatives;
+	delete[] second_derivatives;
 }
 
 void RealFieldValueCache::clear()
@@ -23,6 +23,7 @@
 #include <vector>
 
 struct Computed_field_find_element_xi_cache;
+class FieldProfiler;
 
 // dynamic_cast may make cache value type crashes more predictable.
 // Enable for spurious errors, but switching off for performance reasons, release and debug.
@@ -46,11 +47,13 @@ private:
 public:
 	int evaluationCounter; // set to cmzn_fieldcache::locationCounter when field evaluated
 	int derivatives_valid; // only relevant to real caches, but having here saves a virtual function call
+	int second_derivatives_valid; // only relevant to real caches; reset before each evaluate
 
 	FieldValueCache() :
 		extraCache(0),
 		evaluationCounter(-1),
-		derivatives_valid(0)
+		derivatives_valid(0),
+		second_derivatives_valid(0)
 	{
 	}
 
@@ -83,6 +86,11 @@ public:
 		return derivatives_valid == 1;
 	}
 
+	bool hasSecondDerivatives()
+	{
+		return second_derivatives_valid == 1;
+	}
+
 };
 
 typedef std::vector<FieldValueCache*> ValueCacheVector;
@@ -94,8 +102,10 @@ private:
 	int locationCounter; // incremented whenever domain location changes
 	Field_location *location;
 	int requestedDerivatives;
+	bool requestedSecondDerivatives; // only if requestedDerivatives > 0
 	ValueCacheVector valueCaches;
 	bool assignInCache;
+	FieldProfiler *profiler; // non-accessed, owned by region; set only when profiling
 	int access_count;
 
 	/** call whenever location changes to increment location counter */
@@ -118,8 +128,10 @@ public:
 		locationCounter(0),
 		location(new Field_time_location()),
 		requestedDerivatives(0),
+		requestedSecondDerivatives(false),
 		valueCaches(cmzn_region_get_field_cache_size(region), (FieldValueCache*)0),
 		assignInCache(false),
+		profiler(cmzn_region_get_field_profiler(region)),
 		access_count(1)
 	{
 		cmzn_region_add_field_cache(region, this);
@@ -207,6 +219,17 @@ public:
 		}
 	}
 
+	/** @return  True if second derivatives are requested with the first derivatives */
+	inline bool getRequestedSecondDerivatives()
+	{
+		return requestedSecondDerivatives;
+	}
+
+	void setRequestedSecondDerivatives(bool requestedSecondDerivativesIn)
+	{
+		requestedSecondDerivatives = requestedSecondDerivativesIn;
+	}
+
 	int setElement(cmzn_element_id element)
 	{
 		const double chart_coordinates[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 0.0, 0.0, 0.0 };
@@ -273,6 +296,18 @@ public:
 		}
 	}
 
+	/** @return  Profiler recording evaluations of fields in region, or 0 if not profiling. */
+	inline FieldProfiler *getProfiler() const
+	{
+		return this->profiler;
+	}
+
+	/** Only to be called by owning region. */
+	void setProfiler(FieldProfiler *profilerIn)
+	{
+		this->profiler = profilerIn;
+	}
+
 	bool assignInCacheOnly() const
 	{
 		return assignInCache;
@@ -309,6 +344,8 @@ class RealFieldValueCache : public FieldValueCache
 public:
 	int componentCount;
 	FE_value *values, *derivatives;
+	// allocated on demand; for each component, d2/dxi_i.dxi_j at [i*number_of_xi + j]
+	FE_value *second_derivatives;
 	Computed_field_find_element_xi_cache *find_element_xi_cache;
 
 	RealFieldValueCache(int componentCount) :
@@ -316,10 +353,31 @@ public:
 		componentCount(componentCount),
 		values(new FE_value[componentCount]),
 		derivatives(new FE_value[componentCount*MAXIMUM_ELEMENT_XI_DIMENSIONS]),
+		second_derivatives(0),
 		find_element_xi_cache(0)
 	{
 	}
 
+	/** @return  Second derivatives array, allocating it on first call */
+	FE_value *getSecondDerivatives()
+	{
+		if (!second_derivatives)
+			second_derivatives = new FE_value[componentCount*MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		return second_derivatives;
+	}
+
+	/** Set second derivatives to zero and mark valid */
+	void zeroSecondDerivatives(int numberOfXi)
+	{
+		FE_value *secondDerivative = this->getSecondDerivatives();
+		for (int i = componentCount*numberOfXi*numberOfXi; 0 < i; --i)
+		{
+			*secondDerivative = 0.0;
+			++secondDerivative;
+		}
+		second_derivatives_valid = 1;
+	}
+
 	virtual ~RealFieldValueCache();
 
 	virtual void clear();
@@ -350,10 +408,21 @@ public:
 				derivatives[i] = source.derivatives[i];
 			}
 			derivatives_valid = 1;
+			if (source.second_derivatives_valid)
+			{
+				FE_value *secondDerivatives = this->getSecondDerivatives();
+				int secondDerivativeCount = derivativeCount*MAXIMUM_ELEMENT_XI_DIMENSIONS;
+				for (i = 0; i < secondDerivativeCount; ++i)
+				{
+					secondDerivatives[i] = source.second_derivatives[i];
+				}
+			}
+			second_derivatives_valid = source.second_derivatives_valid;
 		}
 		else
 		{
 			derivatives_valid = 0;
+			second_derivatives_valid = 0;
 		}
 	}
 
@@ -381,6 +450,7 @@ public:
 			values[i] = values_in[i];
 		}
 		derivatives_valid = 0;
+		second_derivatives_valid = 0;
 	}
 private:
 	RealFieldValueCache(); // not implemented
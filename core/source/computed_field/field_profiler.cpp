@@ -0,0 +1,74 @@
+/**
+ * FILE : field_profiler.cpp
+ *
+ * Optional recording of field evaluation counts, value cache hits and
+ * evaluation times per field in a region.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "computed_field/computed_field_private.hpp"
+#include "computed_field/field_profiler.hpp"
+#include "general/mystring.h"
+
+namespace {
+
+struct ReportEntry
+{
+	const char *name;
+	const FieldProfiler::Record *record;
+};
+
+bool compareReportEntries(const ReportEntry& entry1, const ReportEntry& entry2)
+{
+	return entry1.record->exclusiveTime > entry2.record->exclusiveTime;
+}
+
+}
+
+char *FieldProfiler::getReport(int numberOfFields, Computed_field **fields) const
+{
+	std::vector<ReportEntry> entries;
+	for (int i = 0; i < numberOfFields; ++i)
+	{
+		const Record *record = this->getRecord(fields[i]->cache_index);
+		if ((record) && (0 < (record->cacheHits + record->cacheMisses)))
+		{
+			ReportEntry entry = { fields[i]->name, record };
+			entries.push_back(entry);
+		}
+	}
+	std::stable_sort(entries.begin(), entries.end(), compareReportEntries);
+	std::string report("field\tevaluations\tcache hits\tcache misses\thit %\tinclusive ms\texclusive ms\n");
+	const char *lineFormat = "\t%llu\t%llu\t%llu\t%.1f\t%.3f\t%.3f\n";
+	std::vector<char> line(128);
+	for (std::vector<ReportEntry>::iterator iter = entries.begin(); iter != entries.end(); ++iter)
+	{
+		const Record& record = *(iter->record);
+		const unsigned long long evaluations = record.cacheHits + record.cacheMisses;
+		const double hitPercentage = 100.0*record.cacheHits/evaluations;
+		const double inclusiveMilliseconds = 1000.0*record.inclusiveTime;
+		const double exclusiveMilliseconds = 1000.0*record.exclusiveTime;
+		// times are unbounded so grow line to fit if needed
+		int length = snprintf(line.data(), line.size(), lineFormat, evaluations, record.cacheHits,
+			record.cacheMisses, hitPercentage, inclusiveMilliseconds, exclusiveMilliseconds);
+		if (length < 0)
+			continue;
+		if (static_cast<size_t>(length) >= line.size())
+		{
+			line.resize(static_cast<size_t>(length) + 1);
+			snprintf(line.data(), line.size(), lineFormat, evaluations, record.cacheHits,
+				record.cacheMisses, hitPercentage, inclusiveMilliseconds, exclusiveMilliseconds);
+		}
+		report += iter->name;
+		report += line.data();
+	}
+	return duplicate_string(report.c_str());
+}
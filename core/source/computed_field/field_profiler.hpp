@@ -0,0 +1,132 @@
+/**
+ * FILE : field_profiler.hpp
+ *
+ * Optional recording of field evaluation counts, value cache hits and
+ * evaluation times per field in a region.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (FIELD_PROFILER_HPP)
+#define FIELD_PROFILER_HPP
+
+#include <chrono>
+#include <vector>
+
+struct Computed_field;
+
+/**
+ * Profile of field evaluations in one region, recorded by field cache index.
+ * A cache hit is an evaluation request answered from the field value cache;
+ * a cache miss calls the field's evaluate function, and is timed. Inclusive
+ * time includes evaluating source fields that missed the cache; exclusive
+ * time excludes it. Not thread safe, as field caches are not.
+ */
+class FieldProfiler
+{
+public:
+	struct Record
+	{
+		unsigned long long cacheHits;
+		unsigned long long cacheMisses;
+		double inclusiveTime; // seconds
+		double exclusiveTime; // seconds
+
+		Record() :
+			cacheHits(0),
+			cacheMisses(0),
+			inclusiveTime(0.0),
+			exclusiveTime(0.0)
+		{
+		}
+	};
+
+private:
+	/** An evaluation in progress */
+	struct Frame
+	{
+		int cacheIndex;
+		std::chrono::steady_clock::time_point start;
+		double childTime;
+	};
+
+	std::vector<Record> records; // indexed by field cache index
+	std::vector<Frame> stack;
+
+	inline Record& getOrCreateRecord(int cacheIndex)
+	{
+		if (cacheIndex >= static_cast<int>(this->records.size()))
+			this->records.resize(cacheIndex + 1);
+		return this->records[cacheIndex];
+	}
+
+public:
+
+	inline void recordCacheHit(int cacheIndex)
+	{
+		++(this->getOrCreateRecord(cacheIndex).cacheHits);
+	}
+
+	/** Call before evaluating field that missed the cache. */
+	inline void beginEvaluation(int cacheIndex)
+	{
+		Frame frame;
+		frame.cacheIndex = cacheIndex;
+		frame.childTime = 0.0;
+		this->stack.push_back(frame);
+		// start timing last so push is not included
+		this->stack.back().start = std::chrono::steady_clock::now();
+	}
+
+	/** Call after evaluation begun with beginEvaluation, whether or not it succeeded. */
+	inline void endEvaluation()
+	{
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		if (this->stack.empty())
+			return;
+		const Frame& frame = this->stack.back();
+		const double time = std::chrono::duration<double>(end - frame.start).count();
+		Record& record = this->getOrCreateRecord(frame.cacheIndex);
+		++(record.cacheMisses);
+		record.inclusiveTime += time;
+		record.exclusiveTime += time - frame.childTime;
+		this->stack.pop_back();
+		if (!this->stack.empty())
+			this->stack.back().childTime += time;
+	}
+
+	/** Clear record for cache index, e.g. when given to a new field. */
+	void clearRecord(int cacheIndex)
+	{
+		if (cacheIndex < static_cast<int>(this->records.size()))
+			this->records[cacheIndex] = Record();
+	}
+
+	/** Clear all records. Evaluations in progress are still recorded. */
+	void reset()
+	{
+		this->records.clear();
+	}
+
+	/** @return  Record for cache index, or 0 if none. */
+	const Record *getRecord(int cacheIndex) const
+	{
+		if ((0 <= cacheIndex) && (cacheIndex < static_cast<int>(this->records.size())))
+			return &(this->records[cacheIndex]);
+		return 0;
+	}
+
+	/**
+	 * Get table of records for fields which have been evaluated, in order of
+	 * decreasing exclusive time.
+	 * @param fields  Array of fields in the region, to get names from.
+	 * @return  Allocated string, or 0 if failed.
+	 */
+	char *getReport(int numberOfFields, Computed_field **fields) const;
+
+};
+
+#endif /* !defined (FIELD_PROFILER_HPP) */
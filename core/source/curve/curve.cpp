@@ -4357,7 +4357,8 @@ int write_Curve(struct Curve *curve, void *dummy_void)
 				CMZN_FIELD_DOMAIN_TYPE_MESH3D|CMZN_FIELD_DOMAIN_TYPE_MESH_HIGHEST_DIMENSION,
 				/*write_nodes*/1, /*write_data*/0,
 					FE_WRITE_ALL_FIELDS, 0, (char **)NULL, /*time*/0.0,
-				FE_WRITE_COMPLETE_GROUP, CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_OFF))
+				FE_WRITE_COMPLETE_GROUP, CMZN_STREAMINFORMATION_REGION_RECURSION_MODE_OFF,
+				/*binary_values*/false))
 			{
 				return_code = 0;
 			}
@@ -13,6 +13,7 @@
 #include "opencmiss/zinc/status.h"
 #include "datastore/labels.hpp"
 #include "general/message.h"
+#include <algorithm>
 
 DsLabels::DsLabels() :
 	cmzn::RefCounted(),
@@ -43,10 +44,30 @@ void DsLabels::clear()
 	this->lastIdentifier = DS_LABEL_IDENTIFIER_INVALID;
 	this->identifiers.clear();
 	this->identifierToIndexMap.clear();
+	this->identifierHashIndex.clear();
 	this->labelsCount = 0;
 	this->indexSize = 0;
 }
 
+/**
+ * Swaps all labels with other, keeping names. Iterators over both labels are
+ * invalidated. Cannot fail.
+ */
+void DsLabels::swap(DsLabels& other)
+{
+	this->invalidateLabelIterators();
+	other.invalidateLabelIterators();
+	std::swap(this->contiguous, other.contiguous);
+	std::swap(this->firstFreeIdentifier, other.firstFreeIdentifier);
+	std::swap(this->firstIdentifier, other.firstIdentifier);
+	std::swap(this->lastIdentifier, other.lastIdentifier);
+	this->identifiers.swap(other.identifiers);
+	this->identifierToIndexMap.swap(other.identifierToIndexMap);
+	this->identifierHashIndex.swap(other.identifierHashIndex);
+	std::swap(this->labelsCount, other.labelsCount);
+	std::swap(this->indexSize, other.indexSize);
+}
+
 /**
  * Get the next unused identifier of at least startIdentifier,
  * or 1 if startIdentifier is not positive.
@@ -70,12 +91,18 @@ int DsLabels::setNotContiguous()
 {
 	if (this->contiguous)
 	{
-		// this can be optimised:
+		// bulk load: size hash for all labels and the one about to be added
+		if (!this->identifierHashIndex.reserve(static_cast<unsigned int>(this->indexSize) + 1))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::setNotContiguous.  Failed");
+			return CMZN_ERROR_MEMORY;
+		}
 		DsLabelIdentifier identifier = this->firstIdentifier;
 		for (DsLabelIndex index = 0; index < this->indexSize; ++index)
 		{
 			if (!(this->identifiers.setValue(index, identifier) &&
-					this->identifierToIndexMap.insert(*this, index)))
+					this->identifierToIndexMap.insert(*this, index) &&
+					this->identifierHashIndex.insert(identifier, index)))
 			{
 				display_message(ERROR_MESSAGE, "DsLabels::setNotContiguous.  Failed");
 				return CMZN_ERROR_MEMORY;
@@ -131,6 +158,14 @@ DsLabelIndex DsLabels::createLabelPrivate(DsLabelIdentifier identifier)
 			--this->indexSize;
 			return DS_LABEL_INDEX_INVALID;
 		}
+		if (!this->identifierHashIndex.insert(identifier, index))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::createLabelPrivate. Failed to insert identifier into hash index");
+			this->identifierToIndexMap.erase(*this, index);
+			--this->labelsCount;
+			--this->indexSize;
+			return DS_LABEL_INDEX_INVALID;
+		}
 		if (identifier == this->firstFreeIdentifier)
 			++this->firstFreeIdentifier;
 	}
@@ -179,6 +214,13 @@ int DsLabels::addLabelsRange(DsLabelIdentifier min, DsLabelIdentifier max,
 	}
 	else
 	{
+		if ((!this->contiguous) &&
+			(!this->identifierHashIndex.reserve(static_cast<unsigned int>(this->labelsCount) +
+				static_cast<unsigned int>((max - min)/stride + 1))))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::addLabelsRange.  Failed to reserve identifier index");
+			return CMZN_ERROR_MEMORY;
+		}
 		for (DsLabelIdentifier identifier = min; identifier <= max; identifier += stride)
 		{
 			DsLabelIndex index = this->findOrCreateLabel(identifier);
@@ -206,6 +248,7 @@ int DsLabels::removeLabel(DsLabelIndex index)
 		if (identifier >= 0)
 		{
 			this->identifierToIndexMap.erase(*this, index);
+			this->identifierHashIndex.erase(identifier);
 			this->identifiers.setValue(index, DS_LABEL_IDENTIFIER_INVALID);
 			if (identifier < this->firstFreeIdentifier)
 				this->firstFreeIdentifier = identifier;
@@ -256,13 +299,20 @@ int DsLabels::setIdentifier(DsLabelIndex index, DsLabelIdentifier identifier)
 	int return_code = CMZN_OK;
 	if (this->identifierToIndexMap.begin_identifier_change(*this, index))
 	{
-		if (this->identifiers.setValue(index, identifier))
+		// insert new hash entry first so failure leaves label unchanged
+		if (!this->identifierHashIndex.insert(identifier, index))
+			return_code = CMZN_ERROR_MEMORY;
+		else if (this->identifiers.setValue(index, identifier))
 		{
+			this->identifierHashIndex.erase(oldIdentifier);
 			if (oldIdentifier < this->firstFreeIdentifier)
 				this->firstFreeIdentifier = oldIdentifier;
 		}
 		else
+		{
+			this->identifierHashIndex.erase(identifier);
 			return_code = CMZN_ERROR_GENERAL;
+		}
 		this->identifierToIndexMap.end_identifier_change(*this);
 	}
 	else
@@ -449,5 +499,6 @@ void DsLabels::list_storage_details() const
 		display_message(INFORMATION_MESSAGE, "  Mean leaf depth = %g\n", mean_leaf_depth);
 		display_message(INFORMATION_MESSAGE, "  Mean stem occupancy = %g\n", mean_stem_occupancy);
 		display_message(INFORMATION_MESSAGE, "  Mean leaf occupancy = %g\n", mean_leaf_occupancy);
+		display_message(INFORMATION_MESSAGE, "  Hash index capacity = %u\n", this->identifierHashIndex.getCapacity());
 	}
 }
@@ -17,6 +17,7 @@
 #include <vector>
 #include "general/block_array.hpp"
 #include "general/cmiss_btree_index.hpp"
+#include "general/identifier_hash_index.hpp"
 #include "general/message.h"
 #include "general/refcounted.hpp"
 #include "general/refhandle.hpp"
@@ -53,6 +54,7 @@ class DsLabels;
 
 typedef cmzn_btree_index<DsLabels, DsLabelIndex, DsLabelIdentifier, DS_LABEL_INDEX_INVALID> DsLabelIdentifierToIndexMap;
 typedef cmzn_btree_index<DsLabels, DsLabelIndex, DsLabelIdentifier, DS_LABEL_INDEX_INVALID>::ext_iterator DsLabelIdentifierToIndexMapIterator;
+typedef identifier_hash_index<DsLabelIdentifier, DsLabelIndex, DS_LABEL_INDEX_INVALID> DsLabelIdentifierHashIndex;
 
 class DsLabelIterator;
 
@@ -68,7 +70,8 @@ class DsLabels : public cmzn::RefCounted
 	DsLabelIdentifier firstIdentifier; // used if contiguous: identifier of first index
 	DsLabelIdentifier lastIdentifier; // used if contiguous: identifier of last valid index
 	block_array<DsLabelIndex,DsLabelIdentifier> identifiers; // used only if not contiguous
-	DsLabelIdentifierToIndexMap identifierToIndexMap; // used only if not contiguous
+	DsLabelIdentifierToIndexMap identifierToIndexMap; // used only if not contiguous: identifier order
+	DsLabelIdentifierHashIndex identifierHashIndex; // used only if not contiguous: fast find by identifier
 	int labelsCount; // number of valid labels
 	int indexSize; // allocated label array size; can have holes where labels removed
 
@@ -85,6 +88,8 @@ public:
 
 	void clear();
 
+	void swap(DsLabels& other);
+
 private:
 
 	int setNotContiguous();
@@ -269,7 +274,7 @@ inline DsLabelIndex DsLabels::findLabelByIdentifier(DsLabelIdentifier identifier
 	}
 	else
 	{
-		return this->identifierToIndexMap.find_object_by_identifier(*this, identifier);
+		return this->identifierHashIndex.find(identifier);
 	}
 	return DS_LABEL_INDEX_INVALID;
 }
@@ -54,6 +54,15 @@ public:
 		Deaccess(this->labels);
 	}
 
+	/**
+	 * Swaps all array values with other map, which must have the same array
+	 * size. Labels are not swapped. Cannot fail.
+	 */
+	void swap(DsMapArray& other)
+	{
+		this->values.swap(other.values);
+	}
+
 	/**
 	 * Clear array held for index, if any. Does not free memory.
 	 */
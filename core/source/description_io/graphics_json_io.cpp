@@ -749,6 +749,18 @@ void GraphicsJsonIO::ioStreamlinesEntries(Json::Value &graphicsSettings)
 			{
 				attributesSettings["ColourDataType"] = "";
 			}
+			enumString = cmzn_graphics_streamlines_integration_method_enum_to_string(
+				(enum cmzn_graphics_streamlines_integration_method)streamlines.getIntegrationMethod());
+			if (enumString)
+			{
+				attributesSettings["IntegrationMethod"] = enumString;
+				DEALLOCATE(enumString);
+			}
+			else
+			{
+				attributesSettings["IntegrationMethod"] = "";
+			}
+			attributesSettings["IntegrationTolerance"] = streamlines.getIntegrationTolerance();
 			double value = streamlines.getTrackLength();
 			attributesSettings["TrackLength"] = value;
 			graphicsSettings["Streamlines"] = attributesSettings;
@@ -769,6 +781,13 @@ void GraphicsJsonIO::ioStreamlinesEntries(Json::Value &graphicsSettings)
 					static_cast<OpenCMISS::Zinc::GraphicsStreamlines::ColourDataType>(
 						cmzn_graphics_streamlines_colour_data_type_enum_from_string(
 							attributesSettings["ColourDataType"].asCString())));
+			if (attributesSettings["IntegrationMethod"].isString())
+				streamlines.setIntegrationMethod(
+					static_cast<OpenCMISS::Zinc::GraphicsStreamlines::IntegrationMethod>(
+						cmzn_graphics_streamlines_integration_method_enum_from_string(
+							attributesSettings["IntegrationMethod"].asCString())));
+			if (attributesSettings["IntegrationTolerance"].isDouble())
+				streamlines.setIntegrationTolerance(attributesSettings["IntegrationTolerance"].asDouble());
 			if (attributesSettings["TrackLength"].isDouble())
 				streamlines.setTrackLength(attributesSettings["TrackLength"].asDouble());
 		}
@@ -777,12 +796,20 @@ void GraphicsJsonIO::ioStreamlinesEntries(Json::Value &graphicsSettings)
 
 void GraphicsJsonIO::ioSurfacesEntries(Json::Value &graphicsSettings)
 {
-	if (mode == IO_MODE_EXPORT)
+	OpenCMISS::Zinc::GraphicsSurfaces surfaces = graphics.castSurfaces();
+	if (surfaces.isValid())
 	{
-		OpenCMISS::Zinc::GraphicsSurfaces surfaces = graphics.castSurfaces();
-		if (surfaces.isValid())
+		if (mode == IO_MODE_EXPORT)
+		{
+			Json::Value attributesSettings = Json::Value(Json::objectValue);
+			attributesSettings["SharedEdgeEvaluation"] = surfaces.isSharedEdgeEvaluation();
+			graphicsSettings["Surfaces"] = attributesSettings;
+		}
+		else if (graphicsSettings["Surfaces"].isObject())
 		{
-			graphicsSettings["Surfaces"] = Json::Value(Json::objectValue);
+			Json::Value attributesSettings = graphicsSettings["Surfaces"];
+			if (attributesSettings["SharedEdgeEvaluation"].isBool())
+				surfaces.setSharedEdgeEvaluation(attributesSettings["SharedEdgeEvaluation"].asBool());
 		}
 	}
 }
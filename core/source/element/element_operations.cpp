@@ -169,9 +169,12 @@ public:
 };
 
 IntegrationPointsCache::IntegrationPointsCache(cmzn_element_quadrature_rule quadratureRuleIn,
-	int numbersOfPointsCountIn, const int *numbersOfPointsIn) :
-	quadratureRule(quadratureRuleIn),
-	variableNumbersOfPoints(false)
+	int numbersOfPointsCountIn, const int *numbersOfPointsIn, int subdivisionsIn) :
+	// adaptive quadrature is built from fixed Gaussian rules
+	quadratureRule((quadratureRuleIn == CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE) ?
+		CMZN_ELEMENT_QUADRATURE_RULE_GAUSSIAN : quadratureRuleIn),
+	variableNumbersOfPoints(false),
+	subdivisions((subdivisionsIn > 1) ? subdivisionsIn : 1)
 {
 	int lastNumPointsInDirection = 1;
 	for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
@@ -259,12 +262,16 @@ IntegrationShapePoints *IntegrationPointsCache::getPoints(cmzn_element *element)
 				{
 					const int dimension = cmzn_element_get_dimension(element);
 					int order_offset[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+					int axisPoints[MAXIMUM_ELEMENT_XI_DIMENSIONS];
 					numPoints = 1;
 					for (int i = 0; i < dimension; ++i)
 					{
-						numPoints *= useNumbersOfPoints[i];
+						axisPoints[i] = useNumbersOfPoints[i]*this->subdivisions;
+						numPoints *= axisPoints[i];
 						order_offset[i] = lineOffset[useNumbersOfPoints[i] - 1];
 					}
+					// Gauss points are repeated in each equal sub-interval of xi
+					const FE_value scale = 1.0 / static_cast<FE_value>(this->subdivisions);
 					points = new FE_value[numPoints*dimension];
 					weights = new FE_value[numPoints];
 					for (int g = 0; g < numPoints; ++g)
@@ -273,10 +280,11 @@ IntegrationShapePoints *IntegrationPointsCache::getPoints(cmzn_element *element)
 						int shift_g = g;
 						for (int i = 0; i < dimension; ++i)
 						{
-							int g1 = order_offset[i] + (shift_g % useNumbersOfPoints[i]);
-							points[g*dimension + i] = lineGaussPt[g1].location;
-							weights[g] *= lineGaussPt[g1].weight;
-							shift_g /= useNumbersOfPoints[i];
+							const int a = shift_g % axisPoints[i];
+							const int g1 = order_offset[i] + (a % useNumbersOfPoints[i]);
+							points[g*dimension + i] = (static_cast<FE_value>(a / useNumbersOfPoints[i]) + lineGaussPt[g1].location)*scale;
+							weights[g] *= lineGaussPt[g1].weight*scale;
+							shift_g /= axisPoints[i];
 						}
 					}
 				} break;
@@ -446,6 +454,7 @@ IntegrationShapePoints *IntegrationPointsCache::getPoints(cmzn_element *element)
 				} break;
 			}
 		} break;
+	case CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE:
 	case CMZN_ELEMENT_QUADRATURE_RULE_INVALID:
 		{
 			display_message(INFORMATION_MESSAGE, "IntegrationPointsCache::getPoints()  "
@@ -103,10 +103,16 @@ private:
 	cmzn_element_quadrature_rule quadratureRule;
 	int numbersOfPoints[MAXIMUM_ELEMENT_XI_DIMENSIONS];
 	bool variableNumbersOfPoints;
+	int subdivisions;
 
 public:
+	/**
+	 * @param subdivisionsIn  For Gaussian quadrature on line, square and cube
+	 * shapes, the number of equal sub-intervals each xi axis is divided into,
+	 * each with the numbers of points. Ignored for other shapes and rules.
+	 */
 	IntegrationPointsCache(cmzn_element_quadrature_rule quadratureRuleIn,
-		int numbersOfPointsCountIn, const int *numbersOfPointsIn);
+		int numbersOfPointsCountIn, const int *numbersOfPointsIn, int subdivisionsIn = 1);
 
 	~IntegrationPointsCache();
 
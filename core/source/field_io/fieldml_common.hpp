@@ -21,6 +21,11 @@
 
 const FmlObjectHandle FML_INVALID_OBJECT_HANDLE = (const FmlObjectHandle)FML_INVALID_HANDLE;
 
+/** Format of zinc external array data resources holding raw little-endian
+ * 32-bit integers or IEEE doubles; array data source location is byte offset.
+ * Not readable by the FieldML API so zinc reads these directly. */
+const char FieldML_raw_binary_format[] = "ZINC_RAW_LITTLE_ENDIAN";
+
 struct FE_basis;
 
 struct ShapeType
@@ -9,7 +9,9 @@
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <map>
 #include <set>
 #include <string>
@@ -29,6 +31,7 @@
 #include "field_io/read_fieldml.hpp"
 #include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
+#include "general/byte_order.hpp"
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/message.h"
@@ -233,6 +236,11 @@ private:
 
 	DsLabels *getLabelsForEnsemble(FmlObjectHandle fmlEnsemble);
 
+	bool isRawBinaryDataSource(FmlObjectHandle fmlDataSource);
+
+	template <typename VALUETYPE> int readRawBinaryArray(FmlObjectHandle fmlDataSource,
+		int valuesCount, VALUETYPE *values);
+
 	template <typename VALUETYPE> int readParametersArray(FmlObjectHandle fmlParameters,
 		DsMap<VALUETYPE>& parameters);
 
@@ -456,6 +464,88 @@ template <> inline FmlIoErrorNumber FieldML_ReadSlab(
 	return Fieldml_ReadIntSlab(readerHandle, offsets, sizes, valueBuffer);
 }
 
+/**
+ * @return  True if data source is an array in an external raw binary resource
+ * written by zinc, which must be read directly as the FieldML API cannot.
+ */
+bool FieldMLReader::isRawBinaryDataSource(FmlObjectHandle fmlDataSource)
+{
+	FmlObjectHandle fmlDataResource = Fieldml_GetDataSourceResource(this->fmlSession, fmlDataSource);
+	if ((FML_INVALID_HANDLE == fmlDataResource) ||
+		(FML_DATA_RESOURCE_HREF != Fieldml_GetDataResourceType(this->fmlSession, fmlDataResource)))
+		return false;
+	char *format = Fieldml_GetDataResourceFormat(this->fmlSession, fmlDataResource);
+	const bool rawBinary = (format) && (0 == strcmp(format, FieldML_raw_binary_format));
+	Fieldml_FreeString(format);
+	return rawBinary;
+}
+
+/**
+ * Read all values of array data source from raw binary resource, which must
+ * have zero offsets and sizes equal to raw sizes, as zinc writes them.
+ * @param valuesCount  Expected number of values in array.
+ * @return  1 on success, 0 on failure with error reported.
+ */
+template <typename VALUETYPE> int FieldMLReader::readRawBinaryArray(FmlObjectHandle fmlDataSource,
+	int valuesCount, VALUETYPE *values)
+{
+	const int rank = Fieldml_GetArrayDataSourceRank(this->fmlSession, fmlDataSource);
+	std::vector<int> rawSizes(rank), offsets(rank), sizes(rank);
+	int rawValuesCount = 1;
+	if ((rank > 0) && (
+		(FML_ERR_NO_ERROR != Fieldml_GetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, rawSizes.data())) ||
+		(FML_ERR_NO_ERROR != Fieldml_GetArrayDataSourceOffsets(this->fmlSession, fmlDataSource, offsets.data())) ||
+		(FML_ERR_NO_ERROR != Fieldml_GetArrayDataSourceSizes(this->fmlSession, fmlDataSource, sizes.data()))))
+		rawValuesCount = -1;
+	for (int r = 0; (r < rank) && (rawValuesCount >= 0); ++r)
+	{
+		if ((offsets[r] != 0) || ((sizes[r] != 0) && (sizes[r] != rawSizes[r])))
+			rawValuesCount = -1;
+		else
+			rawValuesCount *= rawSizes[r];
+	}
+	if (rawValuesCount != valuesCount)
+	{
+		display_message(ERROR_MESSAGE, "Read FieldML:  Binary data source %s must be whole array of expected size",
+			getName(fmlDataSource).c_str());
+		return 0;
+	}
+	FmlObjectHandle fmlDataResource = Fieldml_GetDataSourceResource(this->fmlSession, fmlDataSource);
+	char *href = Fieldml_GetDataResourceHref(this->fmlSession, fmlDataResource);
+	char *location = Fieldml_GetArrayDataSourceLocation(this->fmlSession, fmlDataSource);
+	std::string path(href ? href : "");
+	const long long offset = (location) ? strtoll(location, 0, 10) : -1;
+	Fieldml_FreeString(location);
+	Fieldml_FreeString(href);
+	// href is relative to directory of FieldML file unless absolute
+	if ((0 < path.size()) && (path[0] != '/') && (path[0] != '\\') &&
+		((path.size() < 2) || (path[1] != ':')))
+	{
+		const std::string fieldmlFilename(this->filename);
+		const size_t lastDirSep = fieldmlFilename.find_last_of("/\\");
+		if (lastDirSep != std::string::npos)
+			path = fieldmlFilename.substr(0, lastDirSep + 1) + path;
+	}
+	std::ifstream binaryFile(path.c_str(), std::ios::in | std::ios::binary);
+	if ((!binaryFile.is_open()) || (offset < 0))
+	{
+		display_message(ERROR_MESSAGE, "Read FieldML:  Could not open binary resource %s for data source %s",
+			path.c_str(), getName(fmlDataSource).c_str());
+		return 0;
+	}
+	binaryFile.seekg(static_cast<std::streamoff>(offset));
+	binaryFile.read(reinterpret_cast<char *>(values), static_cast<std::streamsize>(valuesCount)*sizeof(VALUETYPE));
+	if (!binaryFile.good())
+	{
+		display_message(ERROR_MESSAGE, "Read FieldML:  Truncated binary resource %s for data source %s",
+			path.c_str(), getName(fmlDataSource).c_str());
+		return 0;
+	}
+	if (!host_is_little_endian())
+		swap_byte_order(values, static_cast<size_t>(valuesCount));
+	return 1;
+}
+
 // TODO : Support order
 // ???GRC can order cover subset of ensemble?
 template <typename VALUETYPE> int FieldMLReader::readParametersArray(FmlObjectHandle fmlParameters,
@@ -641,9 +731,18 @@ template <typename VALUETYPE> int FieldMLReader::readParametersArray(FmlObjectHa
 		}
 	}
 
+	// zinc raw binary arrays are read directly; key data must be in same format
+	const bool rawBinary = return_code && this->isRawBinaryDataSource(fmlDataSource);
+	if (rawBinary && (dataDescription == FML_DATA_DESCRIPTION_DOK_ARRAY) &&
+		(!this->isRawBinaryDataSource(fmlKeyDataSource)))
+	{
+		display_message(ERROR_MESSAGE, "Read FieldML:  Key data source %s for parameters %s must also be binary",
+			getName(fmlKeyDataSource).c_str(), name.c_str());
+		return_code = 0;
+	}
 	FmlReaderHandle fmlReader = FML_INVALID_HANDLE;
 	FmlReaderHandle fmlKeyReader = FML_INVALID_HANDLE;
-	if (return_code)
+	if (return_code && (!rawBinary))
 	{
 		fmlReader = Fieldml_OpenReader(fmlSession, fmlDataSource);
 		if (fmlReader == FML_INVALID_HANDLE)
@@ -664,7 +763,15 @@ template <typename VALUETYPE> int FieldMLReader::readParametersArray(FmlObjectHa
 		}
 	}
 
-	if (return_code)
+	if (return_code && rawBinary)
+	{
+		if (!this->readRawBinaryArray(fmlDataSource, valueBufferSize, valueBuffer))
+			return_code = 0;
+		else if ((dataDescription == FML_DATA_DESCRIPTION_DOK_ARRAY) &&
+				(!this->readRawBinaryArray(fmlKeyDataSource, keyArraySizes[0]*keyArraySizes[1], keyBuffer)))
+			return_code = 0;
+	}
+	else if (return_code)
 	{
 		FmlIoErrorNumber ioResult = FML_IOERR_NO_ERROR;
 		ioResult = FieldML_ReadSlab(fmlReader, arrayOffsets, arraySizes, valueBuffer);
@@ -698,9 +805,12 @@ template <typename VALUETYPE> int FieldMLReader::readParametersArray(FmlObjectHa
 		}
 	}
 
-	if (dataDescription == FML_DATA_DESCRIPTION_DOK_ARRAY)
-		Fieldml_CloseReader(fmlKeyReader);
-	Fieldml_CloseReader(fmlReader);
+	if (!rawBinary)
+	{
+		if (dataDescription == FML_DATA_DESCRIPTION_DOK_ARRAY)
+			Fieldml_CloseReader(fmlKeyReader);
+		Fieldml_CloseReader(fmlReader);
+	}
 	delete[] valueBuffer;
 	delete[] keyBuffer;
 	delete[] arraySizes;
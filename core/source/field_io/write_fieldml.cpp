@@ -10,6 +10,7 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <sstream>
@@ -30,6 +31,7 @@
 #include "finite_element/finite_element_basis.h"
 #include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
+#include "general/byte_order.hpp"
 #include "general/debug.h"
 #include "general/message.h"
 #include "general/mystring.h"
@@ -309,6 +311,10 @@ class FieldMLWriter
 	std::map<FieldMLBasisData*,HMeshNodeConnectivity> basisConnectivityMap;
 	// later: multimap
 	std::map<FE_element_field_component*,HElementFieldComponentTemplate> elementTemplates;
+	// external raw binary resource for parameter arrays, if enabled
+	FmlObjectHandle fmlBinaryDataResource;
+	std::ofstream binaryFile;
+	long long binaryFileOffset;
 
 public:
 	FieldMLWriter(struct cmzn_region *region, const char *locationIn, const char *filenameIn) :
@@ -326,7 +332,9 @@ public:
 		meshLabels(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1),
 		fmlMeshElementsType(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1),
 		hermiteNodeValueLabels(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1),
-		fmlHermiteNodeValueLabels(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1)
+		fmlHermiteNodeValueLabels(MAXIMUM_ELEMENT_XI_DIMENSIONS + 1),
+		fmlBinaryDataResource(FML_INVALID_OBJECT_HANDLE),
+		binaryFileOffset(0)
 	{
 		Fieldml_SetDebug(fmlSession, /*debug*/verbose);
 		for (int i = 0; i < 4; ++i)
@@ -345,6 +353,8 @@ public:
 
 	int setMinimumNodeVersions(int minimumNodeVersions);
 
+	int openBinaryArrays();
+
 	int writeNodeset(cmzn_field_domain_type domainType, bool writeIfEmpty);
 	int writeNodesets();
 
@@ -360,6 +370,10 @@ private:
 	FmlObjectHandle getArgumentForType(FmlObjectHandle fmlType);
 	FieldMLBasisData *getOutputBasisData(FE_basis *feBasis);
 	int defineEnsembleFromLabels(FmlObjectHandle fmlEnsembleType, DsLabels& labels);
+	template <typename VALUETYPE> FmlObjectHandle writeBinaryArray(
+		const std::string& dataSourceName, int rank, const int *sizes, const VALUETYPE *values);
+	template <typename VALUETYPE> int writeBinaryParameters(DsMap<VALUETYPE>& parameterMap,
+		FmlObjectHandle& fmlDataSource, FmlObjectHandle& fmlKeyDataSource);
 	template <typename VALUETYPE> FmlObjectHandle defineParametersFromMap(
 		DsMap<VALUETYPE>& parameterMap, FmlObjectHandle fmlValueType);
 	int getNodeConnectivityForBasisData(FieldMLBasisData& basisData,
@@ -652,6 +666,138 @@ template <>	inline const char *FieldML_valueFormat(const int *)
 	return " %d";
 }
 
+/**
+ * Start writing parameter arrays to an external raw binary resource named
+ * after the FieldML file with .bin appended, in the same directory.
+ * @return  Result OK on success, otherwise an error code.
+ */
+int FieldMLWriter::openBinaryArrays()
+{
+	std::string href(this->filename);
+	href += ".bin";
+	std::string path(href);
+	if (this->location && (*this->location != '\0'))
+		path = std::string(this->location) + "/" + href;
+	this->binaryFile.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!this->binaryFile.is_open())
+	{
+		display_message(ERROR_MESSAGE, "FieldMLWriter:  Could not open binary file %s", path.c_str());
+		return CMZN_ERROR_GENERAL;
+	}
+	this->binaryFileOffset = 0;
+	std::string dataResourceName(href + ".resource");
+	this->fmlBinaryDataResource = Fieldml_CreateHrefDataResource(this->fmlSession,
+		dataResourceName.c_str(), FieldML_raw_binary_format, href.c_str());
+	if (FML_INVALID_OBJECT_HANDLE == this->fmlBinaryDataResource)
+		return CMZN_ERROR_GENERAL;
+	return CMZN_OK;
+}
+
+/**
+ * Append values to the binary file as little-endian and create an array data
+ * source for them located at their byte offset in the binary resource.
+ * @return  Handle to data source, or FML_INVALID_OBJECT_HANDLE on failure.
+ */
+template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::writeBinaryArray(
+	const std::string& dataSourceName, int rank, const int *sizes, const VALUETYPE *values)
+{
+	size_t valuesCount = 1;
+	for (int r = 0; r < rank; ++r)
+		valuesCount *= static_cast<size_t>(sizes[r]);
+	std::ostringstream locationStream;
+	locationStream << this->binaryFileOffset;
+	FmlObjectHandle fmlDataSource = Fieldml_CreateArrayDataSource(this->fmlSession,
+		dataSourceName.c_str(), this->fmlBinaryDataResource, locationStream.str().c_str(), rank);
+	if (FML_INVALID_OBJECT_HANDLE == fmlDataSource)
+		return FML_INVALID_OBJECT_HANDLE;
+	Fieldml_SetArrayDataSourceRawSizes(this->fmlSession, fmlDataSource, const_cast<int *>(sizes));
+	Fieldml_SetArrayDataSourceSizes(this->fmlSession, fmlDataSource, const_cast<int *>(sizes));
+	const size_t valuesSize = valuesCount*sizeof(VALUETYPE);
+	if (host_is_little_endian())
+	{
+		this->binaryFile.write(reinterpret_cast<const char *>(values), valuesSize);
+	}
+	else
+	{
+		std::vector<VALUETYPE> swappedValues(values, values + valuesCount);
+		swap_byte_order(swappedValues.data(), swappedValues.size());
+		this->binaryFile.write(reinterpret_cast<const char *>(swappedValues.data()), valuesSize);
+	}
+	if (!this->binaryFile.good())
+	{
+		display_message(ERROR_MESSAGE, "FieldMLWriter:  Failed to write binary array for %s",
+			dataSourceName.c_str());
+		return FML_INVALID_OBJECT_HANDLE;
+	}
+	this->binaryFileOffset += static_cast<long long>(valuesSize);
+	return fmlDataSource;
+}
+
+/**
+ * Write parameters to binary resource: dense parameters as a single array
+ * of rank equal to the number of dense labels; sparse parameters as rank 2
+ * data and integer key arrays with one row per record.
+ * @return  Result OK on success, otherwise an error code.
+ */
+template <typename VALUETYPE> int FieldMLWriter::writeBinaryParameters(DsMap<VALUETYPE>& parameterMap,
+	FmlObjectHandle& fmlDataSource, FmlObjectHandle& fmlKeyDataSource)
+{
+	static_assert(sizeof(int) == 4, "Binary FieldML arrays require 32-bit int");
+	std::string name = parameterMap.getName();
+	std::vector<HDsLabels> sparseLabelsArray;
+	std::vector<HDsLabels> denseLabelsArray;
+	parameterMap.getSparsity(sparseLabelsArray, denseLabelsArray);
+	const int denseLabelsCount = static_cast<int>(denseLabelsArray.size());
+	const int sparseLabelsCount = static_cast<int>(sparseLabelsArray.size());
+	HDsMapIndexing mapIndexing(parameterMap.createIndexing());
+	if (sparseLabelsCount > 0)
+	{
+		int denseSize = 1;
+		for (int i = 0; i < denseLabelsCount; ++i)
+			denseSize *= denseLabelsArray[i]->getSize();
+		for (int i = 0; i < sparseLabelsCount; ++i)
+			mapIndexing->setEntryIndex(*sparseLabelsArray[i], DS_LABEL_INDEX_INVALID);
+		mapIndexing->resetSparseIterators();
+		std::vector<int> keys;
+		std::vector<VALUETYPE> values;
+		std::vector<VALUETYPE> denseValues(denseSize);
+		int numberOfRecords = 0;
+		while (parameterMap.incrementSparseIterators(*mapIndexing))
+		{
+			if (!parameterMap.getValues(*mapIndexing, denseSize, denseValues.data()))
+			{
+				display_message(ERROR_MESSAGE, "FieldMLWriter::writeBinaryParameters.  "
+					"Failed to get sparsely indexed values from map %s", name.c_str());
+				return CMZN_ERROR_GENERAL;
+			}
+			++numberOfRecords;
+			for (int i = 0; i < sparseLabelsCount; ++i)
+				keys.push_back(mapIndexing->getSparseIdentifier(i));
+			values.insert(values.end(), denseValues.begin(), denseValues.end());
+		}
+		const int sizes[2] = { numberOfRecords, denseSize };
+		const int keySizes[2] = { numberOfRecords, sparseLabelsCount };
+		fmlDataSource = this->writeBinaryArray(name + ".data.source", 2, sizes, values.data());
+		fmlKeyDataSource = this->writeBinaryArray(name + ".key.data.source", 2, keySizes, keys.data());
+		if ((FML_INVALID_OBJECT_HANDLE == fmlDataSource) || (FML_INVALID_OBJECT_HANDLE == fmlKeyDataSource))
+			return CMZN_ERROR_GENERAL;
+	}
+	else
+	{
+		std::vector<int> sizes(denseLabelsCount);
+		for (int i = 0; i < denseLabelsCount; ++i)
+			sizes[i] = denseLabelsArray[i]->getSize();
+		DsMapAddressType denseValuesCount = mapIndexing->getEntryCount();
+		std::vector<VALUETYPE> values(denseValuesCount);
+		if (!parameterMap.getValues(*mapIndexing, denseValuesCount, values.data()))
+			return CMZN_ERROR_GENERAL;
+		fmlDataSource = this->writeBinaryArray(name + ".data.source", denseLabelsCount, sizes.data(), values.data());
+		if (FML_INVALID_OBJECT_HANDLE == fmlDataSource)
+			return CMZN_ERROR_GENERAL;
+	}
+	return CMZN_OK;
+}
+
 template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFromMap(
 	DsMap<VALUETYPE>& parameterMap, FmlObjectHandle fmlValueType)
 {
@@ -660,7 +806,8 @@ template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFro
 	std::vector<HDsLabels> denseLabelsArray;
 	parameterMap.getSparsity(sparseLabelsArray, denseLabelsArray);
 	std::string dataResourceName(name + ".data.resource");
-	FmlObjectHandle fmlDataResource = Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
+	FmlObjectHandle fmlDataResource = (FML_INVALID_OBJECT_HANDLE != this->fmlBinaryDataResource) ? FML_INVALID_OBJECT_HANDLE :
+		Fieldml_CreateInlineDataResource(this->fmlSession, dataResourceName.c_str());
 	const int denseLabelsCount = static_cast<int>(denseLabelsArray.size());
 	const int sparseLabelsCount = static_cast<int>(sparseLabelsArray.size());
 	std::string dataSourceName(name + ".data.source");
@@ -668,7 +815,11 @@ template <typename VALUETYPE> FmlObjectHandle FieldMLWriter::defineParametersFro
 	FmlErrorNumber fmlError;
 	FmlObjectHandle fmlDataSource = FML_INVALID_OBJECT_HANDLE;
 	FmlObjectHandle fmlKeyDataSource = FML_INVALID_OBJECT_HANDLE;
-	if (sparseLabelsCount > 0)
+	if (FML_INVALID_OBJECT_HANDLE != this->fmlBinaryDataResource)
+	{
+		return_code = this->writeBinaryParameters(parameterMap, fmlDataSource, fmlKeyDataSource);
+	}
+	else if (sparseLabelsCount > 0)
 	{
 		// when writing to a text bulk data format we want the sparse labels to
 		// precede the dense data under those labels (so kept together). This can only
@@ -2052,13 +2203,23 @@ int FieldMLWriter::writeMeshFields(int meshDimension)
 
 int FieldMLWriter::writeFile(const char *pathandfilename)
 {
+	if (this->binaryFile.is_open())
+	{
+		this->binaryFile.close();
+		if (this->binaryFile.fail())
+		{
+			display_message(ERROR_MESSAGE, "FieldMLWriter:  Failed to close binary file for %s", pathandfilename);
+			return CMZN_ERROR_GENERAL;
+		}
+	}
 	FmlErrorNumber fmlError = Fieldml_WriteFile(this->fmlSession, pathandfilename);
 	if (FML_OK == fmlError)
 		return CMZN_OK;
 	return CMZN_ERROR_GENERAL;
 }
 
-int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename)
+int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename,
+	bool binaryArrays)
 {
 	int return_code = CMZN_OK;
 	if (region && pathandfilename && (*pathandfilename != '\0'))
@@ -2080,6 +2241,8 @@ int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename)
 			filename = pathandfilename;
 		}
 		FieldMLWriter fmlWriter(region, location, filename);
+		if (binaryArrays)
+			return_code = fmlWriter.openBinaryArrays();
 		if (CMZN_OK == return_code)
 			return_code = fmlWriter.writeNodesets();
 		// Currently only writes highest dimension mesh
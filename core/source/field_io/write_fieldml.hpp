@@ -16,7 +16,11 @@ struct cmzn_region;
 
 /**
  * Write model in region in FieldML 0.5 format.
+ * @param binaryArrays  If true, write node parameter and element connectivity
+ * arrays to an external raw little-endian binary resource named after the
+ * file with .bin appended, instead of inline text.
  */
-int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename);
+int write_fieldml_file(struct cmzn_region *region, const char *pathandfilename,
+	bool binaryArrays);
 
 #endif /* !defined (CMZN_WRITE_FIELDML_HPP) */
@@ -21,6 +21,7 @@ Functions for exporting finite element data to a file.
 #include "finite_element/finite_element_mesh.hpp"
 #include "finite_element/finite_element_region.h"
 #include "finite_element/export_finite_element.h"
+#include "general/byte_order.hpp"
 #include "general/compare.h"
 #include "general/debug.h"
 #include "general/enumerator_private.hpp"
@@ -34,12 +35,26 @@ Functions for exporting finite element data to a file.
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 using namespace std;
 
 /* the number of spaces each child object is indented from its parent by in the
 	 output file */
 #define EXPORT_INDENT_SPACES 2
 
+/* number of nodes or elements formatted by each worker thread at a time when
+	 writing large nodesets and meshes */
+#define EXPORT_CHUNK_SIZE 2048
+
+/* size of buffer used when writing to file */
+#define EXPORT_FILE_BUFFER_SIZE (4*1024*1024)
+
 /*
 Module types
 ------------
@@ -53,6 +68,9 @@ struct Write_FE_region_element_data
 	enum FE_write_criterion write_criterion;
 	struct FE_field_order_info *field_order_info;
 	struct FE_element *last_element;
+	/* last element whose field header set the output node and scale factor
+		 indices */
+	struct FE_element *header_element;
 	struct FE_region *fe_region;
 	FE_value time;
 }; /* struct Write_FE_region_element_data */
@@ -88,6 +106,75 @@ Module functions
 ----------------
 */
 
+/**
+ * Writes <value> to <output_file> in FE_VALUE_STRING format, optionally
+ * preceded by a space. Formats into a local buffer and writes the characters
+ * unformatted, avoiding the cost of formatted stream insertion per value.
+ */
+static inline void write_FE_value(ostream *output_file, FE_value value,
+	bool leading_space = true)
+{
+	char num_string[64];
+	const int length = leading_space ?
+		snprintf(num_string, sizeof(num_string), " %" FE_VALUE_STRING, value) :
+		snprintf(num_string, sizeof(num_string), "%" FE_VALUE_STRING, value);
+	if (0 < length)
+		output_file->write(num_string, length);
+}
+
+/**
+ * @return  Index of the ostream iword which is non-zero if real values are
+ * written to the stream in binary.
+ */
+static int get_binary_values_iword_index()
+{
+	static const int iword_index = ios_base::xalloc();
+	return iword_index;
+}
+
+/** @return  True if real values are written to <output_file> in binary. */
+static inline bool write_binary_values(ostream *output_file)
+{
+	return 0 != output_file->iword(get_binary_values_iword_index());
+}
+
+/**
+ * Writes the directive marking the remainder of <output_file> as having real
+ * values written in binary, and sets the stream to write them so.
+ */
+static void write_binary_values_directive(ostream *output_file)
+{
+	output_file->iword(get_binary_values_iword_index()) = 1;
+	(*output_file) << " !#binary_values little-endian\n";
+}
+
+/**
+ * Writes <number_of_values> real values to <output_file> as a binary block: a
+ * space and '@' marker followed by the raw values as little-endian IEEE
+ * doubles, then a newline. The reader gets the number of values from the
+ * preceding header.
+ */
+static void write_FE_value_block_binary(ostream *output_file,
+	int number_of_values, const FE_value *values)
+{
+	static_assert(sizeof(FE_value) == sizeof(double),
+		"Binary EX values require double precision FE_value");
+	(*output_file) << " @";
+	if (host_is_little_endian())
+	{
+		output_file->write(reinterpret_cast<const char *>(values),
+			number_of_values*sizeof(FE_value));
+	}
+	else
+	{
+		std::vector<FE_value> swapped_values(values, values + number_of_values);
+		swap_byte_order(swapped_values.data(), swapped_values.size());
+		output_file->write(reinterpret_cast<const char *>(swapped_values.data()),
+			number_of_values*sizeof(FE_value));
+	}
+	(*output_file) << "\n";
+}
+
 static int write_element_xi_value(ostream *output_file,struct FE_element *element,
 	FE_value *xi)
 /*******************************************************************************
@@ -114,11 +201,7 @@ E<lement>/F<ace>/L<ine> ELEMENT_NUMBER DIMENSION xi1 xi2... xiDIMENSION
 			element_char = 'E';
 		(*output_file) << " " << element_char << " " <<  identifier << " " << dimension;
 		for (i = 0; i < dimension; i++)
-		{
-			char num_string[100];
-			sprintf(num_string, " %" FE_VALUE_STRING, xi[i]);
-			(*output_file) << num_string;
-		}
+			write_FE_value(output_file, xi[i]);
 		return_code = 1;
 	}
 	else
@@ -1179,22 +1262,27 @@ Writes grid-based values stored with the element.
 									if (get_FE_element_field_component_grid_FE_value_values(
 										element, field, /*component_number*/i, &values))
 									{
-										/* have new line every number-of-grid-points-in-xi1 */
-										for (j=0;j<number_of_values;j++)
+										if (write_binary_values(output_file))
 										{
-											char num_string[100];
-											sprintf(num_string," %" FE_VALUE_STRING,values[j]);
-											(* output_file) << num_string;
-											if (0==((j+1)%number_of_columns))
+											write_FE_value_block_binary(output_file, number_of_values, values);
+										}
+										else
+										{
+											/* have new line every number-of-grid-points-in-xi1 */
+											for (j=0;j<number_of_values;j++)
+											{
+												write_FE_value(output_file, values[j]);
+												if (0==((j+1)%number_of_columns))
+												{
+													(* output_file) << "\n";
+												}
+											}
+											/* extra newline if not multiple of number_of_columns */
+											if (0 != (number_of_values % number_of_columns))
 											{
 												(* output_file) << "\n";
 											}
 										}
-										/* extra newline if not multiple of number_of_columns */
-										if (0 != (number_of_values % number_of_columns))
-										{
-											(* output_file) << "\n";
-										}
 										DEALLOCATE(values);
 									}
 									else
@@ -1433,7 +1521,23 @@ Notes:
 			if (get_FE_element_number_of_scale_factors(element,
 				&total_number_of_scale_factors))
 			{
-				if (0 < total_number_of_scale_factors)
+				if ((0 < total_number_of_scale_factors) && write_binary_values(output_file))
+				{
+					(*output_file) << " Scale factors:";
+					std::vector<FE_value> scale_factors;
+					scale_factors.reserve(total_number_of_scale_factors);
+					for (i = 0; i < total_number_of_scale_factors; i++)
+					{
+						if (0 <= output_scale_factor_indices[i])
+						{
+							get_FE_element_scale_factor(element, i, &scale_factor);
+							scale_factors.push_back(scale_factor);
+						}
+					}
+					write_FE_value_block_binary(output_file,
+						static_cast<int>(scale_factors.size()), scale_factors.data());
+				}
+				else if (0 < total_number_of_scale_factors)
 				{
 					(*output_file) << " Scale factors:\n";
 					number_of_scale_factors=0;
@@ -1444,9 +1548,7 @@ Notes:
 						{
 							number_of_scale_factors++;
 							get_FE_element_scale_factor(element, i, &scale_factor);
-							char num_string[100];
-							sprintf(num_string, "%" FE_VALUE_STRING, scale_factor);
-							(*output_file) << " " << num_string;
+							write_FE_value(output_file, scale_factor);
 							if ((0<FE_VALUE_MAX_OUTPUT_COLUMNS)&&
 								(0==(number_of_scale_factors%FE_VALUE_MAX_OUTPUT_COLUMNS)))
 							{
@@ -1615,6 +1717,20 @@ static bool FE_elements_have_same_header(
 	return false;
 }
 
+/**
+ * Returns true if a field header must be written before <element> when it
+ * follows <last_element>, which may be NULL if it is the first element.
+ */
+static bool FE_element_has_new_field_header(struct FE_element *element,
+	struct FE_element *last_element, struct FE_field_order_info *field_order_info)
+{
+	if (!last_element)
+		return true;
+	if (get_FE_element_shape(element) != get_FE_element_shape(last_element))
+		return FE_element_has_fields_to_write(element, field_order_info);
+	return !FE_elements_have_same_header(element, last_element, field_order_info);
+}
+
 static int write_FE_region_element(struct FE_element *element,
 	Write_FE_region_element_data *write_elements_data)
 /*******************************************************************************
@@ -1629,7 +1745,7 @@ in the header.
 {
 	ostream *output_file;
 	int return_code;
-	struct FE_element_shape *element_shape, *last_element_shape;
+	struct FE_element_shape *element_shape;
 
 	ENTER(write_FE_region_element);
 	if (element && write_elements_data &&
@@ -1645,28 +1761,13 @@ in the header.
 			element_shape = get_FE_element_shape(element);
 			if (element_shape)
 			{
-				bool new_shape = true;
-				bool new_field_header = true;
-				if (write_elements_data->last_element)
-				{
-					last_element_shape = get_FE_element_shape(write_elements_data->last_element);
-					new_shape = (element_shape != last_element_shape);
-					if (new_shape)
-					{
-						new_field_header = FE_element_has_fields_to_write(element,
-							write_elements_data->field_order_info);
-					}
-					else
-					{
-						new_field_header = !FE_elements_have_same_header(element,
-							write_elements_data->last_element, write_elements_data->field_order_info);
-					}
-				}
-				if (new_shape)
+				if ((!write_elements_data->last_element) ||
+					(element_shape != get_FE_element_shape(write_elements_data->last_element)))
 				{
 					write_FE_element_shape(output_file, element_shape);
 				}
-				if (new_field_header)
+				if (FE_element_has_new_field_header(element, write_elements_data->last_element,
+					write_elements_data->field_order_info))
 				{
 					write_FE_element_field_info(output_file, element,
 						write_elements_data->field_order_info,
@@ -1674,6 +1775,8 @@ in the header.
 						&(write_elements_data->output_node_indices),
 						&(write_elements_data->output_number_of_scale_factors),
 						&(write_elements_data->output_scale_factor_indices));
+					if (0 < get_FE_element_number_of_fields(element))
+						write_elements_data->header_element = element;
 				}
 				write_FE_element(output_file, element,
 					write_elements_data->field_order_info,
@@ -1873,24 +1976,28 @@ Writes out the nodal values. Each component or version starts on a new line.
 					if (get_FE_nodal_field_FE_value_values(field,node,&number_of_values,
 							values_data->time, &values))
 					{
-						value=values;
-						for (i=0;i<number_of_components;i++)
+						if (write_binary_values(output_file))
 						{
-							number_of_versions=
-								get_FE_node_field_component_number_of_versions(node,field,i);
-							number_of_derivatives=
-								get_FE_node_field_component_number_of_derivatives(node,field,i);
-							for (j=number_of_versions;0<j;j--)
+							write_FE_value_block_binary(output_file, number_of_values, values);
+						}
+						else
+						{
+							value=values;
+							for (i=0;i<number_of_components;i++)
 							{
-								for (k=0;k<=number_of_derivatives;k++)
+								number_of_versions=
+									get_FE_node_field_component_number_of_versions(node,field,i);
+								number_of_derivatives=
+									get_FE_node_field_component_number_of_derivatives(node,field,i);
+								for (j=number_of_versions;0<j;j--)
 								{
-									char num_string[100];
-									sprintf(num_string, "%" FE_VALUE_STRING, *value);
-
-									(*output_file) << " " << num_string;
-									value++;
+									for (k=0;k<=number_of_derivatives;k++)
+									{
+										write_FE_value(output_file, *value);
+										value++;
+									}
+									(*output_file) << "\n";
 								}
-								(*output_file) << "\n";
 							}
 						}
 						DEALLOCATE(values);
@@ -2277,6 +2384,302 @@ has been selected for output) then the header is written out.
 	return (return_code);
 }
 
+/**
+ * Returns the number of threads to format large nodesets and meshes with:
+ * the value of environment variable CMZN_EXPORT_THREADS if set, otherwise the
+ * number of hardware threads. Fewer than 2 means write serially.
+ */
+static unsigned int get_export_number_of_threads()
+{
+	const char *threads_string = getenv("CMZN_EXPORT_THREADS");
+	if (threads_string)
+	{
+		const int number_of_threads = atoi(threads_string);
+		return (0 < number_of_threads) ? static_cast<unsigned int>(number_of_threads) : 1;
+	}
+	return std::thread::hardware_concurrency();
+}
+
+/**
+ * Writes nodes <start> to <end>-1 of <nodes> to <chunk_string>, comparing the
+ * header of the first with <last_node>, the last node before the chunk which
+ * passes the write criterion. Output is identical to writing the nodes
+ * serially. Must only be called from a worker thread with a field order built
+ * on the calling thread: without it, fields are iterated with
+ * for_each_FE_field_at_node_alphabetical_indexer_priority, which creates a
+ * field order and accesses the shared fields on each call. Otherwise nodal
+ * values are only read; time-varying values held in a paged
+ * FE_time_series_store page blocks in and out, which the store locks.
+ */
+static int write_FE_region_node_chunk(FE_node **nodes, int start, int end,
+	FE_node *last_node, Write_FE_region_node_data write_nodes_data,
+	std::string *chunk_string)
+{
+	ostringstream chunk_stream;
+	chunk_stream.iword(get_binary_values_iword_index()) =
+		write_nodes_data.output_file->iword(get_binary_values_iword_index());
+	write_nodes_data.output_file = &chunk_stream;
+	write_nodes_data.last_node = last_node;
+	int return_code = 1;
+	for (int i = start; (i < end) && return_code; ++i)
+	{
+		if (!write_FE_region_node(nodes[i], &write_nodes_data))
+			return_code = 0;
+	}
+	*chunk_string = chunk_stream.str();
+	return return_code;
+}
+
+/**
+ * Writes all nodes in <nodeset>. Large nodesets are formatted in contiguous
+ * chunks on worker threads, each into its own buffer, with buffers written to
+ * the output in identifier order so output is identical to serial writing.
+ * Writes serially if no field order is supplied, or if CMZN_EXPORT_THREADS
+ * or the hardware gives fewer than 2 threads.
+ * Caller must ensure the region is not modified while writing.
+ */
+static int write_FE_region_nodes(cmzn_nodeset_id nodeset,
+	Write_FE_region_node_data *write_nodes_data)
+{
+	std::vector<FE_node *> nodes;
+	nodes.reserve(cmzn_nodeset_get_size(nodeset));
+	cmzn_nodeiterator_id iter = cmzn_nodeset_create_nodeiterator(nodeset);
+	cmzn_node_id node = 0;
+	while (0 != (node = cmzn_nodeiterator_next_non_access(iter)))
+		nodes.push_back(node);
+	cmzn_nodeiterator_destroy(&iter);
+	const int number_of_nodes = static_cast<int>(nodes.size());
+	const unsigned int number_of_threads = get_export_number_of_threads();
+	int return_code = 1;
+	// worker threads must only read the field order, so it must be supplied
+	if ((number_of_threads < 2) || (number_of_nodes < 2*EXPORT_CHUNK_SIZE) ||
+		(!write_nodes_data->field_order_info))
+	{
+		for (int i = 0; i < number_of_nodes; ++i)
+		{
+			if (!write_FE_region_node(nodes[i], write_nodes_data))
+			{
+				return_code = 0;
+				break;
+			}
+		}
+		return return_code;
+	}
+	// get last node written before each chunk, for comparing headers
+	const int number_of_chunks = (number_of_nodes + EXPORT_CHUNK_SIZE - 1)/EXPORT_CHUNK_SIZE;
+	std::vector<FE_node *> chunk_last_nodes(number_of_chunks + 1);
+	for (int i = 0; i < number_of_nodes; ++i)
+	{
+		if (0 == (i % EXPORT_CHUNK_SIZE))
+			chunk_last_nodes[i/EXPORT_CHUNK_SIZE] = write_nodes_data->last_node;
+		if (FE_node_passes_write_criterion(nodes[i], write_nodes_data->write_criterion,
+				write_nodes_data->field_order_info))
+			write_nodes_data->last_node = nodes[i];
+	}
+	std::vector<std::string> chunk_strings(number_of_threads);
+	std::vector<std::future<int> > futures(number_of_threads);
+	std::vector<int> chunk_results(number_of_threads);
+	for (int batch_chunk = 0; (batch_chunk < number_of_chunks) && return_code;
+		batch_chunk += number_of_threads)
+	{
+		unsigned int batch_size = 0;
+		for (; (batch_size < number_of_threads) && (batch_chunk + static_cast<int>(batch_size) < number_of_chunks);
+			++batch_size)
+		{
+			const int chunk = batch_chunk + batch_size;
+			const int start = chunk*EXPORT_CHUNK_SIZE;
+			const int end = (start + EXPORT_CHUNK_SIZE < number_of_nodes) ?
+				start + EXPORT_CHUNK_SIZE : number_of_nodes;
+			try
+			{
+				futures[batch_size] = std::async(std::launch::async, write_FE_region_node_chunk,
+					nodes.data(), start, end, chunk_last_nodes[chunk], *write_nodes_data,
+					&(chunk_strings[batch_size]));
+			}
+			catch (const std::system_error&)
+			{
+				// could not start thread: format chunk on this thread
+				chunk_results[batch_size] = write_FE_region_node_chunk(nodes.data(), start, end,
+					chunk_last_nodes[chunk], *write_nodes_data, &(chunk_strings[batch_size]));
+			}
+		}
+		for (unsigned int c = 0; c < batch_size; ++c)
+		{
+			if (futures[c].valid())
+				chunk_results[c] = futures[c].get();
+		}
+		for (unsigned int c = 0; (c < batch_size) && return_code; ++c)
+		{
+			write_nodes_data->output_file->write(chunk_strings[c].data(), chunk_strings[c].size());
+			if (!chunk_results[c])
+				return_code = 0;
+		}
+	}
+	return return_code;
+}
+
+/**
+ * Writes elements <start> to <end>-1 of <elements> to <chunk_string>, with
+ * header output determined from <last_element>, the last element before the
+ * chunk which passes the write criterion, and output node and scale factor
+ * indices rebuilt from <header_element>, the last element before the chunk
+ * whose field header set them. Output is identical to writing the elements
+ * serially. As for write_FE_region_node_chunk, must only be called from a
+ * worker thread with a field order built on the calling thread.
+ */
+static int write_FE_region_element_chunk(FE_element **elements, int start, int end,
+	FE_element *last_element, FE_element *header_element,
+	Write_FE_region_element_data write_elements_data, std::string *chunk_string)
+{
+	write_elements_data.output_number_of_nodes = 0;
+	write_elements_data.output_node_indices = (int *)NULL;
+	write_elements_data.output_number_of_scale_factors = 0;
+	write_elements_data.output_scale_factor_indices = (int *)NULL;
+	write_elements_data.last_element = last_element;
+	write_elements_data.header_element = header_element;
+	int return_code = 1;
+	if (header_element)
+	{
+		ostringstream discard_stream;
+		return_code = write_FE_element_field_info(&discard_stream, header_element,
+			write_elements_data.field_order_info,
+			&(write_elements_data.output_number_of_nodes),
+			&(write_elements_data.output_node_indices),
+			&(write_elements_data.output_number_of_scale_factors),
+			&(write_elements_data.output_scale_factor_indices));
+	}
+	ostringstream chunk_stream;
+	chunk_stream.iword(get_binary_values_iword_index()) =
+		write_elements_data.output_file->iword(get_binary_values_iword_index());
+	write_elements_data.output_file = &chunk_stream;
+	for (int i = start; (i < end) && return_code; ++i)
+	{
+		if (!write_FE_region_element(elements[i], &write_elements_data))
+			return_code = 0;
+	}
+	DEALLOCATE(write_elements_data.output_node_indices);
+	DEALLOCATE(write_elements_data.output_scale_factor_indices);
+	*chunk_string = chunk_stream.str();
+	return return_code;
+}
+
+/**
+ * Writes all elements in <mesh>. Large meshes are formatted in contiguous
+ * chunks on worker threads, each into its own buffer, with buffers written to
+ * the output in identifier order so output is identical to serial writing.
+ * Writes serially if no field order is supplied, or if CMZN_EXPORT_THREADS
+ * or the hardware gives fewer than 2 threads.
+ * Caller must ensure the region is not modified while writing.
+ */
+static int write_FE_region_elements(cmzn_mesh_id mesh,
+	Write_FE_region_element_data *write_elements_data)
+{
+	std::vector<FE_element *> elements;
+	elements.reserve(cmzn_mesh_get_size(mesh));
+	cmzn_elementiterator_id iter = cmzn_mesh_create_elementiterator(mesh);
+	cmzn_element_id element = 0;
+	while (0 != (element = cmzn_elementiterator_next_non_access(iter)))
+		elements.push_back(element);
+	cmzn_elementiterator_destroy(&iter);
+	const int number_of_elements = static_cast<int>(elements.size());
+	const unsigned int number_of_threads = get_export_number_of_threads();
+	int return_code = 1;
+	// worker threads must only read the field order, so it must be supplied
+	if ((number_of_threads < 2) || (number_of_elements < 2*EXPORT_CHUNK_SIZE) ||
+		(!write_elements_data->field_order_info))
+	{
+		for (int i = 0; i < number_of_elements; ++i)
+		{
+			if (!write_FE_region_element(elements[i], write_elements_data))
+			{
+				return_code = 0;
+				break;
+			}
+		}
+		return return_code;
+	}
+	// get last element written and element whose header set the output indices
+	// before each chunk, replicating header logic in write_FE_region_element
+	const int number_of_chunks = (number_of_elements + EXPORT_CHUNK_SIZE - 1)/EXPORT_CHUNK_SIZE;
+	std::vector<FE_element *> chunk_last_elements(number_of_chunks);
+	std::vector<FE_element *> chunk_header_elements(number_of_chunks);
+	FE_element *last_element = write_elements_data->last_element;
+	FE_element *header_element = write_elements_data->header_element;
+	for (int i = 0; i < number_of_elements; ++i)
+	{
+		if (0 == (i % EXPORT_CHUNK_SIZE))
+		{
+			chunk_last_elements[i/EXPORT_CHUNK_SIZE] = last_element;
+			chunk_header_elements[i/EXPORT_CHUNK_SIZE] = header_element;
+		}
+		if (FE_element_passes_write_criterion(elements[i], write_elements_data->fe_region,
+			write_elements_data->write_criterion, write_elements_data->field_order_info))
+		{
+			if (FE_element_has_new_field_header(elements[i], last_element,
+					write_elements_data->field_order_info) &&
+				(0 < get_FE_element_number_of_fields(elements[i])))
+			{
+				header_element = elements[i];
+			}
+			last_element = elements[i];
+		}
+	}
+	std::vector<std::string> chunk_strings(number_of_threads);
+	std::vector<std::future<int> > futures(number_of_threads);
+	std::vector<int> chunk_results(number_of_threads);
+	for (int batch_chunk = 0; (batch_chunk < number_of_chunks) && return_code;
+		batch_chunk += number_of_threads)
+	{
+		unsigned int batch_size = 0;
+		for (; (batch_size < number_of_threads) && (batch_chunk + static_cast<int>(batch_size) < number_of_chunks);
+			++batch_size)
+		{
+			const int chunk = batch_chunk + batch_size;
+			const int start = chunk*EXPORT_CHUNK_SIZE;
+			const int end = (start + EXPORT_CHUNK_SIZE < number_of_elements) ?
+				start + EXPORT_CHUNK_SIZE : number_of_elements;
+			try
+			{
+				futures[batch_size] = std::async(std::launch::async, write_FE_region_element_chunk,
+					elements.data(), start, end, chunk_last_elements[chunk], chunk_header_elements[chunk],
+					*write_elements_data, &(chunk_strings[batch_size]));
+			}
+			catch (const std::system_error&)
+			{
+				// could not start thread: format chunk on this thread
+				chunk_results[batch_size] = write_FE_region_element_chunk(elements.data(), start, end,
+					chunk_last_elements[chunk], chunk_header_elements[chunk],
+					*write_elements_data, &(chunk_strings[batch_size]));
+			}
+		}
+		for (unsigned int c = 0; c < batch_size; ++c)
+		{
+			if (futures[c].valid())
+				chunk_results[c] = futures[c].get();
+		}
+		for (unsigned int c = 0; (c < batch_size) && return_code; ++c)
+		{
+			write_elements_data->output_file->write(chunk_strings[c].data(), chunk_strings[c].size());
+			if (!chunk_results[c])
+				return_code = 0;
+		}
+	}
+	// leave state as after serial writing, for writing further meshes
+	write_elements_data->last_element = last_element;
+	if (header_element != write_elements_data->header_element)
+	{
+		ostringstream discard_stream;
+		write_FE_element_field_info(&discard_stream, header_element,
+			write_elements_data->field_order_info,
+			&(write_elements_data->output_number_of_nodes),
+			&(write_elements_data->output_node_indices),
+			&(write_elements_data->output_number_of_scale_factors),
+			&(write_elements_data->output_scale_factor_indices));
+		write_elements_data->header_element = header_element;
+	}
+	return return_code;
+}
+
 static int write_cmzn_region_content(ostream *output_file,
 	struct cmzn_region *region, cmzn_field_group_id group,
 	int write_elements, int write_nodes, int write_data,
@@ -2371,17 +2774,8 @@ FE_WRITE_WITH_ANY_LISTED_FIELDS =
 					if (nodeset && (cmzn_nodeset_get_size(nodeset) > 0))
 					{
 						(*output_file) << " !#nodeset datapoints\n";
-						cmzn_nodeiterator_id iter = cmzn_nodeset_create_nodeiterator(nodeset);
-						cmzn_node_id node = 0;
-						while (0 != (node = cmzn_nodeiterator_next_non_access(iter)))
-						{
-							if (!write_FE_region_node(node, &write_nodes_data))
-							{
-								return_code = 0;
-								break;
-							}
-						}
-						cmzn_nodeiterator_destroy(&iter);
+						if (!write_FE_region_nodes(nodeset, &write_nodes_data))
+							return_code = 0;
 						cmzn_nodeset_destroy(&nodeset);
 					}
 				}
@@ -2400,17 +2794,8 @@ FE_WRITE_WITH_ANY_LISTED_FIELDS =
 					if (nodeset && (cmzn_nodeset_get_size(nodeset) > 0))
 					{
 						(*output_file) << " !#nodeset nodes\n";
-						cmzn_nodeiterator_id iter = cmzn_nodeset_create_nodeiterator(nodeset);
-						cmzn_node_id node = 0;
-						while (0 != (node = cmzn_nodeiterator_next_non_access(iter)))
-						{
-							if (!write_FE_region_node(node, &write_nodes_data))
-							{
-								return_code = 0;
-								break;
-							}
-						}
-						cmzn_nodeiterator_destroy(&iter);
+						if (!write_FE_region_nodes(nodeset, &write_nodes_data))
+							return_code = 0;
 						cmzn_nodeset_destroy(&nodeset);
 					}
 				}
@@ -2427,6 +2812,7 @@ FE_WRITE_WITH_ANY_LISTED_FIELDS =
 				write_elements_data.field_order_info = field_order_info;
 				write_elements_data.fe_region = fe_region;
 				write_elements_data.last_element = (struct FE_element *)NULL;
+				write_elements_data.header_element = (struct FE_element *)NULL;
 				write_elements_data.time = time;
 				int highest_dimension = FE_region_get_highest_dimension(fe_region);
 				if (0 >= highest_dimension)
@@ -2450,17 +2836,8 @@ FE_WRITE_WITH_ANY_LISTED_FIELDS =
 						}
 						if (mesh)
 						{
-							cmzn_elementiterator_id iter = cmzn_mesh_create_elementiterator(mesh);
-							cmzn_element_id element = 0;
-							while (0 != (element = cmzn_elementiterator_next_non_access(iter)))
-							{
-								if (!write_FE_region_element(element, &write_elements_data))
-								{
-									return_code = 0;
-									break;
-								}
-							}
-							cmzn_elementiterator_destroy(&iter);
+							if (!write_FE_region_elements(mesh, &write_elements_data))
+								return_code = 0;
 							cmzn_mesh_destroy(&mesh);
 						}
 					}
@@ -2821,16 +3198,22 @@ int write_exregion_file_of_name(const char *file_name,
 	enum FE_write_fields_mode write_fields_mode,
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
-	enum cmzn_streaminformation_region_recursion_mode recursion_mode)
+	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
+	bool binary_values)
 {
 	int return_code;
 
 	if (file_name)
 	{
+		// large buffer reduces number of writes; must be set before opening
+		std::vector<char> file_buffer(EXPORT_FILE_BUFFER_SIZE);
 		ofstream output_file;
-		output_file.open(file_name, ios::out);
+		output_file.rdbuf()->pubsetbuf(file_buffer.data(), file_buffer.size());
+		output_file.open(file_name, binary_values ? (ios::out | ios::binary) : ios::out);
 		if (output_file.is_open())
 		{
+			if (binary_values)
+				write_binary_values_directive(&output_file);
 			return_code = write_exregion_to_stream(&output_file, region, group_name, root_region,
 				write_elements, write_nodes, write_data,
 				write_fields_mode, number_of_field_names, field_names, time,
@@ -2862,7 +3245,7 @@ int write_exregion_file_to_memory_block(
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
 	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
-	void **memory_block, unsigned int *memory_block_length)
+	bool binary_values, void **memory_block, unsigned int *memory_block_length)
 {
 	int return_code;
 
@@ -2872,13 +3255,24 @@ int write_exregion_file_to_memory_block(
 		ostringstream stringStream;
 		if (stringStream)
 		{
+			if (binary_values)
+				write_binary_values_directive(&stringStream);
 			return_code = write_exregion_to_stream(&stringStream, region, group_name, root_region,
 				write_elements, write_nodes, write_data,
 				write_fields_mode, number_of_field_names, field_names, time,
 				write_criterion, recursion_mode);
 			string sstring = stringStream.str();
 			*memory_block_length = sstring.size();
-			*memory_block = duplicate_string(sstring.c_str());
+			// copy with length as binary values may contain null characters
+			char *block;
+			if (ALLOCATE(block, char, sstring.size() + 1))
+			{
+				memcpy(block, sstring.data(), sstring.size());
+				block[sstring.size()] = '\0';
+			}
+			else
+				return_code = 0;
+			*memory_block = block;
 		}
 		else
 		{
@@ -74,6 +74,9 @@ PROTOTYPE_ENUMERATOR_FUNCTIONS(FE_write_recursion);
  * @param group  Optional subgroup to output.
  * @param root_region  The root region output paths are relative to.
  * @param file_name  Name of file. 
+ * @param binary_values  If true, write real node parameters, element scale
+ * factors and grid values as raw little-endian binary blocks, preceded by a
+ * directive telling the reader to expect them.
  * @see write_exregion_to_stream.
  */
 int write_exregion_file_of_name(const char *file_name,
@@ -83,8 +86,13 @@ int write_exregion_file_of_name(const char *file_name,
 	enum FE_write_fields_mode write_fields_mode,
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
-	enum cmzn_streaminformation_region_recursion_mode recursion_mode);
+	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
+	bool binary_values);
 
+/**
+ * Version of write_exregion_file_of_name writing to a newly allocated memory
+ * block, which is null terminated but may contain nulls if binary_values.
+ */
 int write_exregion_file_to_memory_block(
 	struct cmzn_region *region, const char *group_name,
 	struct cmzn_region *root_region, int write_elements,
@@ -93,6 +101,6 @@ int write_exregion_file_to_memory_block(
 	int number_of_field_names, char **field_names, FE_value time,
 	enum FE_write_criterion write_criterion,
 	enum cmzn_streaminformation_region_recursion_mode recursion_mode,
-	void **memory_block, unsigned int *memory_block_length);
+	bool binary_values, void **memory_block, unsigned int *memory_block_length);
 
 #endif /* !defined (EXPORT_FINITE_ELEMENT_H) */
@@ -27,6 +27,7 @@
 #include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_private.h"
 #include "finite_element/finite_element_region_private.h"
+#include "finite_element/finite_element_time_series_store.hpp"
 #include "general/change_log_private.h"
 #include "general/compare.h"
 #include "general/debug.h"
@@ -1160,6 +1161,49 @@ for time depedant types, a pointer to the values.
 	return (size);
 } /* get_Value_storage_size */
 
+/**
+ * Get real value at time index from storage holding array of values at all
+ * times of the sequence, or slot in its paged store.
+ */
+static inline FE_value get_FE_value_storage_time_value(Value_storage *values_storage,
+	struct FE_time_sequence *time_sequence, int time_index)
+{
+	FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence);
+	if (paged_store)
+		return paged_store->getValue(FE_time_series_store::getValueStorageSlot(values_storage), time_index);
+	return (*((FE_value **)values_storage))[time_index];
+}
+
+/**
+ * Get real value interpolated between two time indexes from storage holding
+ * array of values at all times of the sequence, or slot in its paged store.
+ */
+static inline FE_value get_FE_value_storage_interpolated_time_value(Value_storage *values_storage,
+	struct FE_time_sequence *time_sequence, int time_index_one, int time_index_two, FE_value xi)
+{
+	FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence);
+	if (paged_store)
+		return paged_store->getInterpolatedValue(FE_time_series_store::getValueStorageSlot(values_storage),
+			time_index_one, time_index_two, xi);
+	const FE_value *array = *((FE_value **)values_storage);
+	return (1.0 - xi)*array[time_index_one] + xi*array[time_index_two];
+}
+
+/**
+ * Set real value at time index in storage holding array of values at all
+ * times of the sequence, or slot in its paged store.
+ * @return  1 on success, 0 on failure.
+ */
+static inline int set_FE_value_storage_time_value(Value_storage *values_storage,
+	struct FE_time_sequence *time_sequence, int time_index, FE_value value)
+{
+	FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence);
+	if (paged_store)
+		return paged_store->setValue(FE_time_series_store::getValueStorageSlot(values_storage), time_index, value) ? 1 : 0;
+	(*((FE_value **)values_storage))[time_index] = value;
+	return 1;
+}
+
 static int free_value_storage_array(Value_storage *values_storage,
 	enum Value_type value_type, struct FE_time_sequence *time_sequence,
 	int number_of_values)
@@ -1202,11 +1246,20 @@ Only certain value types, eg. arrays, strings, element_xi require this.
 				case FE_VALUE_VALUE:
 				{
 					FE_value **array_address;
+					FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence);
 
 					for (i=0;i<number_of_values;i++)
 					{
-						array_address = (FE_value **)the_values_storage;
-						DEALLOCATE(*array_address);
+						if (paged_store)
+						{
+							paged_store->releaseSlot(FE_time_series_store::getValueStorageSlot(the_values_storage));
+							FE_time_series_store::setValueStorageSlot(the_values_storage, -1);
+						}
+						else
+						{
+							array_address = (FE_value **)the_values_storage;
+							DEALLOCATE(*array_address);
+						}
 						the_values_storage += size;
 					}
 				} break;
@@ -1717,13 +1770,36 @@ in memory. If pointers weren't DWORD aligned get bus errors on SGIs.
 					case FE_VALUE_VALUE:
 					{
 						FE_value *dest_array,*source_array,**array_address;
-						/* get address of array from source */
-						array_address = (FE_value **)source;
-						source_array = *array_address;
-						array_address = (FE_value **)dest;
-						dest_array = *array_address;
-						dest_array[destination_time_index] =
-							source_array[source_time_index];
+						FE_value value;
+						FE_time_series_store *paged_store =
+							FE_time_sequence_get_paged_store(source_time_sequence);
+						if (paged_store)
+						{
+							value = paged_store->getValue(
+								FE_time_series_store::getValueStorageSlot(source), source_time_index);
+						}
+						else
+						{
+							/* get address of array from source */
+							array_address = (FE_value **)source;
+							source_array = *array_address;
+							value = source_array[source_time_index];
+						}
+						paged_store = FE_time_sequence_get_paged_store(destination_time_sequence);
+						if (paged_store)
+						{
+							if (!paged_store->setValue(FE_time_series_store::getValueStorageSlot(dest),
+								destination_time_index, value))
+							{
+								return_code = 0;
+							}
+						}
+						else
+						{
+							array_address = (FE_value **)dest;
+							dest_array = *array_address;
+							dest_array[destination_time_index] = value;
+						}
 					} break;
 					case FLT_VALUE:
 					{
@@ -1879,6 +1955,13 @@ in memory. If pointers weren't DWORD aligned get bus errors on SGIs.
 		return_code = 1;
 		number_of_times = FE_time_sequence_get_number_of_times(
 			destination_time_sequence);
+		FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(destination_time_sequence);
+		if (paged_store && (value_type != FE_VALUE_VALUE))
+		{
+			display_message(ERROR_MESSAGE, "allocate_time_values_storage_array.  "
+				"Paged time sequence storage is only implemented for real values");
+			return 0;
+		}
 		/* Allocate the array */
 		switch (value_type)
 		{
@@ -1909,8 +1992,23 @@ in memory. If pointers weren't DWORD aligned get bus errors on SGIs.
 			case FE_VALUE_VALUE:
 			{
 				FE_value *dest_array,**array_address;
+				if (paged_store)
+				{
+					/* slot index is stored in place of array pointer */
+					const int slot = paged_store->allocateSlot(number_of_times, (0 != initialise_storage));
+					if (0 <= slot)
+					{
+						FE_time_series_store::setValueStorageSlot(dest, slot);
+					}
+					else
+					{
+						display_message(ERROR_MESSAGE,
+							"allocate_time_values_storage_array. Could not allocate paged storage");
+						return_code = 0;
+					}
+				}
 				/* allocate the dest array */
-				if (ALLOCATE(dest_array,FE_value,number_of_times))
+				else if (ALLOCATE(dest_array,FE_value,number_of_times))
 				{
 					if (initialise_storage)
 					{
@@ -2232,11 +2330,21 @@ to destination in certain cases instead of copied; only call from merge_FE_node.
 					case FE_TIME_SEQUENCE_MAPPING_APPEND:
 					{
 						destination_number_of_times = FE_time_sequence_get_number_of_times(destination_time_sequence);
+						/* paged sequences only map if identical and sharing store */
+						const bool paged = (0 != FE_time_sequence_get_paged_store(destination_time_sequence));
 						for (i=0;(i<number_of_values)&&return_code;i++)
 						{
-							reallocate_time_values_storage_array(value_type,
-								destination_number_of_times, dest, src,
-								/*initialise_storage*/0, /*previous_number_of_values*/0);
+							if (paged)
+							{
+								/* transfer slot index */
+								*(void **)dest = *(void **)src;
+							}
+							else
+							{
+								reallocate_time_values_storage_array(value_type,
+									destination_number_of_times, dest, src,
+									/*initialise_storage*/0, /*previous_number_of_values*/0);
+							}
 							*(void **)src = 0x0;
 							dest += value_size;
 							src += value_size;
@@ -2244,6 +2352,42 @@ to destination in certain cases instead of copied; only call from merge_FE_node.
 					} break;
 					default:
 					{
+						FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(destination_time_sequence);
+						if (paged_store && (source_time_sequence == destination_time_sequence))
+						{
+							/* copy all slots one time block at a time */
+							std::vector<int> source_slots(number_of_values), destination_slots(number_of_values);
+							for (i=0;(i<number_of_values)&&return_code;i++)
+							{
+								if (allocate_time_values_storage_array(value_type,
+									destination_time_sequence,dest,/*initialise_storage*/0))
+								{
+									source_slots[i] = FE_time_series_store::getValueStorageSlot(src);
+									destination_slots[i] = FE_time_series_store::getValueStorageSlot(dest);
+								}
+								else
+								{
+									if (0<i)
+									{
+										free_value_storage_array(destination,value_type,
+											destination_time_sequence,i);
+									}
+									return_code = 0;
+								}
+								dest += value_size;
+								src += value_size;
+							}
+							if (return_code && !paged_store->copySlots(number_of_values,
+								source_slots.data(), destination_slots.data()))
+							{
+								display_message(ERROR_MESSAGE,
+									"copy_value_storage_array.  Failed to copy paged values");
+								free_value_storage_array(destination,value_type,
+									destination_time_sequence,number_of_values);
+								return_code = 0;
+							}
+							break;
+						}
 						/* Fallback default implementation */
 						for (i=0;(i<number_of_values)&&return_code;i++)
 						{
@@ -4160,6 +4304,17 @@ int FE_node_field_info_clear_FE_nodeset(
 	return 0;
 }
 
+int FE_node_field_info_set_FE_nodeset(
+	struct FE_node_field_info *node_field_info, void *fe_nodeset_void)
+{
+	if (node_field_info && fe_nodeset_void)
+	{
+		node_field_info->fe_nodeset = static_cast<FE_nodeset *>(fe_nodeset_void);
+		return 1;
+	}
+	return 0;
+}
+
 int FE_node_field_info_has_FE_field(
 	struct FE_node_field_info *node_field_info, void *fe_field_void)
 /*******************************************************************************
@@ -5245,7 +5400,8 @@ static int list_FE_node_field(struct FE_node *node, struct FE_field *field,
 											case FE_VALUE_VALUE:
 											{
 												display_message(INFORMATION_MESSAGE,"%g",
-													*(*((FE_value**)values_storage) + time_index));
+													get_FE_value_storage_time_value(values_storage,
+														node_field->time_sequence, time_index));
 											} break;
 											case INT_VALUE:
 											{
@@ -5488,6 +5644,7 @@ public:
 	FE_node_field_component *nodeFieldComponent;
 	// cache time sequence and indexes as requires binary search to find
 	FE_time_sequence *timeSequence;
+	FE_time_series_store *pagedStore;
 	int timeIndex1, timeIndex2;
 	FE_value timeXi;
 	// cache element node scale information to save lookups
@@ -5506,6 +5663,7 @@ public:
 		nodeFieldInfo(0),
 		nodeFieldComponent(0),
 		timeSequence(0),
+		pagedStore(0),
 		scaleFactors(0),
 		numberOfScaleFactors(0)
 	{
@@ -5532,6 +5690,7 @@ public:
 		if (timeSequenceIn != this->timeSequence)
 		{
 			this->timeSequence = timeSequenceIn;
+			this->pagedStore = FE_time_sequence_get_paged_store(this->timeSequence);
 			if (this->timeSequence)
 			{
 				FE_time_sequence_get_interpolation_for_time(this->timeSequence,
@@ -5745,7 +5904,14 @@ public:
 			}
 			scaleFactor *= cache.scaleFactors[this->scaleFactorIndex];
 		}
-		if (cache.timeSequence)
+		if (cache.pagedStore)
+		{
+			value = scaleFactor*cache.pagedStore->getInterpolatedValue(
+				FE_time_series_store::getValueStorageSlot(
+					reinterpret_cast<Value_storage *>(static_cast<FE_value **>(nodeValues) + valueIndex)),
+				cache.timeIndex1, cache.timeIndex2, cache.timeXi);
+		}
+		else if (cache.timeSequence)
 		{
 			FE_value *array = *((static_cast<FE_value **>(nodeValues) + valueIndex));
 			value = scaleFactor*(
@@ -6195,9 +6361,9 @@ static int global_to_element_map_values(struct FE_element *element,
 												{
 													if (time_sequence)
 													{
-														fe_value_array = *((static_cast<FE_value **>(global_values) + value_index));
-														*element_value = (1.0 - time_xi)*fe_value_array[time_index_one]
-															+ time_xi*fe_value_array[time_index_two];
+														*element_value = get_FE_value_storage_interpolated_time_value(
+															reinterpret_cast<Value_storage *>(static_cast<FE_value **>(global_values) + value_index),
+															time_sequence, time_index_one, time_index_two, time_xi);
 													}
 													else
 													{
@@ -10352,6 +10518,9 @@ PROTOTYPE_ENUMERATOR_STRING_FUNCTION(cmzn_element_quadrature_rule)
 		case CMZN_ELEMENT_QUADRATURE_RULE_MIDPOINT:
 			return "midpoint_quadrature";
 			break;
+		case CMZN_ELEMENT_QUADRATURE_RULE_ADAPTIVE:
+			return "adaptive_quadrature";
+			break;
 		case CMZN_ELEMENT_QUADRATURE_RULE_INVALID:
 			break;
 	}
@@ -12487,9 +12656,20 @@ and <component_number> at the <node> and <time>. \
 					{ \
 						FE_time_sequence_get_interpolation_for_time(time_sequence, \
 							time, &time_index_one, &time_index_two, &xi); \
+						FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence); \
+						if (paged_store) \
+						{ \
+							/* only real values are paged */ \
+							*value = (value_type)paged_store->getInterpolatedValue( \
+								FE_time_series_store::getValueStorageSlot(values_storage), \
+								time_index_one, time_index_two, xi); \
+						} \
+						else \
+						{ \
 				   array = *((value_type **)values_storage); \
 			   *value = (value_type)(array[time_index_one] * (1.0 - xi) + \
 						  array[time_index_two] * xi); \
+						} \
 					} \
 					else \
 					{ \
@@ -12569,9 +12749,20 @@ and <component_number> at the <node>. \
 			{ \
 				if (FE_time_sequence_get_index_for_time(time_sequence, time, &time_index)) \
 				{ \
-					array = *((value_type **)values_storage); \
-					array[time_index] = value; \
-					return_code = 1; \
+					FE_time_series_store *paged_store = FE_time_sequence_get_paged_store(time_sequence); \
+					if (paged_store) \
+					{ \
+						/* only real values are paged */ \
+						return_code = paged_store->setValue( \
+							FE_time_series_store::getValueStorageSlot(values_storage), \
+							time_index, static_cast<FE_value>(value)) ? 1 : 0; \
+					} \
+					else \
+					{ \
+						array = *((value_type **)values_storage); \
+						array[time_index] = value; \
+						return_code = 1; \
+					} \
 				} \
 			   else \
 				{ \
@@ -12633,7 +12824,13 @@ it should only be used temporarily. \
 		if (find_FE_nodal_values_storage_dest(node,field,component_number, \
 		 version,type, value_enum,&values_storage,&time_sequence)) \
 		{ \
-			if (time_sequence) \
+			if (FE_time_sequence_get_paged_store(time_sequence)) \
+			{ \
+				display_message(ERROR_MESSAGE,"get_FE_nodal_" #value_type "_storage.  " \
+					"Values are not held in memory for paged time sequence"); \
+				return_code=0; \
+			} \
+			else if (time_sequence) \
 			{ \
 				if (FE_time_sequence_get_index_for_time(time_sequence, time, &time_index)) \
 				{ \
@@ -14029,14 +14226,15 @@ int get_FE_nodal_field_FE_value_values(struct FE_field *field,
 						{
 							if (time_sequence)
 							{
-								source = *(FE_value **)(the_value_storage);
 								if (xi != 0 && time_index_one != time_index_two)
 								{
-									*dest = source[time_index_one]*(1.0 - xi) + source[time_index_two]*xi;
+									*dest = get_FE_value_storage_interpolated_time_value(the_value_storage,
+										time_sequence, time_index_one, time_index_two, xi);
 								}
 								else
 								{
-									*dest = source[time_index_one];
+									*dest = get_FE_value_storage_time_value(the_value_storage,
+										time_sequence, time_index_one);
 								}
 								dest++;
 								the_value_storage += size;
@@ -14126,7 +14324,8 @@ int set_FE_nodal_field_FE_value_values(struct FE_field *field,
 			FE_value **destArray = (FE_value **)(node->values_storage + component.value);
 			for (int j = 0; j < length; ++j)
 			{
-				(*destArray)[time_index] = *source;
+				set_FE_value_storage_time_value(reinterpret_cast<Value_storage *>(destArray),
+					node_field->time_sequence, time_index, *source);
 				++destArray;
 				++source;
 			}
@@ -14147,6 +14346,58 @@ int set_FE_nodal_field_FE_value_values(struct FE_field *field,
 	return 1;
 }
 
+int set_FE_nodal_field_FE_value_values_all_versions(struct FE_field *field,
+	struct FE_node *node, const FE_value *component_values, FE_value time)
+{
+	if (!(field && node && component_values && (FE_VALUE_VALUE == field->value_type)))
+	{
+		display_message(ERROR_MESSAGE,
+			"set_FE_nodal_field_FE_value_values_all_versions.  Invalid argument(s)");
+		return 0;
+	}
+	FE_node_field *node_field = FE_node_get_FE_node_field(node, field);
+	if (!node_field)
+		return 0;
+	int time_index = 0;
+	if ((node_field->time_sequence) &&
+		(!FE_time_sequence_get_index_for_time(node_field->time_sequence, time, &time_index)))
+	{
+		display_message(ERROR_MESSAGE, "set_FE_nodal_field_FE_value_values_all_versions.  "
+			"Time value for time %g not defined at this node.", time);
+		return 0;
+	}
+	// FE_NODAL_VALUE is conventionally first, so check before setting any values
+	for (int c = 0; c < field->number_of_components; ++c)
+	{
+		const FE_node_field_component& component = node_field->components[c];
+		if (!((component.nodal_value_types) && (FE_NODAL_VALUE == component.nodal_value_types[0])))
+			return 0;
+	}
+	const int size = get_Value_storage_size(FE_VALUE_VALUE, node_field->time_sequence);
+	int return_code = 1;
+	for (int c = 0; c < field->number_of_components; ++c)
+	{
+		const FE_node_field_component& component = node_field->components[c];
+		const int length = 1 + component.number_of_derivatives;
+		for (int v = 0; v < component.number_of_versions; ++v)
+		{
+			Value_storage *values_storage = node->values_storage + component.value + v*length*size;
+			if (node_field->time_sequence)
+			{
+				if (!set_FE_value_storage_time_value(values_storage, node_field->time_sequence,
+						time_index, component_values[c]))
+					return_code = 0;
+			}
+			else
+				*(reinterpret_cast<FE_value *>(values_storage)) = component_values[c];
+		}
+	}
+	/* avoid notifying changes to non-managed nodes */
+	if (node->fields->fe_nodeset->containsNode(node))
+		node->fields->fe_nodeset->nodeFieldChange(node, field);
+	return return_code;
+}
+
 int FE_field_assign_node_parameters_sparse_FE_value(FE_field *field, FE_node *node,
 	int arraySize, FE_value *values, int *valueExists, int valuesCount,
 	int componentsSize, int componentsOffset,
@@ -17945,6 +18196,17 @@ int FE_element_field_info_clear_FE_mesh(
 	return 0;
 }
 
+int FE_element_field_info_set_FE_mesh(
+	struct FE_element_field_info *element_field_info, void *fe_mesh_void)
+{
+	if (element_field_info && fe_mesh_void)
+	{
+		element_field_info->fe_mesh = static_cast<FE_mesh *>(fe_mesh_void);
+		return 1;
+	}
+	return 0;
+}
+
 int FE_element_field_info_has_FE_field(
 	struct FE_element_field_info *element_field_info, void *fe_field_void)
 /*******************************************************************************
@@ -23154,6 +23416,123 @@ the derivatives will start at the first position of <jacobian>.
 	return (return_code);
 } /* calculate_FE_element_field */
 
+int calculate_FE_element_field_second_derivatives(int component_number,
+	struct FE_element_field_values *element_field_values,
+	const FE_value *xi_coordinates, FE_value *second_derivatives)
+{
+	struct FE_field *field;
+	if (!((element_field_values) && (xi_coordinates) && (second_derivatives) &&
+		(field = element_field_values->field)))
+	{
+		display_message(ERROR_MESSAGE,
+			"calculate_FE_element_field_second_derivatives.  Invalid argument(s)");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const int dimension = element_field_values->element->getDimension();
+	const int dimensionSquared = dimension*dimension;
+	int comp_no, components_to_calculate;
+	if ((0 <= component_number) && (component_number < field->number_of_components))
+	{
+		comp_no = component_number;
+		components_to_calculate = 1;
+	}
+	else
+	{
+		comp_no = 0;
+		components_to_calculate = field->number_of_components;
+	}
+	FE_value *second_derivative = second_derivatives;
+	switch (field->fe_field_type)
+	{
+		case CONSTANT_FE_FIELD:
+		case INDEXED_FE_FIELD:
+		{
+			for (int i = components_to_calculate*dimensionSquared; 0 < i; --i)
+			{
+				*second_derivative = 0.0;
+				++second_derivative;
+			}
+		} break;
+		case GENERAL_FE_FIELD:
+		{
+			for (int cn = comp_no; cn < comp_no + components_to_calculate; ++cn)
+			{
+				// grid-based and polygon components are not supported
+				if (((element_field_values->component_number_in_xi) &&
+						(element_field_values->component_number_in_xi[cn])) ||
+					(!standard_basis_function_is_monomial(
+						element_field_values->component_standard_basis_functions[cn],
+						element_field_values->component_standard_basis_function_arguments[cn])))
+					return CMZN_ERROR_NOT_IMPLEMENTED;
+				// monomial coefficients precede any derivative coefficients
+				// term j has power (j/offset[k]) % (order[k] + 1) in xi[k]
+				const int *orders = element_field_values->component_standard_basis_function_arguments[cn] + 1;
+				const FE_value *coefficient = element_field_values->component_values[cn];
+				const int number_of_values = element_field_values->component_number_of_values[cn];
+				for (int i = 0; i < dimensionSquared; ++i)
+					second_derivative[i] = 0.0;
+				int power[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+				for (int k = 0; k < dimension; ++k)
+					power[k] = 0;
+				for (int j = 0; j < number_of_values; ++j)
+				{
+					if (0.0 != coefficient[j])
+					{
+						for (int a = 0; a < dimension; ++a)
+						{
+							for (int b = a; b < dimension; ++b)
+							{
+								// d2/dxi_a.dxi_b of product of xi[k]^power[k]
+								FE_value term = coefficient[j];
+								for (int k = 0; (k < dimension) && (0.0 != term); ++k)
+								{
+									int p = power[k];
+									if (k == a)
+									{
+										term *= static_cast<FE_value>(p);
+										--p;
+									}
+									if (k == b)
+									{
+										term *= static_cast<FE_value>(p);
+										--p;
+									}
+									for (; 0 < p; --p)
+										term *= xi_coordinates[k];
+								}
+								second_derivative[a*dimension + b] += term;
+							}
+						}
+					}
+					// increment powers with xi1 varying fastest
+					for (int k = 0; k < dimension; ++k)
+					{
+						if (power[k] < orders[k])
+						{
+							++power[k];
+							break;
+						}
+						power[k] = 0;
+					}
+				}
+				for (int a = 1; a < dimension; ++a)
+				{
+					for (int b = 0; b < a; ++b)
+						second_derivative[a*dimension + b] = second_derivative[b*dimension + a];
+				}
+				second_derivative += dimensionSquared;
+			}
+		} break;
+		default:
+		{
+			display_message(ERROR_MESSAGE,
+				"calculate_FE_element_field_second_derivatives.  Unknown field type");
+			return CMZN_ERROR_GENERAL;
+		} break;
+	}
+	return CMZN_OK;
+}
+
 int calculate_FE_element_field_as_string(int component_number,
 	struct FE_element_field_values *element_field_values,
 	const FE_value *xi_coordinates, char **string)
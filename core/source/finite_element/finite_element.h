@@ -1026,6 +1026,20 @@ int get_FE_nodal_field_FE_value_values(struct FE_field *field,
 int set_FE_nodal_field_FE_value_values(struct FE_field *field,
 	struct FE_node *node, FE_value *values, int *number_of_values, FE_value time);
 
+/**
+ * Sets the FE_NODAL_VALUE parameter of all versions of each component of the
+ * FE_value field at node to the value for that component, notifying a single
+ * change to the node. Used for assigning field values in bulk.
+ *
+ * @param component_values  Array of one value per field component.
+ * @param time  The time to set values at, ignored for non-time-varying field.
+ * @return  1 on success, 0 if failed including if field is not defined at node
+ * or any component does not have FE_NODAL_VALUE as its first parameter, in
+ * which case no values are set.
+ */
+int set_FE_nodal_field_FE_value_values_all_versions(struct FE_field *field,
+	struct FE_node *node, const FE_value *component_values, FE_value time);
+
 /**
  * Assigns all parameters for the field at the node, taken from sparse arrays.
  * Works around current limitations of node fields (that they must have VALUE
@@ -1706,6 +1720,22 @@ single component, the value will be put in the first position of <values> and
 the derivatives will start at the first position of <jacobian>.
 ==============================================================================*/
 
+/**
+ * Calculates the second derivatives w.r.t. xi of the field specified by the
+ * <element_field_values> at the <xi_coordinates>. For each component,
+ * d2/dxi_i.dxi_j is stored at [i*dimension + j]. Only the
+ * <component_number>+1 component is calculated if
+ * 0<=component_number<number of components. Only implemented for constant
+ * and indexed fields, and general fields with tensor product (monomial)
+ * bases. Grid-based and polygon components are not supported; as callers may
+ * request second derivatives at every point this is not reported as an error.
+ * @return  CMZN_OK on success, CMZN_ERROR_NOT_IMPLEMENTED for unsupported
+ * components, or other error code on failure.
+ */
+int calculate_FE_element_field_second_derivatives(int component_number,
+	struct FE_element_field_values *element_field_values,
+	const FE_value *xi_coordinates, FE_value *second_derivatives);
+
 int calculate_FE_element_field_as_string(int component_number,
 	struct FE_element_field_values *element_field_values,
 	const FE_value *xi_coordinates, char **string);
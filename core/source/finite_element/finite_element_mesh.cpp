@@ -1921,3 +1921,78 @@ int FE_mesh::merge(FE_mesh &source)
 	}
 	return return_code;
 }
+
+static int FE_element_field_info_add_to_list(struct FE_element_field_info *element_field_info,
+	void *element_field_info_list_void)
+{
+	return ADD_OBJECT_TO_LIST(FE_element_field_info)(element_field_info,
+		static_cast<struct LIST(FE_element_field_info) *>(element_field_info_list_void));
+}
+
+/**
+ * Fast alternative to merge for an empty mesh: swaps in the element labels,
+ * element objects, shape, face and parent maps, element field information
+ * and scale factor sets of source, so label indexes are unchanged. Only valid
+ * when the FE_fields and nodes used by source elements have been, or will be,
+ * transferred to the owning region of this mesh, as in FE_region_merge when
+ * the target is empty. Source mesh is left empty.
+ * @return  1 on success, 0 on failure.
+ */
+int FE_mesh::adopt(FE_mesh &source)
+{
+	if ((source.dimension != this->dimension) || (!this->isEmpty()))
+	{
+		display_message(ERROR_MESSAGE, "FE_mesh::adopt.  Invalid source or mesh is not empty");
+		return 0;
+	}
+	int return_code = 1;
+	FE_region_begin_change(this->fe_region);
+	// reset any maps held for previously removed elements
+	this->clear();
+
+	this->labels.swap(source.labels);
+	this->fe_elements.swap(source.fe_elements);
+	this->elementShapeMap.swap(source.elementShapeMap);
+	this->parents.swap(source.parents);
+	// face maps are held against the labels of their own mesh, hence recreate
+	// shape faces for this mesh and take the face maps of the source
+	if (0 < source.elementShapeFacesCount)
+	{
+		this->elementShapeFacesArray = new ElementShapeFaces*[source.elementShapeFacesCount];
+		for (unsigned int i = 0; i < source.elementShapeFacesCount; ++i)
+		{
+			this->elementShapeFacesArray[i] = new ElementShapeFaces(&this->labels,
+				source.elementShapeFacesArray[i]->getShape());
+			this->elementShapeFacesArray[i]->swapFaces(*(source.elementShapeFacesArray[i]));
+		}
+		this->elementShapeFacesCount = source.elementShapeFacesCount;
+	}
+
+	if (!(FOR_EACH_OBJECT_IN_LIST(FE_element_field_info)(FE_element_field_info_set_FE_mesh,
+			(void *)this, source.element_field_info_list) &&
+		FOR_EACH_OBJECT_IN_LIST(FE_element_field_info)(FE_element_field_info_add_to_list,
+			(void *)this->element_field_info_list, source.element_field_info_list)))
+	{
+		display_message(ERROR_MESSAGE, "FE_mesh::adopt.  Failed to transfer element field information");
+		return_code = 0;
+	}
+	source.last_fe_element_field_info = 0;
+	REMOVE_ALL_OBJECTS_FROM_LIST(FE_element_field_info)(source.element_field_info_list);
+	this->last_fe_element_field_info = 0;
+
+	this->scale_factor_sets.swap(source.scale_factor_sets);
+	const size_t size = this->scale_factor_sets.size();
+	for (size_t i = 0; i < size; ++i)
+		this->scale_factor_sets[i]->setMesh(this);
+
+	// release remaining source shape faces
+	source.clear();
+
+	if (this->fe_region && this->changeLog && (0 < this->labels.getSize()))
+	{
+		this->changeLog->setAllChange(DS_LABEL_CHANGE_TYPE_ADD);
+		this->fe_region->update();
+	}
+	FE_region_end_change(this->fe_region);
+	return return_code;
+}
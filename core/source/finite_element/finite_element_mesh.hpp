@@ -69,6 +69,12 @@ public:
 		return CMZN_OK;
 	}
 
+	/** Only to be called by FE_mesh when transferring set to another mesh */
+	void setMesh(FE_mesh *fe_meshIn)
+	{
+		this->fe_mesh = fe_meshIn;
+	}
+
 	/** @return  Internal name, not a copy */
 	const char *getName() const
 	{
@@ -204,6 +210,12 @@ public:
 		/** convenient function for setting a single face for an element */
 		int setElementFace(DsLabelIndex elementIndex, int faceNumber, DsLabelIndex faceIndex);
 
+		/** Swap face maps with other for the same shape, keeping labels. */
+		void swapFaces(ElementShapeFaces& other)
+		{
+			this->faces.swap(other.faces);
+		}
+
 	};
 
 private:
@@ -580,6 +592,15 @@ public:
 	bool canMerge(FE_mesh &source);
 
 	int merge(FE_mesh &source);
+
+	/** @return  True if mesh has no elements or scale factor sets, so it can
+	 * adopt the contents of another mesh instead of merging them. */
+	bool isEmpty() const
+	{
+		return (0 == this->labels.getSize()) && this->scale_factor_sets.empty();
+	}
+
+	int adopt(FE_mesh &source);
 };
 
 struct cmzn_elementiterator : public cmzn::RefCounted
@@ -146,6 +146,8 @@ public:
 	bool canMerge(FE_nodeset &source);
 
 	int merge(FE_nodeset &source);
+
+	int adopt(FE_nodeset &source);
 };
 
 #endif /* !defined (FINITE_ELEMENT_NODESET_HPP) */
@@ -214,6 +214,14 @@ PROTOTYPE_LIST_FUNCTIONS(FE_node_field_info);
 int FE_node_field_info_clear_FE_nodeset(
 	struct FE_node_field_info *node_field_info, void *dummy_void);
 
+/**
+ * Changes the FE_nodeset <node_field_info> belongs to.
+ * Private function only to be called by FE_nodeset::adopt.
+ * @param fe_nodeset_void  Void pointer to new owning FE_nodeset.
+ */
+int FE_node_field_info_set_FE_nodeset(
+	struct FE_node_field_info *node_field_info, void *fe_nodeset_void);
+
 int FE_node_field_info_has_FE_field(
 	struct FE_node_field_info *node_field_info, void *fe_field_void);
 /*******************************************************************************
@@ -400,6 +408,14 @@ PROTOTYPE_LIST_FUNCTIONS(FE_element_field_info);
 int FE_element_field_info_clear_FE_mesh(
 	struct FE_element_field_info *element_field_info, void *dummy_void);
 
+/**
+ * Changes the FE_mesh <element_field_info> belongs to.
+ * Private function only to be called by FE_mesh::adopt.
+ * @param fe_mesh_void  Void pointer to new owning FE_mesh.
+ */
+int FE_element_field_info_set_FE_mesh(
+	struct FE_element_field_info *element_field_info, void *fe_mesh_void);
+
 int FE_element_field_info_has_FE_field(
 	struct FE_element_field_info *element_field_info, void *fe_field_void);
 /*******************************************************************************
@@ -318,6 +318,11 @@ int FE_region_end_change_no_notify(struct FE_region *fe_region)
 	return 0;
 }
 
+bool FE_region_is_caching_changes(struct FE_region *fe_region)
+{
+	return (fe_region) && (0 < fe_region->change_level);
+}
+
 bool FE_field_has_cached_changes(FE_field *fe_field)
 {
 	FE_region *fe_region;
@@ -1234,12 +1239,38 @@ int FE_field_check_element_node_value_labels(struct FE_field *field,
 	return 1;
 }
 
+bool FE_region_can_adopt(struct FE_region *target_fe_region,
+	struct FE_region *source_fe_region)
+{
+	if (!(target_fe_region && source_fe_region && (target_fe_region != source_fe_region) &&
+		(target_fe_region->bases_and_shapes == source_fe_region->bases_and_shapes)))
+		return false;
+	if ((0 != NUMBER_IN_LIST(FE_field)(target_fe_region->fe_field_list)) ||
+		(0 != FE_time_sequence_package_get_number_of_FE_time_sequences(source_fe_region->fe_time)))
+		return false;
+	for (int n = 0; n < 2; ++n)
+	{
+		if (0 != target_fe_region->nodesets[n]->get_number_of_FE_nodes())
+			return false;
+	}
+	for (int dim = 0; dim < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dim)
+	{
+		if (!target_fe_region->meshes[dim]->isEmpty())
+			return false;
+	}
+	return true;
+}
+
 bool FE_region_can_merge(struct FE_region *target_fe_region,
 	struct FE_region *source_fe_region)
 {
 	if (!source_fe_region)
 		return false;
 
+	// no compatibility checks needed when target can adopt source contents
+	if (FE_region_can_adopt(target_fe_region, source_fe_region))
+		target_fe_region = 0;
+
 	if (target_fe_region)
 	{
 		// check fields of the same name have compatible definitions
@@ -1290,6 +1321,8 @@ int FE_region_merge(struct FE_region *target_fe_region,
 	int return_code = 1;
 	if (target_fe_region && source_fe_region)
 	{
+		// must determine before fields are merged
+		const bool adopt = FE_region_can_adopt(target_fe_region, source_fe_region);
 		FE_region_begin_change(target_fe_region);
 
 		// merge fields
@@ -1301,21 +1334,37 @@ int FE_region_merge(struct FE_region *target_fe_region,
 			return_code = 0;
 		}
 
-		// merge nodes (nodesets)
-		if (return_code)
+		if (adopt)
 		{
-			for (int n = 0; n < 2; ++n)
-				if (!target_fe_region->nodesets[n]->merge(*(source_fe_region->nodesets[n])))
-					return_code = 0;
+			// fields were moved to target unchanged so can take nodes and elements as they are
+			if (return_code)
+			{
+				for (int n = 0; n < 2; ++n)
+					if (!target_fe_region->nodesets[n]->adopt(*(source_fe_region->nodesets[n])))
+						return_code = 0;
+				for (int dim = 0; dim < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dim)
+					if (!target_fe_region->meshes[dim]->adopt(*(source_fe_region->meshes[dim])))
+						return_code = 0;
+			}
 		}
-
-		// merge elements (meshes)
-		if (return_code)
+		else
 		{
-			// merge meshes from lowest to highest dimension so faces are merged before parent
-			for (int dim = 0; dim < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dim)
-				if (!target_fe_region->meshes[dim]->merge(*(source_fe_region->meshes[dim])))
-					return_code = 0;
+			// merge nodes (nodesets)
+			if (return_code)
+			{
+				for (int n = 0; n < 2; ++n)
+					if (!target_fe_region->nodesets[n]->merge(*(source_fe_region->nodesets[n])))
+						return_code = 0;
+			}
+
+			// merge elements (meshes)
+			if (return_code)
+			{
+				// merge meshes from lowest to highest dimension so faces are merged before parent
+				for (int dim = 0; dim < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dim)
+					if (!target_fe_region->meshes[dim]->merge(*(source_fe_region->meshes[dim])))
+						return_code = 0;
+			}
 		}
 
 		FE_region_end_change(target_fe_region);
@@ -194,6 +194,12 @@ int FE_region_end_change(struct FE_region *fe_region);
  */
 int FE_region_end_change_no_notify(struct FE_region *fe_region);
 
+/**
+ * @return  True if fe_region is between begin/end change, so its change logs
+ * are incomplete and dependent fields have not been informed of changes.
+ */
+bool FE_region_is_caching_changes(struct FE_region *fe_region);
+
 /**
  * Return true if the fe_field's owning fe_region is currently caching changes
  * and this fe_field has changes that affect its values.
@@ -474,6 +480,17 @@ void FE_region_set_cmzn_region_private(struct FE_region *fe_region,
  */
 struct cmzn_region *FE_region_get_cmzn_region(struct FE_region *fe_region);
 
+/**
+ * Determine whether <target_fe_region> can take the fields, nodes and elements
+ * of <source_fe_region> wholesale instead of merging them, which is much
+ * faster and avoids copying. Requires target to have no fields, nodes,
+ * elements or scale factor sets, to share bases and shapes with source, and
+ * for source to have no time sequences.
+ * @return  True if FE_region_merge will adopt source contents, otherwise false.
+ */
+bool FE_region_can_adopt(struct FE_region *target_fe_region,
+	struct FE_region *source_fe_region);
+
 /**
  * Check that fields and other object definitions in source FE_region are
  * properly defined and compatible with definitions in target FE_region.
@@ -496,6 +513,8 @@ bool FE_region_can_merge(struct FE_region *target_fe_region,
  * containing objects that partly belong to the <target_fe_region> and partly to
  * itself. Currently it needs to be left around for the remainder of the merge
  * up and down the region graph, but it needs to be destroyed as soon as possible.
+ * If FE_region_can_adopt is true, nodes and elements are moved from source
+ * with their label indexes unchanged, leaving source nodesets and meshes empty.
  */
 int FE_region_merge(struct FE_region *target_fe_region,
 	struct FE_region *source_fe_region);
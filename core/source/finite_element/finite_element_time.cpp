@@ -16,6 +16,7 @@ Representing time in finite elements.
 #include "opencmiss/zinc/timesequence.h"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_time.h"
+#include "finite_element/finite_element_time_series_store.hpp"
 #include "general/debug.h"
 #include "general/indexed_list_private.h"
 #include "general/list_private.h"
@@ -51,6 +52,8 @@ DESCRIPTION :
 	/* For FE_TIME_SEQUENCE */
 	int number_of_times;
 	FE_value *times;
+	/* if set, values varying with sequence are held in this store */
+	FE_time_series_store *paged_store;
 
 	/* A pointer to itself so that we can make the INDEX functions work with
 		multiple parts of the object as the identifier */
@@ -257,6 +260,7 @@ Creates a basic FE_time_sequence.
 		fe_time_sequence->type = FE_TIME_SEQUENCE;
 		fe_time_sequence->number_of_times = 0;
 		fe_time_sequence->times = (FE_value *)NULL;
+		fe_time_sequence->paged_store = 0;
 
 		fe_time_sequence->self = fe_time_sequence;
 
@@ -296,6 +300,7 @@ Frees memory/deaccess objects in fe_time_sequence at <*fe_time_sequence_address>
 			{
 				DEALLOCATE(fe_time_sequence->times);
 			}
+			delete fe_time_sequence->paged_store;
 			DEALLOCATE(*fe_time_sequence_address);
 			return_code=1;
 		}
@@ -1114,13 +1119,16 @@ FE_TIME_SEQUENCE_MAPPING_UNKNOWN;
 			if we wanted different representations of the same
 			number to match we would have to compare FE_values
 			instead. */
-		if ((source_sequence->number_of_times == destination_sequence->number_of_times)
+		/* paged values can only be transferred within the same store */
+		if ((source_sequence->paged_store == destination_sequence->paged_store)
+			&& (source_sequence->number_of_times == destination_sequence->number_of_times)
 			&& !memcmp(source_sequence->times, destination_sequence->times,
 				source_sequence->number_of_times * sizeof(FE_value)))
 		{
 			mapping = FE_TIME_SEQUENCE_MAPPING_IDENTICAL;
 		}
-		else if ((source_sequence->number_of_times < destination_sequence->number_of_times)
+		else if ((!source_sequence->paged_store) && (!destination_sequence->paged_store)
+			&& (source_sequence->number_of_times < destination_sequence->number_of_times)
 			&& !memcmp(source_sequence->times, destination_sequence->times,
 				source_sequence->number_of_times * sizeof(FE_value)))
 		{
@@ -1173,6 +1181,14 @@ Returns true if <fe_time> contains the <fe_time_sequence>.
 	return (return_code);
 } /* FE_time_has_FE_time_sequence */
 
+int FE_time_sequence_package_get_number_of_FE_time_sequences(
+	struct FE_time_sequence_package *fe_time)
+{
+	if (fe_time)
+		return NUMBER_IN_MANAGER(FE_time_sequence)(fe_time->fe_time_sequence_manager);
+	return 0;
+}
+
 int FE_time_sequence_is_in_use(struct FE_time_sequence *fe_time_sequence)
 {
 	if (NULL == fe_time_sequence)
@@ -1181,6 +1197,40 @@ int FE_time_sequence_is_in_use(struct FE_time_sequence *fe_time_sequence)
 	return (fe_time_sequence->access_count > 2);
 }
 
+FE_time_series_store *FE_time_sequence_get_paged_store(
+	struct FE_time_sequence *fe_time_sequence)
+{
+	if (fe_time_sequence)
+		return fe_time_sequence->paged_store;
+	return 0;
+}
+
+int FE_time_sequence_set_paged_storage(struct FE_time_sequence *fe_time_sequence,
+	const char *file_name, int maximum_resident_times)
+{
+	if (!((fe_time_sequence) && ((!file_name) || (2 <= maximum_resident_times))))
+	{
+		display_message(ERROR_MESSAGE, "FE_time_sequence_set_paged_storage.  Invalid argument(s)");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	if (FE_time_sequence_is_in_use(fe_time_sequence))
+	{
+		display_message(ERROR_MESSAGE, "FE_time_sequence_set_paged_storage.  "
+			"Cannot change storage of time sequence while in use");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	FE_time_series_store *paged_store = 0;
+	if (file_name)
+	{
+		paged_store = FE_time_series_store::create(file_name, maximum_resident_times);
+		if (!paged_store)
+			return CMZN_ERROR_GENERAL;
+	}
+	delete fe_time_sequence->paged_store;
+	fe_time_sequence->paged_store = paged_store;
+	return CMZN_OK;
+}
+
 cmzn_timesequence_id cmzn_timesequence_access(
 	cmzn_timesequence_id timesequence)
 {
@@ -1226,3 +1276,11 @@ int cmzn_timesequence_set_time(cmzn_timesequence_id timesequence,
 	}
 	return FE_time_sequence_set_time_and_index(fe_timesequence, time_index - 1, time);
 }
+
+int cmzn_timesequence_set_paged_storage(cmzn_timesequence_id timesequence,
+	const char *file_name, int maximum_resident_times)
+{
+	return FE_time_sequence_set_paged_storage(
+		reinterpret_cast<struct FE_time_sequence *>(timesequence),
+		file_name, maximum_resident_times);
+}
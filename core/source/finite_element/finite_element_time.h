@@ -50,6 +50,8 @@ DESCRIPTION :
 struct FE_time_sequence is private.
 ==============================================================================*/
 
+class FE_time_series_store;
+
 DECLARE_LIST_TYPES(FE_time_sequence);
 
 DECLARE_MANAGER_TYPES(FE_time_sequence);
@@ -237,10 +239,34 @@ DESCRIPTION :
 Returns true if <fe_time_sequence_package> contains the <fe_time_seqence>.
 ==============================================================================*/
 
+/**
+ * @return  Number of time sequences in <fe_time>, or 0 if invalid argument.
+ */
+int FE_time_sequence_package_get_number_of_FE_time_sequences(
+	struct FE_time_sequence_package *fe_time);
+
 /***************************************************************************//**
  * @return  1 if the time sequence is in use by other objects and should thus
  * not be modified, or 0 if it is not in use.
  */
 int FE_time_sequence_is_in_use(struct FE_time_sequence *fe_time_sequence);
 
+/**
+ * @return  Store holding values varying with time sequence, or 0 if values
+ * are held in arrays in memory.
+ */
+FE_time_series_store *FE_time_sequence_get_paged_store(
+	struct FE_time_sequence *fe_time_sequence);
+
+/**
+ * Set values varying with the time sequence to be held in a scratch file,
+ * with only some times in memory. Only possible while not in use.
+ * @param file_name  Name of scratch file to create, or NULL to hold values in
+ * memory.
+ * @param maximum_resident_times  Maximum number of times in memory, at least 2.
+ * @return  CMZN_OK on success, otherwise any other error code.
+ */
+int FE_time_sequence_set_paged_storage(struct FE_time_sequence *fe_time_sequence,
+	const char *file_name, int maximum_resident_times);
+
 #endif /* !defined (FINITE_ELEMENT_TIME_H) */
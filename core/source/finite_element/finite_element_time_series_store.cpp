@@ -0,0 +1,493 @@
+/**
+ * FILE : finite_element_time_series_store.cpp
+ *
+ * Paged storage of time-varying nodal parameters in a scratch file, holding
+ * only a limited number of time steps in memory.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "finite_element/finite_element_time_series_store.hpp"
+#include "general/message.h"
+
+FE_time_series_store::FE_time_series_store(const std::string& fileNameIn, int maximumResidentTimesIn) :
+	fileName(fileNameIn),
+	maximumResidentTimes(maximumResidentTimesIn),
+	numberOfTimes(0),
+	numberOfChunks(0),
+	slotCount(0),
+	liveSlotCount(0),
+	lastBlock(0),
+	useCounter(0),
+	lastTimeIndex(-1),
+	prefetchTimeIndex(-1)
+{
+}
+
+FE_time_series_store *FE_time_series_store::create(const char *fileName, int maximumResidentTimes)
+{
+	if (!((fileName) && (*fileName) && (2 <= maximumResidentTimes)))
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::create.  Invalid argument(s)");
+		return 0;
+	}
+	FE_time_series_store *store = new FE_time_series_store(fileName, maximumResidentTimes);
+	store->file.open(fileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!store->file.is_open())
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::create.  Could not create file '%s'", fileName);
+		delete store;
+		return 0;
+	}
+	return store;
+}
+
+FE_time_series_store::~FE_time_series_store()
+{
+	this->cancelPrefetch();
+	for (std::vector<Block *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		delete *iter;
+	if (this->file.is_open())
+	{
+		this->file.close();
+		std::remove(this->fileName.c_str());
+	}
+}
+
+/**
+ * Read values at time index for all slots from file. Runs on worker thread
+ * for prefetching so must not touch the store or the message system.
+ * Values not yet written to the file are zero.
+ */
+std::vector<FE_value> FE_time_series_store::readBlock(const std::string& fileName,
+	int numberOfTimes, int numberOfChunks, int timeIndex)
+{
+	std::vector<FE_value> values(static_cast<size_t>(numberOfChunks)*chunkSize, 0.0);
+	std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+	if (in.is_open())
+	{
+		const std::streamsize chunkBytes = static_cast<std::streamsize>(chunkSize*sizeof(FE_value));
+		for (int c = 0; c < numberOfChunks; ++c)
+		{
+			const std::streamoff offset = (static_cast<std::streamoff>(c)*numberOfTimes + timeIndex)*chunkBytes;
+			in.seekg(offset);
+			in.read(reinterpret_cast<char *>(&(values[static_cast<size_t>(c)*chunkSize])), chunkBytes);
+			if (!in)
+			{
+				// beyond end of file: remainder was never written so stays zero
+				in.clear();
+			}
+		}
+	}
+	return values;
+}
+
+/**
+ * Read values of one chunk at time index from file on the calling thread.
+ * Values not yet written to the file are zero.
+ */
+void FE_time_series_store::readChunk(int chunk, int timeIndex, FE_value *values)
+{
+	std::fill(values, values + chunkSize, 0.0);
+	const std::streamsize chunkBytes = static_cast<std::streamsize>(chunkSize*sizeof(FE_value));
+	const std::streamoff offset = (static_cast<std::streamoff>(chunk)*this->numberOfTimes + timeIndex)*chunkBytes;
+	this->file.seekg(offset);
+	this->file.read(reinterpret_cast<char *>(values), chunkBytes);
+	if (!this->file)
+	{
+		// beyond end of file: remainder was never written so stays zero
+		this->file.clear();
+	}
+}
+
+/** Write values of one chunk at time index to file. Caller must flush. */
+void FE_time_series_store::writeChunk(int chunk, int timeIndex, const FE_value *values)
+{
+	const std::streamsize chunkBytes = static_cast<std::streamsize>(chunkSize*sizeof(FE_value));
+	const std::streamoff offset = (static_cast<std::streamoff>(chunk)*this->numberOfTimes + timeIndex)*chunkBytes;
+	this->file.seekp(offset);
+	this->file.write(reinterpret_cast<const char *>(values), chunkBytes);
+}
+
+bool FE_time_series_store::writeBlock(Block& block)
+{
+	const int blockChunks = static_cast<int>(block.values.size() / chunkSize);
+	for (int c = 0; c < blockChunks; ++c)
+		this->writeChunk(c, block.timeIndex, &(block.values[static_cast<size_t>(c)*chunkSize]));
+	// flush so worker threads reading the file see the values
+	this->file.flush();
+	if (!this->file)
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::writeBlock.  "
+			"Failed to write time index %d to file '%s'", block.timeIndex, this->fileName.c_str());
+		this->file.clear();
+		return false;
+	}
+	block.dirty = false;
+	return true;
+}
+
+/** Wait for and discard any block being read ahead. */
+void FE_time_series_store::cancelPrefetch()
+{
+	if (this->prefetchValues.valid())
+		this->prefetchValues.wait();
+	this->prefetchValues = std::future<std::vector<FE_value> >();
+	this->prefetchTimeIndex = -1;
+}
+
+/** Start reading block for time index on a worker thread if not resident. */
+void FE_time_series_store::prefetch(int timeIndex)
+{
+	// need room for the prefetched block and the pair being interpolated
+	if ((timeIndex < 0) || (timeIndex >= this->numberOfTimes) ||
+		(this->maximumResidentTimes < 3) || (timeIndex == this->prefetchTimeIndex))
+		return;
+	if (this->prefetchValues.valid())
+	{
+		// abandon an unused earlier read ahead only once it has finished
+		if (this->prefetchValues.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return;
+		this->cancelPrefetch();
+	}
+	for (std::vector<Block *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		if ((*iter)->timeIndex == timeIndex)
+			return;
+	try
+	{
+		this->prefetchValues = std::async(std::launch::async, FE_time_series_store::readBlock,
+			this->fileName, this->numberOfTimes, this->numberOfChunks, timeIndex);
+		this->prefetchTimeIndex = timeIndex;
+	}
+	catch (...)
+	{
+		// could not start thread: block is read when needed
+	}
+}
+
+/**
+ * Read ahead in direction times are moving through. The pair of times being
+ * interpolated advances by one index at a time during playback.
+ */
+void FE_time_series_store::notePlayback(int timeIndex1, int timeIndex2)
+{
+	if (timeIndex1 == this->lastTimeIndex)
+		return;
+	if (timeIndex1 == this->lastTimeIndex + 1)
+		this->prefetch(timeIndex2 + 1);
+	else if (timeIndex1 == this->lastTimeIndex - 1)
+		this->prefetch(timeIndex1 - 1);
+	this->lastTimeIndex = timeIndex1;
+}
+
+/** @return  Block for time index if resident, otherwise 0. Does not count as a use. */
+FE_time_series_store::Block *FE_time_series_store::findResidentBlock(int timeIndex)
+{
+	if ((this->lastBlock) && (this->lastBlock->timeIndex == timeIndex))
+		return this->lastBlock;
+	for (std::vector<Block *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		if ((*iter)->timeIndex == timeIndex)
+			return *iter;
+	return 0;
+}
+
+FE_time_series_store::Block *FE_time_series_store::getBlock(int timeIndex)
+{
+	if ((this->lastBlock) && (this->lastBlock->timeIndex == timeIndex))
+		return this->lastBlock;
+	if ((timeIndex < 0) || (timeIndex >= this->numberOfTimes))
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::getBlock.  Time index %d out of range", timeIndex);
+		return 0;
+	}
+	Block *block = this->findResidentBlock(timeIndex);
+	if (!block)
+	{
+		if (static_cast<int>(this->blocks.size()) >= this->maximumResidentTimes)
+		{
+			// evict least recently used block
+			std::vector<Block *>::iterator lruIter = this->blocks.begin();
+			for (std::vector<Block *>::iterator iter = lruIter + 1; iter != this->blocks.end(); ++iter)
+				if ((*iter)->lastUse < (*lruIter)->lastUse)
+					lruIter = iter;
+			Block *lruBlock = *lruIter;
+			if (lruBlock->dirty && !this->writeBlock(*lruBlock))
+				return 0;
+			if (this->lastBlock == lruBlock)
+				this->lastBlock = 0;
+			this->blocks.erase(lruIter);
+			block = lruBlock;
+		}
+		else
+			block = new Block();
+		block->timeIndex = timeIndex;
+		block->dirty = false;
+		if ((this->prefetchTimeIndex == timeIndex) && this->prefetchValues.valid())
+		{
+			block->values = this->prefetchValues.get();
+			this->prefetchTimeIndex = -1;
+			// slots may have been added since prefetch started; their values are zero
+			block->values.resize(static_cast<size_t>(this->numberOfChunks)*chunkSize, 0.0);
+		}
+		else
+			block->values = FE_time_series_store::readBlock(this->fileName, this->numberOfTimes, this->numberOfChunks, timeIndex);
+		this->blocks.push_back(block);
+	}
+	block->lastUse = ++(this->useCounter);
+	this->lastBlock = block;
+	return block;
+}
+
+/** Discard all values and slots, and set number of times. */
+void FE_time_series_store::reset(int numberOfTimesIn)
+{
+	this->cancelPrefetch();
+	for (std::vector<Block *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+		delete *iter;
+	this->blocks.clear();
+	this->lastBlock = 0;
+	this->lastTimeIndex = -1;
+	this->freeSlots.clear();
+	this->zeroSlots.clear();
+	this->slotCount = 0;
+	this->numberOfChunks = 0;
+	this->numberOfTimes = numberOfTimesIn;
+	this->file.close();
+	this->file.open(this->fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!this->file.is_open())
+		display_message(ERROR_MESSAGE, "FE_time_series_store::reset.  Could not recreate file '%s'",
+			this->fileName.c_str());
+}
+
+/**
+ * Set values of slots to zero at all times and flag them as zero. Resident
+ * blocks are changed in memory; other times only where the file holds values.
+ */
+bool FE_time_series_store::zeroSlotValues(int count, const int *slots)
+{
+	// a block being read ahead may hold the old values
+	this->cancelPrefetch();
+	this->file.seekp(0, std::ios::end);
+	const std::streamoff fileSize = this->file.tellp();
+	const FE_value zero = 0.0;
+	for (int t = 0; t < this->numberOfTimes; ++t)
+	{
+		Block *block = this->findResidentBlock(t);
+		for (int i = 0; i < count; ++i)
+		{
+			const int slot = slots[i];
+			if (block)
+			{
+				block->values[slot] = 0.0;
+				continue;
+			}
+			const std::streamoff offset = ((static_cast<std::streamoff>(slot / chunkSize)*this->numberOfTimes + t)*
+				chunkSize + slot % chunkSize)*static_cast<std::streamoff>(sizeof(FE_value));
+			if (offset < fileSize)
+			{
+				this->file.seekp(offset);
+				this->file.write(reinterpret_cast<const char *>(&zero), sizeof(FE_value));
+			}
+		}
+		if (block)
+			block->dirty = true;
+	}
+	this->file.flush();
+	if (!this->file)
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::zeroSlotValues.  "
+			"Failed to write to file '%s'", this->fileName.c_str());
+		this->file.clear();
+		return false;
+	}
+	for (int i = 0; i < count; ++i)
+		this->zeroSlots[slots[i]] = true;
+	return true;
+}
+
+int FE_time_series_store::allocateSlot(int numberOfTimesIn, bool initialise)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (numberOfTimesIn <= 0)
+		return -1;
+	if (numberOfTimesIn != this->numberOfTimes)
+	{
+		if (0 < this->liveSlotCount)
+		{
+			display_message(ERROR_MESSAGE, "FE_time_series_store::allocateSlot.  "
+				"Cannot change number of times from %d to %d while in use", this->numberOfTimes, numberOfTimesIn);
+			return -1;
+		}
+		this->reset(numberOfTimesIn);
+	}
+	if (!this->file.is_open())
+		return -1;
+	int slot;
+	if (0 < this->freeSlots.size())
+	{
+		slot = this->freeSlots.back();
+		this->freeSlots.pop_back();
+		// released slots hold stale values unless they were never set
+		if (initialise && (!this->zeroSlots[slot]) && (!this->zeroSlotValues(1, &slot)))
+		{
+			this->freeSlots.push_back(slot);
+			return -1;
+		}
+	}
+	else
+	{
+		slot = this->slotCount;
+		++(this->slotCount);
+		this->zeroSlots.push_back(true);
+		if (this->slotCount > this->numberOfChunks*chunkSize)
+		{
+			// file region for new chunk was never written so is zero
+			++(this->numberOfChunks);
+			const size_t blockSize = static_cast<size_t>(this->numberOfChunks)*chunkSize;
+			for (std::vector<Block *>::iterator iter = this->blocks.begin(); iter != this->blocks.end(); ++iter)
+				(*iter)->values.resize(blockSize, 0.0);
+		}
+	}
+	++(this->liveSlotCount);
+	return slot;
+}
+
+void FE_time_series_store::releaseSlot(int slot)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if ((0 <= slot) && (slot < this->slotCount))
+	{
+		this->freeSlots.push_back(slot);
+		--(this->liveSlotCount);
+	}
+}
+
+FE_value FE_time_series_store::getValue(int slot, int timeIndex)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->notePlayback(timeIndex, timeIndex);
+	Block *block = this->getBlock(timeIndex);
+	if (block && (0 <= slot) && (slot < this->slotCount))
+		return block->values[slot];
+	return 0.0;
+}
+
+FE_value FE_time_series_store::getInterpolatedValue(int slot, int timeIndex1, int timeIndex2, FE_value xi)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if ((slot < 0) || (slot >= this->slotCount))
+		return 0.0;
+	this->notePlayback(timeIndex1, timeIndex2);
+	Block *block = this->getBlock(timeIndex1);
+	if (!block)
+		return 0.0;
+	const FE_value value1 = block->values[slot];
+	if ((timeIndex2 == timeIndex1) || (0.0 == xi))
+		return value1;
+	// block for first time is most recently used so is not evicted here
+	block = this->getBlock(timeIndex2);
+	if (!block)
+		return 0.0;
+	return (1.0 - xi)*value1 + xi*block->values[slot];
+}
+
+bool FE_time_series_store::setValue(int slot, int timeIndex, FE_value value)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if ((slot < 0) || (slot >= this->slotCount))
+		return false;
+	Block *block = this->getBlock(timeIndex);
+	if (!block)
+		return false;
+	block->values[slot] = value;
+	block->dirty = true;
+	this->zeroSlots[slot] = false;
+	return true;
+}
+
+bool FE_time_series_store::copySlots(int count, const int *sourceSlots, const int *destinationSlots)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	for (int i = 0; i < count; ++i)
+		if ((sourceSlots[i] < 0) || (sourceSlots[i] >= this->slotCount) ||
+			(destinationSlots[i] < 0) || (destinationSlots[i] >= this->slotCount))
+			return false;
+	// zero sources need only destinations not already zero to be cleared
+	std::vector<int> zeroDestinations, sources, destinations;
+	for (int i = 0; i < count; ++i)
+	{
+		if (this->zeroSlots[sourceSlots[i]])
+		{
+			if (!this->zeroSlots[destinationSlots[i]])
+				zeroDestinations.push_back(destinationSlots[i]);
+		}
+		else
+		{
+			sources.push_back(sourceSlots[i]);
+			destinations.push_back(destinationSlots[i]);
+		}
+	}
+	if ((0 < zeroDestinations.size()) &&
+		(!this->zeroSlotValues(static_cast<int>(zeroDestinations.size()), zeroDestinations.data())))
+		return false;
+	const size_t copyCount = sources.size();
+	if (0 == copyCount)
+		return true;
+	// times not resident are copied in the file, reading and writing only
+	// the chunks holding the slots
+	this->cancelPrefetch();
+	std::vector<int> chunks;
+	for (size_t i = 0; i < copyCount; ++i)
+	{
+		chunks.push_back(sources[i] / chunkSize);
+		chunks.push_back(destinations[i] / chunkSize);
+	}
+	std::sort(chunks.begin(), chunks.end());
+	chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+	std::vector<bool> destinationChunk(chunks.size(), false);
+	std::vector<size_t> sourceOffsets(copyCount), destinationOffsets(copyCount);
+	for (size_t i = 0; i < copyCount; ++i)
+	{
+		const size_t sourceChunkIndex = std::lower_bound(chunks.begin(), chunks.end(), sources[i] / chunkSize) - chunks.begin();
+		const size_t destinationChunkIndex = std::lower_bound(chunks.begin(), chunks.end(), destinations[i] / chunkSize) - chunks.begin();
+		sourceOffsets[i] = sourceChunkIndex*chunkSize + sources[i] % chunkSize;
+		destinationOffsets[i] = destinationChunkIndex*chunkSize + destinations[i] % chunkSize;
+		destinationChunk[destinationChunkIndex] = true;
+	}
+	std::vector<FE_value> chunkValues(chunks.size()*chunkSize);
+	for (int t = 0; t < this->numberOfTimes; ++t)
+	{
+		Block *block = this->findResidentBlock(t);
+		if (block)
+		{
+			for (size_t i = 0; i < copyCount; ++i)
+				block->values[destinations[i]] = block->values[sources[i]];
+			block->dirty = true;
+			continue;
+		}
+		for (size_t c = 0; c < chunks.size(); ++c)
+			this->readChunk(chunks[c], t, &(chunkValues[c*chunkSize]));
+		for (size_t i = 0; i < copyCount; ++i)
+			chunkValues[destinationOffsets[i]] = chunkValues[sourceOffsets[i]];
+		for (size_t c = 0; c < chunks.size(); ++c)
+			if (destinationChunk[c])
+				this->writeChunk(chunks[c], t, &(chunkValues[c*chunkSize]));
+	}
+	this->file.flush();
+	if (!this->file)
+	{
+		display_message(ERROR_MESSAGE, "FE_time_series_store::copySlots.  "
+			"Failed to write to file '%s'", this->fileName.c_str());
+		this->file.clear();
+		return false;
+	}
+	for (size_t i = 0; i < copyCount; ++i)
+		this->zeroSlots[destinations[i]] = false;
+	return true;
+}
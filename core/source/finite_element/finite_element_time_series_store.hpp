@@ -0,0 +1,178 @@
+/**
+ * FILE : finite_element_time_series_store.hpp
+ *
+ * Paged storage of time-varying nodal parameters in a scratch file, holding
+ * only a limited number of time steps in memory.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (FINITE_ELEMENT_TIME_SERIES_STORE_HPP)
+#define FINITE_ELEMENT_TIME_SERIES_STORE_HPP
+
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "general/value.h"
+
+/**
+ * Store for parameters at all times of one time sequence. Each parameter
+ * varying with the sequence is given a slot, and the values of all slots at
+ * one time form a block which is read from the scratch file on demand. Up to
+ * a maximum number of blocks are resident, least recently used blocks being
+ * written back if modified and discarded. When consecutive times are
+ * accessed, the next block in that direction is read ahead on a worker
+ * thread for animation playback.
+ * Blocks are split into chunks of slots, with the chunks for all times of
+ * each range of slots consecutive in the file so the file grows as slots are
+ * added without moving existing values. Never-written values read as zero.
+ * Slots known to be zero at all times are flagged so copying from them, as
+ * when creating nodes from a template, needs no values read. Copies to times
+ * not resident update only the affected chunks in the file.
+ * The scratch file is deleted with the store.
+ * Public methods lock the store's mutex, as even reading values changes
+ * resident blocks and the file, and values may be read by several threads at
+ * once, e.g. when writing EX files in parallel.
+ */
+class FE_time_series_store
+{
+	/** number of slots in each contiguous run of a block in the file */
+	static const int chunkSize = 8192;
+
+	struct Block
+	{
+		int timeIndex;
+		std::vector<FE_value> values;
+		bool dirty;
+		unsigned int lastUse;
+	};
+
+	std::string fileName;
+	std::fstream file;
+	int maximumResidentTimes;
+	int numberOfTimes;
+	int numberOfChunks;
+	int slotCount; // number of slots ever allocated since reset
+	int liveSlotCount;
+	std::vector<int> freeSlots;
+	std::vector<bool> zeroSlots; // per slot: true if zero at all times
+	std::vector<Block *> blocks;
+	Block *lastBlock;
+	unsigned int useCounter;
+	int lastTimeIndex;
+	int prefetchTimeIndex;
+	std::future<std::vector<FE_value> > prefetchValues;
+	mutable std::mutex mutex; // locked by public methods; private methods assume it is held
+
+	FE_time_series_store(const std::string& fileNameIn, int maximumResidentTimesIn);
+
+	FE_time_series_store(const FE_time_series_store&); // not implemented
+	FE_time_series_store& operator=(const FE_time_series_store&); // not implemented
+
+	static std::vector<FE_value> readBlock(const std::string& fileName,
+		int numberOfTimes, int numberOfChunks, int timeIndex);
+
+	bool writeBlock(Block& block);
+
+	void readChunk(int chunk, int timeIndex, FE_value *values);
+
+	void writeChunk(int chunk, int timeIndex, const FE_value *values);
+
+	Block *findResidentBlock(int timeIndex);
+
+	bool zeroSlotValues(int count, const int *slots);
+
+	void cancelPrefetch();
+
+	void prefetch(int timeIndex);
+
+	void notePlayback(int timeIndex1, int timeIndex2);
+
+	Block *getBlock(int timeIndex);
+
+	void reset(int numberOfTimesIn);
+
+public:
+
+	/**
+	 * Create store with a new, empty scratch file, replacing any file of the
+	 * same name.
+	 * @param maximumResidentTimes  Maximum number of time blocks held in
+	 * memory, at least 2 for interpolating between times.
+	 * @return  New store, to be deleted by caller, or 0 if failed.
+	 */
+	static FE_time_series_store *create(const char *fileName, int maximumResidentTimes);
+
+	~FE_time_series_store();
+
+	const std::string& getFileName() const
+	{
+		return this->fileName;
+	}
+
+	int getMaximumResidentTimes() const
+	{
+		return this->maximumResidentTimes;
+	}
+
+	int getNumberOfResidentTimes() const
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return static_cast<int>(this->blocks.size());
+	}
+
+	int getNumberOfSlots() const
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->liveSlotCount;
+	}
+
+	/**
+	 * Allocate a slot for a parameter varying over numberOfTimes. The number
+	 * of times can only change when no slots are in use, which discards all
+	 * stored values.
+	 * @param initialise  If true the slot's values are zero at all times,
+	 * otherwise they are undefined and must all be set by the caller.
+	 * Released slots are reused in either case, being zeroed if needed.
+	 * @return  Slot index, or -1 if failed.
+	 */
+	int allocateSlot(int numberOfTimesIn, bool initialise);
+
+	void releaseSlot(int slot);
+
+	/** @return  Value of slot at time index, or 0 if failed. */
+	FE_value getValue(int slot, int timeIndex);
+
+	/** @return  Value of slot linearly interpolated between two time indexes
+	 * with xi from 0 at the first to 1 at the second, or 0 if failed. */
+	FE_value getInterpolatedValue(int slot, int timeIndex1, int timeIndex2, FE_value xi);
+
+	bool setValue(int slot, int timeIndex, FE_value value);
+
+	/** Copy values at all times from source to destination slots, visiting
+	 * each time once. Sources which are zero at all times are not read, and
+	 * times not resident are copied in the file without loading the block. */
+	bool copySlots(int count, const int *sourceSlots, const int *destinationSlots);
+
+	/** Get slot index recorded in time value storage, or -1 if none. */
+	static int getValueStorageSlot(const Value_storage *storage)
+	{
+		return static_cast<int>(*reinterpret_cast<const intptr_t *>(storage)) - 1;
+	}
+
+	/** Record slot index in time value storage in place of an array pointer,
+	 * offset so storage cleared to null has no slot. */
+	static void setValueStorageSlot(Value_storage *storage, int slot)
+	{
+		*reinterpret_cast<intptr_t *>(storage) = static_cast<intptr_t>(slot + 1);
+	}
+
+};
+
+#endif /* !defined (FINITE_ELEMENT_TIME_SERIES_STORE_HPP) */
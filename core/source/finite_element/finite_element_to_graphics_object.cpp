@@ -1795,6 +1795,100 @@ int get_surface_element_segmentation(struct FE_element *element,
 }
 
 
+/**
+ * Get the direction of the line's own xi relative to the face xi of the
+ * surface element, by comparing the end nodes of the default coordinate
+ * field on each. Neighbouring elements may traverse a shared line in
+ * opposite directions.
+ * @return  0 if same direction, 1 if reversed, -1 if not determined.
+ */
+int FE_surface_shared_edge_data::getFaceOrientation(FE_mesh *mesh,
+	DsLabelIndex elementIndex, int faceNumber, DsLabelIndex lineIndex)
+{
+	const ElementFaceKey faceKey(elementIndex, faceNumber);
+	FaceOrientationMap::iterator iter = this->faceOrientations.find(faceKey);
+	if (iter != this->faceOrientations.end())
+		return iter->second;
+	int orientation = -1;
+	int faceNodeCount = 0;
+	int lineNodeCount = 0;
+	FE_node **faceNodes = 0;
+	FE_node **lineNodes = 0;
+	if (calculate_FE_element_field_nodes(mesh->getElement(elementIndex), faceNumber,
+			(FE_field *)0, &faceNodeCount, &faceNodes, /*top_level_element*/(FE_element *)0) &&
+		calculate_FE_element_field_nodes(mesh->getFaceMesh()->getElement(lineIndex), /*face_number*/-1,
+			(FE_field *)0, &lineNodeCount, &lineNodes, /*top_level_element*/(FE_element *)0) &&
+		(1 < faceNodeCount) && (faceNodeCount == lineNodeCount))
+	{
+		FE_node *faceStart = faceNodes[0];
+		FE_node *faceEnd = faceNodes[faceNodeCount - 1];
+		FE_node *lineStart = lineNodes[0];
+		FE_node *lineEnd = lineNodes[lineNodeCount - 1];
+		if (faceStart != faceEnd)
+		{
+			if ((faceStart == lineStart) && (faceEnd == lineEnd))
+				orientation = 0;
+			else if ((faceStart == lineEnd) && (faceEnd == lineStart))
+				orientation = 1;
+		}
+	}
+	for (int i = 0; i < faceNodeCount; ++i)
+		DEACCESS(FE_node)(faceNodes + i);
+	if (faceNodes)
+		DEALLOCATE(faceNodes);
+	for (int i = 0; i < lineNodeCount; ++i)
+		DEACCESS(FE_node)(lineNodes + i);
+	if (lineNodes)
+		DEALLOCATE(lineNodes);
+	this->faceOrientations[faceKey] = orientation;
+	return orientation;
+}
+
+const FE_value *FE_surface_shared_edge_data::findEdgePointValues(FE_mesh *mesh,
+	DsLabelIndex elementIndex, const FE_value *xi, bool& onEdge)
+{
+	onEdge = false;
+	FE_element_shape *shape = mesh->getElementShape(elementIndex);
+	const int faceCount = FE_element_shape_get_number_of_faces(shape);
+	for (int f = 0; f < faceCount; ++f)
+	{
+		// face_to_element maps face xi s to surface xi[j] = b[j] + a[j]*s
+		const FE_value *faceToElement = get_FE_element_shape_face_to_element(shape, f);
+		const FE_value a0 = faceToElement[1];
+		const FE_value a1 = faceToElement[3];
+		const FE_value d0 = xi[0] - faceToElement[0];
+		const FE_value d1 = xi[1] - faceToElement[2];
+		const FE_value s = (a0*d0 + a1*d1)/(a0*a0 + a1*a1);
+		if ((fabs(d0 - a0*s) > 1.0E-6) || (fabs(d1 - a1*s) > 1.0E-6))
+			continue;
+		const DsLabelIndex lineIndex = mesh->getElementFace(elementIndex, f);
+		if (lineIndex < 0)
+			continue;
+		const int orientation = this->getFaceOrientation(mesh, elementIndex, f, lineIndex);
+		if (orientation < 0)
+			continue;
+		onEdge = true;
+		const FE_value lineXi = (orientation) ? 1.0 - s : s;
+		this->edgePointKey = PointKey(lineIndex, static_cast<long>(floor(lineXi*1048576.0 + 0.5)));
+		PointOffsetMap::iterator iter = this->pointOffsets.find(this->edgePointKey);
+		if (iter != this->pointOffsets.end())
+		{
+			++(this->reuseCount);
+			return this->dataValues.data() + iter->second;
+		}
+		return 0;
+	}
+	return 0;
+}
+
+void FE_surface_shared_edge_data::addEdgePointValues(const FE_value *values)
+{
+	const size_t offset = this->dataValues.size();
+	this->dataValues.insert(this->dataValues.end(), values, values + this->numberOfDataValues);
+	this->pointOffsets[this->edgePointKey] = offset;
+	++(this->evaluationCount);
+}
+
 int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id surface_mesh,
 	struct Graphics_vertex_array *array,
@@ -1803,7 +1897,8 @@ int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 	struct Computed_field *data_field,
 	unsigned int number_of_segments_in_xi1_requested,
 	unsigned int number_of_segments_in_xi2_requested,
-	char reverse_normals, struct FE_element *top_level_element)
+	char reverse_normals, struct FE_element *top_level_element,
+	FE_surface_shared_edge_data *shared_edge_data)
 {
 	char modified_reverse_normals, special_normals;
 	enum Collapsed_element_type collapsed_element;
@@ -1866,6 +1961,7 @@ int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 			n_data_components = Computed_field_get_number_of_components(data_field);
 		}
 		const DsLabelIndex elementIndex = get_FE_element_index(element);
+		FE_mesh *fe_mesh = (shared_edge_data && data_field) ? FE_element_get_FE_mesh(element) : 0;
 		GLfloat *floatData = data_field ? new GLfloat[n_data_components] : 0;
 		FE_value *xi_points = new FE_value[2*number_of_points];
 		int replaceRequired = 0;
@@ -2033,10 +2129,22 @@ int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 				}
 				if (data_field)
 				{
-					if (CMZN_OK != cmzn_field_evaluate_real(data_field, field_cache, n_data_components, feData))
+					bool on_edge = false;
+					const FE_value *shared_data = (fe_mesh) ?
+						shared_edge_data->findEdgePointValues(fe_mesh, elementIndex, xi, on_edge) : 0;
+					if (shared_data)
+					{
+						for (j = 0; j < n_data_components; ++j)
+							feData[j] = shared_data[j];
+					}
+					else if (CMZN_OK != cmzn_field_evaluate_real(data_field, field_cache, n_data_components, feData))
 					{
 						return_code = 0;
 					}
+					else if (on_edge)
+					{
+						shared_edge_data->addEdgePointValues(feData);
+					}
 				}
 				if (texture_coordinate_field)
 				{
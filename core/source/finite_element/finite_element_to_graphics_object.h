@@ -14,6 +14,9 @@ The function prototypes for creating graphical objects from finite elements.
 #if !defined (FINITE_ELEMENT_TO_GRAPHICAL_OBJECT_H)
 #define FINITE_ELEMENT_TO_GRAPHICAL_OBJECT_H
 
+#include <map>
+#include <utility>
+#include <vector>
 #include "computed_field/computed_field.h"
 #include "finite_element/finite_element.h"
 #include "general/enumerator.h"
@@ -44,6 +47,71 @@ How an element is collapsed.
 	ELEMENT_COLLAPSED_XI2_1
 }; /* enum Collapsed_element_type */
 
+/**
+ * Stores data field values evaluated at points on the edges of surface
+ * elements, keyed by the line element shared through the mesh face
+ * connectivity and the line's own xi, so neighbouring surface elements
+ * reuse them instead of evaluating the data field again. Only valid for data
+ * fields which are continuous across element boundaries.
+ */
+class FE_surface_shared_edge_data
+{
+	typedef std::pair<DsLabelIndex, long> PointKey;
+	typedef std::map<PointKey, size_t> PointOffsetMap;
+	typedef std::pair<DsLabelIndex, int> ElementFaceKey;
+	typedef std::map<ElementFaceKey, int> FaceOrientationMap;
+
+	const int numberOfDataValues;
+	PointOffsetMap pointOffsets;
+	std::vector<FE_value> dataValues;
+	// cache of getFaceOrientation results
+	FaceOrientationMap faceOrientations;
+	// key of last point found on an edge, for adding values after evaluation
+	PointKey edgePointKey;
+	unsigned int evaluationCount;
+	unsigned int reuseCount;
+
+	int getFaceOrientation(FE_mesh *mesh, DsLabelIndex elementIndex,
+		int faceNumber, DsLabelIndex lineIndex);
+
+public:
+
+	FE_surface_shared_edge_data(int numberOfDataValuesIn) :
+		numberOfDataValues(numberOfDataValuesIn),
+		evaluationCount(0),
+		reuseCount(0)
+	{
+	}
+
+	/**
+	 * Find data values previously evaluated at xi in the surface element, if
+	 * on an edge shared through a line face.
+	 * @param xi  Surface element xi of point.
+	 * @param onEdge  Set to true if point is on an edge with a line face, in
+	 * which case addEdgePointValues must be called with the values evaluated
+	 * there if not found.
+	 * @return  Pointer to numberOfDataValues values, or 0 if not found.
+	 */
+	const FE_value *findEdgePointValues(FE_mesh *mesh, DsLabelIndex elementIndex,
+		const FE_value *xi, bool& onEdge);
+
+	/** Store values evaluated at the edge point last queried with
+	  * findEdgePointValues. */
+	void addEdgePointValues(const FE_value *values);
+
+	/** @return  Number of edge point data evaluations. */
+	unsigned int getEvaluationCount() const
+	{
+		return this->evaluationCount;
+	}
+
+	/** @return  Number of edge point data evaluations avoided by reuse. */
+	unsigned int getReuseCount() const
+	{
+		return this->reuseCount;
+	}
+};
+
 /*
 Global functions
 ----------------
@@ -210,6 +278,9 @@ int FE_element_add_line_to_vertex_array(struct FE_element *element,
  * @param field_cache  cmzn_fieldcache for evaluating fields. Time is expected
  * to be set in the field_cache if needed.
  * @param surface_mesh  2-D surface mesh being converted to surface graphics.
+ * @param shared_edge_data  Optional store for reusing data field values at
+ * points on edges shared with neighbouring surface elements, or 0 to evaluate
+ * data at all points of each element.
 */
 int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id surface_mesh,
@@ -219,7 +290,8 @@ int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 	struct Computed_field *data_field,
 	unsigned int number_of_segments_in_xi1_requested,
 	unsigned int number_of_segments_in_xi2_requested,
-	char reverse_normals, struct FE_element *top_level_element);
+	char reverse_normals, struct FE_element *top_level_element,
+	FE_surface_shared_edge_data *shared_edge_data);
 
 /***************************************************************************//**
  * Fills the array with coordinates from the <coordinate_field> and the radius for
@@ -856,7 +856,7 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 	struct Computed_field *isoscalar_field, FE_value iso_value,
 	struct Computed_field *data_field,int number_of_segments_in_xi1_requested,
 	int number_of_segments_in_xi2_requested,struct FE_element *top_level_element,
-	struct Graphics_vertex_array *array)
+	struct Graphics_vertex_array *array, FE_value *scalar_range)
 {
 	enum Collapsed_element_type collapsed_element;
 	enum FE_element_shape_type shape_type1;
@@ -930,6 +930,19 @@ int create_iso_lines_from_FE_element(struct FE_element *element,
 						(*point)[0]=GLfloat(coordinates[0]);
 						(*point)[1]=GLfloat(coordinates[1]);
 						(*point)[2]=GLfloat(coordinates[2]);
+						if (scalar_range)
+						{
+							if (*scalar < scalar_range[0])
+								scalar_range[0] = *scalar;
+							if (*scalar > scalar_range[1])
+								scalar_range[1] = *scalar;
+							if (*scalar != *scalar)
+							{
+								// NaN: range must never exclude any iso value
+								scalar_range[0] = -HUGE_VAL;
+								scalar_range[1] = HUGE_VAL;
+							}
+						}
 						point++;
 						scalar++;
 						datum += n_data_components;
@@ -25,12 +25,15 @@ value over 2-D elements.
  * <isoscalar_field> at <iso_value>.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param scalar_range  Optional array of minimum and maximum which are
+ * widened to include all scalar values sampled over the element. No contours
+ * are produced at iso values outside this range with the same segmentation.
  */
 int create_iso_lines_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *isoscalar_field, FE_value iso_value,
 	struct Computed_field *data_field,int number_of_segments_in_xi1_requested,
 	int number_of_segments_in_xi2_requested,struct FE_element *top_level_element,
-	struct Graphics_vertex_array *array);
+	struct Graphics_vertex_array *array, FE_value *scalar_range = 0);
 
 #endif /* !defined (FINITE_ELEMENT_TO_ISO_LINES_H) */
@@ -8,6 +8,7 @@
 * This Source Code Form is subject to the terms of the Mozilla Public
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include <cmath>
 #include <list>
 #include <map>
 #include "opencmiss/zinc/differentialoperator.h"
@@ -596,7 +597,12 @@ public:
 
 	~Isosurface_builder();
 
-	int sweep();
+	/**
+	 * Evaluate scalar over grid and find crossings for all iso values.
+	 * @param scalar_range  Optional array of minimum and maximum which are
+	 * widened to include all scalar values evaluated on the grid.
+	 */
+	int sweep(FE_value *scalar_range);
 
 	int fill_graphics(struct Graphics_vertex_array *array);
 
@@ -1649,7 +1655,7 @@ int Isosurface_builder::cross_triangle_wedge(
 	return (return_code);
 }
 
-int Isosurface_builder::sweep()
+int Isosurface_builder::sweep(FE_value *scalar_range)
 {
 	ENTER(Isosurface_builder::sweep);
 	int return_code = 1;
@@ -1686,6 +1692,19 @@ int Isosurface_builder::sweep()
 				{
 					scalar_value = static_cast<double>(scalar_FE_value);
 					set_scalar(i, j, k, scalar_value);
+					if (scalar_range)
+					{
+						if (scalar_FE_value < scalar_range[0])
+							scalar_range[0] = scalar_FE_value;
+						if (scalar_FE_value > scalar_range[1])
+							scalar_range[1] = scalar_FE_value;
+						if (scalar_FE_value != scalar_FE_value)
+						{
+							// NaN: range must never exclude any iso value
+							scalar_range[0] = -HUGE_VAL;
+							scalar_range[1] = HUGE_VAL;
+						}
+					}
 
 					for (int v = 0; v < number_of_iso_values; v++)
 					{
@@ -2115,7 +2134,8 @@ int Iso_surface_specification_destroy(
 int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
 	struct Graphics_vertex_array *array,
-	int *number_in_xi, struct Iso_surface_specification *specification)
+	int *number_in_xi, struct Iso_surface_specification *specification,
+	FE_value *scalar_range)
 {
 	ENTER(create_iso_surfaces_from_FE_element);
 	int return_code = 0;
@@ -2138,7 +2158,7 @@ int create_iso_surfaces_from_FE_element(struct FE_element *element,
 		{
 			Isosurface_builder iso_builder(element, field_cache, mesh,
 				number_in_xi[0], number_in_xi[1], number_in_xi[2], *specification);
-			return_code = iso_builder.sweep();
+			return_code = iso_builder.sweep(scalar_range);
 			if (return_code)
 			{
 				return_code = iso_builder.fill_graphics(array);
@@ -42,10 +42,15 @@ int Iso_surface_specification_destroy(
 
 /***************************************************************************//**
  * Converts a 3-D element into an iso_surface as a GT_surface_vertex_buffer
+ * @param scalar_range  Optional array of minimum and maximum which are
+ * widened to include all scalar values sampled over the element, if it is
+ * built. No surfaces are produced at iso values outside this range with the
+ * same number_in_xi.
  */
 int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
 	struct Graphics_vertex_array *array,
-	int *number_in_xi, struct Iso_surface_specification *specification);
+	int *number_in_xi, struct Iso_surface_specification *specification,
+	FE_value *scalar_range = 0);
 
 #endif /* !defined (FINITE_ELEMENT_TO_ISO_SURFACES_H) */
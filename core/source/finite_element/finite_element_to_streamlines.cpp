@@ -166,11 +166,133 @@ calculating the inverse of the Jacobian matrix <dxdxi> and multiplying.
 	return (return_code);
 } /* calculate_delta_xi */
 
+/**
+ * Evaluates the coordinates <point> and their derivatives <dxdxi> at <xi> in
+ * <element>, and converts the stream vector there into the rate of change of
+ * xi <deltaxi>. If <reverse_track> is true, the reverse of the stream vector
+ * is used.
+ */
+static int evaluate_streamline_delta_xi(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field,
+	struct Computed_field *stream_vector_field, int reverse_track,
+	struct FE_element *element, int element_dimension, int vector_dimension,
+	FE_value *xi, FE_value *point, FE_value *dxdxi, FE_value *deltaxi)
+{
+	FE_value vector[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS];
+	if ((CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, element, element_dimension, xi)) &&
+		(CMZN_OK == cmzn_field_evaluate_real_with_derivatives(coordinate_field, field_cache,
+			vector_dimension, point, /*number_of_derivatives*/element_dimension, dxdxi)) &&
+		(CMZN_OK == cmzn_field_evaluate_real(stream_vector_field, field_cache,
+			MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS, vector)))
+	{
+		if (reverse_track)
+		{
+			for (int i = 0 ; i < vector_dimension ; i++)
+			{
+				vector[i] = -vector[i];
+			}
+		}
+		return calculate_delta_xi(vector_dimension, vector, element_dimension,
+			dxdxi, deltaxi);
+	}
+	return 0;
+}
+
+/**
+ * Moves the streamline at <xi> on face <face_number> of <*element>, with
+ * <xi_face> on that face, into the adjacent element. Permutations of the
+ * adjacent element's xi are tried until its coordinates match <point> to
+ * within <coordinate_tolerance>, relative to <coordinate_length>.
+ * <*keep_tracking> is cleared if there is no adjacent element or the
+ * coordinates cannot be matched, in which case <*element> and <xi> are left
+ * at the boundary of the original element.
+ */
+static int change_streamline_element(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field, struct FE_element **element,
+	FE_value *xi, int face_number, FE_value *xi_face, FE_value *point,
+	FE_value coordinate_length, FE_value coordinate_tolerance, int *keep_tracking)
+{
+	FE_value coordinate_point_error, initial_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		new_point[3] = { 0.0, 0.0, 0.0 };
+	int i, number_of_permutations, permutation, return_code;
+	struct FE_element *initial_element = *element;
+	const int initial_face_number = face_number;
+	const int element_dimension = get_FE_element_dimension(*element);
+	const int vector_dimension = Computed_field_get_number_of_components(coordinate_field);
+	initial_xi[0]=xi[0];
+	initial_xi[1]=xi[1];
+	initial_xi[2]=xi[2];
+	return_code = FE_element_change_to_adjacent_element(element,
+		xi, (FE_value *)NULL, &face_number, xi_face, /*permutation*/0);
+	if (face_number == -1)
+	{
+		/* There is no adjacent element */
+		*keep_tracking = 0;
+	}
+	else
+	{
+		/* Check the new xi coordinates are correct for our
+		coordinate field and if not try rotating them */
+		return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xi)) &&
+			(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, new_point));
+		coordinate_point_error = 0.0;
+		for (i = 0 ; i < vector_dimension ; i++)
+		{
+			coordinate_point_error += (new_point[i] - point[i]) *
+				(new_point[i] - point[i]);
+		}
+		coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
+		// this permutation loop is inefficient; should extract common adjacent element code
+		number_of_permutations =
+			FE_element_get_number_of_change_to_adjacent_element_permutations(
+				*element, xi, face_number);
+		/* We have already tried permutation 0 */
+		permutation = 1;
+		while ((permutation < number_of_permutations) &&
+			(coordinate_point_error > coordinate_tolerance))
+		{
+			*element = initial_element;
+			face_number = initial_face_number;
+			xi[0]=initial_xi[0];
+			xi[1]=initial_xi[1];
+			xi[2]=initial_xi[2];
+			return_code = FE_element_change_to_adjacent_element(element,
+				xi, (FE_value *)NULL, &face_number, xi_face, permutation);
+			return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xi)) &&
+				(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, new_point));
+			coordinate_point_error = 0.0;
+			for (i = 0 ; i < vector_dimension ; i++)
+			{
+				coordinate_point_error += (new_point[i] - point[i]) *
+					(new_point[i] - point[i]);
+			}
+			coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
+			permutation++;
+		}
+		if (!get_FE_element_shape(*element))
+		{
+			display_message(ERROR_MESSAGE, "track_streamline_from_FE_element.  Missing shape.");
+			*keep_tracking = 0;
+		}
+		if (coordinate_point_error > coordinate_tolerance)
+		{
+			display_message(ERROR_MESSAGE,"track_streamline_from_FE_element.  "
+				"Coordinates don't match after changing elements.");
+			*keep_tracking = 0;
+			*element = initial_element;
+			xi[0]=initial_xi[0];
+			xi[1]=initial_xi[1];
+			xi[2]=initial_xi[2];
+		}
+	}
+	return (return_code);
+}
+
 static int update_adaptive_imp_euler(cmzn_fieldcache_id field_cache,
 	struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
 	struct FE_element **element,FE_value *xi,
-	FE_value *point,FE_value *step_size,
+	FE_value *point,FE_value *step_size,FE_value tolerance,
 	FE_value *total_stepped, int *keep_tracking)
 /*******************************************************************************
 LAST MODIFIED : 23 June 2004
@@ -179,23 +301,23 @@ DESCRIPTION :
 Update the xi coordinates using the <stream_vector_field> with adaptive step
 size control and the improved euler method.  The function updates the <total_stepped>.
 If <reverse_track> is true, the reverse of vector field is tracked.
+The <tolerance> is the maximum difference in xi between a whole step and two
+half steps.
 ==============================================================================*/
 {
-	int element_dimension,face_number,i,initial_face_number,j,
-		number_of_permutations, permutation, return_code,vector_dimension, face_numberB = 0;
+	int element_dimension,face_number,i,j,return_code,vector_dimension, face_numberB = 0;
 	FE_value coordinate_length, coordinate_point_error, coordinate_point_vector, coordinate_tolerance,
 		deltaxi[MAXIMUM_ELEMENT_XI_DIMENSIONS],deltaxiA[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		deltaxiC[MAXIMUM_ELEMENT_XI_DIMENSIONS], deltaxiD[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		deltaxiE[MAXIMUM_ELEMENT_XI_DIMENSIONS], 
 		dxdxi[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS], error, fraction,
 		increment_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS], local_step_size,
-		point1[3], point2[3], point3[3], tolerance, 
+		point1[3], point2[3], point3[3], 
 		vector[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS], 
 		xiA[MAXIMUM_ELEMENT_XI_DIMENSIONS], xiB[MAXIMUM_ELEMENT_XI_DIMENSIONS], 
 		xiC[MAXIMUM_ELEMENT_XI_DIMENSIONS], xiD[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		xiE[MAXIMUM_ELEMENT_XI_DIMENSIONS], xiF[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-	struct FE_element *initial_element;
 
 	ENTER(update_adaptive_imp_euler);
 	/* clear coordinates in case fewer than 3 components */
@@ -215,7 +337,6 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 	point3[0]=0.0;
 	point3[1]=0.0;
 	point3[2]=0.0;
-	tolerance=1.0e-4;
 	error=1.0;
 	coordinate_point_error = 1.0;
 	coordinate_tolerance = 1.0e-2;  /* We are tolerating a greater error in the coordinate
@@ -514,78 +635,11 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 			*total_stepped += local_step_size;
 			if (face_number != -1)
 			{
-				initial_element = *element;
-				initial_face_number = face_number;
-				xiD[0]=xiF[0];
-				xiD[1]=xiF[1];
-				xiD[2]=xiF[2];
 				/* The last increment should have been the most accurate, if
 				it wants to change then change element if we can */
-				return_code = FE_element_change_to_adjacent_element(element,
-					xiF, (FE_value *)NULL, &face_number, xi_face, /*permutation*/0);
-				if (face_number == -1)
-				{
-					/* There is no adjacent element */
-					*keep_tracking = 0;
-				}
-				else
-				{
-					/* Check the new xi coordinates are correct for our
-					coordinate field and if not try rotating them */
-
-					return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xiF)) &&
-						(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-					coordinate_point_error = 0.0;
-					for (i = 0 ; i < vector_dimension ; i++)
-					{
-						coordinate_point_error += (point1[i] - point3[i]) * 
-							(point1[i] - point3[i]);
-					}
-					coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-					// this permutation loop is inefficient; should extract common adjacent element code
-					number_of_permutations =
-						FE_element_get_number_of_change_to_adjacent_element_permutations(
-							*element, xiF, face_number);
-					/* We have already tried permutation 0 */
-					permutation = 1;
-					while ((permutation < number_of_permutations) &&
-						(coordinate_point_error > coordinate_tolerance))
-					{
-						*element = initial_element;
-						face_number = initial_face_number;
-						xiF[0]=xiD[0];
-						xiF[1]=xiD[1];
-						xiF[2]=xiD[2];
-						return_code = FE_element_change_to_adjacent_element(element,
-							xiF, (FE_value *)NULL, &face_number, xi_face, permutation);
-						return_code = (CMZN_OK == cmzn_fieldcache_set_mesh_location(field_cache, *element, element_dimension, xiF)) &&
-							(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-						coordinate_point_error = 0.0;
-						for (i = 0 ; i < vector_dimension ; i++)
-						{
-							coordinate_point_error += (point1[i] - point3[i]) *
-								(point1[i] - point3[i]);
-						}
-						coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-						permutation++;
-					}
-					element_shape = get_FE_element_shape(*element);
-					if (!element_shape)
-					{
-						display_message(ERROR_MESSAGE, "track_streamline_from_FE_element.  Missing shape.");
-						*keep_tracking = 0;
-					}
-					if (coordinate_point_error > coordinate_tolerance)
-					{
-						display_message(ERROR_MESSAGE,"track_streamline_from_FE_element.  "
-							"Coordinates don't match after changing elements.");
-						*keep_tracking = 0;
-						*element = initial_element;
-						xiF[0]=xiD[0];
-						xiF[1]=xiD[1];
-						xiF[2]=xiD[2];
-					}
-				}
+				return_code = change_streamline_element(field_cache, coordinate_field,
+					element, xiF, face_number, xi_face, point3, coordinate_length,
+					coordinate_tolerance, keep_tracking);
 			}
 			else
 			{
@@ -611,6 +665,169 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 	return (return_code);
 } /* update_adaptive_imp_euler */
 
+/**
+ * Update the xi coordinates using the <stream_vector_field> with the embedded
+ * Runge-Kutta 4(5) method of Dormand and Prince. The step is accepted if the
+ * difference between the 4th and 5th order solutions in xi is within
+ * <tolerance>, and the 5th order solution is used. The next <step_size> is
+ * predicted from the error. Steps ending on the element boundary are shortened
+ * to it, and tracking continues in the adjacent element.
+ * The function updates the <total_stepped>.
+ * If <reverse_track> is true, the reverse of vector field is tracked.
+ */
+static int update_adaptive_runge_kutta_45(cmzn_fieldcache_id field_cache,
+	struct Computed_field *coordinate_field,
+	struct Computed_field *stream_vector_field, int reverse_track,
+	struct FE_element **element, FE_value *xi,
+	FE_value *point, FE_value *step_size, FE_value tolerance,
+	FE_value *total_stepped, int *keep_tracking)
+{
+	/* Dormand-Prince stage coefficients; the last row gives the 5th order solution,
+		which is also the location of the final stage */
+	static const FE_value a[6][6] =
+	{
+		{ 1.0/5.0 },
+		{ 3.0/40.0, 9.0/40.0 },
+		{ 44.0/45.0, -56.0/15.0, 32.0/9.0 },
+		{ 19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0 },
+		{ 9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0 },
+		{ 35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0 }
+	};
+	/* 5th order minus 4th order weights, giving the error estimate */
+	static const FE_value e[7] =
+	{
+		71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0
+	};
+	const int maximum_attempts = 50;
+	/* We are tolerating a greater error in the coordinate positions so long as
+		the tracking is valid */
+	const FE_value coordinate_tolerance = 1.0e-2;
+	FE_value component, coordinate_length,
+		dxdxi[MAXIMUM_ELEMENT_XI_DIMENSIONS*MAXIMUM_ELEMENT_XI_DIMENSIONS], error,
+		factor, fraction, increment_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		k[7][MAXIMUM_ELEMENT_XI_DIMENSIONS], local_step_size, magnitude,
+		stage_point[3] = { 0.0, 0.0, 0.0 }, start_point[3] = { 0.0, 0.0, 0.0 },
+		xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS],
+		xi_stage[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 0.0, 0.0, 0.0 };
+	int attempt, face_number, i, j, return_code, stage;
+
+	FE_element_shape *element_shape = get_FE_element_shape(*element);
+	const int element_dimension = get_FE_element_shape_dimension(element_shape);
+	/* the vector field may have extra components related to the cross directions
+		which are used to orient stream ribbons and tubes */
+	const int vector_dimension = Computed_field_get_number_of_components(coordinate_field);
+	return_code = evaluate_streamline_delta_xi(field_cache, coordinate_field,
+		stream_vector_field, reverse_track, *element, element_dimension,
+		vector_dimension, xi, start_point, dxdxi, k[0]);
+	if (!return_code)
+	{
+		return 0;
+	}
+	/* Get a length scale estimate */
+	coordinate_length = 0.0;
+	for (i = 0 ; i < vector_dimension ; i++)
+	{
+		for (j = 0 ; j < element_dimension ; j++)
+		{
+			coordinate_length += dxdxi[i + j * vector_dimension] *
+				dxdxi[i + j * vector_dimension];
+		}
+	}
+	coordinate_length = sqrt(coordinate_length / (FE_value)element_dimension);
+	magnitude = sqrt(k[0][0]*k[0][0] + k[0][1]*k[0][1] + k[0][2]*k[0][2]);
+	if (0.0 >= magnitude)
+	{
+		/* streamline is not going anywhere */
+		*keep_tracking = 0;
+		point[0] = start_point[0];
+		point[1] = start_point[1];
+		point[2] = start_point[2];
+		return 1;
+	}
+	local_step_size = *step_size;
+	if (local_step_size == 0.0)
+	{
+		/* This is the first step, set the step_size to make the
+			magnitude of deltaxi 0.01 */
+		local_step_size = 1.0e-2 / magnitude;
+	}
+	error = 0.0;
+	fraction = 1.0;
+	face_number = -1;
+	for (attempt = 0 ; attempt < maximum_attempts ; attempt++)
+	{
+		for (stage = 1 ; return_code && (stage < 7) ; stage++)
+		{
+			for (i = 0 ; i < element_dimension ; i++)
+			{
+				xi_stage[i] = xi[i];
+				component = 0.0;
+				for (j = 0 ; j < stage ; j++)
+				{
+					component += a[stage - 1][j] * k[j][i];
+				}
+				increment_xi[i] = local_step_size * component;
+			}
+			/* Stages leaving the element are limited to its boundary. For the
+				final stage at the 5th order solution this gives the fraction of
+				the step taken and the face reached */
+			return_code = FE_element_shape_xi_increment(element_shape, xi_stage,
+				increment_xi, &fraction, &face_number, xi_face) &&
+				evaluate_streamline_delta_xi(field_cache, coordinate_field,
+					stream_vector_field, reverse_track, *element, element_dimension,
+					vector_dimension, xi_stage, stage_point, dxdxi, k[stage]);
+		}
+		if (!return_code)
+		{
+			break;
+		}
+		error = 0.0;
+		for (i = 0 ; i < element_dimension ; i++)
+		{
+			component = 0.0;
+			for (j = 0 ; j < 7 ; j++)
+			{
+				component += e[j] * k[j][i];
+			}
+			error += component * component;
+		}
+		error = local_step_size * sqrt(error);
+		/* accept if within tolerance, or the step is too small to matter */
+		if ((error <= tolerance) || (local_step_size * magnitude < tolerance))
+		{
+			break;
+		}
+		factor = 0.9 * pow(tolerance / error, 0.2);
+		local_step_size *= (factor < 0.1) ? 0.1 : factor;
+	}
+	if (return_code)
+	{
+		/* predict the next step size from the error, limiting growth */
+		factor = (0.0 < error) ? 0.9 * pow(tolerance / error, 0.2) : 5.0;
+		*step_size = local_step_size * ((factor > 5.0) ? 5.0 : ((factor < 1.0) ? 1.0 : factor));
+		if (face_number != -1)
+		{
+			/* Reduce the step size to that which was actually taken */
+			local_step_size *= fraction;
+		}
+		*total_stepped += local_step_size;
+		for (i = 0 ; i < element_dimension ; i++)
+		{
+			xi[i] = xi_stage[i];
+		}
+		point[0] = stage_point[0];
+		point[1] = stage_point[1];
+		point[2] = stage_point[2];
+		if (face_number != -1)
+		{
+			return_code = change_streamline_element(field_cache, coordinate_field,
+				element, xi, face_number, xi_face, point, coordinate_length,
+				coordinate_tolerance, keep_tracking);
+		}
+	}
+	return (return_code);
+}
+
 static int update_interactive_streampoint(FE_value *point_coordinates,
 	struct FE_element **element, cmzn_fieldcache_id field_cache,
 	struct Computed_field *coordinate_field, FE_value *xi, FE_value *translate)
@@ -693,7 +910,8 @@ accurate if small), also ensuring that the element is updated.
 static int track_streamline_from_FE_element(struct FE_element **element,
 	FE_value *xi, cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	FE_value tolerance, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,int *number_of_points,
 	Triple **stream_points,Triple **stream_vectors,Triple **stream_normals,
 	GLfloat **stream_data)
@@ -716,6 +934,9 @@ On unsuccessful return the above arrays are deallocated.
 If <reverse_track> is true, the reverse of <stream_vector_field> is tracked, and
 the negative travel_scalar is recorded, if requested.
 
+Steps are taken with the <integration_method>, with step size adjusted to keep
+the estimated error in xi within <tolerance>.
+
 The <stream_vector_field> may have 3, 6 or 9 components, the first 3 components
 of which returns the vector along which the streamline is tracked. Additional
 information about lateral direction and normal to a streamribbon are found by
@@ -758,7 +979,8 @@ following way:
 		(9==number_of_stream_vector_components)))
 		|| ((2 == number_of_coordinate_components) &&
 		(2==number_of_stream_vector_components)))&&
-		(0.0<length) && ((colour_data_type != CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD) ||
+		(0.0<length) && (0.0<tolerance) &&
+		((colour_data_type != CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD) ||
 		(0 == data_field) || (1 == cmzn_field_get_number_of_components(data_field))) &&
 		number_of_points&&stream_points&&stream_vectors&&stream_normals&&
 		((!hasData) || stream_data))
@@ -1207,9 +1429,18 @@ following way:
 							previous_total_stepped_A = total_stepped;
 							previous_element_B = previous_element_A;
 							previous_element_A = *element;
-							return_code=update_adaptive_imp_euler(field_cache,coordinate_field,
-								stream_vector_field,reverse_track,element,xi,
-								coordinates,&step_size,&total_stepped,&keep_tracking);
+							if (CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45 == integration_method)
+							{
+								return_code=update_adaptive_runge_kutta_45(field_cache,coordinate_field,
+									stream_vector_field,reverse_track,element,xi,
+									coordinates,&step_size,tolerance,&total_stepped,&keep_tracking);
+							}
+							else
+							{
+								return_code=update_adaptive_imp_euler(field_cache,coordinate_field,
+									stream_vector_field,reverse_track,element,xi,
+									coordinates,&step_size,tolerance,&total_stepped,&keep_tracking);
+							}
 							/* If we haven't gone anywhere and are changing back to the previous
 								element then we are stuck */
 							if (total_stepped == previous_total_stepped_B)
@@ -1357,7 +1588,8 @@ int create_polyline_streamline_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	FE_value tolerance, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,
 	struct Graphics_vertex_array *array)
 {
@@ -1385,7 +1617,7 @@ int create_polyline_streamline_FE_element_vertex_array(
 			/* track points and normals on streamline, and data if requested */
 			if (track_streamline_from_FE_element(&element,start_xi,
 				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
+				integration_method,tolerance,colour_data_type,data_field,&number_of_stream_points,&stream_points,
 					&stream_vectors,&stream_normals,&stream_data))
 			{
 				if (0<number_of_stream_points)
@@ -1437,6 +1669,7 @@ int create_surface_streamribbon_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track, FE_value length,
+	enum cmzn_graphics_streamlines_integration_method integration_method, FE_value tolerance,
 	enum cmzn_graphicslineattributes_shape_type line_shape, int circleDivisions,
 	FE_value *line_base_size, FE_value *line_scale_factors,
 	struct Computed_field *line_orientation_scale_field,
@@ -1478,7 +1711,7 @@ int create_surface_streamribbon_FE_element_vertex_array(
 			/* track points and normals on streamline, and data if requested */
 			if (track_streamline_from_FE_element(&element,start_xi,
 				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
+				integration_method,tolerance,colour_data_type,data_field,&number_of_stream_points,&stream_points,
 				&stream_vectors,&stream_normals,&stream_data))
 			{
 				if (0<number_of_stream_points)
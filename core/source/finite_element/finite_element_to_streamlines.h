@@ -65,12 +65,15 @@ Global functions
  * stream vector is tracked, and the travel_scalar is made negative.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param integration_method  Method for stepping along the streamline.
+ * @param tolerance  Maximum estimated error in xi per step, > 0.
  */
 int create_polyline_streamline_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	FE_value length, enum cmzn_graphics_streamlines_integration_method integration_method,
+	FE_value tolerance, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
 	struct Computed_field *data_field,
 	struct Graphics_vertex_array *array);
 
@@ -81,6 +84,8 @@ int create_polyline_streamline_FE_element_vertex_array(
  * stream vector is tracked, and the travel_scalar is made negative.
  * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
  * expected to have been set in the field_cache if needed.
+ * @param integration_method  Method for stepping along the streamline.
+ * @param tolerance  Maximum estimated error in xi per step, > 0.
  * @param line_shape  LINE, RIBBON, CIRCLE_EXTRUSION or SQUARE_EXTRUSION.
  * @param line_base_size  width and thickness of line, use depends on shape.
  * @param line_scale_factors  Ignored. For future use.
@@ -90,6 +95,7 @@ int create_surface_streamribbon_FE_element_vertex_array(
 	struct FE_element *element,FE_value *start_xi,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
 	struct Computed_field *stream_vector_field,int reverse_track, FE_value length,
+	enum cmzn_graphics_streamlines_integration_method integration_method, FE_value tolerance,
 	enum cmzn_graphicslineattributes_shape_type line_shape, int circleDivisions,
 	FE_value *line_base_size, FE_value *line_scale_factors,
 	struct Computed_field *line_orientation_scale_field,
@@ -18,6 +18,7 @@
 #include "finite_element/finite_element_region.h"
 #include "finite_element/finite_element_time.h"
 #include "finite_element/import_finite_element.h"
+#include "general/byte_order.hpp"
 #include "general/debug.h"
 #include "general/math.h"
 #include "general/io_stream.h"
@@ -36,6 +37,52 @@ Module functions
 ----------------
 */
 
+/**
+ * Reads <number_of_values> real values written as a binary block by the EX
+ * writer: optional whitespace, an '@' marker, then the raw values as
+ * little-endian IEEE doubles.
+ * @return  1 on success, 0 on failure with error reported.
+ */
+static int read_FE_value_block_binary(struct IO_stream *input_file,
+	int number_of_values, FE_value *values)
+{
+	static_assert(sizeof(FE_value) == sizeof(double),
+		"Binary EX values require double precision FE_value");
+	char *location;
+	IO_stream_scan(input_file, " ");
+	if ('@' != IO_stream_getc(input_file))
+	{
+		location = IO_stream_get_location_string(input_file);
+		display_message(ERROR_MESSAGE,
+			"Missing binary values marker '@'.  %s", location);
+		DEALLOCATE(location);
+		return 0;
+	}
+	const size_t size = number_of_values*sizeof(FE_value);
+	if (static_cast<size_t>(IO_stream_fread(input_file, values, 1, size)) != size)
+	{
+		location = IO_stream_get_location_string(input_file);
+		display_message(ERROR_MESSAGE,
+			"Truncated binary values block.  %s", location);
+		DEALLOCATE(location);
+		return 0;
+	}
+	if (!host_is_little_endian())
+		swap_byte_order(values, number_of_values);
+	for (int i = 0; i < number_of_values; ++i)
+	{
+		if (!finite(values[i]))
+		{
+			location = IO_stream_get_location_string(input_file);
+			display_message(ERROR_MESSAGE,
+				"Infinity or NAN read from binary values block.  %s", location);
+			DEALLOCATE(location);
+			return 0;
+		}
+	}
+	return 1;
+}
+
 static int read_element_xi_value(struct IO_stream *input_file,
 	struct cmzn_region *root_region, struct cmzn_region *current_region,
 	struct FE_element **element_address, FE_value *xi)
@@ -1305,15 +1352,16 @@ from a previous call to this function.
 	return (node);
 } /* read_FE_node_field_info */
 
-/***************************************************************************//**
- * Reads in a node from an <input_file>.
- * @param group  Optional group to put node into.
+/**
+ * Reads a node from <input_file> following the Node token, with fields as
+ * in <template_node>. If <binary_values> is true, real values for each field
+ * are read from a binary block.
  */
 static struct FE_node *read_FE_node(struct IO_stream *input_file,
 	struct FE_node *template_node, FE_nodeset *fe_nodeset,
 	cmzn_region_id root_region, cmzn_region_id region,
 	struct FE_field_order_info *field_order_info,
-	struct FE_import_time_index *time_index)
+	struct FE_import_time_index *time_index, bool binary_values)
 {
 	char *location;
 	enum Value_type value_type;
@@ -1396,7 +1444,9 @@ static struct FE_node *read_FE_node(struct IO_stream *input_file,
 
 										if (ALLOCATE(values, FE_value, number_of_values))
 										{
-											for (k = 0; (k < number_of_values) && return_code; k++)
+											if (binary_values)
+												return_code = read_FE_value_block_binary(input_file, number_of_values, values);
+											for (k = 0; (k < number_of_values) && return_code && (!binary_values); k++)
 											{
 												if (1 != IO_stream_scan(input_file, FE_VALUE_INPUT_STRING,
 													&(values[k])))
@@ -2915,7 +2965,7 @@ from a previous call to this function.
 static struct FE_element *read_FE_element(struct IO_stream *input_file,
 	FE_element_template *element_template, FE_mesh *fe_mesh,
 	FE_nodeset *fe_nodeset, struct FE_field_order_info *field_order_info,
-	bool& existingElement)
+	bool binary_values, bool& existingElement)
 {
 	char *location, test_string[5];
 	enum Value_type value_type;
@@ -3151,7 +3201,9 @@ static struct FE_element *read_FE_element(struct IO_stream *input_file,
 													return_code = 0;
 												}
 											}
-											for (k = 0; (k < number_of_values) && return_code; k++)
+											if (return_code && binary_values)
+												return_code = read_FE_value_block_binary(input_file, number_of_values, values);
+											for (k = 0; (k < number_of_values) && return_code && (!binary_values); k++)
 											{
 												if (1 != IO_stream_scan(input_file, FE_VALUE_INPUT_STRING,
 													&(values[k])))
@@ -3329,7 +3381,33 @@ static struct FE_element *read_FE_element(struct IO_stream *input_file,
 								display_message(WARNING_MESSAGE,
 									"Truncated read of required \" Scale factors:\" token in element file.");
 							}
-							for (i = 0; (i < number_of_scale_factors) && return_code; i++)
+							if (binary_values)
+							{
+								FE_value *scale_factors;
+								if (ALLOCATE(scale_factors, FE_value, number_of_scale_factors))
+								{
+									return_code = read_FE_value_block_binary(input_file,
+										number_of_scale_factors, scale_factors);
+									for (i = 0; (i < number_of_scale_factors) && return_code; i++)
+									{
+										if (!set_FE_element_scale_factor(element, i, scale_factors[i]))
+										{
+											location = IO_stream_get_location_string(input_file);
+											display_message(ERROR_MESSAGE,
+												"Error setting scale factor.  %s",
+												location);
+											DEALLOCATE(location);
+											return_code = 0;
+										}
+									}
+									DEALLOCATE(scale_factors);
+								}
+								else
+								{
+									return_code = 0;
+								}
+							}
+							for (i = 0; (i < number_of_scale_factors) && return_code && (!binary_values); i++)
 							{
 								if (1 == IO_stream_scan(input_file,FE_VALUE_INPUT_STRING,
 									&scale_factor))
@@ -3433,6 +3511,8 @@ static int read_exregion_file_private(struct cmzn_region *root_region,
 	if (root_region && input_file)
 	{
 		int use_data_meta_flag = use_data;
+		// set by directive if real values are in binary blocks
+		bool binary_values = false;
 		cmzn_region_begin_hierarchical_change(root_region);
 		/* region is the same as read_region if reading into a true region,
 		 * otherwise it is the parent region of read_region group */
@@ -3736,6 +3816,25 @@ static int read_exregion_file_private(struct cmzn_region *root_region,
 								return_code = 0;
 							}
 						}
+						// directive !#binary_values little-endian
+						// following real values are in binary blocks
+						else if (1 == IO_stream_scan(input_file, "#binary_value%1[s] ", test_string))
+						{
+							char *byteOrder = 0;
+							if (IO_stream_read_string(input_file, "[^,\n\r]", &byteOrder) &&
+								(0 == strncmp("little-endian", byteOrder, 13)))
+							{
+								binary_values = true;
+							}
+							else
+							{
+								location = IO_stream_get_location_string(input_file);
+								display_message(ERROR_MESSAGE, "Unsupported binary values byte order at location %s", location);
+								DEALLOCATE(location);
+								return_code = 0;
+							}
+							DEALLOCATE(byteOrder);
+						}
 						// ignore to end of line for comment AND directive, in case we extend directive
 						IO_stream_read_string(input_file, "[^\n\r]", &comment);
 						DEALLOCATE(comment);
@@ -3799,7 +3898,7 @@ static int read_exregion_file_private(struct cmzn_region *root_region,
 							if (template_node)
 							{
 								FE_node *tmp_node = read_FE_node(input_file, template_node, fe_nodeset,
-									root_region, region, field_order_info, time_index);
+									root_region, region, field_order_info, time_index, binary_values);
 								if (tmp_node)
 								{
 									ACCESS(FE_node)(tmp_node);
@@ -3867,7 +3966,7 @@ static int read_exregion_file_private(struct cmzn_region *root_region,
 							{
 								bool existingElement = false;
 								FE_element *element = read_FE_element(input_file, element_template,
-									fe_mesh, fe_nodeset, field_order_info, existingElement);
+									fe_mesh, fe_nodeset, field_order_info, binary_values, existingElement);
 								if (element)
 								{
 									if (existingElement)
@@ -0,0 +1,43 @@
+/**
+ * FILE : byte_order.hpp
+ * 
+ * Utilities for converting binary data to and from little-endian byte order.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (BYTE_ORDER_HPP)
+#define BYTE_ORDER_HPP
+
+#include <cstddef>
+
+/** @return  True if the host stores multi-byte values little-endian. */
+inline bool host_is_little_endian()
+{
+	const unsigned short test = 1;
+	return 1 == *reinterpret_cast<const unsigned char *>(&test);
+}
+
+/**
+ * Reverses the byte order of each of <count> values of ValueType in place.
+ * Converts between little-endian and host order on big-endian hosts.
+ */
+template <typename ValueType>
+inline void swap_byte_order(ValueType *values, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		unsigned char *bytes = reinterpret_cast<unsigned char *>(values + i);
+		for (size_t j = 0; j < sizeof(ValueType)/2; ++j)
+		{
+			const unsigned char tmp = bytes[j];
+			bytes[j] = bytes[sizeof(ValueType) - 1 - j];
+			bytes[sizeof(ValueType) - 1 - j] = tmp;
+		}
+	}
+}
+
+#endif /* !defined (BYTE_ORDER_HPP) */
@@ -1212,6 +1212,22 @@ public:
 		count = 0;
 	}
 
+	/**
+	 * Swaps indexed contents with other btree; related set links are unchanged.
+	 * Iterators over both btrees are invalidated. Cannot fail.
+	 */
+	inline void swap(cmzn_btree_index& other)
+	{
+		this->invalidateIterators();
+		other.invalidateIterators();
+		BTreeNode *temp_index = this->index;
+		this->index = other.index;
+		other.index = temp_index;
+		const int temp_count = this->count;
+		this->count = other.count;
+		other.count = temp_count;
+	}
+
 	/** Note: caller must ensure object is valid! */
 	inline bool insert(owner_type &owner, object_type object)
 	{
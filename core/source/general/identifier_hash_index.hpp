@@ -0,0 +1,225 @@
+/**
+ * FILE : identifier_hash_index.hpp
+ *
+ * Open-addressing hash table mapping non-negative integer identifiers to
+ * integer indexes. Identifier and index are stored together in one flat
+ * array, so a lookup usually touches a single cache line, unlike indexes
+ * which must fetch the identifier for every comparison.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (IDENTIFIER_HASH_INDEX_HPP)
+#define IDENTIFIER_HASH_INDEX_HPP
+
+#include "general/debug.h"
+
+// IdentifierType = integer key type; negative values are not permitted
+// IndexType = integer value type
+// InvalidIndex = value returned by find() if identifier not present
+template <typename IdentifierType, typename IndexType, IndexType InvalidIndex>
+	class identifier_hash_index
+{
+private:
+	struct Entry
+	{
+		IdentifierType identifier; // negative if empty
+		IndexType index;
+	};
+
+	// Note: any new attributes must be handled by swap()
+	Entry *entries;
+	unsigned int capacity; // power of 2, or 0 if not allocated
+	unsigned int shift; // 32 - log2(capacity)
+	unsigned int count;
+
+	identifier_hash_index(const identifier_hash_index&); // not implemented
+	identifier_hash_index& operator=(const identifier_hash_index&); // not implemented
+
+	/** Fibonacci hashing spreads clustered and strided identifiers evenly */
+	inline unsigned int slot(IdentifierType identifier) const
+	{
+		return (static_cast<unsigned int>(identifier)*2654435769u) >> this->shift;
+	}
+
+	/** maximum load factor is 0.7 to keep linear probe sequences short */
+	static inline bool overloaded(unsigned int entryCount, unsigned int entryCapacity)
+	{
+		return (10ull*entryCount > 7ull*entryCapacity);
+	}
+
+	bool rehash(unsigned int newCapacity)
+	{
+		Entry *newEntries;
+		if (!ALLOCATE(newEntries, Entry, newCapacity))
+			return false;
+		for (unsigned int i = 0; i < newCapacity; ++i)
+			newEntries[i].identifier = -1;
+		Entry *oldEntries = this->entries;
+		const unsigned int oldCapacity = this->capacity;
+		this->entries = newEntries;
+		this->capacity = newCapacity;
+		this->shift = 32;
+		for (unsigned int c = newCapacity; c > 1; c >>= 1)
+			--this->shift;
+		const unsigned int mask = newCapacity - 1;
+		for (unsigned int i = 0; i < oldCapacity; ++i)
+		{
+			if (oldEntries[i].identifier >= 0)
+			{
+				unsigned int s = this->slot(oldEntries[i].identifier);
+				while (newEntries[s].identifier >= 0)
+					s = (s + 1) & mask;
+				newEntries[s] = oldEntries[i];
+			}
+		}
+		DEALLOCATE(oldEntries);
+		return true;
+	}
+
+public:
+
+	identifier_hash_index() :
+		entries(0),
+		capacity(0),
+		shift(32),
+		count(0)
+	{
+	}
+
+	~identifier_hash_index()
+	{
+		DEALLOCATE(this->entries);
+	}
+
+	void clear()
+	{
+		DEALLOCATE(this->entries);
+		this->capacity = 0;
+		this->shift = 32;
+		this->count = 0;
+	}
+
+	/** Swaps all data with other hash index. Cannot fail. */
+	void swap(identifier_hash_index& other)
+	{
+		Entry *tempEntries = this->entries;
+		this->entries = other.entries;
+		other.entries = tempEntries;
+		unsigned int temp = this->capacity;
+		this->capacity = other.capacity;
+		other.capacity = temp;
+		temp = this->shift;
+		this->shift = other.shift;
+		other.shift = temp;
+		temp = this->count;
+		this->count = other.count;
+		other.count = temp;
+	}
+
+	unsigned int size() const
+	{
+		return this->count;
+	}
+
+	/** @return  Number of entry slots allocated. */
+	unsigned int getCapacity() const
+	{
+		return this->capacity;
+	}
+
+	/**
+	 * Ensure space for entryCount entries without further rehashing. Call
+	 * before bulk loading a known number of entries.
+	 */
+	bool reserve(unsigned int entryCount)
+	{
+		unsigned int newCapacity = (this->capacity) ? this->capacity : 16;
+		while (overloaded(entryCount, newCapacity))
+			newCapacity *= 2;
+		if (newCapacity > this->capacity)
+			return this->rehash(newCapacity);
+		return true;
+	}
+
+	/**
+	 * Add identifier -> index. Caller must ensure identifier is non-negative
+	 * and not already present.
+	 * @return  true on success, false if failed to allocate.
+	 */
+	bool insert(IdentifierType identifier, IndexType index)
+	{
+		if ((0 == this->capacity) || overloaded(this->count + 1, this->capacity))
+		{
+			if (!this->rehash((this->capacity) ? 2*this->capacity : 16))
+				return false;
+		}
+		const unsigned int mask = this->capacity - 1;
+		unsigned int s = this->slot(identifier);
+		while (this->entries[s].identifier >= 0)
+			s = (s + 1) & mask;
+		this->entries[s].identifier = identifier;
+		this->entries[s].index = index;
+		++this->count;
+		return true;
+	}
+
+	/**
+	 * Remove identifier, shifting back following entries in its probe sequence
+	 * so no deleted markers are needed.
+	 * @return  true if removed, false if not found.
+	 */
+	bool erase(IdentifierType identifier)
+	{
+		if ((0 == this->count) || (identifier < 0))
+			return false;
+		const unsigned int mask = this->capacity - 1;
+		unsigned int s = this->slot(identifier);
+		while (this->entries[s].identifier != identifier)
+		{
+			if (this->entries[s].identifier < 0)
+				return false;
+			s = (s + 1) & mask;
+		}
+		unsigned int hole = s;
+		unsigned int next = (s + 1) & mask;
+		while (this->entries[next].identifier >= 0)
+		{
+			const unsigned int home = this->slot(this->entries[next].identifier);
+			// move entry into hole if its home slot is not cyclically in (hole, next]
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				this->entries[hole] = this->entries[next];
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		this->entries[hole].identifier = -1;
+		--this->count;
+		return true;
+	}
+
+	/** @return  Index for identifier, or InvalidIndex if not found. */
+	inline IndexType find(IdentifierType identifier) const
+	{
+		if ((0 == this->count) || (identifier < 0))
+			return InvalidIndex;
+		const unsigned int mask = this->capacity - 1;
+		unsigned int s = this->slot(identifier);
+		while (true)
+		{
+			const Entry& entry = this->entries[s];
+			if (entry.identifier == identifier)
+				return entry.index;
+			if (entry.identifier < 0)
+				return InvalidIndex;
+			s = (s + 1) & mask;
+		}
+	}
+
+};
+
+#endif /* !defined (IDENTIFIER_HASH_INDEX_HPP) */
@@ -608,7 +608,7 @@ int IO_stream_open_for_read_compression_specified(struct IO_stream *stream, cons
 					else
 #endif /* defined (HAVE_BZLIB) */
 					{
-						stream->file_handle = fopen(filename, "r");
+						stream->file_handle = fopen(filename, "rb");
 						if (NULL != stream->file_handle)
 						{
 							stream->type = IO_STREAM_FILE_TYPE;
@@ -772,7 +772,7 @@ DESCRIPTION :
 				else
 #endif /* defined (HAVE_BZLIB) */
 				{
-					stream->file_handle = fopen(filename, "r");
+					stream->file_handle = fopen(filename, "rb");
 					if (NULL != stream->file_handle)
 					{
 						stream->type = IO_STREAM_FILE_TYPE;
@@ -0,0 +1,302 @@
+/**
+ * FILE : element_scalar_range_index.hpp
+ *
+ * Cache of the range of a scalar field sampled over each element of a mesh,
+ * with an interval index for finding elements whose range spans any of a set
+ * of values. Used to skip elements which cannot contribute to contours.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (ELEMENT_SCALAR_RANGE_INDEX_HPP)
+#define ELEMENT_SCALAR_RANGE_INDEX_HPP
+
+#include <algorithm>
+#include <vector>
+#include "datastore/labels.hpp"
+#include "general/value.h"
+
+class FE_mesh;
+
+/**
+ * Per-element minimum and maximum of a scalar field over the points it was
+ * sampled at, recorded with the discretization used so ranges from a different
+ * tessellation are never trusted. Ranges are only valid for one mesh and time;
+ * clients must invalidate elements whose scalar values may have changed.
+ * An element whose range does not include a value has no contour at it, as
+ * contours are interpolated between the same sample points.
+ */
+class Element_scalar_range_index
+{
+private:
+	struct Range
+	{
+		FE_value minimum, maximum;
+		int number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		bool valid;
+	};
+
+	/** number of sorted entries sharing one maximum in the interval index */
+	static const int blockSize = 32;
+
+	FE_mesh *mesh; // not accessed
+	FE_value time;
+	std::vector<Range> ranges; // indexed by element index
+	int validCount;
+	// interval index: valid element indexes sorted by range minimum, with
+	// the greatest maximum over each block of blockSize sorted entries
+	std::vector<DsLabelIndex> sortedIndexes;
+	std::vector<FE_value> sortedMinimums;
+	std::vector<FE_value> blockMaximums;
+	bool sortedValid;
+	// complete if the last full build of graphics recorded ranges for all
+	// elements that passed the graphics filters, so other elements can be
+	// skipped if the filters are unchanged
+	bool complete;
+	bool sweeping;
+	bool sweepComplete;
+
+	Element_scalar_range_index(const Element_scalar_range_index&); // not implemented
+	Element_scalar_range_index& operator=(const Element_scalar_range_index&); // not implemented
+
+	class Minimum_less
+	{
+		const std::vector<Range>& ranges;
+	public:
+		Minimum_less(const std::vector<Range>& rangesIn) :
+			ranges(rangesIn)
+		{
+		}
+
+		bool operator()(DsLabelIndex index1, DsLabelIndex index2) const
+		{
+			return this->ranges[index1].minimum < this->ranges[index2].minimum;
+		}
+	};
+
+	void buildSorted()
+	{
+		this->sortedIndexes.clear();
+		this->sortedIndexes.reserve(this->validCount);
+		const DsLabelIndex size = static_cast<DsLabelIndex>(this->ranges.size());
+		for (DsLabelIndex index = 0; index < size; ++index)
+			if (this->ranges[index].valid)
+				this->sortedIndexes.push_back(index);
+		std::sort(this->sortedIndexes.begin(), this->sortedIndexes.end(), Minimum_less(this->ranges));
+		const size_t count = this->sortedIndexes.size();
+		this->sortedMinimums.resize(count);
+		this->blockMaximums.assign((count + blockSize - 1) / blockSize, 0.0);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Range& range = this->ranges[this->sortedIndexes[i]];
+			this->sortedMinimums[i] = range.minimum;
+			FE_value& blockMaximum = this->blockMaximums[i / blockSize];
+			if (((i % blockSize) == 0) || (range.maximum > blockMaximum))
+				blockMaximum = range.maximum;
+		}
+		this->sortedValid = true;
+	}
+
+public:
+
+	Element_scalar_range_index() :
+		mesh(0),
+		time(0.0),
+		validCount(0),
+		sortedValid(false),
+		complete(false),
+		sweeping(false),
+		sweepComplete(false)
+	{
+	}
+
+	/** Discard all ranges. */
+	void clear()
+	{
+		this->ranges.clear();
+		this->validCount = 0;
+		this->sortedIndexes.clear();
+		this->sortedMinimums.clear();
+		this->blockMaximums.clear();
+		this->sortedValid = false;
+		this->setIncomplete();
+	}
+
+	/** Clear ranges if they are for a different mesh or time. */
+	void checkMeshAndTime(FE_mesh *meshIn, FE_value timeIn)
+	{
+		if ((meshIn != this->mesh) || (timeIn != this->time))
+		{
+			this->clear();
+			this->mesh = meshIn;
+			this->time = timeIn;
+		}
+	}
+
+	int getValidCount() const
+	{
+		return this->validCount;
+	}
+
+	/**
+	 * Get cached range of element if sampled with the same discretization.
+	 * @param range  Array of 2 values to receive minimum and maximum.
+	 * @return  True if range found, otherwise false.
+	 */
+	bool getRange(DsLabelIndex elementIndex, const int *number_in_xi, FE_value *range) const
+	{
+		if ((elementIndex < 0) || (elementIndex >= static_cast<DsLabelIndex>(this->ranges.size())))
+			return false;
+		const Range& elementRange = this->ranges[elementIndex];
+		if (!elementRange.valid)
+			return false;
+		for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+			if (elementRange.number_in_xi[i] != number_in_xi[i])
+				return false;
+		range[0] = elementRange.minimum;
+		range[1] = elementRange.maximum;
+		return true;
+	}
+
+	/**
+	 * Record range of element sampled with discretization number_in_xi.
+	 * @param range  Array of minimum and maximum sampled values. Not recorded
+	 * if minimum is not less than or equal to maximum e.g. from NaN.
+	 * @return  True on success, false if failed.
+	 */
+	bool setRange(DsLabelIndex elementIndex, const int *number_in_xi, const FE_value *range)
+	{
+		if ((elementIndex < 0) || !(range[0] <= range[1]))
+			return false;
+		if (elementIndex >= static_cast<DsLabelIndex>(this->ranges.size()))
+		{
+			Range invalidRange;
+			invalidRange.valid = false;
+			this->ranges.resize(elementIndex + 1, invalidRange);
+		}
+		Range& elementRange = this->ranges[elementIndex];
+		if (!elementRange.valid)
+			++this->validCount;
+		elementRange.minimum = range[0];
+		elementRange.maximum = range[1];
+		for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+			elementRange.number_in_xi[i] = number_in_xi[i];
+		elementRange.valid = true;
+		this->sortedValid = false;
+		return true;
+	}
+
+	/**
+	 * Invalidate ranges of elements for which the conditional function
+	 * returns true, also making the index incomplete if any are invalidated.
+	 * @param conditional_function  Function taking element index and
+	 * user data, returning non-zero if the element has changed.
+	 * @return  Number of ranges invalidated.
+	 */
+	int invalidateConditional(int (*conditional_function)(int index, void *user_data), void *user_data)
+	{
+		int count = 0;
+		const DsLabelIndex size = static_cast<DsLabelIndex>(this->ranges.size());
+		for (DsLabelIndex index = 0; index < size; ++index)
+		{
+			Range& elementRange = this->ranges[index];
+			if (elementRange.valid && (conditional_function(index, user_data)))
+			{
+				elementRange.valid = false;
+				++count;
+			}
+		}
+		if (count)
+		{
+			this->validCount -= count;
+			this->sortedValid = false;
+			this->setIncomplete();
+		}
+		return count;
+	}
+
+	/**
+	 * Get indexes of elements with cached range spanning any of the values,
+	 * in increasing order of element index.
+	 * @param values  Array of numberOfValues values.
+	 * @param elementIndexes  Vector to receive element indexes.
+	 */
+	void getElementsSpanningValues(int numberOfValues, const double *values,
+		std::vector<DsLabelIndex>& elementIndexes)
+	{
+		elementIndexes.clear();
+		if (!this->sortedValid)
+			this->buildSorted();
+		for (int v = 0; v < numberOfValues; ++v)
+		{
+			const FE_value value = static_cast<FE_value>(values[v]);
+			// only sorted entries before this position have minimum <= value
+			const size_t count = std::upper_bound(this->sortedMinimums.begin(),
+				this->sortedMinimums.end(), value) - this->sortedMinimums.begin();
+			for (size_t blockStart = 0; blockStart < count; blockStart += blockSize)
+			{
+				if (this->blockMaximums[blockStart / blockSize] < value)
+					continue;
+				const size_t blockEnd = std::min(blockStart + blockSize, count);
+				for (size_t i = blockStart; i < blockEnd; ++i)
+				{
+					const DsLabelIndex elementIndex = this->sortedIndexes[i];
+					if (this->ranges[elementIndex].maximum >= value)
+						elementIndexes.push_back(elementIndex);
+				}
+			}
+		}
+		std::sort(elementIndexes.begin(), elementIndexes.end());
+		elementIndexes.erase(std::unique(elementIndexes.begin(), elementIndexes.end()), elementIndexes.end());
+	}
+
+	bool isComplete() const
+	{
+		return this->complete;
+	}
+
+	/** Restore complete state after a change known not to affect which
+	 * elements pass graphics filters, e.g. isovalues only. */
+	void setComplete()
+	{
+		this->complete = true;
+	}
+
+	/** Call when graphics filters or element membership may have changed. */
+	void setIncomplete()
+	{
+		this->complete = false;
+		this->sweeping = false;
+		this->sweepComplete = false;
+	}
+
+	/** Call before building graphics for all elements from the start. */
+	void beginSweep()
+	{
+		this->sweeping = true;
+		this->sweepComplete = true;
+	}
+
+	/** Call if an element passing graphics filters did not have a range recorded. */
+	void setSweepMissingRange()
+	{
+		this->sweepComplete = false;
+	}
+
+	/** Call after graphics built for all elements to mark index complete if
+	 * ranges recorded for all elements passing filters since beginSweep. */
+	void endSweep()
+	{
+		if (this->sweeping)
+		{
+			this->complete = this->sweepComplete;
+			this->sweeping = false;
+		}
+	}
+
+};
+
+#endif /* !defined (ELEMENT_SCALAR_RANGE_INDEX_HPP) */
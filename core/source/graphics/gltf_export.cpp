@@ -0,0 +1,640 @@
+/**
+ * FILE : gltf_export.cpp
+ *
+ * Class for exporting surface graphics as binary glTF 2.0 (GLB) for three.js
+ * and other WebGL clients.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "general/debug.h"
+#include "general/message.h"
+#include "graphics/gltf_export.hpp"
+#include "graphics/graphics_object.h"
+#include "graphics/graphics_object_private.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+/* glTF accessor component types and buffer view targets */
+const int GLTF_BYTE = 5120;
+const int GLTF_UNSIGNED_BYTE = 5121;
+const int GLTF_SHORT = 5122;
+const int GLTF_UNSIGNED_SHORT = 5123;
+const int GLTF_UNSIGNED_INT = 5125;
+const int GLTF_FLOAT = 5126;
+const int GLTF_ARRAY_BUFFER = 34962;
+const int GLTF_ELEMENT_ARRAY_BUFFER = 34963;
+
+const char *gltf_accessor_type(int numberOfComponents)
+{
+	static const char *types[] = { "SCALAR", "VEC2", "VEC3", "VEC4" };
+	return types[numberOfComponents - 1];
+}
+
+/** Append 32-bit unsigned integer to string in little endian order. */
+void append_uint32(std::string& output, unsigned int value)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		output += static_cast<char>(value & 0xFF);
+		value >>= 8;
+	}
+}
+
+/** @return  value in [-1, 1] scaled to nearest signed integer in [-limit, limit]. */
+inline int quantise_signed(double value, int limit)
+{
+	const int quantised = static_cast<int>(floor(value*limit + 0.5));
+	return (quantised < -limit) ? -limit : ((quantised > limit) ? limit : quantised);
+}
+
+/** @return  value in [0, 1] scaled to nearest unsigned integer in [0, limit]. */
+inline int quantise_unsigned(double value, int limit)
+{
+	const int quantised = static_cast<int>(floor(value*limit + 0.5));
+	return (quantised < 0) ? 0 : ((quantised > limit) ? limit : quantised);
+}
+
+}
+
+Gltf_binary_export::Gltf_binary_export(const char *filename, int number_of_time_steps_in,
+	cmzn_streaminformation_scene_io_data_type mode_in,
+	int morphVerticesIn, int morphColoursIn, int morphNormalsIn, bool quantiseIn) :
+	Threejs_export(filename, number_of_time_steps_in, mode_in,
+		morphVerticesIn, morphColoursIn, morphNormalsIn),
+	quantise(quantiseIn),
+	vertexCount(0),
+	positionAccessor(-1),
+	normalAccessor(-1),
+	colourAccessor(-1),
+	dataAccessor(-1),
+	faceDataAccessor(-1),
+	indexAccessor(-1),
+	colourComponents(0)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		positionOffset[i] = 0.0;
+		positionScale[i] = 1.0;
+	}
+}
+
+/**
+ * Append values to binary buffer in a new buffer view, and add an accessor
+ * for them.
+ * @param valuesPerElement  Number of values stored per vertex or element, at
+ * least numberOfComponents; any extra values pad elements to 4 byte multiples.
+ * @param bounds  If true, record minimum and maximum of each component.
+ * @return  Index of new accessor.
+ */
+template <typename ValueType> int Gltf_binary_export::addAttribute(
+	const std::vector<ValueType>& values, unsigned int valuesPerElement,
+	int numberOfComponents, int componentType, bool normalized, bool bounds, int target)
+{
+	// all buffer views start on a 4 byte boundary
+	while (0 != (this->binary.size() % 4))
+		this->binary += '\0';
+	BufferView bufferView;
+	bufferView.byteOffset = this->binary.size();
+	bufferView.byteLength = values.size()*sizeof(ValueType);
+	bufferView.byteStride = (valuesPerElement != static_cast<unsigned int>(numberOfComponents)) ?
+		static_cast<int>(valuesPerElement*sizeof(ValueType)) : 0;
+	bufferView.target = target;
+	if (!values.empty())
+		this->binary.append(reinterpret_cast<const char *>(values.data()), bufferView.byteLength);
+	this->bufferViews.push_back(bufferView);
+	Accessor accessor;
+	accessor.bufferView = static_cast<int>(this->bufferViews.size()) - 1;
+	accessor.componentType = componentType;
+	accessor.normalized = normalized;
+	accessor.count = static_cast<unsigned int>(values.size() / valuesPerElement);
+	accessor.numberOfComponents = numberOfComponents;
+	accessor.hasBounds = bounds && (0 < accessor.count);
+	if (accessor.hasBounds)
+	{
+		for (int c = 0; c < numberOfComponents; ++c)
+		{
+			accessor.minimum[c] = accessor.maximum[c] = static_cast<double>(values[c]);
+		}
+		for (size_t i = valuesPerElement; i < values.size(); i += valuesPerElement)
+		{
+			for (int c = 0; c < numberOfComponents; ++c)
+			{
+				const double value = static_cast<double>(values[i + c]);
+				if (value < accessor.minimum[c])
+					accessor.minimum[c] = value;
+				else if (value > accessor.maximum[c])
+					accessor.maximum[c] = value;
+			}
+		}
+	}
+	this->accessors.push_back(accessor);
+	return static_cast<int>(this->accessors.size()) - 1;
+}
+
+int Gltf_binary_export::beginExport()
+{
+	this->binary.clear();
+	this->bufferViews.clear();
+	this->accessors.clear();
+	this->targets.clear();
+	this->vertexCount = 0;
+	this->positionAccessor = this->normalAccessor = this->colourAccessor =
+		this->dataAccessor = this->faceDataAccessor = this->indexAccessor = -1;
+	return 1;
+}
+
+void Gltf_binary_export::writeBase(struct GT_object *object, GLfloat *positions,
+	unsigned int position_values_per_vertex, GLfloat *normals,
+	GLfloat *colours, unsigned int colour_values_per_vertex)
+{
+	const unsigned int count = this->vertexCount;
+	const unsigned int position_components = (position_values_per_vertex < 3) ? position_values_per_vertex : 3;
+	this->basePositions.assign(3*count, 0.0f);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		for (unsigned int k = 0; k < position_components; ++k)
+			this->basePositions[3*i + k] = positions[i*position_values_per_vertex + k];
+	}
+	if (this->quantise)
+	{
+		// scale positions in bounding box to [-1, 1] with node transformation
+		for (int k = 0; k < 3; ++k)
+		{
+			GLfloat minimum = this->basePositions[k], maximum = this->basePositions[k];
+			for (unsigned int i = 1; i < count; ++i)
+			{
+				const GLfloat value = this->basePositions[3*i + k];
+				if (value < minimum)
+					minimum = value;
+				else if (value > maximum)
+					maximum = value;
+			}
+			this->positionOffset[k] = 0.5*(static_cast<double>(minimum) + static_cast<double>(maximum));
+			this->positionScale[k] = 0.5*(static_cast<double>(maximum) - static_cast<double>(minimum));
+			if (this->positionScale[k] <= 0.0)
+				this->positionScale[k] = 1.0;
+		}
+		std::vector<short> quantisedPositions(4*count, 0);
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			for (int k = 0; k < 3; ++k)
+				quantisedPositions[4*i + k] = static_cast<short>(quantise_signed(
+					(this->basePositions[3*i + k] - this->positionOffset[k]) / this->positionScale[k], 32767));
+		}
+		this->positionAccessor = this->addAttribute(quantisedPositions, 4, 3, GLTF_SHORT,
+			/*normalized*/true, /*bounds*/true, GLTF_ARRAY_BUFFER);
+	}
+	else
+	{
+		this->positionAccessor = this->addAttribute(this->basePositions, 3, 3, GLTF_FLOAT,
+			/*normalized*/false, /*bounds*/true, GLTF_ARRAY_BUFFER);
+	}
+
+	if (normals)
+	{
+		this->baseNormals.assign(normals, normals + 3*count);
+		if (this->quantise)
+		{
+			std::vector<signed char> quantisedNormals(4*count, 0);
+			for (unsigned int i = 0; i < 3*count; ++i)
+				quantisedNormals[(i/3)*4 + (i % 3)] = static_cast<signed char>(quantise_signed(normals[i], 127));
+			this->normalAccessor = this->addAttribute(quantisedNormals, 4, 3, GLTF_BYTE,
+				/*normalized*/true, /*bounds*/false, GLTF_ARRAY_BUFFER);
+		}
+		else
+		{
+			this->normalAccessor = this->addAttribute(this->baseNormals, 3, 3, GLTF_FLOAT,
+				/*normalized*/false, /*bounds*/false, GLTF_ARRAY_BUFFER);
+		}
+	}
+
+	if (colours)
+	{
+		this->colourComponents = colour_values_per_vertex;
+		this->baseColours.assign(colours, colours + colour_values_per_vertex*count);
+		if (this->quantise)
+		{
+			std::vector<unsigned char> quantisedColours(4*count, 255);
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				for (unsigned int k = 0; k < colour_values_per_vertex; ++k)
+					quantisedColours[4*i + k] = static_cast<unsigned char>(
+						quantise_unsigned(colours[i*colour_values_per_vertex + k], 255));
+			}
+			this->colourAccessor = this->addAttribute(quantisedColours, 4, 4, GLTF_UNSIGNED_BYTE,
+				/*normalized*/true, /*bounds*/false, GLTF_ARRAY_BUFFER);
+		}
+		else
+		{
+			this->colourAccessor = this->addAttribute(this->baseColours, colour_values_per_vertex,
+				colour_values_per_vertex, GLTF_FLOAT, /*normalized*/false, /*bounds*/false, GLTF_ARRAY_BUFFER);
+		}
+	}
+
+	// convert triangle strips to triangles, alternating order to keep winding
+	std::vector<unsigned int> indices;
+	unsigned int *strip_indices = 0, strip_index_values_per_vertex = 0, strip_index_count = 0;
+	object->vertex_array->get_unsigned_integer_vertex_buffer(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_ARRAY,
+		&strip_indices, &strip_index_values_per_vertex, &strip_index_count);
+	if (strip_indices)
+	{
+		unsigned int *number_buffer = 0, number_per_vertex = 0, number_count = 0;
+		object->vertex_array->get_unsigned_integer_vertex_buffer(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+			&number_buffer, &number_per_vertex, &number_count);
+		unsigned int current_index = 0;
+		for (unsigned int i = 0; i < number_count; ++i)
+		{
+			const unsigned int points_per_strip = number_buffer[i];
+			for (unsigned int j = 0; j + 2 < points_per_strip; ++j)
+			{
+				const unsigned int *strip = strip_indices + current_index + j;
+				indices.push_back(strip[(j % 2) ? 1 : 0]);
+				indices.push_back(strip[(j % 2) ? 0 : 1]);
+				indices.push_back(strip[2]);
+			}
+			current_index += points_per_strip;
+		}
+		if (count <= 65535)
+		{
+			// maximum value of type is reserved
+			std::vector<unsigned short> shortIndices(indices.begin(), indices.end());
+			this->indexAccessor = this->addAttribute(shortIndices, 1, 1, GLTF_UNSIGNED_SHORT,
+				/*normalized*/false, /*bounds*/false, GLTF_ELEMENT_ARRAY_BUFFER);
+		}
+		else
+		{
+			this->indexAccessor = this->addAttribute(indices, 1, 1, GLTF_UNSIGNED_INT,
+				/*normalized*/false, /*bounds*/false, GLTF_ELEMENT_ARRAY_BUFFER);
+		}
+	}
+
+	if ((this->mode == CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_PER_VERTEX_VALUE) ||
+		(this->mode == CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_PER_FACE_VALUE))
+	{
+		GLfloat *data_buffer = 0;
+		unsigned int data_values_per_vertex = 0, data_vertex_count = 0;
+		if (object->vertex_array->get_float_vertex_buffer(
+				GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+				&data_buffer, &data_values_per_vertex, &data_vertex_count) &&
+			(data_vertex_count == count))
+		{
+			if ((data_values_per_vertex < 1) || (data_values_per_vertex > 4))
+			{
+				display_message(WARNING_MESSAGE, "Gltf_binary_export::exportGraphicsObject.  "
+					"Cannot export data with %u components; limit is 4", data_values_per_vertex);
+			}
+			else if (this->mode == CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_PER_VERTEX_VALUE)
+			{
+				std::vector<GLfloat> data(data_buffer, data_buffer + data_values_per_vertex*count);
+				this->dataAccessor = this->addAttribute(data, data_values_per_vertex,
+					data_values_per_vertex, GLTF_FLOAT, /*normalized*/false, /*bounds*/false, GLTF_ARRAY_BUFFER);
+			}
+			else
+			{
+				// average of vertex values for each triangle
+				const unsigned int number_of_triangles = (strip_indices) ?
+					static_cast<unsigned int>(indices.size()/3) : count/3;
+				std::vector<GLfloat> faceData(data_values_per_vertex*number_of_triangles);
+				for (unsigned int t = 0; t < number_of_triangles; ++t)
+				{
+					for (unsigned int k = 0; k < data_values_per_vertex; ++k)
+					{
+						GLfloat sum = 0.0f;
+						for (unsigned int v = 0; v < 3; ++v)
+						{
+							const unsigned int vertex = (strip_indices) ? indices[3*t + v] : 3*t + v;
+							sum += data_buffer[vertex*data_values_per_vertex + k];
+						}
+						faceData[t*data_values_per_vertex + k] = sum / 3.0f;
+					}
+				}
+				this->faceDataAccessor = this->addAttribute(faceData, data_values_per_vertex,
+					data_values_per_vertex, GLTF_FLOAT, /*normalized*/false, /*bounds*/false, /*target*/0);
+			}
+		}
+	}
+}
+
+void Gltf_binary_export::writeTarget(GLfloat *positions, unsigned int position_values_per_vertex,
+	unsigned int position_vertex_count, GLfloat *normals, GLfloat *colours,
+	unsigned int colour_values_per_vertex)
+{
+	const unsigned int count = this->vertexCount;
+	// displacements are zero if vertices do not match first time step
+	const bool matching = (position_vertex_count == count);
+	if (!matching)
+	{
+		display_message(WARNING_MESSAGE, "Gltf_binary_export::exportGraphicsObject.  "
+			"Number of vertices varies with time in %s; writing zero displacements", this->filename);
+	}
+	Target target = { -1, -1, -1 };
+	if (this->morphVertices)
+	{
+		const unsigned int position_components = (position_values_per_vertex < 3) ? position_values_per_vertex : 3;
+		std::vector<GLfloat> displacements(3*count, 0.0f);
+		if (matching)
+		{
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				// displacements are in node coordinates, scaled if quantised
+				for (unsigned int k = 0; k < position_components; ++k)
+					displacements[3*i + k] = static_cast<GLfloat>((positions[i*position_values_per_vertex + k] -
+						this->basePositions[3*i + k]) / this->positionScale[k]);
+			}
+		}
+		target.position = this->addAttribute(displacements, 3, 3, GLTF_FLOAT,
+			/*normalized*/false, /*bounds*/true, GLTF_ARRAY_BUFFER);
+	}
+	if (this->morphNormals && (0 <= this->normalAccessor))
+	{
+		std::vector<GLfloat> displacements(3*count, 0.0f);
+		if (matching && normals)
+		{
+			for (unsigned int i = 0; i < 3*count; ++i)
+				displacements[i] = normals[i] - this->baseNormals[i];
+		}
+		target.normal = this->addAttribute(displacements, 3, 3, GLTF_FLOAT,
+			/*normalized*/false, /*bounds*/false, GLTF_ARRAY_BUFFER);
+	}
+	if (this->morphColours && (0 <= this->colourAccessor))
+	{
+		// quantised colours are always RGBA
+		const unsigned int components = (this->quantise) ? 4 : this->colourComponents;
+		std::vector<GLfloat> displacements(components*count, 0.0f);
+		if (matching && colours && (colour_values_per_vertex == this->colourComponents))
+		{
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				for (unsigned int k = 0; k < this->colourComponents; ++k)
+					displacements[i*components + k] = colours[i*colour_values_per_vertex + k] -
+						this->baseColours[i*this->colourComponents + k];
+			}
+		}
+		target.colour = this->addAttribute(displacements, components, components, GLTF_FLOAT,
+			/*normalized*/false, /*bounds*/false, GLTF_ARRAY_BUFFER);
+	}
+	if ((0 <= target.position) || (0 <= target.normal) || (0 <= target.colour))
+		this->targets.push_back(target);
+}
+
+int Gltf_binary_export::exportGraphicsObject(struct GT_object *object, int time_step)
+{
+	if (!object)
+		return 0;
+	if (GT_object_get_type(object) != g_SURFACE_VERTEX_BUFFERS)
+		return 1;
+	const int buffer_binding = object->buffer_binding;
+	object->buffer_binding = 1;
+	GLfloat *position_buffer = 0;
+	unsigned int position_values_per_vertex = 0, position_vertex_count = 0;
+	if (object->vertex_array->get_float_vertex_buffer(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+			&position_buffer, &position_values_per_vertex, &position_vertex_count) &&
+		(0 < position_values_per_vertex) && ((0 < position_vertex_count) || (0 < time_step)))
+	{
+		GLfloat *normal_buffer = 0;
+		unsigned int normal_values_per_vertex = 0, normal_vertex_count = 0;
+		if (!(object->vertex_array->get_float_vertex_buffer(
+				GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+				&normal_buffer, &normal_values_per_vertex, &normal_vertex_count) &&
+			(3 == normal_values_per_vertex) && (normal_vertex_count == position_vertex_count)))
+		{
+			normal_buffer = 0;
+		}
+		GLfloat *colour_buffer = 0;
+		unsigned int colour_values_per_vertex = 0, colour_vertex_count = 0;
+		if ((this->mode == CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_COLOUR) &&
+			Graphics_object_create_colour_buffer_from_data(object,
+				&colour_buffer, &colour_values_per_vertex, &colour_vertex_count) &&
+			(!((colour_vertex_count == position_vertex_count) &&
+				((3 == colour_values_per_vertex) || (4 == colour_values_per_vertex)))))
+		{
+			DEALLOCATE(colour_buffer);
+		}
+		if (0 == time_step)
+		{
+			this->vertexCount = position_vertex_count;
+			this->writeBase(object, position_buffer, position_values_per_vertex,
+				normal_buffer, colour_buffer, colour_values_per_vertex);
+		}
+		if ((1 < this->number_of_time_steps) && (0 <= this->positionAccessor) &&
+			(this->morphVertices || this->morphNormals || this->morphColours))
+		{
+			this->writeTarget(position_buffer, position_values_per_vertex, position_vertex_count,
+				normal_buffer, colour_buffer, colour_values_per_vertex);
+		}
+		if (colour_buffer)
+			DEALLOCATE(colour_buffer);
+	}
+	object->buffer_binding = buffer_binding;
+	return 1;
+}
+
+std::string Gltf_binary_export::getJSON() const
+{
+	char temp[200];
+	std::string json("{\"asset\":{\"version\":\"2.0\",\"generator\":\"OpenCMISS-Zinc\"}");
+	if (this->quantise && (0 <= this->positionAccessor))
+	{
+		json += ",\"extensionsUsed\":[\"KHR_mesh_quantization\"]"
+			",\"extensionsRequired\":[\"KHR_mesh_quantization\"]";
+	}
+	json += ",\"scene\":0,\"scenes\":[{\"nodes\":[";
+	if (0 <= this->positionAccessor)
+	{
+		json += "0]}],\"nodes\":[{\"name\":\"";
+		json += this->filename;
+		json += "\",\"mesh\":0";
+		if (this->quantise)
+		{
+			sprintf(temp, ",\"translation\":[%.9g,%.9g,%.9g],\"scale\":[%.9g,%.9g,%.9g]",
+				this->positionOffset[0], this->positionOffset[1], this->positionOffset[2],
+				this->positionScale[0], this->positionScale[1], this->positionScale[2]);
+			json += temp;
+		}
+		json += "}],\"meshes\":[{\"name\":\"";
+		json += this->filename;
+		sprintf(temp, "\",\"primitives\":[{\"mode\":4,\"attributes\":{\"POSITION\":%d", this->positionAccessor);
+		json += temp;
+		if (0 <= this->normalAccessor)
+		{
+			sprintf(temp, ",\"NORMAL\":%d", this->normalAccessor);
+			json += temp;
+		}
+		if (0 <= this->colourAccessor)
+		{
+			sprintf(temp, ",\"COLOR_0\":%d", this->colourAccessor);
+			json += temp;
+		}
+		if (0 <= this->dataAccessor)
+		{
+			sprintf(temp, ",\"_DATA\":%d", this->dataAccessor);
+			json += temp;
+		}
+		json += "}";
+		if (0 <= this->indexAccessor)
+		{
+			sprintf(temp, ",\"indices\":%d", this->indexAccessor);
+			json += temp;
+		}
+		const int number_of_targets = static_cast<int>(this->targets.size());
+		if (0 < number_of_targets)
+		{
+			json += ",\"targets\":[";
+			for (int t = 0; t < number_of_targets; ++t)
+			{
+				const Target& target = this->targets[t];
+				json += (0 < t) ? ",{" : "{";
+				const char *separator = "";
+				if (0 <= target.position)
+				{
+					sprintf(temp, "\"POSITION\":%d", target.position);
+					json += temp;
+					separator = ",";
+				}
+				if (0 <= target.normal)
+				{
+					sprintf(temp, "%s\"NORMAL\":%d", separator, target.normal);
+					json += temp;
+					separator = ",";
+				}
+				if (0 <= target.colour)
+				{
+					sprintf(temp, "%s\"COLOR_0\":%d", separator, target.colour);
+					json += temp;
+				}
+				json += "}";
+			}
+			json += "]";
+		}
+		json += "}]";
+		if (0 < number_of_targets)
+		{
+			json += ",\"weights\":[";
+			for (int t = 0; t < number_of_targets; ++t)
+				json += (0 < t) ? ",0" : "0";
+			json += "]";
+		}
+		if ((0 < number_of_targets) || (0 <= this->faceDataAccessor))
+		{
+			json += ",\"extras\":{";
+			if (0 < number_of_targets)
+			{
+				json += "\"targetNames\":[";
+				for (int t = 0; t < number_of_targets; ++t)
+				{
+					sprintf(temp, "%s\"%s_%03d\"", (0 < t) ? "," : "", this->filename, t);
+					json += temp;
+				}
+				json += "]";
+			}
+			if (0 <= this->faceDataAccessor)
+			{
+				sprintf(temp, "%s\"faceData\":%d", (0 < number_of_targets) ? "," : "", this->faceDataAccessor);
+				json += temp;
+			}
+			json += "}";
+		}
+		json += "}]";
+	}
+	else
+	{
+		json += "]}]";
+	}
+	const int number_of_accessors = static_cast<int>(this->accessors.size());
+	if (0 < number_of_accessors)
+	{
+		json += ",\"accessors\":[";
+		for (int a = 0; a < number_of_accessors; ++a)
+		{
+			const Accessor& accessor = this->accessors[a];
+			sprintf(temp, "%s{\"bufferView\":%d,\"componentType\":%d,%s\"count\":%u,\"type\":\"%s\"",
+				(0 < a) ? "," : "", accessor.bufferView, accessor.componentType,
+				accessor.normalized ? "\"normalized\":true," : "", accessor.count,
+				gltf_accessor_type(accessor.numberOfComponents));
+			json += temp;
+			if (accessor.hasBounds)
+			{
+				for (int b = 0; b < 2; ++b)
+				{
+					const double *bound = (0 == b) ? accessor.minimum : accessor.maximum;
+					json += (0 == b) ? ",\"min\":[" : ",\"max\":[";
+					for (int c = 0; c < accessor.numberOfComponents; ++c)
+					{
+						sprintf(temp, "%s%.9g", (0 < c) ? "," : "", bound[c]);
+						json += temp;
+					}
+					json += "]";
+				}
+			}
+			json += "}";
+		}
+		json += "]";
+		json += ",\"bufferViews\":[";
+		const int number_of_buffer_views = static_cast<int>(this->bufferViews.size());
+		for (int v = 0; v < number_of_buffer_views; ++v)
+		{
+			const BufferView& bufferView = this->bufferViews[v];
+			sprintf(temp, "%s{\"buffer\":0,\"byteOffset\":%lu,\"byteLength\":%lu",
+				(0 < v) ? "," : "", static_cast<unsigned long>(bufferView.byteOffset),
+				static_cast<unsigned long>(bufferView.byteLength));
+			json += temp;
+			if (0 < bufferView.byteStride)
+			{
+				sprintf(temp, ",\"byteStride\":%d", bufferView.byteStride);
+				json += temp;
+			}
+			if (0 < bufferView.target)
+			{
+				sprintf(temp, ",\"target\":%d", bufferView.target);
+				json += temp;
+			}
+			json += "}";
+		}
+		sprintf(temp, "],\"buffers\":[{\"byteLength\":%lu}]",
+			static_cast<unsigned long>(this->binary.size()));
+		json += temp;
+	}
+	json += "}";
+	return json;
+}
+
+int Gltf_binary_export::endExport()
+{
+	std::string json = this->getJSON();
+	// chunks are padded to 4 bytes: JSON with spaces, binary with zeros
+	while (0 != (json.size() % 4))
+		json += ' ';
+	while (0 != (this->binary.size() % 4))
+		this->binary += '\0';
+	const size_t binaryChunkSize = (this->binary.empty()) ? 0 : (8 + this->binary.size());
+	const size_t totalSize = 12 + 8 + json.size() + binaryChunkSize;
+	this->outputString.clear();
+	this->outputString.reserve(totalSize);
+	append_uint32(this->outputString, 0x46546C67); // "glTF"
+	append_uint32(this->outputString, 2);
+	append_uint32(this->outputString, static_cast<unsigned int>(totalSize));
+	append_uint32(this->outputString, static_cast<unsigned int>(json.size()));
+	append_uint32(this->outputString, 0x4E4F534A); // "JSON"
+	this->outputString += json;
+	if (0 < binaryChunkSize)
+	{
+		append_uint32(this->outputString, static_cast<unsigned int>(this->binary.size()));
+		append_uint32(this->outputString, 0x004E4942); // "BIN"
+		this->outputString += this->binary;
+	}
+	// release working storage
+	std::string().swap(this->binary);
+	std::vector<GLfloat>().swap(this->basePositions);
+	std::vector<GLfloat>().swap(this->baseNormals);
+	std::vector<GLfloat>().swap(this->baseColours);
+	return 1;
+}
@@ -0,0 +1,102 @@
+/**
+ * FILE : gltf_export.hpp
+ *
+ * Class for exporting surface graphics as binary glTF 2.0 (GLB) for three.js
+ * and other WebGL clients.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (GLTF_EXPORT_HPP)
+#define GLTF_EXPORT_HPP
+
+#include "graphics/threejs_export.hpp"
+#include <vector>
+
+/**
+ * Exports one surface graphics object with the same options as Threejs_export
+ * but as a GLB container: a compact glTF JSON header describing typed arrays
+ * in a single binary buffer, which browsers load without parsing text.
+ * Vertex positions, normals and colours go in standard attributes; data values
+ * go in a _DATA attribute, or per-triangle in an accessor referenced from mesh
+ * extras "faceData". Time steps are written as morph targets holding
+ * displacements from the first time step, with names in extras "targetNames".
+ * If quantising, positions are stored as normalised shorts scaled to the
+ * node's bounding box and normals as normalised bytes using the
+ * KHR_mesh_quantization extension, and colours as normalised unsigned bytes.
+ */
+class Gltf_binary_export : public Threejs_export
+{
+	struct BufferView
+	{
+		size_t byteOffset;
+		size_t byteLength;
+		int byteStride; // 0 if tightly packed
+		int target;
+	};
+
+	struct Accessor
+	{
+		int bufferView;
+		int componentType;
+		bool normalized;
+		unsigned int count;
+		int numberOfComponents;
+		bool hasBounds;
+		double minimum[4];
+		double maximum[4];
+	};
+
+	/** Accessor indexes for the attributes of one morph target, -1 if absent */
+	struct Target
+	{
+		int position;
+		int normal;
+		int colour;
+	};
+
+	bool quantise;
+	std::string binary; // contents of BIN chunk
+	std::vector<BufferView> bufferViews;
+	std::vector<Accessor> accessors;
+	std::vector<Target> targets;
+	unsigned int vertexCount;
+	int positionAccessor, normalAccessor, colourAccessor, dataAccessor,
+		faceDataAccessor, indexAccessor;
+	double positionOffset[3], positionScale[3];
+	// attributes at first time step for computing morph target displacements
+	std::vector<GLfloat> basePositions, baseNormals, baseColours;
+	unsigned int colourComponents;
+
+	template <typename ValueType> int addAttribute(const std::vector<ValueType>& values,
+		unsigned int valuesPerElement, int numberOfComponents, int componentType,
+		bool normalized, bool bounds, int target);
+
+	void writeBase(struct GT_object *object, GLfloat *positions,
+		unsigned int position_values_per_vertex, GLfloat *normals,
+		GLfloat *colours, unsigned int colour_values_per_vertex);
+
+	void writeTarget(GLfloat *positions, unsigned int position_values_per_vertex,
+		unsigned int position_vertex_count, GLfloat *normals, GLfloat *colours,
+		unsigned int colour_values_per_vertex);
+
+	std::string getJSON() const;
+
+public:
+
+	Gltf_binary_export(const char *filename, int number_of_time_steps_in,
+		cmzn_streaminformation_scene_io_data_type mode_in,
+		int morphVerticesIn, int morphColoursIn, int morphNormalsIn, bool quantiseIn);
+
+	virtual int exportGraphicsObject(struct GT_object *object, int time_step);
+
+	virtual int beginExport();
+
+	virtual int endExport();
+
+};
+
+#endif /* !defined (GLTF_EXPORT_HPP) */
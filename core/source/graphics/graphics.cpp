@@ -9,7 +9,9 @@
 * This Source Code Form is subject to the terms of the Mozilla Public
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include <map>
 #include <string>
+#include <vector>
 
 #include "opencmiss/zinc/zincconfigure.h"
 
@@ -47,6 +49,7 @@
 #include "finite_element/finite_element_to_iso_surfaces.h"
 #include "finite_element/finite_element_to_streamlines.h"
 #include "graphics/auxiliary_graphics_types.h"
+#include "graphics/element_scalar_range_index.hpp"
 #include "graphics/font.h"
 #include "graphics/glyph.hpp"
 #include "graphics/graphics_object.h"
@@ -59,6 +62,7 @@
 #include "graphics/render_gl.h"
 #include "graphics/scene_coordinate_system.hpp"
 #include "graphics/tessellation.hpp"
+#include "mesh/cmiss_element_private.hpp"
 #if defined(USE_OPENCASCADE)
 #	include "cad/computed_field_cad_geometry.h"
 #	include "cad/computed_field_cad_topology.h"
@@ -81,6 +85,130 @@ enum cmzn_graphics_change
 	CMZN_GRAPHICS_CHANGE_FULL_REBUILD = 5,    /**< graphics object needs full rebuild */
 };
 
+/** Default limit on memory for the graphics time cache in megabytes */
+#define CMZN_GRAPHICS_TIME_CACHE_DEFAULT_MEMORY_LIMIT 256
+
+/**
+ * Cache of complete graphics objects built for time-dependent graphics at
+ * different times, so that replaying an animation need not rebuild them.
+ * Holds an access to each cached graphics object. Least recently used objects
+ * are discarded when the approximate memory used exceeds the limit.
+ */
+class cmzn_graphics_time_cache
+{
+	struct Entry
+	{
+		GT_object *graphicsObject;
+		size_t memorySize;
+		unsigned int lastUse;
+	};
+	typedef std::map<double, Entry> TimeEntryMap;
+
+	TimeEntryMap entries;
+	int memoryLimit; // in megabytes
+	size_t memoryUsed;
+	unsigned int useCounter;
+
+	static size_t getGraphicsObjectMemorySize(GT_object *graphicsObject)
+	{
+		Graphics_vertex_array *vertexArray = GT_object_get_vertex_set(graphicsObject);
+		return (vertexArray) ? vertexArray->get_memory_size() : 0;
+	}
+
+	/** Discard least recently used entries until memory used is within limit,
+	  * never discarding the entry with lastUse equal to keepUse. */
+	void trim(unsigned int keepUse)
+	{
+		const size_t memoryLimitBytes = static_cast<size_t>(this->memoryLimit)*1024*1024;
+		while ((this->memoryUsed > memoryLimitBytes) && (this->entries.size() > 1))
+		{
+			TimeEntryMap::iterator oldest = this->entries.end();
+			for (TimeEntryMap::iterator iter = this->entries.begin(); iter != this->entries.end(); ++iter)
+			{
+				if ((iter->second.lastUse != keepUse) &&
+					((oldest == this->entries.end()) || (iter->second.lastUse < oldest->second.lastUse)))
+				{
+					oldest = iter;
+				}
+			}
+			if (oldest == this->entries.end())
+				break;
+			this->erase(oldest);
+		}
+	}
+
+	void erase(TimeEntryMap::iterator iter)
+	{
+		this->memoryUsed -= iter->second.memorySize;
+		DEACCESS(GT_object)(&(iter->second.graphicsObject));
+		this->entries.erase(iter);
+	}
+
+public:
+
+	cmzn_graphics_time_cache(int memoryLimitIn) :
+		memoryLimit(memoryLimitIn),
+		memoryUsed(0),
+		useCounter(0)
+	{
+	}
+
+	~cmzn_graphics_time_cache()
+	{
+		this->clear();
+	}
+
+	void clear()
+	{
+		for (TimeEntryMap::iterator iter = this->entries.begin(); iter != this->entries.end(); ++iter)
+		{
+			DEACCESS(GT_object)(&(iter->second.graphicsObject));
+		}
+		this->entries.clear();
+		this->memoryUsed = 0;
+	}
+
+	void setMemoryLimit(int memoryLimitIn)
+	{
+		this->memoryLimit = memoryLimitIn;
+		this->trim(this->useCounter);
+	}
+
+	/** Add or replace graphics object cached for time. */
+	void store(double time, GT_object *graphicsObject)
+	{
+		TimeEntryMap::iterator iter = this->entries.find(time);
+		if (iter != this->entries.end())
+		{
+			if (iter->second.graphicsObject == graphicsObject)
+			{
+				iter->second.lastUse = ++(this->useCounter);
+				return;
+			}
+			this->erase(iter);
+		}
+		Entry entry;
+		entry.graphicsObject = ACCESS(GT_object)(graphicsObject);
+		entry.memorySize = getGraphicsObjectMemorySize(graphicsObject);
+		entry.lastUse = ++(this->useCounter);
+		this->entries[time] = entry;
+		this->memoryUsed += entry.memorySize;
+		this->trim(entry.lastUse);
+	}
+
+	/** @return  Non-accessed graphics object cached for time, or NULL if none. */
+	GT_object *find(double time)
+	{
+		TimeEntryMap::iterator iter = this->entries.find(time);
+		if (iter != this->entries.end())
+		{
+			iter->second.lastUse = ++(this->useCounter);
+			return iter->second.graphicsObject;
+		}
+		return 0;
+	}
+};
+
 /***************************************************************************//**
  * Call whenever attributes of the graphics have changed to ensure the graphics
  * object is invalidated (if needed) or that the minimum rebuild and redraw is
@@ -116,6 +244,16 @@ static int cmzn_graphics_changed(struct cmzn_graphics *graphics,
 			break;
 		}
 		graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
+		// elements passing graphics filters may have changed; cached ranges are
+		// still valid per element but must be recorded for all again before culling
+		// elements without visiting them
+		if ((graphics->scalar_range_index) && (CMZN_GRAPHICS_CHANGE_PARTIAL_REBUILD <= change))
+			graphics->scalar_range_index->setIncomplete();
+		// cached graphics for other times are invalid after any change except redraw
+		if ((graphics->time_cache) && (CMZN_GRAPHICS_CHANGE_REDRAW != change))
+		{
+			graphics->time_cache->clear();
+		}
 		if (return_code)
 		{
 			cmzn_scene_changed(graphics->scene);
@@ -211,6 +349,7 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->first_isovalue=0.0;
 			graphics->last_isovalue=0.0;
 			graphics->decimation_threshold = 0.0;
+			graphics->scalar_range_index = 0;
 
 			/* point attributes */
 			graphics->glyph = 0;
@@ -261,6 +400,8 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->stream_vector_field=(struct Computed_field *)NULL;
 			graphics->streamlines_track_direction = CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_FORWARD;
 			graphics->streamline_length=1.0;
+			graphics->streamlines_integration_method = CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER;
+			graphics->streamlines_integration_tolerance = 1.0E-4;
 			graphics->seed_nodeset = (cmzn_nodeset_id)0;
 			graphics->seed_node_mesh_location_field = (struct Computed_field *)NULL;
 			graphics->overlay_flag = 0;
@@ -279,6 +420,9 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->font = NULL;
 			/* for surface rendering */
 			graphics->render_polygon_mode = CMZN_GRAPHICS_RENDER_POLYGON_MODE_SHADED;
+			graphics->shared_edge_evaluation = false;
+			graphics->shared_edge_evaluation_count = 0;
+			graphics->shared_edge_reuse_count = 0;
 			/* for streamlines only */
 			graphics->streamlines_colour_data_type = CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD;
 			graphics->render_line_width = 1.0;
@@ -290,6 +434,9 @@ struct cmzn_graphics *CREATE(cmzn_graphics)(
 			graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
 			graphics->selected_graphics_changed = 0;
 			graphics->time_dependent = 0;
+			graphics->graphics_object_time = 0.0;
+			graphics->time_cache = 0;
+			graphics->time_cache_memory_limit = CMZN_GRAPHICS_TIME_CACHE_DEFAULT_MEMORY_LIMIT;
 
 			graphics->access_count=1;
 		}
@@ -327,6 +474,8 @@ int DESTROY(cmzn_graphics)(
 		{
 			DEACCESS(GT_object)(&(graphics->graphics_object));
 		}
+		delete graphics->time_cache;
+		delete graphics->scalar_range_index;
 		if (graphics->coordinate_field)
 		{
 			DEACCESS(Computed_field)(&(graphics->coordinate_field));
@@ -497,6 +646,25 @@ int cmzn_element_conditional_field_is_true(cmzn_element_id element,
 }
 #endif // OLD_CODE
 
+/**
+ * @param graphics  Contours graphics.
+ * @param isovalue_number  From 0 to number_of_isovalues - 1.
+ * @return  Isovalue from list if set, otherwise spaced over range.
+ */
+static double cmzn_graphics_get_isovalue(struct cmzn_graphics *graphics,
+	int isovalue_number)
+{
+	if (graphics->isovalues)
+		return graphics->isovalues[isovalue_number];
+	if (graphics->number_of_isovalues > 1)
+	{
+		return graphics->first_isovalue + (double)isovalue_number *
+			((graphics->last_isovalue - graphics->first_isovalue)
+			/ (double)(graphics->number_of_isovalues - 1));
+	}
+	return graphics->first_isovalue;
+}
+
 /**
  * Converts a finite element into a graphics object with the supplied graphics.
  * @param element  The cmzn_element.
@@ -617,64 +785,62 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 						graphics->texture_coordinate_field,
 						graphics->data_field,
 						number_in_xi[0], number_in_xi[1],
-						/*reverse_normals*/0, top_level_element);
+						/*reverse_normals*/0, top_level_element,
+						graphics_to_object_data->shared_edge_data);
 				} break;
 				case CMZN_GRAPHICS_TYPE_CONTOURS:
 				{
+					// scalar range over element, if known, to skip isovalues it can't contain
+					Element_scalar_range_index *range_index = graphics->scalar_range_index;
+					int range_number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+					for (int dim = 0; dim < MAXIMUM_ELEMENT_XI_DIMENSIONS; dim++)
+						range_number_in_xi[dim] = (dim < element_dimension) ? number_in_xi[dim] : 0;
+					FE_value scalar_range[2] = { HUGE_VAL, -HUGE_VAL };
+					bool range_known = (range_index) &&
+						range_index->getRange(elementIndex, range_number_in_xi, scalar_range);
 					switch (GT_object_get_type(graphics->graphics_object))
 					{
 						case g_SURFACE_VERTEX_BUFFERS:
 						{
 							if (3 == element_dimension)
 							{
-								return_code = create_iso_surfaces_from_FE_element(element,
-									graphics_to_object_data->field_cache,
-									graphics_to_object_data->master_mesh,
-									GT_object_get_vertex_set(graphics->graphics_object),
-									number_in_xi, graphics_to_object_data->iso_surface_specification);
+								bool build = !range_known;
+								for (i = 0; (i < graphics->number_of_isovalues) && (!build); i++)
+								{
+									const double isovalue = cmzn_graphics_get_isovalue(graphics, i);
+									build = (scalar_range[0] <= isovalue) && (isovalue <= scalar_range[1]);
+								}
+								if (build)
+								{
+									return_code = create_iso_surfaces_from_FE_element(element,
+										graphics_to_object_data->field_cache,
+										graphics_to_object_data->master_mesh,
+										GT_object_get_vertex_set(graphics->graphics_object),
+										number_in_xi, graphics_to_object_data->iso_surface_specification,
+										(range_known) ? 0 : scalar_range);
+								}
 							}
 						} break;
 						case g_POLYLINE_VERTEX_BUFFERS:
 						{
 							if (2 == element_dimension)
 							{
-								if (graphics->isovalues)
+								for (i = 0 ; (i < graphics->number_of_isovalues) && return_code; i++)
 								{
-									for (i = 0 ; i < graphics->number_of_isovalues ; i++)
-									{
-										return_code = create_iso_lines_from_FE_element(element,
-											graphics_to_object_data->field_cache,
-											graphics_to_object_data->rc_coordinate_field,
-											graphics->isoscalar_field, graphics->isovalues[i],
-											graphics->data_field, number_in_xi[0], number_in_xi[1],
-											top_level_element, GT_object_get_vertex_set(graphics->graphics_object));
-									}
-								}
-								else
-								{
-									double isovalue_range;
-									if (graphics->number_of_isovalues > 1)
-									{
-										isovalue_range =
-											(graphics->last_isovalue - graphics->first_isovalue)
-											/ (double)(graphics->number_of_isovalues - 1);
-									}
-									else
-									{
-										isovalue_range = 0;
-									}
-									for (i = 0 ; i < graphics->number_of_isovalues ; i++)
-									{
-										double isovalue =
-											graphics->first_isovalue +
-											(double)i * isovalue_range;
-										return_code = create_iso_lines_from_FE_element(element,
-											graphics_to_object_data->field_cache,
-											graphics_to_object_data->rc_coordinate_field,
-											graphics->isoscalar_field, isovalue,
-											graphics->data_field, number_in_xi[0], number_in_xi[1],
-											top_level_element, GT_object_get_vertex_set(graphics->graphics_object));
-									}
+									const double isovalue = cmzn_graphics_get_isovalue(graphics, i);
+									if (range_known && ((isovalue < scalar_range[0]) || (isovalue > scalar_range[1])))
+										continue;
+									return_code = create_iso_lines_from_FE_element(element,
+										graphics_to_object_data->field_cache,
+										graphics_to_object_data->rc_coordinate_field,
+										graphics->isoscalar_field, isovalue,
+										graphics->data_field, number_in_xi[0], number_in_xi[1],
+										top_level_element, GT_object_get_vertex_set(graphics->graphics_object),
+										(range_known) ? 0 : scalar_range);
+									// all isovalues sample the same points, so range is now known
+									if ((!range_known) && range_index && return_code &&
+										range_index->setRange(elementIndex, range_number_in_xi, scalar_range))
+										range_known = true;
 								}
 							}
 						} break;
@@ -685,6 +851,11 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 							return_code = 0;
 						} break;
 					}
+					if (range_index && (!range_known) && ((!return_code) ||
+						(!range_index->setRange(elementIndex, range_number_in_xi, scalar_range))))
+					{
+						range_index->setSweepMissingRange();
+					}
 				} break;
 				case CMZN_GRAPHICS_TYPE_POINTS:
 				{
@@ -759,6 +930,7 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 										graphics_to_object_data->wrapper_stream_vector_field,
 										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 										graphics->streamline_length,
+										graphics->streamlines_integration_method, graphics->streamlines_integration_tolerance,
 										graphics->streamlines_colour_data_type, graphics->data_field,
 										GT_object_get_vertex_set(graphics->graphics_object));
 								}
@@ -778,6 +950,7 @@ static int FE_element_to_graphics_object(struct FE_element *element,
 										graphics_to_object_data->wrapper_stream_vector_field,
 										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 										graphics->streamline_length,
+										graphics->streamlines_integration_method, graphics->streamlines_integration_tolerance,
 										graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
 										graphics->line_base_size, graphics->line_scale_factors,
 										graphics->line_orientation_scale_field,
@@ -861,6 +1034,7 @@ static int cmzn_node_to_streamline(struct FE_node *node,
 							graphics_to_object_data->wrapper_stream_vector_field,
 							static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 							graphics->streamline_length,
+							graphics->streamlines_integration_method, graphics->streamlines_integration_tolerance,
 							graphics->streamlines_colour_data_type, graphics->data_field,
 							GT_object_get_vertex_set(graphics->graphics_object));
 				} break;
@@ -874,6 +1048,7 @@ static int cmzn_node_to_streamline(struct FE_node *node,
 						graphics_to_object_data->wrapper_stream_vector_field,
 						static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
 						graphics->streamline_length,
+						graphics->streamlines_integration_method, graphics->streamlines_integration_tolerance,
 						graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
 						graphics->line_base_size, graphics->line_scale_factors,
 						graphics->line_orientation_scale_field,
@@ -1983,6 +2158,22 @@ char *cmzn_graphics_string(struct cmzn_graphics *graphics,
 			append_string(&graphics_string,temp_string,&error);
 			append_string(&graphics_string,
 				ENUMERATOR_STRING(cmzn_graphics_streamlines_colour_data_type)(graphics->streamlines_colour_data_type),&error);
+			if (CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER != graphics->streamlines_integration_method)
+			{
+				char *method_string = cmzn_graphics_streamlines_integration_method_enum_to_string(
+					graphics->streamlines_integration_method);
+				if (method_string)
+				{
+					append_string(&graphics_string, " integration ", &error);
+					append_string(&graphics_string, method_string, &error);
+					DEALLOCATE(method_string);
+				}
+			}
+			if (1.0E-4 != graphics->streamlines_integration_tolerance)
+			{
+				sprintf(temp_string, " tolerance %g", graphics->streamlines_integration_tolerance);
+				append_string(&graphics_string, temp_string, &error);
+			}
 			if (graphics->seed_nodeset)
 			{
 				append_string(&graphics_string, " seed_nodeset ", &error);
@@ -2621,17 +2812,160 @@ static char *cmzn_graphics_get_graphics_object_name(cmzn_graphics *graphics, con
 	return graphics_object_name;
 }
 
+/**
+ * Count the elements of mesh which pass the exterior and face type filters of
+ * graphics, as used by FE_element_to_graphics_object. Other filters such as
+ * subgroup and selection are not applied so the count may be high.
+ */
+static int cmzn_graphics_count_mesh_elements_to_build(cmzn_graphics *graphics,
+	cmzn_mesh_id mesh)
+{
+	FE_mesh *fe_mesh = cmzn_mesh_get_FE_mesh_internal(mesh);
+	if ((!fe_mesh) || (fe_mesh->getDimension() >= 3) ||
+		((!graphics->exterior) && (CMZN_ELEMENT_FACE_TYPE_ALL == graphics->face)))
+		return cmzn_mesh_get_size(mesh);
+	int count = 0;
+	cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(mesh);
+	cmzn_element_id element = 0;
+	while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
+	{
+		const DsLabelIndex elementIndex = get_FE_element_index(element);
+		if ((graphics->exterior) && (!fe_mesh->isElementExterior(elementIndex)))
+			continue;
+		if (CMZN_ELEMENT_FACE_TYPE_NO_FACE == graphics->face)
+		{
+			if (fe_mesh->getElementParentOnFace(elementIndex, CMZN_ELEMENT_FACE_TYPE_ANY_FACE) >= 0)
+				continue;
+		}
+		else if ((CMZN_ELEMENT_FACE_TYPE_ALL != graphics->face) &&
+			(fe_mesh->getElementParentOnFace(elementIndex, graphics->face) < 0))
+			continue;
+		++count;
+	}
+	cmzn_elementiterator_destroy(&iterator);
+	return count;
+}
+
+/* limit on vertices reserved up front; buffers grow geometrically beyond it */
+#define GRAPHICS_MAXIMUM_RESERVED_VERTICES 4194304
+
+/**
+ * Before a full build of line or surface graphics, reserve vertex buffer
+ * memory for the number of vertices estimated from the elements to build and
+ * tessellation so the buffers are not repeatedly reallocated while filling.
+ * Does nothing if the vertex array already holds vertices, e.g. when partially
+ * rebuilding. Unused memory is freed by cmzn_graphics_free_unused_vertex_buffers
+ * once the build is complete.
+ * @param points_per_element  Estimated vertices generated per element.
+ * @param include_normals  Set to reserve normals as well as positions.
+ */
+static void cmzn_graphics_reserve_vertex_buffers(
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data,
+	Graphics_vertex_array *array, int points_per_element, bool include_normals)
+{
+	cmzn_mesh_id mesh = graphics_to_object_data->iteration_mesh;
+	if ((!array) || (!mesh) || (points_per_element <= 0) ||
+		(0 < array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION)))
+		return;
+	const int element_count = cmzn_graphics_count_mesh_elements_to_build(
+		graphics_to_object_data->graphics, mesh);
+	if (element_count <= 0)
+		return;
+	size_t number_of_points = GRAPHICS_MAXIMUM_RESERVED_VERTICES;
+	if (static_cast<size_t>(element_count) <= GRAPHICS_MAXIMUM_RESERVED_VERTICES / static_cast<size_t>(points_per_element))
+		number_of_points = static_cast<size_t>(element_count)*static_cast<size_t>(points_per_element);
+	const unsigned int reserve_count = static_cast<unsigned int>(number_of_points);
+	array->reserve_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION, 3, reserve_count);
+	if (include_normals)
+		array->reserve_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL, 3, reserve_count);
+	if ((graphics_to_object_data->graphics->data_field) && (0 < graphics_to_object_data->number_of_data_values))
+		array->reserve_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+			graphics_to_object_data->number_of_data_values, reserve_count);
+}
+
+#undef GRAPHICS_MAXIMUM_RESERVED_VERTICES
+
+/**
+ * After a line or surface build is complete, free memory reserved beyond the
+ * vertices actually added so it is not held or counted in the memory size of
+ * the graphics. Does nothing while an incremental build has more to do.
+ */
+static void cmzn_graphics_free_unused_vertex_buffers(cmzn_graphics *graphics)
+{
+	if (graphics->incrementalBuildIndex != DS_LABEL_INDEX_INVALID)
+		return;
+	Graphics_vertex_array *array = GT_object_get_vertex_set(graphics->graphics_object);
+	if (!array)
+		return;
+	array->free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	array->free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL);
+	array->free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA);
+}
+
+/**
+ * Converts only elements of mesh whose cached isoscalar range spans any of
+ * the isovalues of contours graphics. Scalar range index must be complete.
+ */
+static int cmzn_mesh_to_contours_spanning_isovalues(cmzn_mesh_id mesh,
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	cmzn_graphics *graphics = graphics_to_object_data->graphics;
+	std::vector<double> isovalues(graphics->number_of_isovalues);
+	for (int i = 0; i < graphics->number_of_isovalues; ++i)
+		isovalues[i] = cmzn_graphics_get_isovalue(graphics, i);
+	std::vector<DsLabelIndex> elementIndexes;
+	if (0 < graphics->number_of_isovalues)
+		graphics->scalar_range_index->getElementsSpanningValues(graphics->number_of_isovalues,
+			&(isovalues[0]), elementIndexes);
+	FE_mesh *fe_mesh = cmzn_mesh_get_FE_mesh_internal(mesh);
+	int return_code = 1;
+	GraphicsIncrementalBuild *incrementalBuild = graphics_to_object_data->incrementalBuild;
+	const size_t size = elementIndexes.size();
+	for (size_t i = 0; i < size; ++i)
+	{
+		const DsLabelIndex elementIndex = elementIndexes[i];
+		if ((incrementalBuild) && (elementIndex <= graphics->incrementalBuildIndex))
+			continue;
+		FE_element *element = fe_mesh->getElement(elementIndex);
+		if ((!element) || (!cmzn_mesh_contains_element(mesh, element)))
+			continue;
+		if (!FE_element_to_graphics_object(element, graphics_to_object_data))
+		{
+			return_code = 0;
+			break;
+		}
+		if ((incrementalBuild) && incrementalBuild->incrementDone())
+		{
+			graphics->incrementalBuildIndex = elementIndex;
+			if ((i + 1) < size)
+				incrementalBuild->setMoreWorkToDo();
+			break;
+		}
+	}
+	if ((incrementalBuild) && !incrementalBuild->isMoreWorkToDo())
+		graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
+	return return_code;
+}
+
 static int cmzn_mesh_to_graphics(cmzn_mesh_id mesh, cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
 {
+	cmzn_graphics *graphics = graphics_to_object_data->graphics;
+	Element_scalar_range_index *range_index = (CMZN_GRAPHICS_TYPE_CONTOURS == graphics->graphics_type) ?
+		graphics->scalar_range_index : 0;
+	// if isovalues changed since last full build, cull elements not visited
+	if ((range_index) && range_index->isComplete())
+		return cmzn_mesh_to_contours_spanning_isovalues(mesh, graphics_to_object_data);
 	cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(mesh);
 	if (!iterator)
 		return 0;
 	int return_code = 1;
 	cmzn_element_id element = 0;
 	GraphicsIncrementalBuild *incrementalBuild = graphics_to_object_data->incrementalBuild;
-	cmzn_graphics *graphics = graphics_to_object_data->graphics;
 	if ((incrementalBuild) && (graphics->incrementalBuildIndex != DS_LABEL_INDEX_INVALID))
 		iterator->setIndex(graphics->incrementalBuildIndex);
+	else if (range_index)
+		range_index->beginSweep();
+	bool finished = true;
 	while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
 	{
 		if (!FE_element_to_graphics_object(element, graphics_to_object_data))
@@ -2643,13 +2977,18 @@ static int cmzn_mesh_to_graphics(cmzn_mesh_id mesh, cmzn_graphics_to_graphics_ob
 		{
 			graphics->incrementalBuildIndex = get_FE_element_index(element);
 			if (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
+			{
 				incrementalBuild->setMoreWorkToDo();
+				finished = false;
+			}
 			break;
 		}
 	}
 	cmzn_elementiterator_destroy(&iterator);
 	if ((incrementalBuild) && !incrementalBuild->isMoreWorkToDo())
 		graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
+	if ((range_index) && return_code && finished)
+		range_index->endSweep();
 	return return_code;
 }
 
@@ -2947,6 +3286,12 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 										DESTROY(GT_polyline_vertex_buffers)(&lines);
 										return_code = 0;
 									}
+									else
+									{
+										cmzn_graphics_reserve_vertex_buffers(graphics_to_object_data,
+											GT_object_get_vertex_set(graphics->graphics_object),
+											graphics_to_object_data->top_level_number_in_xi[0] + 1, /*include_normals*/false);
+									}
 								}
 								else if (graphics_to_object_data->iteration_mesh)
 								{
@@ -2962,7 +3307,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 							else
 								GT_object_reset_buffer_binding(graphics->graphics_object);
 							if (return_code && (graphics_to_object_data->iteration_mesh))
+							{
 								return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+								cmzn_graphics_free_unused_vertex_buffers(graphics);
+							}
 						} break;
 						case CMZN_GRAPHICS_TYPE_SURFACES:
 						{
@@ -3005,11 +3353,34 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 										DESTROY(GT_surface_vertex_buffers)(&surfaces);
 										return_code = 0;
 									}
+									else
+									{
+										cmzn_graphics_reserve_vertex_buffers(graphics_to_object_data,
+											GT_object_get_vertex_set(graphics->graphics_object),
+											(graphics_to_object_data->top_level_number_in_xi[0] + 1)*
+											(graphics_to_object_data->top_level_number_in_xi[1] + 1), /*include_normals*/true);
+									}
 								}
 								else
 									GT_object_reset_buffer_binding(graphics->graphics_object);
+								FE_surface_shared_edge_data *shared_edge_data = 0;
+								if ((graphics->shared_edge_evaluation) && (graphics->data_field))
+								{
+									shared_edge_data = new FE_surface_shared_edge_data(
+										Computed_field_get_number_of_components(graphics->data_field));
+								}
+								graphics_to_object_data->shared_edge_data = shared_edge_data;
 								if (return_code && (graphics_to_object_data->iteration_mesh))
+								{
 									return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+									cmzn_graphics_free_unused_vertex_buffers(graphics);
+								}
+								graphics_to_object_data->shared_edge_data = 0;
+								graphics->shared_edge_evaluation_count = (shared_edge_data) ?
+									static_cast<int>(shared_edge_data->getEvaluationCount()) : 0;
+								graphics->shared_edge_reuse_count = (shared_edge_data) ?
+									static_cast<int>(shared_edge_data->getReuseCount()) : 0;
+								delete shared_edge_data;
 							}
 						} break;
 						case CMZN_GRAPHICS_TYPE_CONTOURS:
@@ -3045,6 +3416,16 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 									GT_object_reset_buffer_binding(graphics->graphics_object);
 								if (return_code && (graphics_to_object_data->iteration_mesh))
 								{
+									if (graphics->isoscalar_field)
+									{
+										if (!graphics->scalar_range_index)
+											graphics->scalar_range_index = new Element_scalar_range_index();
+										// ranges of isoscalar field without multiple times are valid at all times
+										graphics->scalar_range_index->checkMeshAndTime(
+											cmzn_mesh_get_FE_mesh_internal(graphics_to_object_data->master_mesh),
+											Computed_field_has_multiple_times(graphics->isoscalar_field) ?
+												graphics_to_object_data->time : 0.0);
+									}
 									if (g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
 										graphics_to_object_data->iso_surface_specification =
@@ -3128,7 +3509,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								set_GT_object_Spectrum(graphics->graphics_object, graphics->spectrum);
 							}
 							if (!((incrementalBuild) && incrementalBuild->isMoreWorkToDo()))
+							{
 								graphics->graphics_changed = 0;
+								graphics->graphics_object_time = graphics_to_object_data->time;
+							}
 							/* mark display list as needing updating */
 							GT_object_changed(graphics->graphics_object);
 						}
@@ -3178,7 +3562,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 		if (graphics->selected_graphics_changed)
 		{
 			if (graphics->graphics_object)
-				GT_object_changed(graphics->graphics_object);
+				GT_object_selection_changed(graphics->graphics_object);
 			graphics->selected_graphics_changed = 0;
 		}
 	}
@@ -3437,6 +3821,21 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 		reinterpret_cast<cmzn_graphics_field_change_data *>(change_data_void);
 	if (change_data->selection_changed && (CMZN_GRAPHICS_TYPE_STREAMLINES != graphics->graphics_type))
 		cmzn_graphics_update_selected(graphics, (void *)NULL);
+	Element_scalar_range_index *range_index = graphics->scalar_range_index;
+	cmzn_field_change_flags isoscalarChange = CMZN_FIELD_CHANGE_FLAG_NONE;
+	if (range_index)
+	{
+		// cached isoscalar ranges are invalidated per element below for partial
+		// changes to existing graphics, otherwise all are cleared
+		if (graphics->isoscalar_field)
+			isoscalarChange = cmzn_fieldmoduleevent_get_field_change_flags(change_data->event, graphics->isoscalar_field);
+		if ((isoscalarChange & (CMZN_FIELD_CHANGE_FLAG_DEFINITION | CMZN_FIELD_CHANGE_FLAG_FULL_RESULT)) ||
+			((isoscalarChange & CMZN_FIELD_CHANGE_FLAG_PARTIAL_RESULT) &&
+				((0 == graphics->graphics_object) || (0 == change_data->event->getFeRegionChanges()))))
+			range_index->clear();
+		else if (0 == graphics->graphics_object)
+			range_index->setIncomplete(); // filters may have changed
+	}
 	if (0 == graphics->graphics_object)
 	{
 		cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_REDRAW);
@@ -3474,6 +3873,8 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 		{
 			if (fieldChange & CMZN_FIELD_CHANGE_FLAG_FULL_RESULT)
 			{
+				if ((range_index) && (isoscalarChange & CMZN_FIELD_CHANGE_FLAG_PARTIAL_RESULT))
+					range_index->clear();
 				cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 				return 1;
 			}
@@ -3522,6 +3923,8 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 				if (tooManyElementChanges ||
 					(numberNodeChanges*2 > fe_nodeset->get_number_of_FE_nodes()))
 				{
+					if (range_index)
+						range_index->clear();
 					cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 					return 1;
 				}
@@ -3534,6 +3937,8 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 				/* partial rebuild for few node/element field changes */
 				GT_object_conditional_invalidate_primitives(graphics->graphics_object,
 					FE_element_as_graphics_name_has_changed, static_cast<void*>(&data));
+				if (range_index)
+					range_index->invalidateConditional(FE_element_as_graphics_name_has_changed, static_cast<void*>(&data));
 				cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_PARTIAL_REBUILD);
 			}
 		}
@@ -3674,6 +4079,9 @@ int cmzn_graphics_copy_without_graphics_object(
 		/* for all graphics types */
 		destination->graphics_type=source->graphics_type;
 		destination->domain_type = source->domain_type;
+		// filters may change without notification, so cached ranges can't be trusted
+		if (destination->scalar_range_index)
+			destination->scalar_range_index->clear();
 		destination->coordinate_system=source->coordinate_system;
 		REACCESS(Computed_field)(&(destination->coordinate_field),
 			source->coordinate_field);
@@ -3800,6 +4208,8 @@ int cmzn_graphics_copy_without_graphics_object(
 			source->stream_vector_field);
 		destination->streamlines_track_direction = source->streamlines_track_direction;
 		destination->streamline_length=source->streamline_length;
+		destination->streamlines_integration_method = source->streamlines_integration_method;
+		destination->streamlines_integration_tolerance = source->streamlines_integration_tolerance;
 		if (destination->seed_nodeset)
 		{
 			cmzn_nodeset_destroy(&destination->seed_nodeset);
@@ -3820,6 +4230,7 @@ int cmzn_graphics_copy_without_graphics_object(
 		REACCESS(cmzn_material)(&(destination->secondary_material),
 			source->secondary_material);
 		cmzn_graphics_set_render_polygon_mode(destination,source->render_polygon_mode);
+		destination->shared_edge_evaluation = source->shared_edge_evaluation;
 		REACCESS(Computed_field)(&(destination->data_field), source->data_field);
 		REACCESS(cmzn_spectrum)(&(destination->spectrum), source->spectrum);
 		destination->streamlines_colour_data_type = source->streamlines_colour_data_type;
@@ -3827,6 +4238,10 @@ int cmzn_graphics_copy_without_graphics_object(
 			source->selected_material);
 		destination->autorange_spectrum_flag = source->autorange_spectrum_flag;
 		REACCESS(cmzn_font)(&(destination->font), source->font);
+		destination->time_cache_memory_limit = source->time_cache_memory_limit;
+		// discard any graphics cached for destination's previous attributes
+		cmzn_graphics_set_time_cache_enabled(destination, false);
+		cmzn_graphics_set_time_cache_enabled(destination, 0 != source->time_cache);
 
 		/* ensure destination graphics object is cleared */
 		REACCESS(GT_object)(&(destination->graphics_object),
@@ -4043,11 +4458,19 @@ int cmzn_graphics_same_non_trivial(cmzn_graphics *graphics,
 				(graphics->stream_vector_field==second_graphics->stream_vector_field)&&
 				(graphics->streamlines_track_direction == second_graphics->streamlines_track_direction) &&
 				(graphics->streamline_length==second_graphics->streamline_length)&&
+				(graphics->streamlines_integration_method == second_graphics->streamlines_integration_method) &&
+				(graphics->streamlines_integration_tolerance == second_graphics->streamlines_integration_tolerance) &&
 				(((graphics->seed_nodeset==0) && (second_graphics->seed_nodeset==0)) ||
 					((graphics->seed_nodeset) && (second_graphics->seed_nodeset) &&
 						cmzn_nodeset_match(graphics->seed_nodeset, second_graphics->seed_nodeset)))&&
 				(graphics->seed_node_mesh_location_field==second_graphics->seed_node_mesh_location_field);
 		}
+		/* for surfaces only */
+		if (return_code&&(CMZN_GRAPHICS_TYPE_SURFACES==graphics->graphics_type))
+		{
+			return_code=
+				(graphics->shared_edge_evaluation==second_graphics->shared_edge_evaluation);
+		}
 
 		if (return_code)
 		{
@@ -4630,13 +5053,13 @@ int cmzn_graphics_set_texture_coordinate_field(
 }
 
 int cmzn_graphics_time_change(
-	struct cmzn_graphics *graphics,void *dummy_void)
+	struct cmzn_graphics *graphics,void *time_void)
 {
 	int return_code;
+	double *time = static_cast<double *>(time_void);
 
 	ENTER(cmzn_graphics_time_change);
-	USE_PARAMETER(dummy_void);
-	if (graphics)
+	if (graphics && time)
 	{
 		return_code = 1;
 		if (graphics->glyph)
@@ -4645,7 +5068,33 @@ int cmzn_graphics_time_change(
 		}
 		if (graphics->time_dependent)
 		{
-			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+			GT_object *cached_graphics_object = 0;
+			if (graphics->time_cache)
+			{
+				if ((graphics->graphics_object) && (!graphics->graphics_changed))
+				{
+					graphics->time_cache->store(graphics->graphics_object_time,
+						graphics->graphics_object);
+				}
+				cached_graphics_object = graphics->time_cache->find(*time);
+			}
+			if (cached_graphics_object)
+			{
+				REACCESS(GT_object)(&(graphics->graphics_object), cached_graphics_object);
+				graphics->graphics_object_time = *time;
+				graphics->graphics_changed = 0;
+				cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_REDRAW);
+			}
+			else
+			{
+				// rebuild without clearing time cache
+				graphics->graphics_changed = 1;
+				if (graphics->graphics_object)
+				{
+					DEACCESS(GT_object)(&(graphics->graphics_object));
+				}
+				cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_REDRAW);
+			}
 		}
 	}
 	else
@@ -4659,6 +5108,53 @@ int cmzn_graphics_time_change(
 	return (return_code);
 } /* cmzn_graphics_time_change */
 
+bool cmzn_graphics_is_time_cache_enabled(cmzn_graphics_id graphics)
+{
+	if (graphics)
+		return (0 != graphics->time_cache);
+	return false;
+}
+
+int cmzn_graphics_set_time_cache_enabled(cmzn_graphics_id graphics,
+	bool enabled)
+{
+	if (graphics)
+	{
+		if (enabled)
+		{
+			if (!graphics->time_cache)
+				graphics->time_cache = new cmzn_graphics_time_cache(graphics->time_cache_memory_limit);
+		}
+		else
+		{
+			delete graphics->time_cache;
+			graphics->time_cache = 0;
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_graphics_get_time_cache_memory_limit(cmzn_graphics_id graphics)
+{
+	if (graphics)
+		return graphics->time_cache_memory_limit;
+	return 0;
+}
+
+int cmzn_graphics_set_time_cache_memory_limit(cmzn_graphics_id graphics,
+	int memory_limit)
+{
+	if (graphics && (memory_limit > 0))
+	{
+		graphics->time_cache_memory_limit = memory_limit;
+		if (graphics->time_cache)
+			graphics->time_cache->setMemoryLimit(memory_limit);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 int cmzn_graphics_update_time_behaviour(
 	struct cmzn_graphics *graphics, void *update_time_behaviour_void)
 {
@@ -5340,6 +5836,41 @@ char *cmzn_graphics_streamlines_track_direction_enum_to_string(
 	return (string ? duplicate_string(string) : 0);
 }
 
+class cmzn_graphics_streamlines_integration_method_conversion
+{
+public:
+	static const char *to_string(enum cmzn_graphics_streamlines_integration_method method)
+	{
+		const char *enum_string = 0;
+		switch (method)
+		{
+		case CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER:
+			enum_string = "IMPROVED_EULER";
+			break;
+		case CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45:
+			enum_string = "RUNGE_KUTTA_45";
+			break;
+		default:
+			break;
+		}
+		return enum_string;
+	}
+};
+
+enum cmzn_graphics_streamlines_integration_method cmzn_graphics_streamlines_integration_method_enum_from_string(
+	const char *string)
+{
+	return string_to_enum<enum cmzn_graphics_streamlines_integration_method,
+		cmzn_graphics_streamlines_integration_method_conversion>(string);
+}
+
+char *cmzn_graphics_streamlines_integration_method_enum_to_string(
+	enum cmzn_graphics_streamlines_integration_method method)
+{
+	const char *string = cmzn_graphics_streamlines_integration_method_conversion::to_string(method);
+	return (string ? duplicate_string(string) : 0);
+}
+
 class cmzn_graphics_streamlines_colour_data_type_conversion
 {
 public:
@@ -5472,6 +6003,8 @@ int cmzn_graphics_contours_set_isoscalar_field(
 		if (isoscalar_field != graphics->isoscalar_field)
 		{
 			REACCESS(Computed_field)(&(graphics->isoscalar_field), isoscalar_field);
+			if (graphics->scalar_range_index)
+				graphics->scalar_range_index->clear();
 			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 		}
 		return CMZN_OK;
@@ -5479,6 +6012,20 @@ int cmzn_graphics_contours_set_isoscalar_field(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+/**
+ * Call after changing only the isovalues of contours graphics. Since graphics
+ * filters are unchanged, a complete scalar range index remains complete so
+ * the rebuild only visits elements spanning the new isovalues.
+ */
+static void cmzn_graphics_isovalues_changed(struct cmzn_graphics *graphics)
+{
+	const bool ranges_complete = (graphics->scalar_range_index) &&
+		graphics->scalar_range_index->isComplete();
+	cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+	if (ranges_complete)
+		graphics->scalar_range_index->setComplete();
+}
+
 int cmzn_graphics_contours_get_list_isovalues(
 	cmzn_graphics_contours_id contours, int number_of_isovalues,
 	double *isovalues)
@@ -5558,7 +6105,7 @@ int cmzn_graphics_contours_set_list_isovalues(
 				}
 				graphics->number_of_isovalues = 0;
 			}
-			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+			cmzn_graphics_isovalues_changed(graphics);
 		}
 		return CMZN_OK;
 	}
@@ -5626,7 +6173,7 @@ int cmzn_graphics_contours_set_range_isovalues(
 			graphics->number_of_isovalues = number_of_isovalues;
 			graphics->first_isovalue = first_isovalue;
 			graphics->last_isovalue = last_isovalue;
-			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+			cmzn_graphics_isovalues_changed(graphics);
 		}
 		return CMZN_OK;
 	}
@@ -5705,6 +6252,59 @@ int cmzn_graphics_streamlines_set_colour_data_type(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+enum cmzn_graphics_streamlines_integration_method
+	cmzn_graphics_streamlines_get_integration_method(
+		cmzn_graphics_streamlines_id streamlines)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics)
+		return graphics->streamlines_integration_method;
+	return CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID;
+}
+
+int cmzn_graphics_streamlines_set_integration_method(
+	cmzn_graphics_streamlines_id streamlines,
+	enum cmzn_graphics_streamlines_integration_method integration_method)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics && ((integration_method == CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER) ||
+		(integration_method == CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45)))
+	{
+		if (integration_method != graphics->streamlines_integration_method)
+		{
+			graphics->streamlines_integration_method = integration_method;
+			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+double cmzn_graphics_streamlines_get_integration_tolerance(
+	cmzn_graphics_streamlines_id streamlines)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics)
+		return graphics->streamlines_integration_tolerance;
+	return 0.0;
+}
+
+int cmzn_graphics_streamlines_set_integration_tolerance(
+	cmzn_graphics_streamlines_id streamlines, double tolerance)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics && (tolerance > 0.0))
+	{
+		if (tolerance != graphics->streamlines_integration_tolerance)
+		{
+			graphics->streamlines_integration_tolerance = tolerance;
+			cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_field_id cmzn_graphics_streamlines_get_stream_vector_field(
 	cmzn_graphics_streamlines_id streamlines)
 {
@@ -5800,6 +6400,46 @@ int cmzn_graphics_surfaces_destroy(cmzn_graphics_surfaces_id *surfaces_address)
 	return cmzn_graphics_destroy(reinterpret_cast<cmzn_graphics_id *>(surfaces_address));
 }
 
+bool cmzn_graphics_surfaces_is_shared_edge_evaluation(
+	cmzn_graphics_surfaces_id surfaces)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(surfaces);
+	if (graphics)
+		return graphics->shared_edge_evaluation;
+	return false;
+}
+
+int cmzn_graphics_surfaces_get_shared_edge_statistics(
+	cmzn_graphics_surfaces_id surfaces, int *evaluation_count_out,
+	int *reuse_count_out)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(surfaces);
+	if (graphics && evaluation_count_out && reuse_count_out)
+	{
+		*evaluation_count_out = graphics->shared_edge_evaluation_count;
+		*reuse_count_out = graphics->shared_edge_reuse_count;
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_graphics_surfaces_set_shared_edge_evaluation(
+	cmzn_graphics_surfaces_id surfaces, bool shared_edge_evaluation)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(surfaces);
+	if (graphics)
+	{
+		if (shared_edge_evaluation != graphics->shared_edge_evaluation)
+		{
+			graphics->shared_edge_evaluation = shared_edge_evaluation;
+			if (graphics->data_field)
+				cmzn_graphics_changed(graphics, CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_graphicslineattributes_id cmzn_graphics_get_graphicslineattributes(
 	cmzn_graphics_id graphics)
 {
@@ -6708,6 +7348,7 @@ struct GT_object *cmzn_graphics_copy_graphics_object(struct cmzn_graphics *graph
 				graphics_to_object_data.selection_group_field = cmzn_scene_get_selection_field(
 					graphics->scene);
 				graphics_to_object_data.iso_surface_specification = NULL;
+				graphics_to_object_data.shared_edge_data = 0;
 				cmzn_graphics_to_graphics_object_no_check_on_filter(copy_graphics,
 					&graphics_to_object_data);
 				return_object = ACCESS(GT_object)(copy_graphics->graphics_object);
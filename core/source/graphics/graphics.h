@@ -29,6 +29,8 @@
 
 struct cmzn_graphicspointattributes;
 struct cmzn_graphicslineattributes;
+class cmzn_graphics_time_cache;
+class Element_scalar_range_index;
 
 struct cmzn_graphics
 /*******************************************************************************
@@ -78,6 +80,8 @@ finite element group scene.
 		first_isovalue to last_isovalue including these values for n>1 */
 	double *isovalues, first_isovalue, last_isovalue,
 		decimation_threshold;
+	/* cached range of isoscalar_field over elements for culling, or NULL */
+	Element_scalar_range_index *scalar_range_index;
 
 	/* point attributes */
 	cmzn_glyph *glyph;
@@ -110,6 +114,8 @@ finite element group scene.
 	struct Computed_field *stream_vector_field;
 	enum cmzn_graphics_streamlines_track_direction streamlines_track_direction;
 	FE_value streamline_length;
+	enum cmzn_graphics_streamlines_integration_method streamlines_integration_method;
+	FE_value streamlines_integration_tolerance;
 	enum cmzn_graphics_streamlines_colour_data_type streamlines_colour_data_type;
 	/* streamline seed nodeset and field giving mesh location */
 	cmzn_nodeset_id seed_nodeset;
@@ -127,6 +133,11 @@ finite element group scene.
 	struct cmzn_font *font;
 	/* for surfaces */
 	enum cmzn_graphics_render_polygon_mode render_polygon_mode;
+	/* for surfaces: reuse data values at points on edges shared with neighbours */
+	bool shared_edge_evaluation;
+	/* for surfaces: edge point data evaluations made and reused in last build */
+	int shared_edge_evaluation_count;
+	int shared_edge_reuse_count;
 	/* for rendering lines in GL, positive value; default 1.0 */
 	double render_line_width;
 	/* for rendering points in GL, positive value; default 1.0 */
@@ -144,6 +155,12 @@ finite element group scene.
 	/* flag indicating that this settings needs to be regenerated when time
 		changes */
 	int time_dependent;
+	/* time graphics_object was last completely built at */
+	double graphics_object_time;
+	/* optional cache of graphics objects built at other times, or NULL */
+	cmzn_graphics_time_cache *time_cache;
+	/* approximate memory limit for time_cache in megabytes */
+	int time_cache_memory_limit;
 	enum cmzn_scenecoordinatesystem coordinate_system;
 // 	/* for accessing objects */
 	int access_count;
@@ -283,6 +300,8 @@ struct cmzn_graphics_to_graphics_object_data
 	FE_value *data_copy_buffer;
 
 	struct Iso_surface_specification *iso_surface_specification;
+	/* for surfaces with shared edge evaluation, otherwise NULL */
+	FE_surface_shared_edge_data *shared_edge_data;
 	struct cmzn_scenefilter *scenefilter;
 	/* additional values for passing to element_to_graphics_object */
 	struct cmzn_graphics *graphics;
@@ -551,8 +570,13 @@ int cmzn_graphics_same_non_trivial_with_graphics_object(
  */
 char *cmzn_graphics_get_name_internal(struct cmzn_graphics *graphics);
 
+/**
+ * Informs graphics that time has changed so time-dependent graphics are
+ * rebuilt, or restored from the time cache if enabled.
+ * @param time_void  Pointer to double new time.
+ */
 int cmzn_graphics_time_change(
-	struct cmzn_graphics *graphics,void *dummy_void);
+	struct cmzn_graphics *graphics,void *time_void);
 
 int cmzn_graphics_update_time_behaviour(
 	struct cmzn_graphics *graphics, void *update_time_behaviour_void);
@@ -681,6 +705,12 @@ enum cmzn_graphics_streamlines_track_direction cmzn_graphics_streamlines_track_d
 char *cmzn_graphics_streamlines_track_direction_enum_to_string(
 	enum cmzn_graphics_streamlines_track_direction direction);
 
+enum cmzn_graphics_streamlines_integration_method cmzn_graphics_streamlines_integration_method_enum_from_string(
+	const char *string);
+
+char *cmzn_graphics_streamlines_integration_method_enum_to_string(
+	enum cmzn_graphics_streamlines_integration_method method);
+
 enum cmzn_graphics_streamlines_colour_data_type cmzn_graphics_streamlines_colour_data_type_enum_from_string(
 	const char *string);
 
@@ -33,6 +33,7 @@ gtObject/gtWindow management routines.
 #include "graphics/font.h"
 #include "graphics/glyph.hpp"
 #include "graphics/graphics_object.h"
+#include "graphics/graphics_object_bvh.hpp"
 #include "graphics/material.h"
 #include "graphics/spectrum.h"
 #include "graphics/volume_texture.h"
@@ -1136,6 +1137,8 @@ struct GT_object *CREATE(GT_object)(const char *name,enum GT_object_type object_
 				object->multipass_frame_buffer_texture = 0;
 #endif /* defined (OPENGL_API) */
 				object->compile_status = GRAPHICS_NOT_COMPILED;
+				object->picking_bvh = 0;
+				object->picking_bvh_time_index = 0;
 				object->object_type=object_type;
 				if (default_material)
 				{
@@ -1231,6 +1234,7 @@ static int DESTROY(GT_object)(struct GT_object **object_ptr)
 			{
 				delete object->vertex_array;
 			}
+			delete object->picking_bvh;
 			if (object->texture_tiling)
 			{
 				DEACCESS(Texture_tiling)(&object->texture_tiling);
@@ -1315,6 +1319,20 @@ DECLARE_OBJECT_FUNCTIONS(GT_object)
 DECLARE_DEFAULT_GET_OBJECT_NAME_FUNCTION(GT_object)
 
 void GT_object_changed(struct GT_object *graphics_object)
+{
+	while (graphics_object)
+	{
+		graphics_object->compile_status = GRAPHICS_NOT_COMPILED;
+		if (graphics_object->picking_bvh)
+		{
+			delete graphics_object->picking_bvh;
+			graphics_object->picking_bvh = 0;
+		}
+		graphics_object = graphics_object->nextobject;
+	}
+}
+
+void GT_object_selection_changed(struct GT_object *graphics_object)
 {
 	while (graphics_object)
 	{
@@ -1323,6 +1341,36 @@ void GT_object_changed(struct GT_object *graphics_object)
 	}
 }
 
+Graphics_object_bvh *GT_object_get_picking_bvh(struct GT_object *graphics_object,
+	ZnReal time)
+{
+	if (!graphics_object)
+		return 0;
+	/* as in render_GT_object_opengl_immediate: last time not after time, or
+	 * the first time if time is before all of them */
+	int time_index = graphics_object->number_of_times - 1;
+	if ((0 < time_index) && (graphics_object->times))
+	{
+		while ((0 < time_index) && (time < graphics_object->times[time_index]))
+			--time_index;
+	}
+	else
+	{
+		time_index = 0;
+	}
+	if ((graphics_object->picking_bvh) && (graphics_object->picking_bvh_time_index != time_index))
+	{
+		delete graphics_object->picking_bvh;
+		graphics_object->picking_bvh = 0;
+	}
+	if (!graphics_object->picking_bvh)
+	{
+		graphics_object->picking_bvh = Graphics_object_bvh::create(graphics_object, time_index);
+		graphics_object->picking_bvh_time_index = time_index;
+	}
+	return graphics_object->picking_bvh;
+}
+
 int GT_object_Graphical_material_change(struct GT_object *graphics_object,
 	struct LIST(cmzn_material) *changed_material_list)
 /*******************************************************************************
@@ -31,6 +31,7 @@ Global types
 
 struct cmzn_font;
 struct cmzn_scene;
+class Graphics_object_bvh;
 
 enum GT_object_type
 /*******************************************************************************
@@ -392,6 +393,22 @@ struct GT_object *CREATE(GT_object)(const char *name,enum GT_object_type object_
  */
 void GT_object_changed(struct GT_object *graphics_object);
 
+/**
+ * Mark graphics object as needing recompilation after a change only to which
+ * primitives are selected. Keeps its picking tree as geometry is unchanged.
+ */
+void GT_object_selection_changed(struct GT_object *graphics_object);
+
+/**
+ * Get tree of primitives in graphics object for picking, building it if the
+ * graphics object has changed since it was last requested.
+ * @param time  Time at which graphics are picked. Primitives are taken at the
+ * last time in the graphics object not after it, as they are rendered.
+ * @return  Tree owned by graphics object, or 0 if failed.
+ */
+Graphics_object_bvh *GT_object_get_picking_bvh(struct GT_object *graphics_object,
+	ZnReal time);
+
 int GT_object_Graphical_material_change(struct GT_object *graphics_object,
 	struct LIST(cmzn_material) *changed_material_list);
 /*******************************************************************************
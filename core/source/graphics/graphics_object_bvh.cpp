@@ -0,0 +1,606 @@
+/**
+ * FILE : graphics_object_bvh.cpp
+ *
+ * Bounding volume hierarchy over the primitives in the vertex array of a
+ * graphics object, for picking without rendering to the OpenGL select buffer.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <string>
+#include "general/debug.h"
+#include "general/message.h"
+#include "graphics/glyph.hpp"
+#include "graphics/graphics_object_bvh.hpp"
+#include "graphics/graphics_object_private.hpp"
+#include "graphics/graphics_vertex_array.hpp"
+
+namespace {
+
+/** Sort primitives by centre of bounding box along one axis. */
+template <typename PrimitiveType> class Primitive_centre_less
+{
+	const int axis;
+public:
+	Primitive_centre_less(int axisIn) :
+		axis(axisIn)
+	{
+	}
+
+	bool operator()(const PrimitiveType& primitive1, const PrimitiveType& primitive2) const
+	{
+		return (primitive1.minimum[this->axis] + primitive1.maximum[this->axis]) <
+			(primitive2.minimum[this->axis] + primitive2.maximum[this->axis]);
+	}
+};
+
+/** Sort hits by their names so those with the same names are adjacent. */
+bool Hit_names_less(const Graphics_object_bvh::Hit& hit1, const Graphics_object_bvh::Hit& hit2)
+{
+	if (hit1.numberOfNames != hit2.numberOfNames)
+		return hit1.numberOfNames < hit2.numberOfNames;
+	if (hit1.objectName != hit2.objectName)
+		return hit1.objectName < hit2.objectName;
+	return hit1.vertexName < hit2.vertexName;
+}
+
+inline void transform_homogeneous(const double *transformation, const double *point3, double *result4)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		const double *row = transformation + i*4;
+		result4[i] = row[0]*point3[0] + row[1]*point3[1] + row[2]*point3[2] + row[3];
+	}
+}
+
+/**
+ * Signed distance of homogeneous point from plane of picking volume, with
+ * planes numbered 0..5 for -x, +x, -y, +y, -z, +z. Non-negative inside.
+ */
+inline double volume_plane_distance(const double *point4, int plane)
+{
+	const double value = point4[plane / 2];
+	return (plane & 1) ? (point4[3] - value) : (point4[3] + value);
+}
+
+/**
+ * @return  True if all box corners are outside the same plane of the picking
+ * volume, so no part of the box can be inside it.
+ */
+bool box_outside_volume(const float *minimum, const float *maximum,
+	const double *transformation)
+{
+	double corners[8][4];
+	double point[3];
+	for (int c = 0; c < 8; ++c)
+	{
+		point[0] = (c & 1) ? maximum[0] : minimum[0];
+		point[1] = (c & 2) ? maximum[1] : minimum[1];
+		point[2] = (c & 4) ? maximum[2] : minimum[2];
+		transform_homogeneous(transformation, point, corners[c]);
+	}
+	for (int plane = 0; plane < 6; ++plane)
+	{
+		int c = 0;
+		while ((c < 8) && (volume_plane_distance(corners[c], plane) < 0.0))
+			++c;
+		if (c == 8)
+			return true;
+	}
+	return false;
+}
+
+}
+
+void Graphics_object_bvh::addPrimitive(unsigned int numberOfVertices,
+	const float *const *vertexCoordinates, unsigned int valuesPerVertex,
+	unsigned int numberOfNames, int objectName, int vertexName)
+{
+	Primitive primitive;
+	primitive.vertexStart = static_cast<unsigned int>(this->vertices.size() / 3);
+	primitive.numberOfVertices = static_cast<unsigned char>(numberOfVertices);
+	primitive.numberOfNames = static_cast<unsigned char>(numberOfNames);
+	primitive.objectName = objectName;
+	primitive.vertexName = vertexName;
+	const unsigned int componentCount = (valuesPerVertex < 3) ? valuesPerVertex : 3;
+	for (unsigned int v = 0; v < numberOfVertices; ++v)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			const float value = (i < componentCount) ? vertexCoordinates[v][i] : 0.0f;
+			// reject primitives with NaN coordinates
+			if (value != value)
+			{
+				this->vertices.resize(primitive.vertexStart*3);
+				return;
+			}
+			this->vertices.push_back(value);
+			if ((0 == v) || (value < primitive.minimum[i]))
+				primitive.minimum[i] = value;
+			if ((0 == v) || (value > primitive.maximum[i]))
+				primitive.maximum[i] = value;
+		}
+	}
+	this->primitives.push_back(primitive);
+}
+
+void Graphics_object_bvh::addTriangle(const float *const *vertexCoordinates,
+	unsigned int valuesPerVertex, bool wireframe, unsigned int numberOfNames, int objectName)
+{
+	if (!wireframe)
+	{
+		this->addPrimitive(3, vertexCoordinates, valuesPerVertex, numberOfNames, objectName, 0);
+		return;
+	}
+	const float *edgeCoordinates[2];
+	for (int e = 0; e < 3; ++e)
+	{
+		edgeCoordinates[0] = vertexCoordinates[e];
+		edgeCoordinates[1] = vertexCoordinates[(e + 1) % 3];
+		this->addPrimitive(2, edgeCoordinates, valuesPerVertex, numberOfNames, objectName, 0);
+	}
+}
+
+void Graphics_object_bvh::addGlyphSet(GT_object *graphics_object, bool pickingNames)
+{
+	GT_glyphset_vertex_buffers *glyph_set = graphics_object->primitive_lists->gt_glyphset_vertex_buffers;
+	if (!glyph_set)
+		return;
+	Graphics_vertex_array *array = graphics_object->vertex_array;
+	const unsigned int nodeset_count = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START);
+	GLfloat *position_buffer = 0, *axis1_buffer = 0, *axis2_buffer = 0,
+		*axis3_buffer = 0, *scale_buffer = 0;
+	int *names_buffer = 0;
+	std::string *label_buffer = 0;
+	unsigned int position_values_per_vertex = 0, axis1_values_per_vertex = 0,
+		axis2_values_per_vertex = 0, axis3_values_per_vertex = 0,
+		scale_values_per_vertex = 0, names_per_vertex = 0, label_per_vertex = 0,
+		vertex_count = 0;
+	array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		&position_buffer, &position_values_per_vertex, &vertex_count);
+	array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS1,
+		&axis1_buffer, &axis1_values_per_vertex, &vertex_count);
+	array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS2,
+		&axis2_buffer, &axis2_values_per_vertex, &vertex_count);
+	array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS3,
+		&axis3_buffer, &axis3_values_per_vertex, &vertex_count);
+	array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_SCALE,
+		&scale_buffer, &scale_values_per_vertex, &vertex_count);
+	array->get_integer_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_VERTEX_ID,
+		&names_buffer, &names_per_vertex, &vertex_count);
+	array->get_string_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL,
+		&label_buffer, &label_per_vertex, &vertex_count);
+	GT_object *glyph = glyph_set->glyph;
+	// as for rendering: nothing is drawn without a glyph or labels
+	if (!(position_buffer && axis1_buffer && axis2_buffer && axis3_buffer && scale_buffer) ||
+		((!glyph) && (!label_buffer)))
+		return;
+	const cmzn_glyph_repeat_mode glyph_repeat_mode = glyph_set->glyph_repeat_mode;
+	// primitives of all objects in the glyph list in glyph coordinates, as
+	// drawn at each point; point glyphs and labels are points
+	Graphics_object_bvh glyphGeometry;
+	int number_of_glyphs = 1;
+	if (glyph && (CMZN_GLYPH_SHAPE_TYPE_POINT != GT_object_get_glyph_type(glyph)))
+	{
+		for (GT_object *glyph_item = glyph; glyph_item; glyph_item = glyph_item->nextobject)
+			glyphGeometry.addObjectPrimitives(glyph_item, /*timeIndex*/0);
+		number_of_glyphs = cmzn_glyph_repeat_mode_get_number_of_glyphs(glyph_repeat_mode);
+	}
+	const bool pointGlyph = glyphGeometry.primitives.empty();
+	const unsigned int numberOfNames = (pickingNames) ? ((names_buffer) ? 2 : 1) : 0;
+	Triple temp_point, temp_axis1, temp_axis2, temp_axis3;
+	float transformedVertices[3][3];
+	const float *vertexCoordinates[3];
+	for (int v = 0; v < 3; ++v)
+		vertexCoordinates[v] = transformedVertices[v];
+	for (unsigned int nodeset_index = 0; nodeset_index < nodeset_count; ++nodeset_index)
+	{
+		unsigned int index_start = 0, index_count = 0;
+		array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+			nodeset_index, 1, &index_start);
+		array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+			nodeset_index, 1, &index_count);
+		int object_name = 0;
+		array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+			nodeset_index, 1, &object_name);
+		for (unsigned int i = index_start; i < index_start + index_count; ++i)
+		{
+			const int vertex_name = (names_buffer) ? names_buffer[i*names_per_vertex] : 0;
+			for (int glyph_number = 0; glyph_number < number_of_glyphs; ++glyph_number)
+			{
+				resolve_glyph_axes(glyph_repeat_mode, glyph_number,
+					glyph_set->base_size, glyph_set->scale_factors, glyph_set->offset,
+					position_buffer + i*position_values_per_vertex,
+					axis1_buffer + i*axis1_values_per_vertex,
+					axis2_buffer + i*axis2_values_per_vertex,
+					axis3_buffer + i*axis3_values_per_vertex,
+					scale_buffer + i*scale_values_per_vertex,
+					temp_point, temp_axis1, temp_axis2, temp_axis3);
+				if (pointGlyph)
+				{
+					for (int k = 0; k < 3; ++k)
+						transformedVertices[0][k] = temp_point[k];
+					this->addPrimitive(1, vertexCoordinates, 3, numberOfNames, object_name, vertex_name);
+					continue;
+				}
+				for (std::vector<Primitive>::const_iterator primitive = glyphGeometry.primitives.begin();
+					primitive != glyphGeometry.primitives.end(); ++primitive)
+				{
+					const float *glyphVertex = &(glyphGeometry.vertices[primitive->vertexStart*3]);
+					for (unsigned int v = 0; v < primitive->numberOfVertices; ++v)
+					{
+						for (int k = 0; k < 3; ++k)
+							transformedVertices[v][k] = temp_point[k] + glyphVertex[0]*temp_axis1[k] +
+								glyphVertex[1]*temp_axis2[k] + glyphVertex[2]*temp_axis3[k];
+						glyphVertex += 3;
+					}
+					this->addPrimitive(primitive->numberOfVertices, vertexCoordinates, 3,
+						numberOfNames, object_name, vertex_name);
+				}
+			}
+		}
+	}
+}
+
+void Graphics_object_bvh::addPolylines(GT_object *graphics_object, int timeIndex, bool pickingNames)
+{
+	GT_polyline_vertex_buffers *line = graphics_object->primitive_lists[timeIndex].gt_polyline_vertex_buffers;
+	if (!line)
+		return;
+	bool strip = true;
+	switch (line->polyline_type)
+	{
+	case g_PLAIN:
+	case g_NORMAL:
+		strip = true;
+		break;
+	case g_PLAIN_DISCONTINUOUS:
+	case g_NORMAL_DISCONTINUOUS:
+		strip = false;
+		break;
+	default:
+		return;
+	}
+	Graphics_vertex_array *array = graphics_object->vertex_array;
+	GLfloat *position_buffer = 0;
+	unsigned int position_values_per_vertex = 0, position_vertex_count = 0;
+	if (!array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		&position_buffer, &position_values_per_vertex, &position_vertex_count))
+		return;
+	const unsigned int line_count = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START);
+	const unsigned int numberOfNames = (pickingNames) ? 1 : 0;
+	const float *vertexCoordinates[2];
+	for (unsigned int line_index = 0; line_index < line_count; ++line_index)
+	{
+		int object_name = 0;
+		array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+			line_index, 1, &object_name);
+		if (object_name < 0)
+			continue;
+		unsigned int index_start = 0, index_count = 0;
+		array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+			line_index, 1, &index_start);
+		array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+			line_index, 1, &index_count);
+		const unsigned int step = (strip) ? 1 : 2;
+		for (unsigned int i = 0; i + 1 < index_count; i += step)
+		{
+			vertexCoordinates[0] = position_buffer + (index_start + i)*position_values_per_vertex;
+			vertexCoordinates[1] = vertexCoordinates[0] + position_values_per_vertex;
+			this->addPrimitive(2, vertexCoordinates, position_values_per_vertex, numberOfNames, object_name, 0);
+		}
+	}
+}
+
+void Graphics_object_bvh::addSurfaces(GT_object *graphics_object, int timeIndex, bool pickingNames)
+{
+	GT_surface_vertex_buffers *surface = graphics_object->primitive_lists[timeIndex].gt_surface_vertex_buffers;
+	if (!surface)
+		return;
+	bool strip = true;
+	switch (surface->surface_type)
+	{
+	case g_SHADED:
+	case g_SHADED_TEXMAP:
+		strip = true;
+		break;
+	case g_SH_DISCONTINUOUS:
+	case g_SH_DISCONTINUOUS_STRIP:
+	case g_SH_DISCONTINUOUS_TEXMAP:
+	case g_SH_DISCONTINUOUS_STRIP_TEXMAP:
+		strip = false;
+		break;
+	default:
+		return;
+	}
+	Graphics_vertex_array *array = graphics_object->vertex_array;
+	GLfloat *position_buffer = 0;
+	unsigned int position_values_per_vertex = 0, position_vertex_count = 0;
+	if (!array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		&position_buffer, &position_values_per_vertex, &position_vertex_count))
+		return;
+	unsigned int *index_buffer = 0, index_values_per_vertex = 0, index_count = 0;
+	array->get_unsigned_integer_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_ARRAY,
+		&index_buffer, &index_values_per_vertex, &index_count);
+	if (strip && !index_buffer)
+		return;
+	const unsigned int surface_count = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START);
+	const unsigned int numberOfNames = (pickingNames) ? 1 : 0;
+	// wireframe surfaces are drawn and picked only on triangle edges
+	const bool wireframe = (CMZN_GRAPHICS_RENDER_POLYGON_MODE_WIREFRAME == surface->render_polygon_mode);
+	const float *vertexCoordinates[3];
+	for (unsigned int surface_index = 0; surface_index < surface_count; ++surface_index)
+	{
+		int object_name = 0;
+		array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+			surface_index, 1, &object_name);
+		if (object_name < 0)
+			continue;
+		if (strip)
+		{
+			unsigned int number_of_strips = 0, strip_start = 0;
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+				surface_index, 1, &number_of_strips);
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+				surface_index, 1, &strip_start);
+			for (unsigned int s = 0; s < number_of_strips; ++s)
+			{
+				unsigned int points_per_strip = 0, index_start_for_strip = 0;
+				array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+					strip_start + s, 1, &index_start_for_strip);
+				array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+					strip_start + s, 1, &points_per_strip);
+				const unsigned int *indices = index_buffer + index_start_for_strip;
+				for (unsigned int i = 0; i + 2 < points_per_strip; ++i)
+				{
+					for (int v = 0; v < 3; ++v)
+						vertexCoordinates[v] = position_buffer + indices[i + v]*position_values_per_vertex;
+					this->addTriangle(vertexCoordinates, position_values_per_vertex, wireframe, numberOfNames, object_name);
+				}
+			}
+		}
+		else
+		{
+			unsigned int index_start = 0, vertex_count = 0;
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+				surface_index, 1, &index_start);
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+				surface_index, 1, &vertex_count);
+			for (unsigned int i = 0; i + 2 < vertex_count; i += 3)
+			{
+				for (int v = 0; v < 3; ++v)
+					vertexCoordinates[v] = position_buffer + (index_start + i + v)*position_values_per_vertex;
+				this->addTriangle(vertexCoordinates, position_values_per_vertex, wireframe, numberOfNames, object_name);
+			}
+		}
+	}
+}
+
+void Graphics_object_bvh::addPointSet(GT_object *graphics_object)
+{
+	GLfloat *position_buffer = 0;
+	unsigned int position_values_per_vertex = 0, position_vertex_count = 0;
+	if (!graphics_object->vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		&position_buffer, &position_values_per_vertex, &position_vertex_count))
+		return;
+	// point sets put out no names for picking
+	const float *vertexCoordinates[1];
+	for (unsigned int i = 0; i < position_vertex_count; ++i)
+	{
+		vertexCoordinates[0] = position_buffer + i*position_values_per_vertex;
+		this->addPrimitive(1, vertexCoordinates, position_values_per_vertex, 0, 0, 0);
+	}
+}
+
+void Graphics_object_bvh::addObjectPrimitives(GT_object *graphics_object, int timeIndex)
+{
+	if (!((graphics_object->vertex_array) && (graphics_object->primitive_lists) &&
+		(0 < graphics_object->number_of_times)))
+		return;
+	const bool pickingNames = (CMZN_GRAPHICS_SELECT_MODE_OFF != graphics_object->select_mode);
+	switch (graphics_object->object_type)
+	{
+	case g_GLYPH_SET_VERTEX_BUFFERS:
+		this->addGlyphSet(graphics_object, pickingNames);
+		break;
+	case g_POLYLINE_VERTEX_BUFFERS:
+		this->addPolylines(graphics_object, timeIndex, pickingNames);
+		break;
+	case g_SURFACE_VERTEX_BUFFERS:
+		this->addSurfaces(graphics_object, timeIndex, pickingNames);
+		break;
+	case g_POINT_SET_VERTEX_BUFFERS:
+		this->addPointSet(graphics_object);
+		break;
+	default:
+		break;
+	}
+}
+
+unsigned int Graphics_object_bvh::buildNode(unsigned int start, unsigned int count)
+{
+	const unsigned int nodeIndex = static_cast<unsigned int>(this->nodes.size());
+	this->nodes.push_back(Node());
+	Node node;
+	node.start = start;
+	node.count = count;
+	node.secondChild = 0;
+	float centreMinimum[3], centreMaximum[3];
+	for (unsigned int p = start; p < start + count; ++p)
+	{
+		const Primitive& primitive = this->primitives[p];
+		for (int i = 0; i < 3; ++i)
+		{
+			const float centre = primitive.minimum[i] + primitive.maximum[i];
+			if ((p == start) || (primitive.minimum[i] < node.minimum[i]))
+				node.minimum[i] = primitive.minimum[i];
+			if ((p == start) || (primitive.maximum[i] > node.maximum[i]))
+				node.maximum[i] = primitive.maximum[i];
+			if ((p == start) || (centre < centreMinimum[i]))
+				centreMinimum[i] = centre;
+			if ((p == start) || (centre > centreMaximum[i]))
+				centreMaximum[i] = centre;
+		}
+	}
+	if (count > leafSize)
+	{
+		// split at median centre along axis of greatest spread of centres
+		int axis = 0;
+		for (int i = 1; i < 3; ++i)
+			if ((centreMaximum[i] - centreMinimum[i]) > (centreMaximum[axis] - centreMinimum[axis]))
+				axis = i;
+		const unsigned int firstCount = count / 2;
+		std::nth_element(this->primitives.begin() + start, this->primitives.begin() + start + firstCount,
+			this->primitives.begin() + start + count, Primitive_centre_less<Primitive>(axis));
+		this->buildNode(start, firstCount);
+		node.secondChild = this->buildNode(start + firstCount, count - firstCount);
+		node.count = 0;
+	}
+	this->nodes[nodeIndex] = node;
+	return nodeIndex;
+}
+
+Graphics_object_bvh *Graphics_object_bvh::create(GT_object *graphics_object, int timeIndex)
+{
+	if (!((graphics_object) && (graphics_object->vertex_array) &&
+		(0 <= timeIndex) && ((0 == timeIndex) || (timeIndex < graphics_object->number_of_times))))
+	{
+		display_message(ERROR_MESSAGE, "Graphics_object_bvh::create.  Invalid argument(s)");
+		return 0;
+	}
+	Graphics_object_bvh *bvh = new Graphics_object_bvh();
+	bvh->addObjectPrimitives(graphics_object, timeIndex);
+	if (0 < bvh->primitives.size())
+	{
+		bvh->nodes.reserve(2*(bvh->primitives.size() / leafSize) + 1);
+		bvh->buildNode(0, static_cast<unsigned int>(bvh->primitives.size()));
+	}
+	return bvh;
+}
+
+bool Graphics_object_bvh::findPrimitiveDepthRange(const Primitive& primitive,
+	const double *transformation, double& nearest, double& furthest) const
+{
+	const float *vertex = &(this->vertices[primitive.vertexStart*3]);
+	double point[3];
+	// clip point, line or triangle against each plane of the picking volume
+	// in homogeneous coordinates; lines are treated as 2-sided polygons
+	const int maximumClipVertices = 16;
+	double clip[2][maximumClipVertices][4];
+	int clipCount = primitive.numberOfVertices;
+	for (int v = 0; v < clipCount; ++v)
+	{
+		point[0] = vertex[v*3];
+		point[1] = vertex[v*3 + 1];
+		point[2] = vertex[v*3 + 2];
+		transform_homogeneous(transformation, point, clip[0][v]);
+	}
+	int source = 0;
+	for (int plane = 0; (plane < 6) && (0 < clipCount); ++plane)
+	{
+		const int target = 1 - source;
+		int targetCount = 0;
+		for (int v = 0; v < clipCount; ++v)
+		{
+			const double *start = clip[source][(v + clipCount - 1) % clipCount];
+			const double *end = clip[source][v];
+			const double startDistance = volume_plane_distance(start, plane);
+			const double endDistance = volume_plane_distance(end, plane);
+			if ((startDistance >= 0.0) != (endDistance >= 0.0))
+			{
+				const double t = startDistance / (startDistance - endDistance);
+				for (int i = 0; i < 4; ++i)
+					clip[target][targetCount][i] = start[i] + t*(end[i] - start[i]);
+				++targetCount;
+			}
+			if (endDistance >= 0.0)
+			{
+				for (int i = 0; i < 4; ++i)
+					clip[target][targetCount][i] = end[i];
+				++targetCount;
+			}
+		}
+		clipCount = targetCount;
+		source = target;
+	}
+	bool found = false;
+	for (int v = 0; v < clipCount; ++v)
+	{
+		const double w = clip[source][v][3];
+		if (w > 0.0)
+		{
+			const double z = clip[source][v][2] / w;
+			if ((!found) || (z < nearest))
+				nearest = z;
+			if ((!found) || (z > furthest))
+				furthest = z;
+			found = true;
+		}
+	}
+	return found;
+}
+
+void Graphics_object_bvh::findHits(const double *transformation, std::vector<Hit>& hits) const
+{
+	if (0 == this->nodes.size())
+		return;
+	const size_t firstHit = hits.size();
+	std::vector<unsigned int> stack;
+	stack.push_back(0);
+	Hit hit;
+	while (!stack.empty())
+	{
+		const unsigned int nodeIndex = stack.back();
+		stack.pop_back();
+		const Node& node = this->nodes[nodeIndex];
+		if (box_outside_volume(node.minimum, node.maximum, transformation))
+			continue;
+		if (0 == node.count)
+		{
+			stack.push_back(node.secondChild);
+			stack.push_back(nodeIndex + 1);
+			continue;
+		}
+		for (unsigned int p = node.start; p < node.start + node.count; ++p)
+		{
+			const Primitive& primitive = this->primitives[p];
+			if (this->findPrimitiveDepthRange(primitive, transformation, hit.nearest, hit.furthest))
+			{
+				hit.numberOfNames = primitive.numberOfNames;
+				hit.objectName = (0 < primitive.numberOfNames) ? primitive.objectName : 0;
+				hit.vertexName = (1 < primitive.numberOfNames) ? primitive.vertexName : 0;
+				hits.push_back(hit);
+			}
+		}
+	}
+	// merge hits with the same names as the select buffer does
+	std::sort(hits.begin() + firstHit, hits.end(), Hit_names_less);
+	size_t lastHit = firstHit;
+	for (size_t h = firstHit + 1; h < hits.size(); ++h)
+	{
+		Hit& last = hits[lastHit];
+		const Hit& current = hits[h];
+		if ((current.numberOfNames == last.numberOfNames) &&
+			(current.objectName == last.objectName) && (current.vertexName == last.vertexName))
+		{
+			if (current.nearest < last.nearest)
+				last.nearest = current.nearest;
+			if (current.furthest > last.furthest)
+				last.furthest = current.furthest;
+		}
+		else
+		{
+			++lastHit;
+			hits[lastHit] = current;
+		}
+	}
+	if (firstHit < hits.size())
+		hits.resize(lastHit + 1);
+}
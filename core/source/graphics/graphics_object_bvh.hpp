@@ -0,0 +1,127 @@
+/**
+ * FILE : graphics_object_bvh.hpp
+ *
+ * Bounding volume hierarchy over the primitives in the vertex array of a
+ * graphics object, for picking without rendering to the OpenGL select buffer.
+ */
+/* OpenCMISS-Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (GRAPHICS_OBJECT_BVH_HPP)
+#define GRAPHICS_OBJECT_BVH_HPP
+
+#include <vector>
+
+struct GT_object;
+
+/**
+ * Axis-aligned bounding box tree over the points, line segments and
+ * triangles of one graphics object, in its local coordinates, including the
+ * geometry of glyphs placed at each glyph point and only the triangle edges
+ * of wireframe surfaces, as they are drawn in OpenGL picking. Each
+ * primitive records the picking names the OpenGL renderer puts out for it
+ * below the scene and graphics names, so hits can be reported in the same
+ * form as the select buffer. Primitive coordinates are copied so the tree
+ * stays valid until the graphics object changes, when it must be rebuilt.
+ */
+class Graphics_object_bvh
+{
+public:
+	/** Primitive found in a picking volume. */
+	struct Hit
+	{
+		/* number of names after scene and graphics: 0, 1 or 2 */
+		int numberOfNames;
+		int objectName;
+		int vertexName;
+		/* range of normalised depth from -1 at near to +1 at far plane */
+		double nearest, furthest;
+	};
+
+private:
+	struct Primitive
+	{
+		float minimum[3], maximum[3];
+		unsigned int vertexStart; // index of first vertex in vertices
+		unsigned char numberOfVertices; // 1 = point, 2 = line, 3 = triangle
+		unsigned char numberOfNames;
+		int objectName;
+		int vertexName;
+	};
+
+	struct Node
+	{
+		float minimum[3], maximum[3];
+		unsigned int start, count; // range of primitives if leaf
+		unsigned int secondChild; // index of second child if not leaf; first child follows node
+	};
+
+	/** maximum number of primitives in a leaf node */
+	static const unsigned int leafSize = 4;
+
+	std::vector<float> vertices; // 3 coordinates per vertex
+	std::vector<Primitive> primitives;
+	std::vector<Node> nodes;
+
+	Graphics_object_bvh()
+	{
+	}
+
+	Graphics_object_bvh(const Graphics_object_bvh&); // not implemented
+	Graphics_object_bvh& operator=(const Graphics_object_bvh&); // not implemented
+
+	void addPrimitive(unsigned int numberOfVertices, const float *const *vertexCoordinates,
+		unsigned int valuesPerVertex, unsigned int numberOfNames, int objectName, int vertexName);
+
+	/** Add filled triangle, or its 3 edges if wireframe. */
+	void addTriangle(const float *const *vertexCoordinates, unsigned int valuesPerVertex,
+		bool wireframe, unsigned int numberOfNames, int objectName);
+
+	void addGlyphSet(GT_object *graphics_object, bool pickingNames);
+
+	void addPolylines(GT_object *graphics_object, int timeIndex, bool pickingNames);
+
+	void addSurfaces(GT_object *graphics_object, int timeIndex, bool pickingNames);
+
+	void addPointSet(GT_object *graphics_object);
+
+	/** Add primitives of graphics object for its type, with no tree built. */
+	void addObjectPrimitives(GT_object *graphics_object, int timeIndex);
+
+	unsigned int buildNode(unsigned int start, unsigned int count);
+
+	bool findPrimitiveDepthRange(const Primitive& primitive,
+		const double *transformation, double& nearest, double& furthest) const;
+
+public:
+
+	/**
+	 * Build tree for all primitives in the first graphics object of the list,
+	 * in the form they are drawn by the glbegin/glend OpenGL renderer.
+	 * @param timeIndex  Index of the primitive list for the time being picked.
+	 * Point and glyph sets are always drawn from the first, as in the renderer.
+	 * @return  New tree, to be deleted by caller, or 0 if failed.
+	 */
+	static Graphics_object_bvh *create(GT_object *graphics_object, int timeIndex);
+
+	size_t getNumberOfPrimitives() const
+	{
+		return this->primitives.size();
+	}
+
+	/**
+	 * Find primitives intersecting the picking volume, which is
+	 * -w <= x, y, z <= w in homogeneous normalised coordinates. Hits for
+	 * primitives with the same names are merged as in the select buffer.
+	 * @param transformation  4x4 matrix premultiplying local coordinates
+	 * {x y z 1} to give homogeneous normalised coordinates, across rows fastest.
+	 * @param hits  Vector to which hits are appended.
+	 */
+	void findHits(const double *transformation, std::vector<Hit>& hits) const;
+
+};
+
+#endif /* !defined (GRAPHICS_OBJECT_BVH_HPP) */
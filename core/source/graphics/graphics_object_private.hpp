@@ -60,6 +60,8 @@ Global types
 ------------
 */
 
+class Graphics_object_bvh;
+
 /***************************************************************************//**
  * Provides the scene information for the lines stored in the
  * vertex_array. */
@@ -175,6 +177,10 @@ Graphical object data structure.
 #endif /* defined (OPENGL_API) */
 	/* enumeration indicates whether the graphics display list is up to date */
 	enum Graphics_compile_status compile_status;
+	/* tree of primitives for picking, built on demand and cleared when changed */
+	Graphics_object_bvh *picking_bvh;
+	/* index of primitive list picking_bvh was built from */
+	int picking_bvh_time_index;
 
 	/* Custom per compile code for graphics_objects used as glyphs. */
 	Graphics_object_glyph_labels_function glyph_labels_function;
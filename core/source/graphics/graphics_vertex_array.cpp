@@ -14,7 +14,6 @@
 #include "general/debug.h"
 #include "graphics/auxiliary_graphics_types.h"
 #include "graphics/graphics_vertex_array.hpp"
-#include "general/indexed_list_private.h"
 #include "general/message.h"
 #include "general/mystring.h"
 
@@ -35,8 +34,6 @@ struct Graphics_vertex_buffer
 	unsigned int max_vertex_count;
 	/** Vertex buffer memory */
 	void *memory;
-	/** Cmgui reference count. */
-	int access_count;
 };
 
 struct Graphics_vertex_string_buffer
@@ -48,26 +45,11 @@ struct Graphics_vertex_string_buffer
 	unsigned int values_per_vertex;
 };
 
-DECLARE_LIST_TYPES(Graphics_vertex_buffer);
-
 /*
 Module functions
 ----------------
 */
 
-PROTOTYPE_DEFAULT_DESTROY_OBJECT_FUNCTION(Graphics_vertex_buffer);
-PROTOTYPE_OBJECT_FUNCTIONS(Graphics_vertex_buffer);
-PROTOTYPE_LIST_FUNCTIONS(Graphics_vertex_buffer);
-PROTOTYPE_FIND_BY_IDENTIFIER_IN_LIST_FUNCTION(Graphics_vertex_buffer,type,
-	Graphics_vertex_array_attribute_type);
-FULL_DECLARE_INDEXED_LIST_TYPE(Graphics_vertex_buffer);
-DECLARE_OBJECT_FUNCTIONS(Graphics_vertex_buffer)
-DECLARE_INDEXED_LIST_MODULE_FUNCTIONS(Graphics_vertex_buffer,type,
-	Graphics_vertex_array_attribute_type,compare_int)
-DECLARE_INDEXED_LIST_FUNCTIONS(Graphics_vertex_buffer)
-DECLARE_FIND_BY_IDENTIFIER_IN_INDEXED_LIST_FUNCTION(Graphics_vertex_buffer,
-	type,Graphics_vertex_array_attribute_type,compare_int)
-
 
 /*****************************************************************************//**
  * Creates a new Graphics_vertex_buffer.  Initially no memory is allocated
@@ -88,7 +70,6 @@ struct Graphics_vertex_buffer *CREATE(Graphics_vertex_buffer)(
 		buffer->max_vertex_count = 0;
 		buffer->vertex_count = 0;
 		buffer->memory = NULL;
-		buffer->access_count = 0;
 	}
 	else
 	{
@@ -135,7 +116,8 @@ class Graphics_vertex_array_internal
 {
 public:
 	Graphics_vertex_array_type type;
-	LIST(Graphics_vertex_buffer) *buffer_list;
+	/* buffers indexed directly by attribute type, NULL if not created */
+	Graphics_vertex_buffer *buffers[GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT];
 	String_buffer_map string_buffer_list;
 	/* fast search map for locating id for quick modification,
 	 * this is implemented as multimap for graphics type that have varying number of primitives */
@@ -144,13 +126,18 @@ public:
 	Graphics_vertex_array_internal(Graphics_vertex_array_type type)
 		: type(type)
 	{
-		buffer_list = CREATE(LIST(Graphics_vertex_buffer))();
+		for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+			buffers[i] = 0;
 	}
 
 	~Graphics_vertex_array_internal()
 	{
 		clear_string_buffer();
-		DESTROY(LIST(Graphics_vertex_buffer))(&buffer_list);
+		for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+		{
+			if (buffers[i])
+				DESTROY(Graphics_vertex_buffer)(&(buffers[i]));
+		}
 	}
 
 	void clear_string_buffer()
@@ -200,6 +187,9 @@ public:
 
 	template <class value_type> int free_unused_buffer_memory( Graphics_vertex_array_attribute_type vertex_type, const value_type* dummy );
 
+	template <class value_type> int reserve_buffer_memory(Graphics_vertex_buffer *buffer,
+		unsigned int required_vertex_count, bool exact);
+
 	template <class value_type> int add_attribute(
 		Graphics_vertex_array_attribute_type vertex_type,
 		const unsigned int values_per_vertex, const unsigned int number_of_values, const value_type *values);
@@ -403,8 +393,9 @@ Graphics_vertex_buffer *Graphics_vertex_array_internal::get_or_create_vertex_buf
 			vertex_buffer_type = vertex_type;
 		} break;
 	}
-	buffer = FIND_BY_IDENTIFIER_IN_LIST(Graphics_vertex_buffer,type)
-		 (vertex_buffer_type, buffer_list);
+	if ((vertex_buffer_type < 0) || (vertex_buffer_type >= GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT))
+		return 0;
+	buffer = buffers[vertex_buffer_type];
 	if (buffer)
 	{
 		if (buffer->values_per_vertex != values_per_vertex)
@@ -416,14 +407,7 @@ Graphics_vertex_buffer *Graphics_vertex_array_internal::get_or_create_vertex_buf
 	{
 		buffer = CREATE(Graphics_vertex_buffer)(vertex_buffer_type,
 			values_per_vertex);
-		if (buffer)
-		{
-			if (!ADD_OBJECT_TO_LIST(Graphics_vertex_buffer)(buffer,
-				buffer_list))
-			{
-				DESTROY(Graphics_vertex_buffer)(&buffer);
-			}
-		}
+		buffers[vertex_buffer_type] = buffer;
 	}
 	return (buffer);
 }
@@ -441,12 +425,41 @@ Graphics_vertex_buffer *Graphics_vertex_array_internal::get_vertex_buffer_for_at
 			vertex_buffer_type = vertex_type;
 		} break;
 	}
-	buffer = FIND_BY_IDENTIFIER_IN_LIST(Graphics_vertex_buffer,type)
-		(vertex_buffer_type, buffer_list);
+	if ((vertex_buffer_type >= 0) && (vertex_buffer_type < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT))
+		buffer = buffers[vertex_buffer_type];
 
 	return (buffer);
 }
 
+/**
+ * Ensure buffer has memory for at least required_vertex_count vertices.
+ * @param exact  If true allocate exactly the required count, otherwise grow
+ * geometrically with headroom to amortise the cost of repeated additions.
+ */
+template <class value_type> int Graphics_vertex_array_internal::reserve_buffer_memory(
+	Graphics_vertex_buffer *buffer, unsigned int required_vertex_count, bool exact)
+{
+	if ((buffer->memory) && (required_vertex_count <= buffer->max_vertex_count))
+		return 1;
+	unsigned int new_max_vertex_count = required_vertex_count;
+	if (!exact)
+	{
+		const unsigned int grown_vertex_count = (buffer->memory) ?
+			2*buffer->max_vertex_count : GRAPHICS_VERTEX_BUFFER_INITIAL_SIZE;
+		if (new_max_vertex_count < grown_vertex_count)
+			new_max_vertex_count = grown_vertex_count;
+	}
+	value_type *new_memory;
+	if (REALLOCATE(new_memory, buffer->memory, value_type,
+		static_cast<size_t>(new_max_vertex_count)*buffer->values_per_vertex))
+	{
+		buffer->memory = new_memory;
+		buffer->max_vertex_count = new_max_vertex_count;
+		return 1;
+	}
+	return 0;
+}
+
 template <class value_type> int Graphics_vertex_array_internal::add_attribute(
 	Graphics_vertex_array_attribute_type vertex_type,
 	const unsigned int values_per_vertex, const unsigned int number_of_values, const value_type *values)
@@ -458,35 +471,8 @@ template <class value_type> int Graphics_vertex_array_internal::add_attribute(
 	if (buffer)
 	{
 		Graphics_vertex_array_attribute_type vertex_buffer_type = buffer->type;
-		if (!buffer->memory)
-		{
-		// Allocate enough memory for what I am about to add plus some headroom
-			if (ALLOCATE(buffer->memory, value_type,
-				( GRAPHICS_VERTEX_BUFFER_INITIAL_SIZE + number_of_values ) * values_per_vertex))
-			{
-				buffer->max_vertex_count = GRAPHICS_VERTEX_BUFFER_INITIAL_SIZE;
-			}
-			else
-			{
-				return_code = 0;
-			}
-		}
-		if (return_code)
-		{
-			if (buffer->max_vertex_count <= ( buffer->vertex_count + number_of_values ) )
-			{
-				// Reallocate enough memory for what I am about to add plus some headroom
-				if (REALLOCATE(buffer->memory, buffer->memory, value_type,
-					( 2 * buffer->max_vertex_count + number_of_values ) * values_per_vertex))
-				{
-					buffer->max_vertex_count = 2 * buffer->max_vertex_count + number_of_values;
-				}
-				else
-				{
-					return_code = 0;
-				}
-			}
-		}
+		return_code = reserve_buffer_memory<value_type>(buffer,
+			buffer->vertex_count + number_of_values, /*exact*/false);
 		if (return_code)
 		{
 			if (vertex_buffer_type == vertex_type)
@@ -611,11 +597,26 @@ template <class value_type> int Graphics_vertex_array_internal::free_unused_buff
 	Graphics_vertex_buffer *buffer = get_vertex_buffer_for_attribute(vertex_type);
 	if (buffer)
 	{
-		if (REALLOCATE(buffer->memory, buffer->memory, value_type,
-				(buffer->vertex_count  * buffer->values_per_vertex)))
+		if (buffer->max_vertex_count == buffer->vertex_count)
 		{
 			return_code = 1;
-			buffer->max_vertex_count = buffer->vertex_count;
+		}
+		else if (0 == buffer->vertex_count)
+		{
+			DEALLOCATE(buffer->memory);
+			buffer->max_vertex_count = 0;
+			return_code = 1;
+		}
+		else
+		{
+			value_type *new_memory;
+			if (REALLOCATE(new_memory, buffer->memory, value_type,
+				static_cast<size_t>(buffer->vertex_count)*buffer->values_per_vertex))
+			{
+				buffer->memory = new_memory;
+				buffer->max_vertex_count = buffer->vertex_count;
+				return_code = 1;
+			}
 		}
 	}
 
@@ -625,8 +626,8 @@ template <class value_type> int Graphics_vertex_array_internal::free_unused_buff
 int Graphics_vertex_array::free_unused_buffer_memory(
 	Graphics_vertex_array_attribute_type vertex_type )
 {
-	USE_PARAMETER(vertex_type);
-	return 0;//internal->free_unused_buffer_memory( vertex_type );
+	/* all numeric buffer value types are 32-bit */
+	return internal->free_unused_buffer_memory(vertex_type, static_cast<const GLfloat *>(0));
 }
 /*
 int Graphics_vertex_array::add_float_attribute(
@@ -920,17 +921,105 @@ int Graphics_vertex_array::get_all_fast_search_id_locations(int target_id,
 	return internal->get_all_fast_search_id_locations(target_id, number_of_locations, locations);
 }
 
+size_t Graphics_vertex_array::get_memory_size()
+{
+	size_t memory_size = 0;
+	for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+	{
+		Graphics_vertex_buffer *buffer = internal->buffers[i];
+		/* all numeric buffer value types are 32-bit */
+		if (buffer)
+			memory_size += static_cast<size_t>(buffer->max_vertex_count)*
+				buffer->values_per_vertex*sizeof(GLfloat);
+	}
+	for (String_buffer_map::iterator pos = internal->string_buffer_list.begin();
+		pos != internal->string_buffer_list.end(); ++pos)
+	{
+		std::vector<std::string> &strings = pos->second->strings_vectors;
+		memory_size += strings.capacity()*sizeof(std::string);
+		for (std::vector<std::string>::iterator iter = strings.begin(); iter != strings.end(); ++iter)
+			memory_size += iter->capacity();
+	}
+	return memory_size;
+}
+
+int Graphics_vertex_array::reserve_attribute(
+	Graphics_vertex_array_attribute_type vertex_type,
+	const unsigned int values_per_vertex, const unsigned int number_of_values)
+{
+	Graphics_vertex_buffer *buffer = internal->get_or_create_vertex_buffer(vertex_type, values_per_vertex);
+	if (!buffer)
+	{
+		display_message(ERROR_MESSAGE, "Graphics_vertex_array::reserve_attribute.  "
+			"Unable to create buffer.");
+		return 0;
+	}
+	/* all numeric buffer value types are 32-bit */
+	return internal->reserve_buffer_memory<GLfloat>(buffer,
+		buffer->vertex_count + number_of_values, /*exact*/true);
+}
+
+int Graphics_vertex_array::get_interleaved_float_vertex_buffer(
+	int number_of_attributes, const Graphics_vertex_array_attribute_type *vertex_types,
+	GLfloat **interleaved_buffer, unsigned int *values_per_vertex,
+	unsigned int *vertex_count)
+{
+	if (!((0 < number_of_attributes) && vertex_types && interleaved_buffer &&
+		values_per_vertex && vertex_count))
+		return 0;
+	*interleaved_buffer = 0;
+	*values_per_vertex = 0;
+	*vertex_count = 0;
+	std::vector<Graphics_vertex_buffer *> attribute_buffers(number_of_attributes);
+	unsigned int total_values_per_vertex = 0;
+	for (int a = 0; a < number_of_attributes; ++a)
+	{
+		Graphics_vertex_buffer *buffer = internal->get_vertex_buffer_for_attribute(vertex_types[a]);
+		if ((!buffer) || ((0 < a) && (buffer->vertex_count != attribute_buffers[0]->vertex_count)))
+			return 0;
+		attribute_buffers[a] = buffer;
+		total_values_per_vertex += buffer->values_per_vertex;
+	}
+	const unsigned int number_of_vertices = attribute_buffers[0]->vertex_count;
+	GLfloat *buffer_out = 0;
+	if ((0 < number_of_vertices) && !ALLOCATE(buffer_out, GLfloat,
+		static_cast<size_t>(number_of_vertices)*total_values_per_vertex))
+		return 0;
+	unsigned int offset = 0;
+	for (int a = 0; a < number_of_attributes; ++a)
+	{
+		const unsigned int attribute_values_per_vertex = attribute_buffers[a]->values_per_vertex;
+		const GLfloat *source = static_cast<const GLfloat *>(attribute_buffers[a]->memory);
+		GLfloat *target = buffer_out + offset;
+		for (unsigned int v = 0; v < number_of_vertices; ++v)
+		{
+			for (unsigned int i = 0; i < attribute_values_per_vertex; ++i)
+				target[i] = source[i];
+			source += attribute_values_per_vertex;
+			target += total_values_per_vertex;
+		}
+		offset += attribute_values_per_vertex;
+	}
+	*interleaved_buffer = buffer_out;
+	*values_per_vertex = total_values_per_vertex;
+	*vertex_count = number_of_vertices;
+	return 1;
+}
+
 int Graphics_vertex_array::clear_buffers()
 {
 	internal->clear_string_buffer();
-	return FOR_EACH_OBJECT_IN_LIST(Graphics_vertex_buffer)(
-		Graphics_vertex_buffer_clear, NULL, internal->buffer_list);
+	for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+	{
+		if (internal->buffers[i])
+			Graphics_vertex_buffer_clear(internal->buffers[i], 0);
+	}
+	return 1;
 }
 
 int Graphics_vertex_array::clear_specified_buffer(Graphics_vertex_array_attribute_type vertex_type)
 {
-	Graphics_vertex_buffer *buffer = FIND_BY_IDENTIFIER_IN_LIST(Graphics_vertex_buffer,type)
-		 (vertex_type, internal->buffer_list);
+	Graphics_vertex_buffer *buffer = internal->get_vertex_buffer_for_attribute(vertex_type);
 	if (buffer)
 		return Graphics_vertex_buffer_clear(buffer, 0);
 	return 1;
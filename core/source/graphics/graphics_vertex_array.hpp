@@ -92,7 +92,9 @@ enum Graphics_vertex_array_attribute_type
 	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
 	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL,
 	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_PARTIAL_REDRAW,
-	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_PARTIAL_REDRAW_COUNT
+	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_PARTIAL_REDRAW_COUNT,
+	/** Number of attribute types, for sizing tables indexed by type. Must be last. */
+	GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT
 	/* Complex types might be like this...
 	 * GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_VERTEX3_NORMAL3
 	 * and element_array indices might be supported with an DRAW_ELEMENTS set
@@ -290,10 +292,47 @@ public:
 		Graphics_vertex_array_attribute_type vertex_type);
 
 	/**
-	 * Free any unused memory at the end of a buffer
+	 * Get approximate number of bytes allocated for all buffers in the array,
+	 * including reserved but unused capacity.
+	 */
+	size_t get_memory_size();
+
+	/**
+	 * Free any unused memory at the end of a buffer, e.g. after filling a buffer
+	 * whose size was over-estimated with reserve_attribute.
+	 * @return return_code. 1 for Success, 0 for failure or if no buffer.
 	 */
 	int free_unused_buffer_memory( Graphics_vertex_array_attribute_type vertex_type );
 
+	/**
+	 * Reserve memory for number_of_values further vertices in the buffer for
+	 * vertex_type, creating it if needed, so subsequent additions do not
+	 * reallocate. Use when the final vertex count can be estimated up front.
+	 *
+	 * @param values_per_vertex  Must match that used for adding attributes.
+	 * @return return_code. 1 for Success, 0 for failure.
+	 */
+	int reserve_attribute(Graphics_vertex_array_attribute_type vertex_type,
+		const unsigned int values_per_vertex, const unsigned int number_of_values);
+
+	/**
+	 * Get a copy of several float attribute buffers interleaved per vertex, in
+	 * the order of vertex_types, e.g. for uploading as a single vertex buffer
+	 * object with strided access. All attributes must have the same number of
+	 * vertices.
+	 *
+	 * @param interleaved_buffer  On success returns newly allocated buffer of
+	 * vertex_count*values_per_vertex values, or NULL if no vertices. Caller must
+	 * DEALLOCATE.
+	 * @param values_per_vertex  Returns the total values per vertex i.e. stride.
+	 * @param vertex_count  Returns the number of vertices.
+	 * @return return_code. 1 for Success, 0 for failure.
+	 */
+	int get_interleaved_float_vertex_buffer(int number_of_attributes,
+		const Graphics_vertex_array_attribute_type *vertex_types,
+		GLfloat **interleaved_buffer, unsigned int *values_per_vertex,
+		unsigned int *vertex_count);
+
 	/*****************************************************************************//**
 	 * Resets the sizes of all the buffers in the set.  Does not actually
 	 * release memory in the buffers as it is assumed likely that the same buffers
@@ -12,6 +12,7 @@ GL rendering calls - API specific.
 #include <stdio.h>
 #include <math.h>
 #include <map>
+#include <vector>
 #include "opencmiss/zinc/zincconfigure.h"
 
 #include "general/mystring.h"
@@ -35,6 +36,7 @@ GL rendering calls - API specific.
 #include "graphics/scene_coordinate_system.hpp"
 #include "graphics/spectrum.hpp"
 #include "graphics/texture.hpp"
+#include "graphics/gltf_export.hpp"
 #include "graphics/threejs_export.hpp"
 #include "graphics/webgl_export.hpp"
 
@@ -578,16 +580,19 @@ public:
 	int *number_of_entries;
 	std::string **output_string;
 	int morphVertices, morphColours, morphNormals;
+	bool binary, quantise;
 
 
 	Render_graphics_opengl_threejs(const char *file_prefix_in,
 		int number_of_time_steps_in, double begin_time_in,  double end_time_in,
 		enum cmzn_streaminformation_scene_io_data_type mode_in, int *number_of_entries_in,
-		std::string **output_string_in, int morphVerticesIn, int morphColoursIn, int morphNormalsIn) :
+		std::string **output_string_in, int morphVerticesIn, int morphColoursIn, int morphNormalsIn,
+		bool binaryIn, bool quantiseIn) :
 		Render_graphics_opengl_vertex_buffer_object(),
 		file_prefix(duplicate_string(file_prefix_in)), begin_time(begin_time_in),
 		end_time(end_time_in), number_of_time_steps(number_of_time_steps_in),
-		mode(mode_in), number_of_entries(number_of_entries_in)
+		mode(mode_in), number_of_entries(number_of_entries_in),
+		binary(binaryIn), quantise(quantiseIn)
 	{
 		exports_map.clear();
 		current_graphics_number = 0;
@@ -710,8 +715,12 @@ public:
 					sprintf(new_file_prefix, "%s_%s_%s", file_prefix, region_name, graphics_name);
 				else
 					sprintf(new_file_prefix, "%s_%s", file_prefix, graphics_name);
-				threejs_export = new Threejs_export(new_file_prefix, number_of_time_steps, mode,
-					morphVertices, morphColours, morphNormals);
+				if (binary)
+					threejs_export = new Gltf_binary_export(new_file_prefix, number_of_time_steps, mode,
+						morphVertices, morphColours, morphNormals, quantise);
+				else
+					threejs_export = new Threejs_export(new_file_prefix, number_of_time_steps, mode,
+						morphVertices, morphColours, morphNormals);
 				threejs_export->beginExport();
 				DEALLOCATE(graphics_name);
 				if (region_name)
@@ -763,11 +772,11 @@ Render_graphics_opengl *Render_graphics_opengl_create_threejs_renderer(
 	const char *file_prefix, int number_of_time_steps, double begin_time,
 	double end_time, enum cmzn_streaminformation_scene_io_data_type mode,
 	int *number_of_entries, std::string **output_string,
-	int morphVertices, int morphColours, int morphNormals)
+	int morphVertices, int morphColours, int morphNormals, bool binary, bool quantise)
 {
 	return new Render_graphics_opengl_threejs(file_prefix, number_of_time_steps,
 		begin_time, end_time, mode, number_of_entries, output_string,
-		morphVertices, morphColours, morphNormals);
+		morphVertices, morphColours, morphNormals, binary, quantise);
 }
 
 /**
@@ -960,6 +969,60 @@ inline char *concatenateLabels(char *label1, char *label2, bool &allocatedText)
 	return text;
 }
 
+/**
+ * Sets the GL colour for vertex data values in immediate mode rendering.
+ * Colours for the whole data buffer are calculated up front with
+ * Spectrum_values_to_rgba rather than walking the spectrum components for
+ * each vertex. Spectrums with banded or step components need a texture
+ * coordinate per vertex, so these still render values one at a time with
+ * spectrum_renderGL_value. Construct after spectrum_start_renderGL.
+ */
+class SpectrumRenderGLColours
+{
+	cmzn_spectrum *spectrum;
+	cmzn_material *material;
+	Spectrum_render_data *render_data;
+	const GLfloat *data_buffer;
+	unsigned int data_values_per_vertex;
+	std::vector<GLfloat> rgba_buffer;
+
+public:
+	SpectrumRenderGLColours(cmzn_spectrum *spectrumIn, cmzn_material *materialIn,
+		Spectrum_render_data *renderDataIn, const GLfloat *dataBufferIn,
+		unsigned int dataValuesPerVertexIn, unsigned int dataVertexCount) :
+		spectrum(spectrumIn),
+		material(materialIn),
+		render_data(renderDataIn),
+		data_buffer(dataBufferIn),
+		data_values_per_vertex(dataValuesPerVertexIn)
+	{
+		if ((this->render_data) && (this->data_buffer) && (0 < this->data_values_per_vertex) &&
+			(0 < dataVertexCount) && (!Spectrum_has_texture_lookup_components(this->spectrum)))
+		{
+			this->rgba_buffer.resize(4*dataVertexCount);
+			if (!Spectrum_values_to_rgba(this->spectrum, this->material, this->data_values_per_vertex,
+				dataVertexCount, this->data_buffer, &(this->rgba_buffer[0])))
+			{
+				this->rgba_buffer.clear();
+			}
+		}
+	}
+
+	/** @param datum  Pointer to values for a vertex in the data buffer. */
+	void renderValue(GLfloat *datum)
+	{
+		if (this->rgba_buffer.empty())
+		{
+			spectrum_renderGL_value(this->spectrum, this->material, this->render_data, datum);
+		}
+		else
+		{
+			glColor4fv(&(this->rgba_buffer[0]) +
+				4*((datum - this->data_buffer)/this->data_values_per_vertex));
+		}
+	}
+};
+
 } // namespace
 
 /** Routine that uses the objects material and spectrum to convert
@@ -985,45 +1048,11 @@ int Graphics_object_create_colour_buffer_from_data(GT_object *object,
 		{
 			if (ALLOCATE(*colour_buffer, GLfloat, 4 * data_vertex_count))
 			{
-				GLfloat *data_vertex;
-				GLfloat *colour_vertex;
-				unsigned int i;
-				ZnReal colData[4];
-				if (!cmzn_spectrum_is_material_overwrite(spectrum))
-				{
-					Colour diffuse_colour;
-					Graphical_material_get_diffuse(material, &diffuse_colour);
-					MATERIAL_PRECISION prec;
-					Graphical_material_get_alpha(material, &prec);
-					GLfloat alpha = prec;
-					for (i = 0 ; i < data_vertex_count ; i++)
-					{
-						colData[0] = diffuse_colour.red;
-						colData[1] = diffuse_colour.green;
-						colData[2] = diffuse_colour.blue;
-						colData[3] = alpha;
-					}
-				}
-				colour_vertex = *colour_buffer;
-				data_vertex = data_buffer;
-				FE_value *feData = new FE_value[data_values_per_vertex];
-				for (i = 0 ; i < data_vertex_count ; i++)
-				{
-					CAST_TO_FE_VALUE(feData,data_vertex,(int)data_values_per_vertex);
-					Spectrum_value_to_rgba(spectrum, data_values_per_vertex,
-							feData, colData);
-					for (unsigned int j = 0 ; j < 4 ; j++)
-					{
-						colour_vertex[j] = (GLfloat)colData[j];
-					}
-					colour_vertex += 4;
-					data_vertex += data_values_per_vertex;
-				}
+				return_code = Spectrum_values_to_rgba(spectrum, material, data_values_per_vertex,
+					data_vertex_count, data_buffer, *colour_buffer);
 				Spectrum_end_value_to_rgba(spectrum);
-
 				*colour_vertex_count = data_vertex_count;
 				*colour_values_per_vertex = 4;
-				delete[] feData;
 			}
 			else
 			{
@@ -2018,6 +2047,8 @@ static int draw_vertexBufferPointset(gtObject *object,
 			{
 				render_data=spectrum_start_renderGL(spectrum,material,data_values_per_vertex);
 			}
+			SpectrumRenderGLColours spectrum_colours(spectrum, material, render_data,
+				data_buffer, data_values_per_vertex, data_vertex_count);
 			switch (rendering_type)
 			{
 				case GRAPHICS_OBJECT_RENDERING_TYPE_CLIENT_VERTEX_ARRAYS:
@@ -2071,7 +2102,7 @@ static int draw_vertexBufferPointset(gtObject *object,
 						/* set the spectrum for this datum, if any */
 						if (datum)
 						{
-							spectrum_renderGL_value(spectrum,material,render_data,datum);
+							spectrum_colours.renderValue(datum);
 							datum += data_values_per_vertex;
 						}
 						cmzn_font_rendergl_text(font, const_cast<char *>(label->c_str()), x, y, z);
@@ -2211,6 +2242,8 @@ static int draw_vertexBufferGlyphset(gtObject *object,
 				{
 					render_data=spectrum_start_renderGL(spectrum,material,data_values_per_vertex);
 				}
+				SpectrumRenderGLColours spectrum_colours(spectrum, material, render_data,
+					data_buffer, data_values_per_vertex, data_vertex_count);
 				// disable highlighting beneath glyph set level
 				renderer->push_highlight_functor();
 				for (nodeset_index = 0; nodeset_index < nodeset_count; nodeset_index++)
@@ -2310,7 +2343,7 @@ static int draw_vertexBufferGlyphset(gtObject *object,
 								/* set the spectrum for this datum, if any */
 								if (data_buffer)
 								{
-									spectrum_renderGL_value(spectrum,material,render_data,datum);
+									spectrum_colours.renderValue(datum);
 								}
 								if (picking_names)
 								{
@@ -2445,7 +2478,7 @@ static int draw_vertexBufferGlyphset(gtObject *object,
 									/* set the spectrum for this datum, if any */
 									if (datum)
 									{
-										spectrum_renderGL_value(spectrum,material,render_data,datum);
+										spectrum_colours.renderValue(datum);
 									}
 									for (int j = 0; j < number_of_glyphs; j++)
 									{
@@ -2575,7 +2608,7 @@ static int draw_vertexBufferGlyphset(gtObject *object,
 									/* set the spectrum for this datum, if any */
 									if (datum)
 									{
-										spectrum_renderGL_value(spectrum,material,render_data,datum);
+										spectrum_colours.renderValue(datum);
 									}
 									for (int glyph_number = 0; glyph_number < number_of_glyphs; glyph_number++)
 									{
@@ -3008,7 +3041,7 @@ int draw_vertexBufferLine(gtObject *object, Render_graphics_opengl *renderer,
 			*texture_coordinate0_buffer;
 		struct Spectrum_render_data *render_data = NULL;
 		unsigned int position_values_per_vertex, position_vertex_count,
-			data_values_per_vertex, data_vertex_count, normal_values_per_vertex,
+			data_values_per_vertex = 0, data_vertex_count = 0, normal_values_per_vertex,
 			normal_vertex_count, texture_coordinate0_values_per_vertex,
 			texture_coordinate0_vertex_count;
 
@@ -3062,6 +3095,8 @@ int draw_vertexBufferLine(gtObject *object, Render_graphics_opengl *renderer,
 			} break;
 		}
 
+		SpectrumRenderGLColours spectrum_colours(spectrum, material, render_data,
+			data_buffer, data_values_per_vertex, data_vertex_count);
 		for (line_index = 0; line_index < line_count; line_index++)
 		{
 			int object_name = 0;
@@ -3130,7 +3165,7 @@ int draw_vertexBufferLine(gtObject *object, Render_graphics_opengl *renderer,
 							{
 								if (data_buffer)
 								{
-									spectrum_renderGL_value(spectrum,material,render_data,data_vertex);
+									spectrum_colours.renderValue(data_vertex);
 									data_vertex += data_values_per_vertex;
 								}
 								if (normal_buffer)
@@ -449,38 +449,39 @@ Sets VRML file for rendering values on the current material.
 	return (return_code);
 } /* spectrum_start_render_vrml */
 
-static int spectrum_render_vrml_value(FILE *vrml_file,struct cmzn_spectrum *spectrum,
-	cmzn_material *material,int number_of_data_components,GLfloat *data)
-/*******************************************************************************
-LAST MODIFIED : 6 May 1999
-
-DESCRIPTION :
-Writes VRML to represent the value 'data' in accordance with the spectrum.
-==============================================================================*/
+/**
+ * Writes VRML colours for number_of_values data values, each value repeated
+ * <repeat> times, computing all colours with one batched spectrum evaluation.
+ */
+static int spectrum_render_vrml_values(FILE *vrml_file,struct cmzn_spectrum *spectrum,
+	cmzn_material *material,int number_of_data_components,int number_of_values,
+	const GLfloat *data,int repeat)
 {
-	int return_code;
-	ZnReal rgba[4];
-
-	ENTER(spectrum_render_vrml_value);
-	if (spectrum&&material)
+	int return_code = 0;
+	if (spectrum && material && (0 <= number_of_values))
 	{
-		FE_value *feData = new FE_value[number_of_data_components];
-		CAST_TO_FE_VALUE(feData,data,number_of_data_components);
-		Spectrum_value_to_rgba(spectrum,number_of_data_components,feData,rgba);
-		fprintf(vrml_file,"    %f %f %f,\n",rgba[0],rgba[1],rgba[2]);
-		return_code=1;
-		delete[] feData;
+		GLfloat *rgba = 0;
+		if ((0 == number_of_values) || ALLOCATE(rgba, GLfloat, 4*number_of_values))
+		{
+			return_code = Spectrum_values_to_rgba(spectrum, material,
+				number_of_data_components, number_of_values, data, rgba);
+			const GLfloat *rgba_vertex = rgba;
+			for (int i = 0; i < number_of_values; ++i)
+			{
+				for (int j = 0; j < repeat; ++j)
+					fprintf(vrml_file,"    %f %f %f,\n",rgba_vertex[0],rgba_vertex[1],rgba_vertex[2]);
+				rgba_vertex += 4;
+			}
+			DEALLOCATE(rgba);
+		}
 	}
 	else
 	{
 		display_message(ERROR_MESSAGE,
-			"spectrum_render_vrml_value.  Invalid arguments given.");
-		return_code=0;
+			"spectrum_render_vrml_values.  Invalid arguments given.");
 	}
-	LEAVE;
-
 	return (return_code);
-} /* spectrum_render_vrml_value */
+}
 
 static int spectrum_end_render_vrml(FILE *vrml_file,struct cmzn_spectrum *spectrum)
 /*******************************************************************************
@@ -663,7 +664,7 @@ static int draw_glyph_set_vrml(FILE *vrml_file, GT_glyphset_vertex_buffers *glyp
 			ZnReal a1, a2, a3, a_angle, a_magnitude, ax1, ax2, ax3, b1, b2, b3, b_angle,
 			bx1, bx2, bx3, c1, c2, c3, cx1, cx2, cx3, dp, j1, j2, j3,
 			c_magnitude, s1, s2, s3, x = 0.0, y = 0.0, z = 0.0;
-			int j, number_of_skew_glyph_axes, skewed_axes;
+			int number_of_skew_glyph_axes, skewed_axes;
 			unsigned int i;
 			cmzn_material *material_copy;
 			GT_object *glyph = glyph_set->glyph;
@@ -704,11 +705,8 @@ static int draw_glyph_set_vrml(FILE *vrml_file, GT_glyphset_vertex_buffers *glyp
 				if (data_spectrum)
 				{
 					spectrum_start_render_vrml(vrml_file,spectrum,material);
-					for (i=0;i<index_count;i++)
-					{
-						spectrum_render_vrml_value(vrml_file,spectrum,material,
-							data_values_per_vertex,datum+i*data_values_per_vertex);
-					}
+					spectrum_render_vrml_values(vrml_file,spectrum,material,
+						data_values_per_vertex,index_count,datum,/*repeat*/1);
 					spectrum_end_render_vrml(vrml_file, spectrum);
 				}
 				fprintf(vrml_file,"  } #Pointset\n");
@@ -761,11 +759,8 @@ static int draw_glyph_set_vrml(FILE *vrml_file, GT_glyphset_vertex_buffers *glyp
 				{
 					fprintf(vrml_file,"    colorPerVertex FALSE\n");
 					spectrum_start_render_vrml(vrml_file,spectrum,material);
-					for (i=0;i<index_count;i++)
-					{
-						spectrum_render_vrml_value(vrml_file,spectrum,material,
-							data_values_per_vertex,datum+i*data_values_per_vertex);
-					}
+					spectrum_render_vrml_values(vrml_file,spectrum,material,
+						data_values_per_vertex,index_count,datum,/*repeat*/1);
 					spectrum_end_render_vrml(vrml_file, spectrum);
 				}
 				fprintf(vrml_file,"    coordIndex [\n");
@@ -843,14 +838,8 @@ static int draw_glyph_set_vrml(FILE *vrml_file, GT_glyphset_vertex_buffers *glyp
 				{
 					fprintf(vrml_file,"    colorPerVertex FALSE\n");
 					spectrum_start_render_vrml(vrml_file,spectrum,material);
-					for (i=0;i<index_count;i++)
-					{
-						for (j=0;j<3;j++)
-						{
-							spectrum_render_vrml_value(vrml_file,spectrum,material,
-								data_values_per_vertex,datum+i*data_values_per_vertex);
-						}
-					}
+					spectrum_render_vrml_values(vrml_file,spectrum,material,
+						data_values_per_vertex,index_count,datum,/*repeat*/3);
 					spectrum_end_render_vrml(vrml_file, spectrum);
 				}
 				fprintf(vrml_file,"    coordIndex [\n");
@@ -1371,11 +1360,8 @@ static int draw_point_set_vrml(FILE *vrml_file,int n_pts, GLfloat *point_list,
 				if (number_of_data_components && data && spectrum)
 				{
 					spectrum_start_render_vrml(vrml_file,spectrum,material);
-					for (i=0;i<n_pts;i++)
-					{
-						spectrum_render_vrml_value(vrml_file,spectrum,material,
-							number_of_data_components,data+i*number_of_data_components);
-					}
+					spectrum_render_vrml_values(vrml_file,spectrum,material,
+						number_of_data_components,n_pts,data,/*repeat*/1);
 					spectrum_end_render_vrml(vrml_file, spectrum);
 				}
 				fprintf(vrml_file,"  } #PointSet\n");
@@ -1546,11 +1532,8 @@ continuous polyline. If data or spectrum are NULL they are ignored.
 			{
 				fprintf(vrml_file,"    colorPerVertex TRUE\n");
 				spectrum_start_render_vrml(vrml_file,spectrum,material);
-				for (i=0;i<n_pts;i++)
-				{
-					spectrum_render_vrml_value(vrml_file,spectrum,material,
-						number_of_data_components,data+i*number_of_data_components);
-				}
+				spectrum_render_vrml_values(vrml_file,spectrum,material,
+					number_of_data_components,n_pts,data,/*repeat*/1);
 				spectrum_end_render_vrml(vrml_file, spectrum);
 			}
 			if (material&&Graphical_material_get_texture(material))
@@ -1730,11 +1713,8 @@ DESCRIPTION :
 		if (data_spectrum)
 		{
 			spectrum_start_render_vrml(vrml_file,spectrum,material);
-			for (i=0;i<position_vertex_count;i++)
-			{
-				spectrum_render_vrml_value(vrml_file,spectrum,material,
-					data_values_per_vertex,data_buffer+data_values_per_vertex*i);
-			}
+			spectrum_render_vrml_values(vrml_file,spectrum,material,
+				data_values_per_vertex,position_vertex_count,data_buffer,/*repeat*/1);
 			spectrum_end_render_vrml(vrml_file, spectrum);
 		}
 		/* texture coordinates */
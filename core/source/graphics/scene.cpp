@@ -620,6 +620,7 @@ static int cmzn_scene_build_graphics_objects(
 			graphics_to_object_data.incrementalBuild = renderer->getIncrementalBuild();
 			graphics_to_object_data.selection_group_field = cmzn_scene_get_selection_field(scene);
 			graphics_to_object_data.iso_surface_specification = NULL;
+			graphics_to_object_data.shared_edge_data = 0;
 			return_code = FOR_EACH_OBJECT_IN_LIST(cmzn_graphics)(
 				cmzn_graphics_to_graphics_object, (void *) &graphics_to_object_data,
 				scene->list_of_graphics);
@@ -2211,8 +2212,9 @@ static void cmzn_scene_time_update_callback(cmzn_timenotifierevent_id timenotifi
 			cmzn_scene_trigger_time_dependent_transformation(scene,
 				cmzn_timenotifierevent_get_time(timenotifierevent));
 		}
+		double time = cmzn_timenotifierevent_get_time(timenotifierevent);
 		FOR_EACH_OBJECT_IN_LIST(cmzn_graphics)(
-			cmzn_graphics_time_change,NULL,
+			cmzn_graphics_time_change, static_cast<void *>(&time),
 			scene->list_of_graphics);
 		cmzn_scene_end_change(scene);
 	}
@@ -3510,13 +3512,13 @@ int Scene_render_threejs(cmzn_scene_id scene,
 	int number_of_time_steps, double begin_time, double end_time,
 	cmzn_streaminformation_scene_io_data_type export_mode,
 	int *number_of_entries, std::string **output_string,
-	 int morphVertices, int morphColours, int morphNormals)
+	 int morphVertices, int morphColours, int morphNormals, bool binary, bool quantise)
 {
 	if (scene)
 	{
 		Render_graphics_opengl *renderer = Render_graphics_opengl_create_threejs_renderer(
 			file_prefix, number_of_time_steps, begin_time, end_time, export_mode, number_of_entries,
-			output_string, morphVertices, morphColours, morphNormals);
+			output_string, morphVertices, morphColours, morphNormals, binary, quantise);
 		renderer->Scene_compile(scene, scenefilter);
 		delete renderer;
 
@@ -5,15 +5,22 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <algorithm>
+#include <vector>
 
 #include "opencmiss/zinc/scenefilter.h"
 #include "opencmiss/zinc/status.h"
+#include "opencmiss/zinc/timenotifier.h"
 #include "finite_element/finite_element_region.h"
 #include "general/debug.h"
+#include "general/matrix_vector.h"
 #include "general/object.h"
+#include "graphics/graphics.h"
 #include "graphics/graphics_library.h"
+#include "graphics/graphics_object.h"
+#include "graphics/graphics_object_bvh.hpp"
 #include "graphics/render_gl.h"
 #include "graphics/scene.h"
+#include "graphics/scene.hpp"
 #include "graphics/scene_picker.hpp"
 #include "graphics/scene_viewer.h"
 #include "graphics/scene.h"
@@ -107,16 +114,138 @@ int cmzn_scenepicker::getPickingVolumeCentre(double *coordinateValuesOut3)
 	return CMZN_ERROR_GENERAL;
 }
 
-int cmzn_scenepicker::pickObjects()
+namespace {
+
+/** Convert normalised depth from -1 at near to +1 at far plane to the
+ * unsigned integer range used for depths in the OpenGL select buffer. */
+inline GLuint normalised_depth_to_select_depth(double depth)
+{
+	if (depth < -1.0)
+		depth = -1.0;
+	else if (depth > 1.0)
+		depth = 1.0;
+	return static_cast<GLuint>(0.5*(depth + 1.0)*4294967295.0);
+}
+
+}
+
+void cmzn_scenepicker::pickSceneTree(cmzn_scene *scene,
+	const double *parentTransformation, const double *worldTransformation,
+	std::vector<GLuint>& hitRecords)
+{
+	double sceneTransformation[16];
+	if (cmzn_scene_has_transformation(scene))
+	{
+		gtMatrix transformation;
+		cmzn_scene_get_transformation(scene, &transformation);
+		/* scene transformation is stored for glMultMatrix, columns fastest */
+		double rowMajorTransformation[16];
+		for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
+				rowMajorTransformation[i*4 + j] = transformation[j][i];
+		multiply_matrix(4, 4, 4, const_cast<double *>(parentTransformation),
+			rowMajorTransformation, sceneTransformation);
+	}
+	else
+	{
+		for (int i = 0; i < 16; ++i)
+			sceneTransformation[i] = parentTransformation[i];
+	}
+	const GLuint scenePosition = static_cast<GLuint>(cmzn_scene_get_position(scene));
+	/* pick graphics at the scene time, as they are rendered */
+	const double time = (scene->time_notifier) ?
+		cmzn_timenotifier_get_time(scene->time_notifier) : 0.0;
+	std::vector<Graphics_object_bvh::Hit> hits;
+	cmzn_graphics *graphics = cmzn_scene_get_first_graphics(scene);
+	while (graphics)
+	{
+		GT_object *graphics_object = cmzn_graphics_get_graphics_object(graphics);
+		if (graphics_object && ((0 == this->filter) ||
+			cmzn_scenefilter_evaluate_graphics(this->filter, graphics)))
+		{
+			/* as for OpenGL picking, graphics in window coordinates are not picked */
+			const double *transformation = 0;
+			switch (cmzn_graphics_get_scenecoordinatesystem(graphics))
+			{
+			case CMZN_SCENECOORDINATESYSTEM_LOCAL:
+				transformation = sceneTransformation;
+				break;
+			case CMZN_SCENECOORDINATESYSTEM_WORLD:
+				transformation = worldTransformation;
+				break;
+			default:
+				break;
+			}
+			Graphics_object_bvh *bvh = (transformation) ?
+				GT_object_get_picking_bvh(graphics_object, time) : 0;
+			if (bvh)
+			{
+				hits.clear();
+				bvh->findHits(transformation, hits);
+				const GLuint graphicsPosition =
+					static_cast<GLuint>(cmzn_scene_get_graphics_position(scene, graphics));
+				for (std::vector<Graphics_object_bvh::Hit>::const_iterator hit = hits.begin();
+					hit != hits.end(); ++hit)
+				{
+					hitRecords.push_back(static_cast<GLuint>(2 + hit->numberOfNames));
+					hitRecords.push_back(normalised_depth_to_select_depth(hit->nearest));
+					hitRecords.push_back(normalised_depth_to_select_depth(hit->furthest));
+					hitRecords.push_back(scenePosition);
+					hitRecords.push_back(graphicsPosition);
+					if (hit->numberOfNames > 0)
+						hitRecords.push_back(static_cast<GLuint>(hit->objectName));
+					if (hit->numberOfNames > 1)
+						hitRecords.push_back(static_cast<GLuint>(hit->vertexName));
+					++(this->number_of_hits);
+				}
+			}
+		}
+		cmzn_graphics *next_graphics = cmzn_scene_get_next_graphics(scene, graphics);
+		cmzn_graphics_destroy(&graphics);
+		graphics = next_graphics;
+	}
+	cmzn_region *child_region = cmzn_region_get_first_child(cmzn_scene_get_region_internal(scene));
+	while (child_region)
+	{
+		cmzn_scene *child_scene = cmzn_region_get_scene_private(child_region);
+		if (child_scene)
+			this->pickSceneTree(child_scene, sceneTransformation, worldTransformation, hitRecords);
+		cmzn_region_reaccess_next_sibling(&child_region);
+	}
+}
+
+int cmzn_scenepicker::pickObjectsBvh()
+{
+	if (!(top_scene && interaction_volume))
+		return CMZN_ERROR_GENERAL;
+	/* ensure all graphics are built since none may have been drawn yet */
+	build_Scene(top_scene, filter);
+	double modelview_matrix[16], projection_matrix[16], world_transformation[16];
+	Interaction_volume_get_modelview_matrix(interaction_volume, modelview_matrix);
+	Interaction_volume_get_projection_matrix(interaction_volume, projection_matrix);
+	multiply_matrix(4, 4, 4, projection_matrix, modelview_matrix, world_transformation);
+	/* hits are recorded in the same form as the OpenGL select buffer:
+	 * number of names, minimum and maximum depth, scene position,
+	 * graphics position, then any object and vertex names */
+	std::vector<GLuint> hitRecords;
+	number_of_hits = 0;
+	this->pickSceneTree(top_scene, world_transformation, world_transformation, hitRecords);
+	select_buffer_size = static_cast<int>(hitRecords.size());
+	if (!ALLOCATE(select_buffer, GLuint, (select_buffer_size > 0) ? select_buffer_size : 1))
+	{
+		number_of_hits = 0;
+		return CMZN_ERROR_MEMORY;
+	}
+	if (select_buffer_size > 0)
+		std::copy(hitRecords.begin(), hitRecords.end(), select_buffer);
+	return CMZN_OK;
+}
+
+int cmzn_scenepicker::pickObjectsOpenGL()
 {
 	double modelview_matrix[16],projection_matrix[16];
 	GLdouble opengl_modelview_matrix[16],opengl_projection_matrix[16];
 	int i, j, return_code = CMZN_ERROR_GENERAL;
-	updateViewerRectangle();
-	if (select_buffer != NULL)
-		return CMZN_OK;
-	if (!has_current_context())
-		return CMZN_ERROR_GENERAL;
 	if (top_scene&&interaction_volume)
 	{
 		Render_graphics_opengl *renderer = Render_graphics_opengl_create_glbeginend_renderer();
@@ -190,6 +319,16 @@ int cmzn_scenepicker::pickObjects()
 	return return_code;
 }
 
+int cmzn_scenepicker::pickObjects()
+{
+	updateViewerRectangle();
+	if (select_buffer != NULL)
+		return CMZN_OK;
+	if (has_current_context())
+		return this->pickObjectsOpenGL();
+	return this->pickObjectsBvh();
+}
+
 void cmzn_scenepicker::reset()
 {
 	if (select_buffer)
@@ -767,6 +906,27 @@ int cmzn_scenepicker_add_picked_nodes_to_field_group(cmzn_scenepicker_id scenepi
 	return scenepicker->addPickedNodesToFieldGroup(group);
 }
 
+int cmzn_scenepicker_set_picking_volume_box(cmzn_scenepicker_id scenepicker,
+	const double *centreValuesIn3, const double *sizeValuesIn3)
+{
+	if (scenepicker && centreValuesIn3 && sizeValuesIn3 &&
+		(0.0 < sizeValuesIn3[0]) && (0.0 < sizeValuesIn3[1]) && (0.0 < sizeValuesIn3[2]))
+	{
+		Interaction_volume *interaction_volume = create_Interaction_volume_centred_box(
+			centreValuesIn3[0], centreValuesIn3[1], centreValuesIn3[2],
+			sizeValuesIn3[0], sizeValuesIn3[1], sizeValuesIn3[2]);
+		if (interaction_volume)
+		{
+			ACCESS(Interaction_volume)(interaction_volume);
+			scenepicker->setInteractionVolume(interaction_volume);
+			DEACCESS(Interaction_volume)(&interaction_volume);
+			return CMZN_OK;
+		}
+		return CMZN_ERROR_MEMORY;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 int cmzn_scenepicker_get_picking_volume_centre(cmzn_scenepicker_id scenepicker,
 	double *coordinateValuesOut3)
 {
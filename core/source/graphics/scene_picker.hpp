@@ -8,6 +8,7 @@
 #define SCENE_PICKER_HPP
 
 #include <map>
+#include <vector>
 #include "opencmiss/zinc/scenepicker.h"
 #include "opencmiss/zinc/types/graphicsid.h"
 #include "opencmiss/zinc/types/scenefilterid.h"
@@ -42,6 +43,27 @@ private:
 
 	void updateViewerRectangle();
 
+	/**
+	 * Append select buffer records for graphics in scene and its children
+	 * hit by the interaction volume, found with the picking bounding volume
+	 * hierarchy of each graphics object.
+	 * @param parentTransformation  Row-major 4x4 matrix transforming parent
+	 * scene coordinates to homogeneous normalised picking coordinates.
+	 * @param worldTransformation  Matrix for world coordinates.
+	 */
+	void pickSceneTree(cmzn_scene_id scene, const double *parentTransformation,
+		const double *worldTransformation, std::vector<GLuint>& hitRecords);
+
+	/** Pick by rendering the scene into the OpenGL select buffer. Requires
+	 * a current OpenGL context. */
+	int pickObjectsOpenGL();
+
+	/** Pick with the bounding volume hierarchy of each graphics object, for
+	 * use without an OpenGL context. */
+	int pickObjectsBvh();
+
+	/** Fill select buffer for the current interaction volume, if not already,
+	 * using OpenGL if there is a current context, otherwise the CPU. */
 	int pickObjects();
 
 	void reset();
@@ -1915,6 +1915,94 @@ Uses the <spectrum> to calculate RGBA components to represent the
 	return (return_code);
 } /* spectrum_value_to_rgba */
 
+namespace {
+
+struct Spectrum_values_to_rgba_data
+{
+	int number_of_data_components;
+	unsigned int number_of_values;
+	const GLfloat *data;
+	GLfloat *rgba;
+};
+
+int cmzn_spectrumcomponent_values_to_rgba_iterator(
+	struct cmzn_spectrumcomponent *component, void *values_to_rgba_data_void)
+{
+	Spectrum_values_to_rgba_data *values_to_rgba_data =
+		static_cast<Spectrum_values_to_rgba_data *>(values_to_rgba_data_void);
+	return cmzn_spectrumcomponent_values_to_rgba(component,
+		values_to_rgba_data->number_of_data_components,
+		values_to_rgba_data->number_of_values,
+		values_to_rgba_data->data, values_to_rgba_data->rgba);
+}
+
+int cmzn_spectrumcomponent_is_active_texture_lookup(
+	struct cmzn_spectrumcomponent *component, void *dummy_void)
+{
+	USE_PARAMETER(dummy_void);
+	if (!cmzn_spectrumcomponent_is_active(component))
+		return 0;
+	enum cmzn_spectrumcomponent_colour_mapping_type colour_mapping_type =
+		cmzn_spectrumcomponent_get_colour_mapping_type(component);
+	return (CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BANDED == colour_mapping_type) ||
+		(CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_STEP == colour_mapping_type);
+}
+
+} // anonymous namespace
+
+bool Spectrum_has_texture_lookup_components(struct cmzn_spectrum *spectrum)
+{
+	if (!spectrum)
+		return false;
+	return (0 != FIRST_OBJECT_IN_LIST_THAT(cmzn_spectrumcomponent)(
+		cmzn_spectrumcomponent_is_active_texture_lookup, (void *)NULL,
+		spectrum->list_of_components));
+}
+
+int Spectrum_values_to_rgba(struct cmzn_spectrum *spectrum,
+	struct cmzn_material *material, int number_of_data_components,
+	unsigned int number_of_values, const GLfloat *data, GLfloat *rgba)
+{
+	if (!(spectrum && (0 < number_of_data_components) &&
+		((0 == number_of_values) || (data && rgba))))
+	{
+		display_message(ERROR_MESSAGE,
+			"Spectrum_values_to_rgba.  Invalid argument(s)");
+		return 0;
+	}
+	GLfloat base_rgba[4] = { 0.0, 0.0, 0.0, 1.0 };
+	if ((!spectrum->overwrite_colour) && material)
+	{
+		struct Colour diffuse;
+		MATERIAL_PRECISION alpha;
+		Graphical_material_get_diffuse(material, &diffuse);
+		Graphical_material_get_alpha(material, &alpha);
+		base_rgba[0] = diffuse.red;
+		base_rgba[1] = diffuse.green;
+		base_rgba[2] = diffuse.blue;
+		base_rgba[3] = alpha;
+	}
+	GLfloat *rgba_vertex = rgba;
+	for (unsigned int v = 0; v < number_of_values; ++v)
+	{
+		rgba_vertex[0] = base_rgba[0];
+		rgba_vertex[1] = base_rgba[1];
+		rgba_vertex[2] = base_rgba[2];
+		rgba_vertex[3] = base_rgba[3];
+		rgba_vertex += 4;
+	}
+	/* each component modifies only rgba from data, so applying components in
+	 * order over all values gives the same result as per-value evaluation */
+	Spectrum_values_to_rgba_data values_to_rgba_data;
+	values_to_rgba_data.number_of_data_components = number_of_data_components;
+	values_to_rgba_data.number_of_values = number_of_values;
+	values_to_rgba_data.data = data;
+	values_to_rgba_data.rgba = rgba;
+	return FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
+		cmzn_spectrumcomponent_values_to_rgba_iterator,
+		static_cast<void *>(&values_to_rgba_data), spectrum->list_of_components);
+}
+
 int Spectrum_end_value_to_rgba(struct cmzn_spectrum *spectrum)
 /*******************************************************************************
 LAST MODIFIED : 13 September 2007
@@ -287,6 +287,27 @@ Uses the <spectrum> to calculate RGBA components to represent the
 <rgba> is assumed to be an array of four values for red, green, blue and alpha.
 ==============================================================================*/
 
+/**
+ * Uses the spectrum to calculate RGBA colours for an array of data values in
+ * one pass, evaluating each spectrum component over all values at once.
+ * Each colour starts from the material diffuse colour and alpha, or opaque
+ * black if the spectrum overwrites material colour or material is NULL.
+ * @param material  Optional material giving base colour.
+ * @param data  Array of number_of_values*number_of_data_components values.
+ * @param rgba  Array to receive number_of_values*4 colour values.
+ * @return  1 on success, 0 on failure.
+ */
+int Spectrum_values_to_rgba(struct cmzn_spectrum *spectrum,
+	struct cmzn_material *material, int number_of_data_components,
+	unsigned int number_of_values, const GLfloat *data, GLfloat *rgba);
+
+/**
+ * Banded and step components are rendered through a 1-D texture lookup, so
+ * Spectrum_values_to_rgba does not give their colours.
+ * @return  True if spectrum has any active banded or step components.
+ */
+bool Spectrum_has_texture_lookup_components(struct cmzn_spectrum *spectrum);
+
 int Spectrum_end_value_to_rgba(struct cmzn_spectrum *spectrum);
 /*******************************************************************************
 LAST MODIFIED : 13 September 2007
@@ -1358,6 +1358,106 @@ DESCRIPTION :
 	return (return_code);
 } /* cmzn_spectrumcomponent_enable */
 
+/**
+ * Set the rgba channels controlled by the colour mapping type from normalised
+ * value in range 0 to 1. Banded and step types are rendered with textures so
+ * do not modify rgba.
+ */
+static inline void spectrum_colour_mapping_value_to_rgba(
+	enum cmzn_spectrumcomponent_colour_mapping_type colour_mapping_type,
+	GLfloat value, GLfloat *rgba)
+{
+	switch (colour_mapping_type)
+	{
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_ALPHA:
+		{
+			rgba[3] = value;
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RAINBOW:
+		{
+			if (value<1.0/3.0)
+			{
+				rgba[0]=1.0;
+				rgba[2]=0.0;
+				if (value<1.0/6.0)
+				{
+					rgba[1]=value*4.5;
+				}
+				else
+				{
+					rgba[1]=0.75+(value-1.0/6.0)*1.5;
+				}
+			}
+			else if (value<2.0/3.0)
+			{
+				rgba[1]=1.0;
+				if (value<0.5)
+				{
+					rgba[0] = 2.5 - 4.5*value;
+					rgba[2] = 1.5*value - 0.5;
+				}
+				else
+				{
+					rgba[0] = 1.0 - 1.5*value;
+					rgba[2] = -2.0 + 4.5*value;
+				}
+			}
+			else
+			{
+				rgba[0]=0.0;
+				rgba[2]=1.0;
+				if (value<5.0/6.0)
+				{
+					rgba[1]=1.0-(value-2.0/3.0)*1.5;
+				}
+				else
+				{
+					rgba[1]=0.75-(value-5.0/6.0)*4.5;
+				}
+			}
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RED:
+		{
+			rgba[0]=value;
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_GREEN:
+		{
+			rgba[1]=value;
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BLUE:
+		{
+			rgba[2]=value;
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_MONOCHROME:
+		{
+			rgba[0]=value;
+			rgba[1]=value;
+			rgba[2]=value;
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_BLUE:
+		{
+			rgba[2]=1.0;
+			rgba[0]=(1-value);
+			rgba[1]=(1-value);
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_RED:
+		{
+			rgba[0]=1.0;
+			rgba[2]=(1-value);
+			rgba[1]=(1-value);
+		} break;
+		case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_GREEN:
+		{
+			rgba[1]=1.0;
+			rgba[0]=(1-value);
+			rgba[2]=(1-value);
+		} break;
+		default:
+		{
+		} break;
+	}
+}
+
 int cmzn_spectrumcomponent_activate(struct cmzn_spectrumcomponent *component,
 	void *render_data_void)
 /*******************************************************************************
@@ -1427,95 +1527,8 @@ passed in render data.
 				if (1 == number_of_components)
 				{
 					value = values[0];
-					switch (component->colour_mapping_type)
-					{
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_ALPHA:
-						{
-							render_data->rgba[3] = value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RAINBOW:
-							{
-								if (value<1.0/3.0)
-								{
-									render_data->rgba[0]=1.0;
-									render_data->rgba[2]=0.0;
-									if (value<1.0/6.0)
-									{
-										render_data->rgba[1]=value*4.5;
-									}
-									else
-									{
-										render_data->rgba[1]=0.75+(value-1.0/6.0)*1.5;
-									}
-								}
-								else if (value<2.0/3.0)
-								{
-									render_data->rgba[1]=1.0;
-									if (value<0.5)
-									{
-										render_data->rgba[0] = 2.5 - 4.5*value;
-										render_data->rgba[2] = 1.5*value - 0.5;
-									}
-									else
-									{
-										render_data->rgba[0] = 1.0 - 1.5*value;
-										render_data->rgba[2] = -2.0 + 4.5*value;
-									}
-								}
-								else
-								{
-									render_data->rgba[0]=0.0;
-									render_data->rgba[2]=1.0;
-									if (value<5.0/6.0)
-									{
-										render_data->rgba[1]=1.0-(value-2.0/3.0)*1.5;
-									}
-									else
-									{
-										render_data->rgba[1]=0.75-(value-5.0/6.0)*4.5;
-									}
-								}
-							} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RED:
-							{
-								render_data->rgba[0]=value;
-							} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_GREEN:
-							{
-								render_data->rgba[1]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BLUE:
-						{
-							render_data->rgba[2]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_MONOCHROME:
-						{
-							render_data->rgba[0]=value;
-							render_data->rgba[1]=value;
-							render_data->rgba[2]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_BLUE:
-						{
-							render_data->rgba[2]=1.0;
-							render_data->rgba[0]=(1-value);
-							render_data->rgba[1]=(1-value);
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_RED:
-						{
-							render_data->rgba[0]=1;
-							render_data->rgba[2]=(1-value);
-							render_data->rgba[1]=(1-value);
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_GREEN:
-						{
-							render_data->rgba[1]=1.0;
-							render_data->rgba[0]=(1-value);
-							render_data->rgba[2]=(1-value);
-						} break;
-						default:
-						{
-						} break;
-					}
+					spectrum_colour_mapping_value_to_rgba(component->colour_mapping_type,
+						value, render_data->rgba);
 				}
 				else if (2 == number_of_components)
 				{
@@ -1657,91 +1670,10 @@ passed in render data.
 							glTexCoord1f(value);
 #endif /* defined (OPENGL_API) */
 						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_ALPHA:
-						{
-							render_data->rgba[3] = value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RAINBOW:
-						{
-							if (value<1.0/3.0)
-							{
-								render_data->rgba[0]=1.0;
-								render_data->rgba[2]=0.0;
-								if (value<1.0/6.0)
-								{
-									render_data->rgba[1]=value*4.5;
-								}
-								else
-								{
-									render_data->rgba[1]=0.75+(value-1.0/6.0)*1.5;
-								}
-							}
-							else if (value<2.0/3.0)
-							{
-								render_data->rgba[1]=1.0;
-								if (value<0.5)
-								{
-									render_data->rgba[0] = 2.5 - 4.5*value;
-									render_data->rgba[2] = 1.5*value - 0.5;
-								}
-								else
-								{
-									render_data->rgba[0] = 1.0 - 1.5*value;
-									render_data->rgba[2] = -2.0 + 4.5*value;
-								}
-							}
-							else
-							{
-								render_data->rgba[0]=0.0;
-								render_data->rgba[2]=1.0;
-								if (value<5.0/6.0)
-								{
-									render_data->rgba[1]=1.0-(value-2.0/3.0)*1.5;
-								}
-								else
-								{
-									render_data->rgba[1]=0.75-(value-5.0/6.0)*4.5;
-								}
-							}
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_RED:
-						{
-							render_data->rgba[0]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_GREEN:
-						{
-							render_data->rgba[1]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BLUE:
-						{
-							render_data->rgba[2]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_MONOCHROME:
-						{
-							render_data->rgba[0]=value;
-							render_data->rgba[1]=value;
-							render_data->rgba[2]=value;
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_BLUE:
-						{
-							render_data->rgba[2]=1.0;
-							render_data->rgba[0]=(1-value);
-							render_data->rgba[1]=(1-value);
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_RED:
-						{
-							render_data->rgba[0]=1.0;
-							render_data->rgba[2]=(1-value);
-							render_data->rgba[1]=(1-value);
-						} break;
-						case CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_WHITE_TO_GREEN:
-						{
-							render_data->rgba[1]=1.0;
-							render_data->rgba[0]=(1-value);
-							render_data->rgba[2]=(1-value);
-						} break;
 						default:
 						{
+							spectrum_colour_mapping_value_to_rgba(component->colour_mapping_type,
+								value, render_data->rgba);
 						} break;
 					}
 				}
@@ -1785,6 +1717,107 @@ passed in render data.
 	return (return_code);
 } /* cmzn_spectrumcomponent_activate */
 
+int cmzn_spectrumcomponent_values_to_rgba(struct cmzn_spectrumcomponent *component,
+	int number_of_data_components, unsigned int number_of_values,
+	const GLfloat *data, GLfloat *rgba)
+{
+	if (!(component && (0 < number_of_data_components) && ((0 == number_of_values) || (data && rgba))))
+	{
+		display_message(ERROR_MESSAGE, "cmzn_spectrumcomponent_values_to_rgba.  "
+			"Invalid argument(s)");
+		return 0;
+	}
+	if (!component->active)
+		return 1;
+	if (component->component_scale == CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_INVALID &&
+		component->is_field_lookup)
+	{
+		/* field lookup must evaluate fields per value */
+		struct Spectrum_render_data render_data;
+		render_data.number_of_data_components = number_of_data_components;
+		int return_code = 1;
+		for (unsigned int v = 0; (v < number_of_values) && return_code; ++v)
+		{
+			render_data.data = const_cast<GLfloat *>(data + v*number_of_data_components);
+			render_data.rgba = rgba + 4*v;
+			return_code = cmzn_spectrumcomponent_activate(component, static_cast<void *>(&render_data));
+		}
+		return return_code;
+	}
+	/* banded and step types only set texture coordinates; ignore component
+	 * acting on a component for which there is no data */
+	if ((CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BANDED == component->colour_mapping_type) ||
+		(CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_STEP == component->colour_mapping_type) ||
+		(component->component_number >= number_of_data_components))
+		return 1;
+	const bool log_scale = (CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LOG == component->component_scale);
+	if ((!log_scale) && (CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LINEAR != component->component_scale))
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_spectrumcomponent_values_to_rgba.  Unknown type");
+		return 0;
+	}
+	/* precompute everything independent of the data value */
+	const ZnReal minimum = component->minimum;
+	const ZnReal maximum = component->maximum;
+	const ZnReal range = maximum - minimum;
+	const bool zero_range = (maximum == minimum);
+	const ZnReal exaggeration = component->exaggeration;
+	const bool negative_exaggeration = (exaggeration < 0);
+	const ZnReal log_denominator = log_scale ?
+		(negative_exaggeration ? log(1 - exaggeration) : log(1 + exaggeration)) : 1.0;
+	const bool extend_below = component->extend_below;
+	const bool extend_above = component->extend_above;
+	const bool reverse = component->reverse;
+	const ZnReal min_value = component->min_value;
+	const ZnReal value_range = component->max_value - component->min_value;
+	const enum cmzn_spectrumcomponent_colour_mapping_type colour_mapping_type =
+		component->colour_mapping_type;
+	const GLfloat *data_component_address = data + component->component_number;
+	GLfloat *rgba_vertex = rgba;
+	for (unsigned int v = 0; v < number_of_values; ++v)
+	{
+		const ZnReal data_component = *data_component_address;
+		data_component_address += number_of_data_components;
+		if (((data_component >= minimum) || extend_below) &&
+			((data_component <= maximum) || extend_above))
+		{
+			GLfloat value;
+			if (zero_range)
+			{
+				value = (data_component <= minimum) ? 0.0 : 1.0;
+			}
+			else
+			{
+				if (!log_scale)
+				{
+					value = (data_component - minimum)/range;
+				}
+				else if (negative_exaggeration)
+				{
+					value = 1.0 - log(1 - exaggeration*(maximum - data_component)/range)/
+						log_denominator;
+				}
+				else
+				{
+					value = log(1 + exaggeration*(data_component - minimum)/range)/
+						log_denominator;
+				}
+				if (value > 1.0)
+					value = 1.0;
+				if (value < 0.0)
+					value = 0.0;
+			}
+			if (reverse)
+				value = 1.0 - value;
+			value = min_value + value_range*value;
+			spectrum_colour_mapping_value_to_rgba(colour_mapping_type, value, rgba_vertex);
+		}
+		rgba_vertex += 4;
+	}
+	return 1;
+}
+
 int cmzn_spectrumcomponent_disable(struct cmzn_spectrumcomponent *component,
 	void *render_data_void)
 /*******************************************************************************
@@ -180,6 +180,19 @@ Modifies the colour in the render data to represent the data value
 passed in render data.
 ==============================================================================*/
 
+/**
+ * Batch equivalent of cmzn_spectrumcomponent_activate for an array of data
+ * values. Applies the component to the rgba of each value in turn, with all
+ * terms independent of the data value evaluated once per call. Banded and step
+ * colour mappings only set texture coordinates so have no effect here.
+ * @param data  Array of number_of_values*number_of_data_components values.
+ * @param rgba  Array of number_of_values*4 colour values to modify.
+ * @return  1 on success, 0 on failure.
+ */
+int cmzn_spectrumcomponent_values_to_rgba(struct cmzn_spectrumcomponent *component,
+	int number_of_data_components, unsigned int number_of_values,
+	const GLfloat *data, GLfloat *rgba);
+
 int cmzn_spectrumcomponent_disable(struct cmzn_spectrumcomponent *component,
 	void *render_data_void);
 /*******************************************************************************
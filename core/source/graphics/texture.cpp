@@ -4969,458 +4969,521 @@ Returns the byte values in the texture at x,y,z.
 	return (return_code);
 } /* Texture_get_raw_pixel_values */
 
-int Texture_get_pixel_values(struct Texture *texture,
-	ZnReal x, ZnReal y, ZnReal z, ZnReal *values)
-/*******************************************************************************
-LAST MODIFIED : 28 August 2002
-
-DESCRIPTION :
-Returns the byte values in the texture using the texture coordinates relative
-to the physical size.  Each texel is assumed to apply exactly
-at its centre and the filter_mode used to determine whether the pixels are
-interpolated or not.  When closer than half a texel to a boundary the colour
-is constant from the half texel location to the edge.
-==============================================================================*/
+namespace {
+
+/**
+ * Samples a texture at many texture coordinates, resolving its wrap and
+ * filter modes, sizes and texel layout once for all locations. Kernels are
+ * specialised on the component type, number of components, wrap mode and
+ * dimension, so no modes are tested per point and only the texture's own
+ * axes are wrapped. Texel fetches are gathers from coordinate-dependent
+ * addresses, so each point is sampled with scalar code rather than
+ * vectorised across points.
+ */
+class TextureSampler
 {
-	ZnReal local_xi[3], max_v, pos[3], weight, weight_i, weight_j, weight_k, v;
-	int bytes_per_pixel, component_max, dimension, i, in_border, j, k,
-		max_i, max_j, max_k, n, number_of_bytes_per_component,
-		number_of_components, original_size[3], return_code, row_width_bytes,
-		size[3];
-	long int high_offset[3], low_offset[3], offset, offset_i, offset_j, offset_k,
-		v_i, x_i, y_i, z_i;
-	unsigned char *pixel_ptr;
-	unsigned short short_value;
+	const Texture *texture;
+	const unsigned char *image;
+	int numberOfComponents;
+	ZnReal componentMax;
+	/* bytes between adjacent texels in x, y and z */
+	long int stride[3];
+	/* texels interpolated over with the linear filter: the original size for
+		clamp modes, the stored size for repeat modes */
+	int filterSize[3];
+	int originalSize[3];
+	int storedSize[3];
+	double physicalSize[3];
+	/* factor converting coordinate to original texels with clamp modes */
+	ZnReal clampScale[3];
+	/* factor converting coordinate to fraction of stored texels with repeat modes */
+	ZnReal repeatScale[3];
+	int borderComponents;
+	ZnReal borderValues[4];
+
+	static inline ZnReal getComponent(const unsigned char *componentPtr, unsigned char)
+	{
+		return (ZnReal)(*componentPtr);
+	}
+
+	/** Reads a component in native byte order from a possibly unaligned address. */
+	static inline ZnReal getComponent(const unsigned char *componentPtr, unsigned short)
+	{
+		unsigned short value;
+		memcpy(&value, componentPtr, sizeof(unsigned short));
+		return (ZnReal)value;
+	}
+
+	/**
+	 * Converts coordinates relative to physical size to texel coordinates
+	 * according to the wrap mode, for the axes up to dimension.
+	 * @return  False if outside the texture in border clamp mode, otherwise true.
+	 */
+	template <enum Texture_wrap_mode wrapMode, int dimension>
+		inline bool wrapCoordinates(const ZnReal *coordinates, ZnReal *pos) const
+	{
+		bool inside = true;
+		for (int i = 0; i < dimension; ++i)
+		{
+			ZnReal v = coordinates[i];
+			switch (wrapMode)
+			{
+				/* SAB As far as I can tell we had actually implemented clamp_to_edge for
+					normal clamp, so it is the same. It also behaves differently to the
+					OpenGL implementation where it uses the original_sizes. */
+				case TEXTURE_CLAMP_WRAP:
+				case TEXTURE_CLAMP_EDGE_WRAP:
+				{
+					if ((v < 0.0) || (this->originalSize[i] <= 1))
+						v = 0.0;
+					else if (v > this->physicalSize[i])
+						v = this->originalSize[i];
+					else
+						v *= this->clampScale[i];
+				} break;
+				case TEXTURE_CLAMP_BORDER_WRAP:
+				{
+					/* Technically we should be merging to the border using the
+						current filter, so this is correct for nearest but the colour
+						should blend to the border colour 1/2 a pixel outside the texture
+						for linear. */
+					if ((v < 0.0) || (v > this->physicalSize[i]))
+					{
+						v = 0.0;
+						inside = false;
+					}
+					else if (this->originalSize[i] <= 1)
+						v = 0.0;
+					else
+						v *= this->clampScale[i];
+				} break;
+				case TEXTURE_REPEAT_WRAP:
+				{
+					/* make v range from 0.0 to 1.0 over full texture size */
+					if (this->originalSize[i] <= 1)
+						v = 0.0;
+					else
+					{
+						v *= this->repeatScale[i];
+						v -= floor(v);
+						v *= (ZnReal)(this->storedSize[i]);
+					}
+				} break;
+				case TEXTURE_MIRRORED_REPEAT_WRAP:
+				{
+					/* as for repeat, but reflected on alternate repeats */
+					if (this->originalSize[i] <= 1)
+						v = 0.0;
+					else
+					{
+						v *= this->repeatScale[i];
+						v -= 2.0*floor(0.5*v);
+						if (v > 1.0)
+							v = 2.0 - v;
+						v *= (ZnReal)(this->storedSize[i]);
+					}
+				} break;
+			}
+			pos[i] = v;
+		}
+		/* higher axes have a single texel, but are still bounded in border mode */
+		if (TEXTURE_CLAMP_BORDER_WRAP == wrapMode)
+		{
+			for (int i = dimension; i < 3; ++i)
+				if ((coordinates[i] < 0.0) || (coordinates[i] > this->physicalSize[i]))
+					inside = false;
+		}
+		return inside;
+	}
 
-	ENTER(Texture_get_pixel_values);
-	if (texture && values)
+	/**
+	 * Gets byte offsets of the low and high texels to interpolate between in
+	 * each dimension, and the local xi between them. Each texel applies
+	 * exactly at its centre; within half a texel of the edge the value is
+	 * constant for clamp modes or blends with the opposite edge for repeat.
+	 */
+	template <enum Texture_wrap_mode wrapMode, int dimension>
+		inline void getLinearOffsets(const ZnReal *pos,
+		long int *lowOffset, long int *highOffset, ZnReal *localXi) const
 	{
-		return_code = 1;
-		number_of_components =
-			Texture_storage_type_get_number_of_components(texture->storage);
-		number_of_bytes_per_component = texture->number_of_bytes_per_component;
-		bytes_per_pixel = number_of_components*number_of_bytes_per_component;
-		row_width_bytes=
-			((int)(texture->width_texels*bytes_per_pixel+3)/4)*4;
-
-		in_border = 0;
-		switch (texture->wrap_mode)
+		for (int i = 0; i < dimension; ++i)
 		{
-			/* SAB As far as I can tell we had actually implemented clamp_to_edge for
-				normal clamp, so it is the same. It also behaves differently to the
-			   OpenGL implementation where it uses the original_sizes.  Would be
-				able to simplify this if we allowed non-power-of-2 textures. */
-			case TEXTURE_CLAMP_WRAP:
-			case TEXTURE_CLAMP_EDGE_WRAP:
+			const ZnReal maxV = (ZnReal)this->filterSize[i] - 0.5;
+			const ZnReal v = pos[i];
+			if ((0.5 <= v) && (v < maxV))
 			{
-				if ((x < 0.0) || (texture->original_width_texels <= 1))
-					x = 0.0;
-				else if (x > texture->width)
-					x = texture->original_width_texels;
-				else
-					x *= ((ZnReal)texture->original_width_texels / texture->width);
-
-				if ((y < 0.0) || (texture->original_height_texels <= 1))
-					y = 0.0;
-				else if (y > texture->height)
-					y = texture->original_height_texels;
+				const long int vI = (long int)(v - 0.5);
+				localXi[i] = v - 0.5 - (ZnReal)vI;
+				lowOffset[i] = vI*this->stride[i];
+				highOffset[i] = (vI + 1)*this->stride[i];
+			}
+			else
+			{
+				lowOffset[i] = (long int)(this->filterSize[i] - 1)*this->stride[i];
+				highOffset[i] = 0;
+				if (TEXTURE_REPEAT_WRAP == wrapMode)
+					localXi[i] = (v < 0.5) ? (v + 0.5) : (v - maxV);
 				else
-					y *= ((ZnReal)texture->original_height_texels / texture->height);
+					localXi[i] = (v < 0.5) ? 1.0 : 0.0;
+			}
+		}
+	}
 
-				if ((z < 0.0) || (texture->original_depth_texels <= 1))
-					z = 0.0;
-				else if (z > texture->depth)
-					z = texture->original_depth_texels;
-				else
-					z *= ((ZnReal)texture->original_depth_texels / texture->depth);
+public:
+
+	TextureSampler(const Texture *textureIn) :
+		texture(textureIn),
+		image(textureIn->image),
+		numberOfComponents(Texture_storage_type_get_number_of_components(textureIn->storage)),
+		componentMax((2 == textureIn->number_of_bytes_per_component) ? 65535.0 : 255.0),
+		borderComponents(0)
+	{
+		const int bytesPerPixel = this->numberOfComponents*textureIn->number_of_bytes_per_component;
+		const long int rowWidthBytes = ((long int)(textureIn->width_texels*bytesPerPixel + 3)/4)*4;
+		this->stride[0] = bytesPerPixel;
+		this->stride[1] = rowWidthBytes;
+		this->stride[2] = rowWidthBytes*(long int)textureIn->height_texels;
+		this->originalSize[0] = textureIn->original_width_texels;
+		this->originalSize[1] = textureIn->original_height_texels;
+		this->originalSize[2] = textureIn->original_depth_texels;
+		this->storedSize[0] = textureIn->width_texels;
+		this->storedSize[1] = textureIn->height_texels;
+		this->storedSize[2] = textureIn->depth_texels;
+		this->physicalSize[0] = textureIn->width;
+		this->physicalSize[1] = textureIn->height;
+		this->physicalSize[2] = textureIn->depth;
+		const bool clampMode = (TEXTURE_CLAMP_WRAP == textureIn->wrap_mode) ||
+			(TEXTURE_CLAMP_EDGE_WRAP == textureIn->wrap_mode) ||
+			(TEXTURE_CLAMP_BORDER_WRAP == textureIn->wrap_mode);
+		for (int i = 0; i < 3; ++i)
+		{
+			this->filterSize[i] = clampMode ? this->originalSize[i] : this->storedSize[i];
+			this->clampScale[i] = (ZnReal)this->originalSize[i] / this->physicalSize[i];
+			this->repeatScale[i] = ((ZnReal)this->originalSize[i] /
+				(ZnReal)this->storedSize[i]) / this->physicalSize[i];
+		}
+		switch (textureIn->storage)
+		{
+			case TEXTURE_LUMINANCE:
+			{
+				/* Just use the red colour to be efficient */
+				this->borderComponents = 1;
+				this->borderValues[0] = (textureIn->combine_colour).red;
 			} break;
-			case TEXTURE_CLAMP_BORDER_WRAP:
+			case TEXTURE_LUMINANCE_ALPHA:
 			{
-				/* Technically we should be merging to the border using the
-					current filter, so this is correct for nearest but the colour
-					should blend to the border colour 1/2 a pixel outside the texture
-					for linear.  We are also doing clamp to edge for the values inside
-					the texture range rather than blending to the border colour. */
-				if ((x < 0)||(x > texture->width))
-				{
-					x = 0.0;
-					in_border = 1;
-				}
-				else if (texture->original_width_texels <= 1)
-					x = 0.0;
-				else
-					x *= ((double)texture->original_width_texels / texture->width);
-
-				if ((y < 0)||(y > texture->height))
-				{
-					y = 0.0;
-					in_border = 1;
-				}
-				else if (texture->original_height_texels <= 1)
-					y = 0.0;
-				else
-					y *= ((double)texture->original_height_texels / texture->height);
-
-				if ((z < 0)||(z > texture->depth))
-				{
-					z = 0.0;
-					in_border = 1;
-				}
-				else if (texture->original_depth_texels <= 1)
-					z = 0.0;
-				else
-					z *= ((double)texture->original_depth_texels / texture->depth);
+				this->borderComponents = 2;
+				this->borderValues[0] = (textureIn->combine_colour).red;
+				this->borderValues[1] = textureIn->combine_alpha;
 			} break;
-			case TEXTURE_REPEAT_WRAP:
+			case TEXTURE_RGB:
+			case TEXTURE_RGBA:
 			{
-				/* make x, y and z range from 0.0 to 1.0 over full texture size */
-				if (texture->original_width_texels <= 1)
-					x = 0.0;
-				else
-				{
-					x *= ((double)texture->original_width_texels /
-						(double)texture->width_texels) / texture->width;
-					x -= floor(x);
-					x *= (double)(texture->width_texels);
-				}
-
-				if (texture->original_height_texels <= 1)
-					y = 0.0;
-				else
-				{
-					y *= ((double)texture->original_height_texels /
-						(double)texture->height_texels) / texture->height;
-					y -= floor(y);
-					y *= (double)(texture->height_texels);
-				}
-
-				if (texture->original_depth_texels <= 1)
-					z = 0.0;
-				else
-				{
-					z *= ((double)texture->original_depth_texels /
-						(double)texture->depth_texels) / texture->depth;
-					z -= floor(z);
-					z *= (double)(texture->depth_texels);
-				}
+				this->borderComponents = this->numberOfComponents;
+				this->borderValues[0] = (textureIn->combine_colour).red;
+				this->borderValues[1] = (textureIn->combine_colour).green;
+				this->borderValues[2] = (textureIn->combine_colour).blue;
+				this->borderValues[3] = textureIn->combine_alpha;
 			} break;
 			default:
 			{
-				display_message(ERROR_MESSAGE,
-					"Texture_get_pixel_values.  Unknown wrap type");
-				return_code = 0;
+				/* border not implemented for other storage types */
 			} break;
 		}
-		if (2 == number_of_bytes_per_component)
+	}
+
+	int getNumberOfComponents() const
+	{
+		return this->numberOfComponents;
+	}
+
+	/** @return  True if the texture can be sampled with this sampler. */
+	bool isValid() const
+	{
+		if (!this->image)
 		{
-			component_max = 65535;
+			display_message(ERROR_MESSAGE, "Texture_get_pixel_values_batch.  Texture has no image");
+			return false;
 		}
-		else
+		if ((this->numberOfComponents < 1) || (this->numberOfComponents > 4) ||
+			((1 != this->texture->number_of_bytes_per_component) &&
+				(2 != this->texture->number_of_bytes_per_component)))
 		{
-			component_max = 255;
+			display_message(ERROR_MESSAGE, "Texture_get_pixel_values_batch.  "
+				"Unsupported texture storage");
+			return false;
 		}
-		if (!in_border)
+		switch (this->texture->wrap_mode)
 		{
-			switch (texture->filter_mode)
+			case TEXTURE_CLAMP_WRAP:
+			case TEXTURE_CLAMP_EDGE_WRAP:
+			case TEXTURE_CLAMP_BORDER_WRAP:
+			case TEXTURE_REPEAT_WRAP:
+			case TEXTURE_MIRRORED_REPEAT_WRAP:
+				break;
+			default:
 			{
-				case TEXTURE_LINEAR_FILTER:
-				case TEXTURE_LINEAR_MIPMAP_NEAREST_FILTER:
-				case TEXTURE_LINEAR_MIPMAP_LINEAR_FILTER:
-				{
-					dimension = texture->dimension;
-					pos[0] = x;
-					pos[1] = y;
-					pos[2] = z;
-					size[0] = texture->width_texels;
-					size[1] = texture->height_texels;
-					size[2] = texture->depth_texels;
-					offset = bytes_per_pixel;
-					switch (texture->wrap_mode)
-					{
-						case TEXTURE_CLAMP_BORDER_WRAP:
-						/* We should handle this correctly as a border clamp, but lets do something anyway */
-						case TEXTURE_CLAMP_WRAP:
-						case TEXTURE_CLAMP_EDGE_WRAP:
-						{
-							/* note we clamp to the original size; not the power-of-2 */
-							original_size[0] = texture->original_width_texels;
-							original_size[1] = texture->original_height_texels;
-							original_size[2] = texture->original_depth_texels;
-							offset = bytes_per_pixel;
-							for (i = 0; i < dimension; i++)
-							{
-								max_v = (double)original_size[i] - 0.5;
-								v = pos[i];
-								if ((0.5 <= v) && (v < max_v))
-								{
-									v_i = (long int)(v - 0.5);
-									local_xi[i] = v - 0.5 - (double)v_i;
-									low_offset[i] = v_i*offset;
-									high_offset[i] = (v_i + 1)*offset;
-								}
-								else
-								{
-									/* I think this implements clamp to edge? */
-									low_offset[i] = (long int)(original_size[i] - 1)*offset;
-									high_offset[i] = 0;
-									if (v < 0.5)
-									{
-										local_xi[i] = 1.0;
-									}
-									else
-									{
-										local_xi[i] = 0.0;
-									}
-								}
-								if (i == 0)
-								{
-									offset = row_width_bytes;
-								}
-								else
-								{
-									offset *= (long int)size[i];
-								}
-							}
-						} break;
-						case TEXTURE_MIRRORED_REPEAT_WRAP:
-						/* We should handle this correctly as a mirror, but lets do something anyway */
-						case TEXTURE_REPEAT_WRAP:
-						{
-							for (i = 0; i < dimension; i++)
-							{
-								max_v = (double)size[i] - 0.5;
-								v = pos[i];
-								if ((0.5 <= v) && (v < max_v))
-								{
-									v_i = (long int)(v - 0.5);
-									local_xi[i] = v - 0.5 - (double)v_i;
-									low_offset[i] = v_i*offset;
-									high_offset[i] = (v_i + 1)*offset;
-								}
-								else
-								{
-									low_offset[i] = (long int)(size[i] - 1)*offset;
-									high_offset[i] = 0;
-									if (v < 0.5)
-									{
-										local_xi[i] = v + 0.5;
-									}
-									else
-									{
-										local_xi[i] = v - max_v;
-									}
-								}
-								if (i == 0)
-								{
-									offset = row_width_bytes;
-								}
-								else
-								{
-									offset *= (long int)size[i];
-								}
-							}
-						} break;
-					}
+				display_message(ERROR_MESSAGE,
+					"Texture_get_pixel_values_batch.  Unknown wrap type");
+				return false;
+			} break;
+		}
+		return true;
+	}
 
-					max_i = 2;
-					if (1 < dimension)
-					{
-						max_j = 2;
-					}
-					else
-					{
-						max_j = 1;
-					}
-					if (2 < dimension)
-					{
-						max_k = 2;
-					}
-					else
-					{
-						max_k = 1;
-					}
+	void displayBorderError() const
+	{
+		display_message(ERROR_MESSAGE,  "Texture_get_pixel_values_batch.  "
+			"Border code not implemented for texture storage.");
+	}
 
-					for (i = 0; i < number_of_components; i++)
-					{
-						values[i] = 0.0;
-					}
+	/**
+	 * Sets values to the border colour.
+	 * @return  True on success, false if not implemented for storage type.
+	 */
+	inline bool getBorderValues(ZnReal *values) const
+	{
+		if (0 == this->borderComponents)
+			return false;
+		for (int n = 0; n < this->borderComponents; ++n)
+			values[n] = this->borderValues[n];
+		return true;
+	}
 
-					for (k = 0; k < max_k; k++)
-					{
-						if (2 < dimension)
-						{
-							if (0 == k)
-							{
-								weight_k = (1.0 - local_xi[2]);
-								offset_k = low_offset[2];
-							}
-							else
-							{
-								weight_k = local_xi[2];
-								offset_k = high_offset[2];
-							}
-						}
-						else
-						{
-							weight_k = 1.0;
-							offset_k = 0;
-						}
-						for (j = 0; j < max_j; j++)
-						{
-							if (1 < dimension)
-							{
-								if (0 == j)
-								{
-									weight_j = weight_k*(1.0 - local_xi[1]);
-									offset_j = offset_k + low_offset[1];
-								}
-								else
-								{
-									weight_j = weight_k*local_xi[1];
-									offset_j = offset_k + high_offset[1];
-								}
-							}
-							else
-							{
-								weight_j = 1.0;
-								offset_j = 0;
-							}
-							for (i = 0; i < max_i; i++)
-							{
-								if (0 == i)
-								{
-									weight_i = weight_j*(1.0 - local_xi[0]);
-									offset_i = offset_j + low_offset[0];
-								}
-								else
-								{
-									weight_i = weight_j*local_xi[0];
-									offset_i = offset_j + high_offset[0];
-								}
-								pixel_ptr = texture->image + offset_i;
-								weight = weight_i / component_max;
-								for (n = 0; n < number_of_components; n++)
-								{
-									if (2 == number_of_bytes_per_component)
-									{
-#if (1234==BYTE_ORDER)
-										short_value =
-											(((unsigned short)(*(pixel_ptr + 1))) << 8) + (*pixel_ptr);
-#else /* (1234==BYTE_ORDER) */
-										short_value =
-											(((unsigned short)(*pixel_ptr)) << 8) + (*(pixel_ptr + 1));
-#endif /* (1234==BYTE_ORDER) */
-										values[n] += (double)short_value * weight;
-									}
-									else
-									{
-										values[n] += (double)(*pixel_ptr) * weight;
-									}
-									pixel_ptr += number_of_bytes_per_component;
-								}
-							}
-						}
-					}
-				} break;
-				case TEXTURE_NEAREST_FILTER:
-				case TEXTURE_NEAREST_MIPMAP_NEAREST_FILTER:
+	/** Samples nearest texel at each location; see Texture_get_pixel_values_batch. */
+	template <typename ComponentType, int numberOfComponents,
+		enum Texture_wrap_mode wrapMode, int dimension>
+		bool sampleNearest(int pointsCount, const ZnReal *coordinates, ZnReal *values) const
+	{
+		bool result = true;
+		ZnReal pos[3];
+		long int index[3];
+		for (int p = 0; p < pointsCount; ++p)
+		{
+			ZnReal *pointValues = values + p*numberOfComponents;
+			if (!this->wrapCoordinates<wrapMode, dimension>(coordinates + 3*p, pos))
+			{
+				if (!this->getBorderValues(pointValues))
+					result = false;
+				continue;
+			}
+			long int offset = 0;
+			for (int i = 0; i < dimension; ++i)
+			{
+				index[i] = (long int)pos[i];
+				/* fix problem of value being exactly on upper boundary */
+				if (index[i] >= this->filterSize[i])
+					index[i] = this->filterSize[i] - 1;
+				offset += index[i]*this->stride[i];
+			}
+			const unsigned char *texelPtr = this->image + offset;
+			for (int n = 0; n < numberOfComponents; ++n)
+				pointValues[n] = getComponent(texelPtr + n*sizeof(ComponentType), ComponentType()) /
+					this->componentMax;
+		}
+		if (!result)
+			this->displayBorderError();
+		return result;
+	}
+
+	/** Samples with linear, bilinear or trilinear interpolation; see Texture_get_pixel_values_batch. */
+	template <typename ComponentType, int numberOfComponents,
+		enum Texture_wrap_mode wrapMode, int dimension>
+		bool sampleLinear(int pointsCount, const ZnReal *coordinates, ZnReal *values) const
+	{
+		bool result = true;
+		ZnReal pos[3], localXi[3];
+		long int lowOffset[3], highOffset[3];
+		for (int p = 0; p < pointsCount; ++p)
+		{
+			ZnReal *pointValues = values + p*numberOfComponents;
+			if (!this->wrapCoordinates<wrapMode, dimension>(coordinates + 3*p, pos))
+			{
+				if (!this->getBorderValues(pointValues))
+					result = false;
+				continue;
+			}
+			this->getLinearOffsets<wrapMode, dimension>(pos, lowOffset, highOffset, localXi);
+			ZnReal sum[numberOfComponents];
+			for (int n = 0; n < numberOfComponents; ++n)
+				sum[n] = 0.0;
+			for (int k = 0; k < ((2 < dimension) ? 2 : 1); ++k)
+			{
+				ZnReal weightK = 1.0;
+				long int offsetK = 0;
+				if (2 < dimension)
+				{
+					weightK = (0 == k) ? (1.0 - localXi[2]) : localXi[2];
+					offsetK = (0 == k) ? lowOffset[2] : highOffset[2];
+				}
+				for (int j = 0; j < ((1 < dimension) ? 2 : 1); ++j)
 				{
-					x_i = (int)x;
-					y_i = (int)y;
-					z_i = (int)z;
-					if (TEXTURE_CLAMP_WRAP == texture->wrap_mode)
-					{
-						/* fix problem of value being exactly on upper boundary */
-						if (x_i == texture->original_width_texels)
-						{
-							x_i--;
-						}
-						if (y_i == texture->original_height_texels)
-						{
-							y_i--;
-						}
-						if (z_i == texture->original_depth_texels)
-						{
-							z_i--;
-						}
-					}
-					offset = (z_i*(long int)texture->height_texels + y_i)*(long int)row_width_bytes +
-						x_i*(long int)bytes_per_pixel;
-					pixel_ptr = texture->image + offset;
-					for (n = 0; n < number_of_components; n++)
+					ZnReal weightJ = 1.0;
+					long int offsetJ = 0;
+					if (1 < dimension)
 					{
-						if (2 == number_of_bytes_per_component)
-						{
-#if (1234==BYTE_ORDER)
-							short_value =
-								(((unsigned short)(*(pixel_ptr + 1))) << 8) + (*pixel_ptr);
-#else /* (1234==BYTE_ORDER) */
-							short_value =
-								(((unsigned short)(*pixel_ptr)) << 8) + (*(pixel_ptr + 1));
-#endif /* (1234==BYTE_ORDER) */
-							values[n] = (double)short_value / component_max;
-						}
-						else
-						{
-							values[n] = (double)(*pixel_ptr) / component_max;
-						}
-						pixel_ptr += number_of_bytes_per_component;
+						weightJ = weightK*((0 == j) ? (1.0 - localXi[1]) : localXi[1]);
+						offsetJ = offsetK + ((0 == j) ? lowOffset[1] : highOffset[1]);
 					}
-				} break;
-				default:
-				{
-					display_message(ERROR_MESSAGE,
-						"Texture_get_pixel_values.  Unknown filter type");
-					return_code = 0;
+					const ZnReal weightLow = weightJ*(1.0 - localXi[0]) / this->componentMax;
+					const ZnReal weightHigh = weightJ*localXi[0] / this->componentMax;
+					const unsigned char *lowPtr = this->image + offsetJ + lowOffset[0];
+					const unsigned char *highPtr = this->image + offsetJ + highOffset[0];
+					for (int n = 0; n < numberOfComponents; ++n)
+						sum[n] += getComponent(lowPtr + n*sizeof(ComponentType), ComponentType())*weightLow;
+					for (int n = 0; n < numberOfComponents; ++n)
+						sum[n] += getComponent(highPtr + n*sizeof(ComponentType), ComponentType())*weightHigh;
 				}
 			}
+			for (int n = 0; n < numberOfComponents; ++n)
+				pointValues[n] = sum[n];
 		}
-		else
+		if (!result)
+			this->displayBorderError();
+		return result;
+	}
+
+};
+
+template <typename ComponentType, int numberOfComponents, enum Texture_wrap_mode wrapMode>
+bool Texture_sample_batch(const TextureSampler& sampler, enum Texture_filter_mode filter_mode,
+	int dimension, int number_of_points, const ZnReal *texture_coordinates, ZnReal *values)
+{
+	switch (filter_mode)
+	{
+		case TEXTURE_LINEAR_FILTER:
+		case TEXTURE_LINEAR_MIPMAP_NEAREST_FILTER:
+		case TEXTURE_LINEAR_MIPMAP_LINEAR_FILTER:
 		{
-			/* Use border colour */
-			switch (texture->storage)
-			{
-				case TEXTURE_LUMINANCE:
-				{
-					/* Just use the red colour to be efficient */
-					values[0] = (texture->combine_colour).red;
-				} break;
-				case TEXTURE_LUMINANCE_ALPHA:
-				{
-					values[0] = (texture->combine_colour).red;
-					values[1] = texture->combine_alpha;
-				} break;
-				case TEXTURE_RGB:
-				{
-					values[0] = (texture->combine_colour).red;
-					values[1] = (texture->combine_colour).green;
-					values[2] = (texture->combine_colour).blue;
-				} break;
-				case TEXTURE_RGBA:
-				{
-					values[0] = (texture->combine_colour).red;
-					values[1] = (texture->combine_colour).green;
-					values[2] = (texture->combine_colour).blue;
-					values[3] = texture->combine_alpha;
-				} break;
-				default:
-				{
-					display_message(ERROR_MESSAGE,  "Texture_get_pixel_values.  "
-						"Border code not implemented for texture storage.");
-					return_code = 0;
-				} break;
-			}
+			if (3 == dimension)
+				return sampler.sampleLinear<ComponentType, numberOfComponents, wrapMode, 3>(
+					number_of_points, texture_coordinates, values);
+			if (2 == dimension)
+				return sampler.sampleLinear<ComponentType, numberOfComponents, wrapMode, 2>(
+					number_of_points, texture_coordinates, values);
+			return sampler.sampleLinear<ComponentType, numberOfComponents, wrapMode, 1>(
+				number_of_points, texture_coordinates, values);
+		}
+		case TEXTURE_NEAREST_FILTER:
+		case TEXTURE_NEAREST_MIPMAP_NEAREST_FILTER:
+		{
+			if (3 == dimension)
+				return sampler.sampleNearest<ComponentType, numberOfComponents, wrapMode, 3>(
+					number_of_points, texture_coordinates, values);
+			if (2 == dimension)
+				return sampler.sampleNearest<ComponentType, numberOfComponents, wrapMode, 2>(
+					number_of_points, texture_coordinates, values);
+			return sampler.sampleNearest<ComponentType, numberOfComponents, wrapMode, 1>(
+				number_of_points, texture_coordinates, values);
 		}
+		default:
+			break;
 	}
-	else
+	display_message(ERROR_MESSAGE,
+		"Texture_get_pixel_values_batch.  Unknown filter type");
+	return false;
+}
+
+template <typename ComponentType, int numberOfComponents>
+bool Texture_sample_batch(const TextureSampler& sampler, enum Texture_filter_mode filter_mode,
+	enum Texture_wrap_mode wrap_mode, int dimension, int number_of_points,
+	const ZnReal *texture_coordinates, ZnReal *values)
+{
+	switch (wrap_mode)
 	{
-		display_message(ERROR_MESSAGE,
-			"Texture_get_pixel_values.  Invalid arguments");
-		return_code = 0;
+		/* clamp is implemented as clamp to edge */
+		case TEXTURE_CLAMP_WRAP:
+		case TEXTURE_CLAMP_EDGE_WRAP:
+			return Texture_sample_batch<ComponentType, numberOfComponents, TEXTURE_CLAMP_EDGE_WRAP>(
+				sampler, filter_mode, dimension, number_of_points, texture_coordinates, values);
+		case TEXTURE_CLAMP_BORDER_WRAP:
+			return Texture_sample_batch<ComponentType, numberOfComponents, TEXTURE_CLAMP_BORDER_WRAP>(
+				sampler, filter_mode, dimension, number_of_points, texture_coordinates, values);
+		case TEXTURE_REPEAT_WRAP:
+			return Texture_sample_batch<ComponentType, numberOfComponents, TEXTURE_REPEAT_WRAP>(
+				sampler, filter_mode, dimension, number_of_points, texture_coordinates, values);
+		case TEXTURE_MIRRORED_REPEAT_WRAP:
+			return Texture_sample_batch<ComponentType, numberOfComponents, TEXTURE_MIRRORED_REPEAT_WRAP>(
+				sampler, filter_mode, dimension, number_of_points, texture_coordinates, values);
+		default:
+			break;
 	}
-	LEAVE;
+	display_message(ERROR_MESSAGE,
+		"Texture_get_pixel_values_batch.  Unknown wrap type");
+	return false;
+}
 
-	return (return_code);
+template <typename ComponentType>
+bool Texture_sample_batch(const TextureSampler& sampler, enum Texture_filter_mode filter_mode,
+	enum Texture_wrap_mode wrap_mode, int dimension, int number_of_points,
+	const ZnReal *texture_coordinates, ZnReal *values)
+{
+	switch (sampler.getNumberOfComponents())
+	{
+		case 1:
+			return Texture_sample_batch<ComponentType, 1>(sampler, filter_mode, wrap_mode, dimension,
+				number_of_points, texture_coordinates, values);
+		case 2:
+			return Texture_sample_batch<ComponentType, 2>(sampler, filter_mode, wrap_mode, dimension,
+				number_of_points, texture_coordinates, values);
+		case 3:
+			return Texture_sample_batch<ComponentType, 3>(sampler, filter_mode, wrap_mode, dimension,
+				number_of_points, texture_coordinates, values);
+		case 4:
+			return Texture_sample_batch<ComponentType, 4>(sampler, filter_mode, wrap_mode, dimension,
+				number_of_points, texture_coordinates, values);
+		default:
+			break;
+	}
+	return false;
+}
+
+} // anonymous namespace
+
+int Texture_get_pixel_values_batch(struct Texture *texture,
+	int number_of_points, const ZnReal *texture_coordinates, ZnReal *values)
+{
+	if (!((texture) && (0 <= number_of_points) &&
+		((0 == number_of_points) || ((texture_coordinates) && (values)))))
+	{
+		display_message(ERROR_MESSAGE,
+			"Texture_get_pixel_values_batch.  Invalid arguments");
+		return 0;
+	}
+	if (0 == number_of_points)
+		return 1;
+	TextureSampler sampler(texture);
+	if (!sampler.isValid())
+		return 0;
+	bool result;
+	if (2 == texture->number_of_bytes_per_component)
+		result = Texture_sample_batch<unsigned short>(sampler, texture->filter_mode,
+			texture->wrap_mode, texture->dimension, number_of_points, texture_coordinates, values);
+	else
+		result = Texture_sample_batch<unsigned char>(sampler, texture->filter_mode,
+			texture->wrap_mode, texture->dimension, number_of_points, texture_coordinates, values);
+	return (result) ? 1 : 0;
+}
+
+int Texture_get_pixel_values(struct Texture *texture,
+	ZnReal x, ZnReal y, ZnReal z, ZnReal *values)
+/*******************************************************************************
+LAST MODIFIED : 18 October 2026
+
+DESCRIPTION :
+Returns the byte values in the texture using the texture coordinates relative
+to the physical size.  Each texel is assumed to apply exactly
+at its centre and the filter_mode used to determine whether the pixels are
+interpolated or not.  When closer than half a texel to a boundary the colour
+is constant from the half texel location to the edge.
+==============================================================================*/
+{
+	ZnReal texture_coordinates[3];
+
+	texture_coordinates[0] = x;
+	texture_coordinates[1] = y;
+	texture_coordinates[2] = z;
+	return Texture_get_pixel_values_batch(texture, 1, texture_coordinates, values);
 } /* Texture_get_pixel_values */
 
 char *Texture_get_image_file_name(struct Texture *texture)
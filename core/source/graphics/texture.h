@@ -488,7 +488,20 @@ Returns the byte values in the texture using the texture coordinates relative
 to the physical size.  Each texel is assumed to apply exactly
 at its centre and the filter_mode used to determine whether the pixels are
 interpolated or not.  When closer than half a texel to a boundary the colour 
-is constant from the half texel location to the edge. 
+is constant from the half texel location to the edge.
+==============================================================================*/
+
+int Texture_get_pixel_values_batch(struct Texture *texture,
+	int number_of_points, const double *texture_coordinates, double *values);
+/*******************************************************************************
+LAST MODIFIED : 18 October 2026
+
+DESCRIPTION :
+Samples the texture at <number_of_points> locations as for
+Texture_get_pixel_values, with the wrap and filter setup done once and
+filtering specialised for the texel type and number of components.
+<texture_coordinates> holds x, y, z for each point, consecutively.
+<values> receives the texture's number of components values per point.
 ==============================================================================*/
 
 char *Texture_get_image_file_name(struct Texture *texture);
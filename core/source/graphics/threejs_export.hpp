@@ -9,6 +9,9 @@
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#if !defined (THREEJS_EXPORT_HPP)
+#define THREEJS_EXPORT_HPP
+
 #include "general/mystring.h"
 #include "graphics/graphics_library.h"
 #include "graphics/render_gl.h"
@@ -18,7 +21,7 @@ struct GT_object;
 
 class Threejs_export
 {
-private:
+protected:
 	char *filename;
 	int number_of_time_steps;
 	cmzn_streaminformation_scene_io_data_type mode;
@@ -29,6 +32,7 @@ private:
 	std::string colorsMorphString;
 	std::string outputString;
 
+private:
 	void writeVertexBuffer(const char *output_variable_name,
 		GLfloat *vertex_buffer, unsigned int values_per_vertex,
 		unsigned int vertex_count);
@@ -67,14 +71,16 @@ public:
 		outputString.clear();
 	}
 
-	~Threejs_export();
+	virtual ~Threejs_export();
 
-	int exportGraphicsObject(struct GT_object *object, int time_step);
+	virtual int exportGraphicsObject(struct GT_object *object, int time_step);
 
-	int beginExport();
+	virtual int beginExport();
 
-	int endExport();
+	virtual int endExport();
 
 	std::string *getExportString();
 
 };
+
+#endif /* !defined (THREEJS_EXPORT_HPP) */
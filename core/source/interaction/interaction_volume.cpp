@@ -194,13 +194,13 @@ It must therefore be transposed to be used by OpenGL.
 				interaction_volume->projection_matrix[10] =
 					2.0 / interaction_volume->data.centred_box.size_z;
 				/* re-centre */
-				interaction_volume->projection_matrix[4] =
+				interaction_volume->projection_matrix[3] =
 					-2.0*interaction_volume->data.centred_box.centre_x /
 					interaction_volume->data.centred_box.size_x;
-				interaction_volume->projection_matrix[8] =
+				interaction_volume->projection_matrix[7] =
 					-2.0*interaction_volume->data.centred_box.centre_y /
 					interaction_volume->data.centred_box.size_y;
-				interaction_volume->projection_matrix[12] =
+				interaction_volume->projection_matrix[11] =
 					-2.0*interaction_volume->data.centred_box.centre_z /
 					interaction_volume->data.centred_box.size_z;
 				interaction_volume->projection_matrix_calculated=1;
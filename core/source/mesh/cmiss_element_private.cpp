@@ -1353,8 +1353,13 @@ cmzn_mesh_scale_factor_set_id cmzn_mesh_create_mesh_scale_factor_set(
 cmzn_differentialoperator_id cmzn_mesh_get_chart_differentialoperator(
 	cmzn_mesh_id mesh, int order, int term)
 {
-	if (mesh && (1 == order) && (1 <= term) && (term <= mesh->getDimension()))
-		return new cmzn_differentialoperator(mesh->get_FE_mesh()->get_FE_region(), mesh->getDimension(), term);
+	if (mesh && (1 <= order) && (order <= 2) && (1 <= term))
+	{
+		const int dimension = mesh->getDimension();
+		const int termCount = (1 == order) ? dimension : dimension*dimension;
+		if (term <= termCount)
+			return new cmzn_differentialoperator(mesh->get_FE_mesh()->get_FE_region(), dimension, order, term);
+	}
 	return 0;
 }
 
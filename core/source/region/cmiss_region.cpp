@@ -19,7 +19,9 @@
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/field_cache.hpp"
 #include "computed_field/field_module.hpp"
+#include "computed_field/field_profiler.hpp"
 #include "computed_field/computed_field_finite_element.h"
+#include "computed_field/computed_field_subobject_group.hpp"
 #include "context/context.h"
 #include "general/callback_private.h"
 #include "general/debug.h"
@@ -31,6 +33,7 @@
 #include "finite_element/finite_element_region_private.h"
 #include "general/message.h"
 #include <algorithm>
+#include <climits>
 #include <list>
 #include <vector>
 
@@ -68,6 +71,9 @@ struct cmzn_region
 	// all field caches currently in use for this region, for clearing
 	// when fields changed, and adding value caches for new fields.
 	std::list<cmzn_fieldcache_id> *field_caches;
+	// records field evaluations if profiling; kept when disabled for querying
+	FieldProfiler *field_profiler;
+	bool field_profiling_enabled;
 
 	/* list of objects attached to region */
 	struct LIST(Any_object) *any_object_list;
@@ -341,6 +347,8 @@ cmzn_region *cmzn_region_create_internal(cmzn_region *base_region)
 		FE_region_set_cmzn_region_private(region->fe_region, region);
 		region->field_cache_size = 0;
 		region->field_caches = new std::list<cmzn_fieldcache_id>();
+		region->field_profiler = 0;
+		region->field_profiling_enabled = false;
 		region->access_count = 1;
 		if (!(region->any_object_list && region->change_callback_list &&
 			region->field_manager && region->field_manager_callback_id &&
@@ -429,6 +437,7 @@ int DESTROY(cmzn_region)(struct cmzn_region **region_address)
 			}
 
 			delete region->field_caches;
+			delete region->field_profiler;
 			DESTROY(LIST(Any_object))(&(region->any_object_list));
 
 			cmzn_region_detach_fields(region);
@@ -505,6 +514,8 @@ int cmzn_region_add_field_private(cmzn_region_id region, cmzn_field_id field)
 				++i;
 			}
 			cmzn_field_set_cache_index_private(field, cache_index);
+			if (region->field_profiler)
+				region->field_profiler->clearRecord(cache_index);
 			return 1;
 		}
 	}
@@ -639,6 +650,13 @@ void cmzn_region_remove_field_cache(cmzn_region_id region,
 		region->field_caches->remove(cache);
 }
 
+FieldProfiler *cmzn_region_get_field_profiler(cmzn_region_id region)
+{
+	if ((region) && (region->field_profiling_enabled))
+		return region->field_profiler;
+	return 0;
+}
+
 int cmzn_fieldmodule_begin_change(cmzn_fieldmodule_id field_module)
 {
 	return cmzn_region_fields_begin_change(cmzn_fieldmodule_get_region_internal(field_module));
@@ -655,6 +673,93 @@ int cmzn_fieldmodule_define_all_faces(cmzn_fieldmodule_id field_module)
 		cmzn_fieldmodule_get_region_internal(field_module)));
 }
 
+bool cmzn_fieldmodule_is_profiling_enabled(cmzn_fieldmodule_id field_module)
+{
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	if (region)
+		return region->field_profiling_enabled;
+	return false;
+}
+
+int cmzn_fieldmodule_set_profiling_enabled(cmzn_fieldmodule_id field_module,
+	bool enabled)
+{
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	if (!region)
+		return CMZN_ERROR_ARGUMENT;
+	if (enabled != region->field_profiling_enabled)
+	{
+		if (enabled && (!region->field_profiler))
+			region->field_profiler = new FieldProfiler();
+		region->field_profiling_enabled = enabled;
+		FieldProfiler *profiler = enabled ? region->field_profiler : 0;
+		for (std::list<cmzn_fieldcache_id>::iterator iter = region->field_caches->begin();
+			iter != region->field_caches->end(); ++iter)
+		{
+			(*iter)->setProfiler(profiler);
+		}
+	}
+	return CMZN_OK;
+}
+
+int cmzn_fieldmodule_reset_profiling(cmzn_fieldmodule_id field_module)
+{
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	if (!region)
+		return CMZN_ERROR_ARGUMENT;
+	if (region->field_profiler)
+		region->field_profiler->reset();
+	return CMZN_OK;
+}
+
+namespace {
+
+/** Clamp count to fit API int. */
+inline int FieldProfiler_count_to_int(unsigned long long count)
+{
+	return (count > static_cast<unsigned long long>(INT_MAX)) ? INT_MAX : static_cast<int>(count);
+}
+
+}
+
+int cmzn_fieldmodule_get_field_profile(cmzn_fieldmodule_id field_module,
+	cmzn_field_id field, int *cache_hits_out, int *cache_misses_out,
+	double *inclusive_time_out, double *exclusive_time_out)
+{
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	if (!((region) && (field) && (Computed_field_get_region(field) == region)))
+	{
+		display_message(ERROR_MESSAGE, "Fieldmodule getFieldProfile.  Invalid argument(s)");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const FieldProfiler::Record *record = (region->field_profiler) ?
+		region->field_profiler->getRecord(cmzn_field_get_cache_index_private(field)) : 0;
+	const FieldProfiler::Record noRecord;
+	if (!record)
+		record = &noRecord;
+	if (cache_hits_out)
+		*cache_hits_out = FieldProfiler_count_to_int(record->cacheHits);
+	if (cache_misses_out)
+		*cache_misses_out = FieldProfiler_count_to_int(record->cacheMisses);
+	if (inclusive_time_out)
+		*inclusive_time_out = record->inclusiveTime;
+	if (exclusive_time_out)
+		*exclusive_time_out = record->exclusiveTime;
+	return CMZN_OK;
+}
+
+char *cmzn_fieldmodule_get_profile_report(cmzn_fieldmodule_id field_module)
+{
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	if (!region)
+		return 0;
+	const cmzn_set_cmzn_field& fieldSet = Computed_field_manager_get_fields(region->field_manager);
+	std::vector<Computed_field *> fields(fieldSet.begin(), fieldSet.end());
+	const FieldProfiler emptyProfiler;
+	const FieldProfiler& profiler = (region->field_profiler) ? *(region->field_profiler) : emptyProfiler;
+	return profiler.getReport(static_cast<int>(fields.size()), fields.data());
+}
+
 int cmzn_region_begin_change(struct cmzn_region *region)
 {
 	if (region)
@@ -1531,9 +1636,13 @@ bool cmzn_region_can_merge(cmzn_region_id target_region, cmzn_region_id source_r
 	return true;
 }
 
-/** currently just merges group fields */
+/**
+ * Currently just merges group fields.
+ * @param adopted  True if target FE_region adopted the contents of source
+ * FE_region, so element groups are transferred by index.
+ */
 static int cmzn_region_merge_fields(cmzn_region_id target_region,
-	cmzn_region_id source_region)
+	cmzn_region_id source_region, bool adopted)
 {
 	int return_code = 1;
 	cmzn_fieldmodule_id target_field_module = cmzn_region_get_fieldmodule(target_region);
@@ -1621,6 +1730,13 @@ static int cmzn_region_merge_fields(cmzn_region_id target_region,
 						}
 						cmzn_mesh_group_id target_mesh_group = cmzn_field_element_group_get_mesh_group(target_element_group);
 
+						if (adopted)
+						{
+							// source elements now belong to target mesh with the same indexes
+							if (CMZN_OK != Computed_field_element_group_core_cast(target_element_group)->adoptElements(
+								*Computed_field_element_group_core_cast(source_element_group)))
+								return_code = 0;
+						}
 						cmzn_elementiterator_id element_iter = cmzn_mesh_create_elementiterator(cmzn_mesh_group_base_cast(source_mesh_group));
 						cmzn_element_id source_element = 0;
 						while ((source_element = cmzn_elementiterator_next_non_access(element_iter)) && return_code)
@@ -1670,6 +1786,7 @@ static int cmzn_region_merge_private(cmzn_region_id target_region,
 	// merge FE_region
 	FE_region *target_fe_region = cmzn_region_get_FE_region(target_region);
 	FE_region *source_fe_region = cmzn_region_get_FE_region(source_region);
+	const bool adopted = FE_region_can_adopt(target_fe_region, source_fe_region);
 	if (!FE_region_merge(target_fe_region, source_fe_region))
 	{
 		char *target_path = cmzn_region_get_path(target_region);
@@ -1681,7 +1798,7 @@ static int cmzn_region_merge_private(cmzn_region_id target_region,
 		return_code = 0;
 	}
 
-	if (!cmzn_region_merge_fields(target_region, source_region))
+	if (!cmzn_region_merge_fields(target_region, source_region, adopted))
 	{
 		return_code = 0;
 	}
@@ -36,6 +36,7 @@ Global types
 struct cmzn_context;
 
 struct cmzn_region;
+class FieldProfiler;
 /*******************************************************************************
 LAST MODIFIED : 30 September 2002
 
@@ -124,6 +125,12 @@ void cmzn_region_add_field_cache(cmzn_region_id region, cmzn_fieldcache_id cache
 void cmzn_region_remove_field_cache(cmzn_region_id region,
 	cmzn_fieldcache_id cache);
 
+/**
+ * @return  Profiler new field caches record evaluations of fields in region
+ * with, or 0 if profiling is not enabled.
+ */
+FieldProfiler *cmzn_region_get_field_profiler(cmzn_region_id region);
+
 int cmzn_region_add_callback(struct cmzn_region *region,
 	CMZN_CALLBACK_FUNCTION(cmzn_region_change) *function, void *user_data);
 /*******************************************************************************
@@ -10,6 +10,13 @@
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
 #include "opencmiss/zinc/streamregion.h"
 #include "opencmiss/zinc/streamregion.h"
 #include "field_io/fieldml_common.hpp"
@@ -24,13 +31,16 @@
 
 namespace {
 
+/**
+ * Read region data from memory buffer.
+ * @param block_name  Name of memory block, appears in error location strings.
+ */
 int cmzn_region_read_from_memory(struct cmzn_region *region, const void *memory_buffer,
 	const unsigned int memory_buffer_size, struct FE_import_time_index *time_index, int useData,
 	enum cmzn_streaminformation_data_compression_type data_compression_type,
-	cmzn_streaminformation_region_file_format fileFormatIn)
+	cmzn_streaminformation_region_file_format fileFormatIn, const char *block_name = "dataBlock")
 {
-	const char block_name[] = "dataBlock";
-	const char block_name_uri[] = "memory:dataBlock";
+	const std::string block_name_uri = std::string("memory:") + block_name;
 	int return_code;
 	struct IO_stream_package *io_stream_package;
 	struct IO_stream *input_stream;
@@ -49,15 +59,17 @@ int cmzn_region_read_from_memory(struct cmzn_region *region, const void *memory_
 		switch (fileFormat)
 		{
 			case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
+			case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY:
 				display_message(WARNING_MESSAGE, "cmzn_region_read.  Cannot read FieldML from memory resource");
 				break;
 			case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
+			case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY:
 			{
 				// We should add a way to define a memory block without requiring specifying a name.
 				IO_stream_package_define_memory_block(io_stream_package,
 					block_name, memory_buffer, memory_buffer_size);
 				input_stream = CREATE(IO_stream)(io_stream_package);
-				IO_stream_open_for_read_compression_specified(input_stream, block_name_uri,
+				IO_stream_open_for_read_compression_specified(input_stream, block_name_uri.c_str(),
 					data_compression_type);
 				if (!useData)
 				{
@@ -100,11 +112,13 @@ int cmzn_region_read_field_file_of_name(struct cmzn_region *region, const char *
 	switch (fileFormat)
 	{
 		case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
+		case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY:
 			if (time_index)
 				display_message(WARNING_MESSAGE, "cmzn_region_read.  Time not supported by FieldML reader");
 			return_code = parse_fieldml_file(region, file_name) ? CMZN_OK : CMZN_ERROR_GENERAL;
 			break;
 		case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
+		case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY:
 			return_code = read_exregion_file_of_name(region, file_name, io_stream_package, time_index,
 				useData, data_compression_type) ? CMZN_OK : CMZN_ERROR_GENERAL;
 			break;
@@ -116,6 +130,115 @@ int cmzn_region_read_field_file_of_name(struct cmzn_region *region, const char *
 	return return_code;
 }
 
+/** Raw contents of a file resource read ahead of parsing by a worker thread. */
+struct Prefetched_file
+{
+	std::vector<char> data;
+	bool valid;
+
+	Prefetched_file() :
+		valid(false)
+	{
+	}
+
+	/** @return  True if data starts with the gzip magic bytes. */
+	bool hasGzipHeader() const
+	{
+		return (this->data.size() >= 2) &&
+			(static_cast<unsigned char>(this->data[0]) == 0x1f) &&
+			(static_cast<unsigned char>(this->data[1]) == 0x8b);
+	}
+};
+
+/**
+ * Read the whole of file into memory without interpretation. Runs on a
+ * worker thread so must not touch regions, fields or the message system.
+ * Decompression is left to the memory stream during parsing.
+ */
+Prefetched_file prefetch_file(const std::string& file_name)
+{
+	Prefetched_file prefetched_file;
+	FILE *file = fopen(file_name.c_str(), "rb");
+	if (file)
+	{
+		if (0 == fseek(file, 0, SEEK_END))
+		{
+			const long size = ftell(file);
+			// memory stream sizes are unsigned int; empty files use normal read
+			if ((size > 0) && (static_cast<unsigned long>(size) <= UINT_MAX) &&
+				(0 == fseek(file, 0, SEEK_SET)))
+			{
+				prefetched_file.data.resize(static_cast<size_t>(size));
+				prefetched_file.valid = (fread(&(prefetched_file.data[0]), 1,
+					prefetched_file.data.size(), file) == prefetched_file.data.size());
+				if (!prefetched_file.valid)
+					prefetched_file.data.clear();
+			}
+		}
+		fclose(file);
+	}
+	return prefetched_file;
+}
+
+/**
+ * Reads file resources ahead of the thread parsing them, up to a limited
+ * number at a time, so file I/O for later resources overlaps parsing of
+ * earlier ones. Parsing itself is not thread safe as it modifies regions and
+ * shared bases/shapes, so results are consumed in resource order on the
+ * calling thread.
+ */
+class Region_read_prefetcher
+{
+	std::vector<std::string> file_names; // empty for non-file resources
+	std::vector<std::future<Prefetched_file> > futures;
+	size_t next_index;
+	size_t limit;
+
+public:
+
+	Region_read_prefetcher(const std::vector<std::string>& file_names_in) :
+		file_names(file_names_in),
+		futures(file_names_in.size()),
+		next_index(0)
+	{
+		const unsigned int number_of_threads = std::thread::hardware_concurrency();
+		this->limit = (number_of_threads > 2) ? number_of_threads : 2;
+	}
+
+	/** Start reading files for resources up to limit after resource index */
+	void prefetchFrom(size_t index)
+	{
+		if (this->next_index < index)
+			this->next_index = index;
+		const size_t end_index = std::min(index + this->limit, this->file_names.size());
+		for (; this->next_index < end_index; ++this->next_index)
+		{
+			if (!this->file_names[this->next_index].empty())
+			{
+				try
+				{
+					this->futures[this->next_index] = std::async(std::launch::async,
+						prefetch_file, this->file_names[this->next_index]);
+				}
+				catch (...)
+				{
+					// could not start thread: resource is read normally
+				}
+			}
+		}
+	}
+
+	/** Get prefetched file for resource index, blocking until ready.
+	 * Returned file is invalid if it was not or could not be prefetched. */
+	Prefetched_file take(size_t index)
+	{
+		this->prefetchFrom(index + 1);
+		if ((index < this->futures.size()) && this->futures[index].valid())
+			return this->futures[index].get();
+		return Prefetched_file();
+	}
+};
+
 }
 
 int cmzn_region_read(cmzn_region_id region,
@@ -146,7 +269,35 @@ int cmzn_region_read(cmzn_region_id region,
 					streaminformation_region, CMZN_STREAMINFORMATION_REGION_ATTRIBUTE_TIME);
 				time_index = &time_index_value;
 			}
-			for (iter = streams_list.begin(); (iter != streams_list.end()) && (return_code == CMZN_OK); ++iter)
+			const cmzn_streaminformation_region_file_format fileFormat =
+				cmzn_streaminformation_region_get_file_format(streaminformation_region);
+			// prefetch file resources unless known to be FieldML, which must be read from file
+			std::vector<std::string> prefetch_file_names;
+			for (iter = streams_list.begin(); iter != streams_list.end(); ++iter)
+			{
+				std::string prefetch_file_name;
+				if ((fileFormat != CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML) &&
+					(fileFormat != CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY))
+				{
+					cmzn_streamresource_file_id file_resource = cmzn_streamresource_cast_file((*iter)->getResource());
+					if (file_resource)
+					{
+						char *file_name = file_resource->getFileName();
+						if (file_name)
+						{
+							prefetch_file_name = file_name;
+							DEALLOCATE(file_name);
+						}
+						cmzn_streamresource_file_destroy(&file_resource);
+					}
+				}
+				prefetch_file_names.push_back(prefetch_file_name);
+			}
+			Region_read_prefetcher prefetcher(prefetch_file_names);
+			prefetcher.prefetchFrom(0);
+			size_t resource_index = 0;
+			for (iter = streams_list.begin(); (iter != streams_list.end()) && (return_code == CMZN_OK);
+				++iter, ++resource_index)
 			{
 				data_compression_type = CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE;
 				stream_properties = *iter;
@@ -169,8 +320,6 @@ int cmzn_region_read(cmzn_region_id region,
 				{
 					data_compression_type = cmzn_streaminformation_get_data_compression_type(streaminformation);
 				}
-				cmzn_streaminformation_region_file_format fileFormat =
-					cmzn_streaminformation_region_get_file_format(streaminformation_region);
 				cmzn_streamresource_file_id file_resource = cmzn_streamresource_cast_file(stream);
 				cmzn_streamresource_memory_id memory_resource = NULL;
 				void *memory_block = NULL;
@@ -187,8 +336,27 @@ int cmzn_region_read(cmzn_region_id region,
 					char *file_name = file_resource->getFileName();
 					if (file_name)
 					{
-						return_code = cmzn_region_read_field_file_of_name(temp_region, file_name, io_stream_package, stream_time_index,
-							readData, data_compression_type, fileFormat);
+						Prefetched_file prefetched_file = prefetcher.take(resource_index);
+						if (prefetched_file.valid && ((fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX) ||
+							(fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY) ||
+							((fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC) &&
+								(!is_FieldML_memory_block(static_cast<unsigned int>(prefetched_file.data.size()),
+									&(prefetched_file.data[0]))))))
+						{
+							// gzopen reads files without a gzip header as uncompressed; do the same
+							const enum cmzn_streaminformation_data_compression_type prefetched_compression_type =
+								((CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP == data_compression_type) &&
+									(!prefetched_file.hasGzipHeader())) ?
+								CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE : data_compression_type;
+							return_code = cmzn_region_read_from_memory(temp_region, &(prefetched_file.data[0]),
+								static_cast<unsigned int>(prefetched_file.data.size()), stream_time_index,
+								readData, prefetched_compression_type, CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX, file_name);
+						}
+						else
+						{
+							return_code = cmzn_region_read_field_file_of_name(temp_region, file_name, io_stream_package, stream_time_index,
+								readData, data_compression_type, fileFormat);
+						}
 						if (return_code != CMZN_OK)
 							display_message(ERROR_MESSAGE, "cmzn_region_read.  Cannot read file %s", file_name);
 						DEALLOCATE(file_name);
@@ -387,18 +555,22 @@ int cmzn_region_write(cmzn_region_id region,
 						switch (fileFormat)
 						{
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
+							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY:
 								if (!write_exregion_file_of_name(file_name, region, group_name,
 									cmzn_streaminformation_region_get_root_region(streaminformation_region),
 									writeElements,	writeNodes, writeData,
 									write_fields_mode, numberOfFieldNames, fieldNames,
-									stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode))
+									stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode,
+									/*binary_values*/(fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY)))
 								{
 									return_code = CMZN_ERROR_GENERAL;
 									display_message(ERROR_MESSAGE, "cmzn_region_write.  Failed to write EX file %s", file_name);
 								}
 								break;
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
-								return_code = write_fieldml_file(region, file_name);
+							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY:
+								return_code = write_fieldml_file(region, file_name,
+									/*binaryArrays*/(fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY));
 								break;
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_AUTOMATIC:
 							case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_INVALID:
@@ -418,11 +590,14 @@ int cmzn_region_write(cmzn_region_id region,
 					switch (fileFormat)
 					{
 						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX:
+						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY:
 							if (!write_exregion_file_to_memory_block(region, group_name,
 								cmzn_streaminformation_region_get_root_region(streaminformation_region),
 								writeElements,	writeNodes, writeData,
 								write_fields_mode, numberOfFieldNames, fieldNames,
-								stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode, &memory_block, &buffer_size))
+								stream_time,	FE_WRITE_COMPLETE_GROUP, local_recursion_mode,
+								/*binary_values*/(fileFormat == CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_EX_BINARY),
+								&memory_block, &buffer_size))
 							{
 								return_code = CMZN_ERROR_GENERAL;
 								display_message(ERROR_MESSAGE, "cmzn_region_write.  Failed to write EX format to memory block");
@@ -433,6 +608,7 @@ int cmzn_region_write(cmzn_region_id region,
 							}
 							break;
 						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML:
+						case CMZN_STREAMINFORMATION_REGION_FILE_FORMAT_FIELDML_BINARY:
 							display_message(ERROR_MESSAGE, "cmzn_region_write.  Cannot write FieldML to memory block.");
 							return_code = CMZN_ERROR_ARGUMENT;
 							break;
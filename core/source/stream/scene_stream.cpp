@@ -36,7 +36,8 @@ int cmzn_scene_write(cmzn_scene_id scene,
 			std::string *output_string = 0;
 
 			cmzn_scene_id scene = streaminformation_scene->getScene();
-			if (streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS)
+			const bool binary = (streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY);
+			if ((streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS) || binary)
 			{
 				cmzn_scenefilter_id scenefilter = streaminformation_scene->getScenefilter();
 				return_code = Scene_render_threejs(scene,
@@ -48,7 +49,8 @@ int cmzn_scene_write(cmzn_scene_id scene,
 					&number_of_entries, &output_string,
 					streaminformation_scene->getOutputTimeDependentVertices(),
 					streaminformation_scene->getOutputTimeDependentColours(),
-					streaminformation_scene->getOutputTimeDependentNormals()
+					streaminformation_scene->getOutputTimeDependentNormals(),
+					binary, streaminformation_scene->isQuantised()
 				);
 				cmzn_scenefilter_destroy(&scenefilter);
 			}
@@ -80,9 +82,17 @@ int cmzn_scene_write(cmzn_scene_id scene,
 						char *file_name = file_resource->getFileName();
 						if (file_name)
 						{
-							FILE *export_file = fopen(file_name,"w");
-							fprintf(export_file, "%s", output_string[i].c_str());
-							fclose(export_file);
+							FILE *export_file = fopen(file_name, binary ? "wb" : "w");
+							if (export_file)
+							{
+								fwrite(output_string[i].data(), 1, output_string[i].size(), export_file);
+								fclose(export_file);
+							}
+							else
+							{
+								display_message(ERROR_MESSAGE, "cmzn_scene_export.  Could not open file %s", file_name);
+								return_code = 0;
+							}
 							DEALLOCATE(file_name);
 							i++;
 						}
@@ -90,9 +100,16 @@ int cmzn_scene_write(cmzn_scene_id scene,
 					}
 					else if (NULL != (memory_resource = cmzn_streamresource_cast_memory(stream)))
 					{
-						char *buffer_out = duplicate_string(output_string[i].c_str());
-						unsigned int buffer_size = strlen(buffer_out);
-						memory_resource->setBuffer(buffer_out, buffer_size);
+						// copy including terminating null; binary output may contain nulls
+						const unsigned int buffer_size = static_cast<unsigned int>(output_string[i].size());
+						char *buffer_out = 0;
+						if (ALLOCATE(buffer_out, char, buffer_size + 1))
+						{
+							memcpy(buffer_out, output_string[i].c_str(), buffer_size + 1);
+							memory_resource->setBuffer(buffer_out, buffer_size);
+						}
+						else
+							return_code = 0;
 						cmzn_streamresource_memory_destroy(&memory_resource);
 						i++;
 					}
@@ -373,6 +390,12 @@ public:
 			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS:
 				enum_string = "THREEJS";
 				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION:
+				enum_string = "DESCRIPTION";
+				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY:
+				enum_string = "GLTF_BINARY";
+				break;
 			default:
 				break;
 		}
@@ -493,3 +516,22 @@ int cmzn_streaminformation_scene_set_output_time_dependent_normals(
 	}
 	return CMZN_ERROR_ARGUMENT;
 }
+
+bool cmzn_streaminformation_scene_is_quantised(
+	cmzn_streaminformation_scene_id streaminformation)
+{
+	if (streaminformation)
+		return streaminformation->isQuantised();
+	return false;
+}
+
+int cmzn_streaminformation_scene_set_quantised(
+	cmzn_streaminformation_scene_id streaminformation, bool quantised)
+{
+	if (streaminformation)
+	{
+		streaminformation->setQuantised(quantised);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
@@ -27,7 +27,8 @@ public:
 		format(CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_INVALID),
 		data_type(CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_COLOUR),
 		overwriteSceneGraphics(0),  outputTimeDependentVertices(1),
-		outputTimeDependentColours(0), outputTimeDependentNormals(0)
+		outputTimeDependentColours(0), outputTimeDependentNormals(0),
+		quantised(false)
 	{
 		cmzn_scene_access(scene_in);
 	}
@@ -67,7 +68,8 @@ public:
 
 	int getNumberOfResourcesRequired()
 	{
-		if (format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS)
+		if ((format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS) ||
+			(format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY))
 		{
 			return Scene_get_number_of_graphics_with_surface_vertices_in_tree(
 				scene, scenefilter);
@@ -170,6 +172,16 @@ public:
 		return CMZN_OK;
 	}
 
+	bool isQuantised() const
+	{
+		return quantised;
+	}
+
+	void setQuantised(bool quantisedIn)
+	{
+		quantised = quantisedIn;
+	}
+
 private:
 	cmzn_scene_id scene;
 	cmzn_scenefilter_id scenefilter;
@@ -179,6 +191,7 @@ private:
 	enum cmzn_streaminformation_scene_io_data_type data_type;
 	int overwriteSceneGraphics;
 	int outputTimeDependentVertices, outputTimeDependentColours, outputTimeDependentNormals;
+	bool quantised;
 };
 
 
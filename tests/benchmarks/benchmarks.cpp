@@ -0,0 +1,850 @@
+/*
+ * OpenCMISS-Zinc Library Benchmarks
+ *
+ * Times the core operations applications depend on, over the test data and
+ * synthetic meshes, so performance can be compared across commits.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opencmiss/zinc/context.hpp>
+#include <opencmiss/zinc/element.hpp>
+#include <opencmiss/zinc/field.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldmeshoperators.hpp>
+#include <opencmiss/zinc/fieldmodule.hpp>
+#include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/graphics.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/region.hpp>
+#include <opencmiss/zinc/scene.hpp>
+#include <opencmiss/zinc/scenefilter.hpp>
+#include <opencmiss/zinc/spectrum.hpp>
+#include <opencmiss/zinc/status.hpp>
+#include <opencmiss/zinc/streamregion.hpp>
+#include "test_resources.h"
+
+using namespace OpenCMISS::Zinc;
+
+namespace {
+
+/** Number of elements along each side of the synthetic cube mesh. */
+int meshSize = 16;
+
+/**
+ * Create unit cube mesh of size^3 trilinear Lagrange elements with
+ * rectangular cartesian coordinates field named "coordinates".
+ * @return  True on success.
+ */
+bool createCubeMesh(Fieldmodule& fm, int size)
+{
+	fm.beginChange();
+	FieldFiniteElement coordinates = fm.createFieldFiniteElement(3);
+	coordinates.setName("coordinates");
+	coordinates.setManaged(true);
+	coordinates.setTypeCoordinate(true);
+	coordinates.setComponentName(1, "x");
+	coordinates.setComponentName(2, "y");
+	coordinates.setComponentName(3, "z");
+
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	nodetemplate.defineField(coordinates);
+	Fieldcache fieldcache = fm.createFieldcache();
+	const int nodesCount1 = size + 1;
+	const double scale = 1.0 / size;
+	for (int k = 0; k < nodesCount1; ++k)
+		for (int j = 0; j < nodesCount1; ++j)
+			for (int i = 0; i < nodesCount1; ++i)
+			{
+				Node node = nodes.createNode(1 + i + nodesCount1*(j + nodesCount1*k), nodetemplate);
+				fieldcache.setNode(node);
+				const double x[3] = { i*scale, j*scale, k*scale };
+				if (OK != coordinates.assignReal(fieldcache, 3, x))
+				{
+					fm.endChange();
+					return false;
+				}
+			}
+
+	Mesh mesh = fm.findMeshByDimension(3);
+	Elementtemplate elementtemplate = mesh.createElementtemplate();
+	elementtemplate.setElementShapeType(Element::SHAPE_TYPE_CUBE);
+	elementtemplate.setNumberOfNodes(8);
+	Elementbasis basis = fm.createElementbasis(3, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	const int localNodeIndexes[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	elementtemplate.defineFieldSimpleNodal(coordinates, /*componentNumber*/-1, basis, 8, localNodeIndexes);
+	for (int k = 0; k < size; ++k)
+		for (int j = 0; j < size; ++j)
+			for (int i = 0; i < size; ++i)
+			{
+				const int baseNodeIdentifier = 1 + i + nodesCount1*(j + nodesCount1*k);
+				for (int n = 0; n < 8; ++n)
+				{
+					const int nodeIdentifier = baseNodeIdentifier + (n & 1) +
+						((n & 2) ? nodesCount1 : 0) + ((n & 4) ? nodesCount1*nodesCount1 : 0);
+					elementtemplate.setNode(n + 1, nodes.findNodeByIdentifier(nodeIdentifier));
+				}
+				if (OK != mesh.defineElement(1 + i + size*(j + size*k), elementtemplate))
+				{
+					fm.endChange();
+					return false;
+				}
+			}
+	fm.endChange();
+	return (mesh.getSize() == size*size*size);
+}
+
+/** Deterministic pseudo-random sequence so runs are comparable. */
+class Random
+{
+	unsigned int state;
+
+public:
+	Random() : state(12345u)
+	{
+	}
+
+	/** @return  Value in [0, 1). */
+	double next()
+	{
+		this->state = this->state*1664525u + 1013904223u;
+		return static_cast<double>(this->state >> 8) / 16777216.0;
+	}
+};
+
+/**
+ * Base class for one benchmark. Each repetition calls setUp, times run,
+ * then calls tearDown.
+ */
+class Benchmark
+{
+public:
+	virtual ~Benchmark()
+	{
+	}
+
+	virtual const char *getName() const = 0;
+
+	/** Name of the unit counted by run, for throughput. */
+	virtual const char *getOperationName() const = 0;
+
+	/** Prepare for a run; not timed. @return  True on success. */
+	virtual bool setUp()
+	{
+		return true;
+	}
+
+	/** The timed operation. @return  Number of operations done, or -1 if failed. */
+	virtual int run() = 0;
+
+	/** Clean up after a run; not timed. */
+	virtual void tearDown()
+	{
+	}
+};
+
+/** Read heart model from gzipped EX files into a new region. */
+class ExReadBenchmark : public Benchmark
+{
+	Context context;
+	Region region;
+
+public:
+	ExReadBenchmark() :
+		context("benchmark")
+	{
+	}
+
+	virtual const char *getName() const
+	{
+		return "ex_read_heart";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "nodes";
+	}
+
+	virtual bool setUp()
+	{
+		this->region = this->context.getDefaultRegion().createChild("heart");
+		return this->region.isValid();
+	}
+
+	virtual int run()
+	{
+		StreaminformationRegion si = this->region.createStreaminformationRegion();
+		si.createStreamresourceFile(TestResources::getLocation(TestResources::HEART_EXNODE_GZ));
+		si.createStreamresourceFile(TestResources::getLocation(TestResources::HEART_EXELEM_GZ));
+		si.setDataCompressionType(Streaminformation::DATA_COMPRESSION_TYPE_GZIP);
+		if (OK != this->region.read(si))
+			return -1;
+		return this->region.getFieldmodule().findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES).getSize();
+	}
+
+	virtual void tearDown()
+	{
+		this->context.getDefaultRegion().removeChild(this->region);
+		this->region = Region();
+	}
+};
+
+/** Write heart model to an EX format memory buffer. */
+class ExWriteBenchmark : public Benchmark
+{
+	Context context;
+	Region region;
+
+public:
+	ExWriteBenchmark() :
+		context("benchmark"),
+		region(context.getDefaultRegion())
+	{
+	}
+
+	virtual const char *getName() const
+	{
+		return "ex_write_heart";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "kbytes";
+	}
+
+	virtual bool setUp()
+	{
+		if (0 < this->region.getFieldmodule().findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES).getSize())
+			return true;
+		StreaminformationRegion si = this->region.createStreaminformationRegion();
+		si.createStreamresourceFile(TestResources::getLocation(TestResources::HEART_EXNODE_GZ));
+		si.createStreamresourceFile(TestResources::getLocation(TestResources::HEART_EXELEM_GZ));
+		si.setDataCompressionType(Streaminformation::DATA_COMPRESSION_TYPE_GZIP);
+		return (OK == this->region.read(si));
+	}
+
+	virtual int run()
+	{
+		StreaminformationRegion si = this->region.createStreaminformationRegion();
+		StreamresourceMemory memory = si.createStreamresourceMemory();
+		if (OK != this->region.write(si))
+			return -1;
+		void *buffer = 0;
+		unsigned int size = 0;
+		memory.getBuffer(&buffer, &size);
+		return static_cast<int>(size / 1024);
+	}
+};
+
+/** Create nodes and elements of synthetic cube mesh. */
+class MeshCreateBenchmark : public Benchmark
+{
+	Context *context;
+
+public:
+	MeshCreateBenchmark() :
+		context(0)
+	{
+	}
+
+	virtual ~MeshCreateBenchmark()
+	{
+		delete this->context;
+	}
+
+	virtual const char *getName() const
+	{
+		return "mesh_create";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "elements";
+	}
+
+	virtual bool setUp()
+	{
+		this->context = new Context("benchmark");
+		return true;
+	}
+
+	virtual int run()
+	{
+		Fieldmodule fm = this->context->getDefaultRegion().getFieldmodule();
+		if (!createCubeMesh(fm, meshSize))
+			return -1;
+		return meshSize*meshSize*meshSize;
+	}
+
+	virtual void tearDown()
+	{
+		delete this->context;
+		this->context = 0;
+	}
+};
+
+/** Define faces and lines of synthetic cube mesh. */
+class DefineFacesBenchmark : public Benchmark
+{
+	Context *context;
+
+public:
+	DefineFacesBenchmark() :
+		context(0)
+	{
+	}
+
+	virtual ~DefineFacesBenchmark()
+	{
+		delete this->context;
+	}
+
+	virtual const char *getName() const
+	{
+		return "define_faces";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "elements";
+	}
+
+	virtual bool setUp()
+	{
+		this->context = new Context("benchmark");
+		Fieldmodule fm = this->context->getDefaultRegion().getFieldmodule();
+		return createCubeMesh(fm, meshSize);
+	}
+
+	virtual int run()
+	{
+		Fieldmodule fm = this->context->getDefaultRegion().getFieldmodule();
+		if (OK != fm.defineAllFaces())
+			return -1;
+		return fm.findMeshByDimension(3).getSize();
+	}
+
+	virtual void tearDown()
+	{
+		delete this->context;
+		this->context = 0;
+	}
+};
+
+/** Base for benchmarks on a synthetic cube mesh built once. */
+class CubeMeshBenchmark : public Benchmark
+{
+protected:
+	Context context;
+	Fieldmodule fm;
+	Field coordinates;
+	Mesh mesh;
+	bool valid;
+
+public:
+	CubeMeshBenchmark(bool defineFaces = false) :
+		context("benchmark"),
+		fm(context.getDefaultRegion().getFieldmodule())
+	{
+		this->valid = createCubeMesh(this->fm, meshSize) &&
+			((!defineFaces) || (OK == this->fm.defineAllFaces()));
+		this->coordinates = this->fm.findFieldByName("coordinates");
+		this->mesh = this->fm.findMeshByDimension(3);
+	}
+
+	virtual bool setUp()
+	{
+		return this->valid;
+	}
+};
+
+/** Evaluate coordinates and a derived field at points in all elements. */
+class FieldEvaluationBenchmark : public CubeMeshBenchmark
+{
+	Field magnitude;
+
+public:
+	FieldEvaluationBenchmark()
+	{
+		this->magnitude = this->fm.createFieldMagnitude(this->coordinates);
+	}
+
+	virtual const char *getName() const
+	{
+		return "field_evaluation";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "evaluations";
+	}
+
+	virtual int run()
+	{
+		Fieldcache fieldcache = this->fm.createFieldcache();
+		Elementiterator iter = this->mesh.createElementiterator();
+		Element element;
+		int count = 0;
+		double x[3], value;
+		while ((element = iter.next()).isValid())
+		{
+			for (int p = 0; p < 8; ++p)
+			{
+				const double xi[3] = { (p & 1) ? 0.75 : 0.25, (p & 2) ? 0.75 : 0.25, (p & 4) ? 0.75 : 0.25 };
+				fieldcache.setMeshLocation(element, 3, xi);
+				if ((OK != this->coordinates.evaluateReal(fieldcache, 3, x)) ||
+					(OK != this->magnitude.evaluateReal(fieldcache, 1, &value)))
+					return -1;
+				++count;
+			}
+		}
+		return count;
+	}
+};
+
+/** Find mesh locations of pseudo-random points in the cube mesh. */
+class FindMeshLocationBenchmark : public CubeMeshBenchmark
+{
+	FieldFindMeshLocation findMeshLocation;
+
+public:
+	FindMeshLocationBenchmark()
+	{
+		this->findMeshLocation = this->fm.createFieldFindMeshLocation(this->coordinates, this->coordinates, this->mesh);
+	}
+
+	virtual const char *getName() const
+	{
+		return "find_mesh_location";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "points";
+	}
+
+	virtual int run()
+	{
+		const int pointsCount = 10000;
+		Fieldcache fieldcache = this->fm.createFieldcache();
+		Random random;
+		double xi[3];
+		for (int i = 0; i < pointsCount; ++i)
+		{
+			const double x[3] = { random.next(), random.next(), random.next() };
+			fieldcache.setFieldReal(this->coordinates, 3, x);
+			if (!this->findMeshLocation.evaluateMeshLocation(fieldcache, 3, xi).isValid())
+				return -1;
+		}
+		return pointsCount;
+	}
+};
+
+/**
+ * Find mesh locations of spatially coherent points, raster scanning the cube
+ * with alternate rows reversed so each point is near the last. With faces
+ * defined the search walks from the last element found to neighbours;
+ * without faces it can only check the last element before searching all
+ * elements, giving the time without walking for comparison.
+ */
+class FindMeshLocationCoherentBenchmark : public CubeMeshBenchmark
+{
+	FieldFindMeshLocation findMeshLocation;
+	const char *name;
+
+public:
+	FindMeshLocationCoherentBenchmark(bool defineFaces, const char *nameIn) :
+		CubeMeshBenchmark(defineFaces),
+		name(nameIn)
+	{
+		this->findMeshLocation = this->fm.createFieldFindMeshLocation(this->coordinates, this->coordinates, this->mesh);
+	}
+
+	virtual const char *getName() const
+	{
+		return this->name;
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "points";
+	}
+
+	virtual int run()
+	{
+		const int rowPointsCount = 100;
+		const int rowsCount = 100;
+		Fieldcache fieldcache = this->fm.createFieldcache();
+		double xi[3];
+		for (int j = 0; j < rowsCount; ++j)
+		{
+			const double y = (j + 0.5) / rowsCount;
+			const double z = (j + 0.5) / rowsCount;
+			for (int k = 0; k < rowPointsCount; ++k)
+			{
+				const int i = (j % 2) ? (rowPointsCount - 1 - k) : k;
+				const double x[3] = { (i + 0.5) / rowPointsCount, y, z };
+				fieldcache.setFieldReal(this->coordinates, 3, x);
+				if (!this->findMeshLocation.evaluateMeshLocation(fieldcache, 3, xi).isValid())
+					return -1;
+			}
+		}
+		return rowPointsCount*rowsCount;
+	}
+};
+
+/** Integrate volume over the cube mesh with 4 Gauss points per xi direction. */
+class MeshIntegralBenchmark : public CubeMeshBenchmark
+{
+	FieldMeshIntegral volume;
+
+public:
+	MeshIntegralBenchmark()
+	{
+		const double one = 1.0;
+		Field integrand = this->fm.createFieldConstant(1, &one);
+		this->volume = this->fm.createFieldMeshIntegral(integrand, this->coordinates, this->mesh);
+		const int numbersOfPoints = 4;
+		this->volume.setNumbersOfPoints(1, &numbersOfPoints);
+	}
+
+	virtual const char *getName() const
+	{
+		return "mesh_integral";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "elements";
+	}
+
+	virtual int run()
+	{
+		// new cache each run so value is not cached
+		Fieldcache fieldcache = this->fm.createFieldcache();
+		double value = 0.0;
+		if (OK != this->volume.evaluateReal(fieldcache, 1, &value))
+			return -1;
+		return this->mesh.getSize();
+	}
+};
+
+/** Generate surface graphics coloured by a data field over the exterior faces. */
+class GraphicsSurfacesBenchmark : public CubeMeshBenchmark
+{
+	Scene scene;
+	Spectrum spectrum;
+	Scenefilter scenefilter;
+	Field magnitude;
+
+public:
+	GraphicsSurfacesBenchmark() :
+		CubeMeshBenchmark(/*defineFaces*/true)
+	{
+		this->scene = this->context.getDefaultRegion().getScene();
+		this->spectrum = this->context.getSpectrummodule().getDefaultSpectrum();
+		this->scenefilter = this->context.getScenefiltermodule().getDefaultScenefilter();
+		this->magnitude = this->fm.createFieldMagnitude(this->coordinates);
+	}
+
+	virtual const char *getName() const
+	{
+		return "graphics_surfaces";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "faces";
+	}
+
+	virtual bool setUp()
+	{
+		if (!this->valid)
+			return false;
+		// graphics are built lazily so create afresh each run
+		Graphics surfaces = this->scene.createGraphicsSurfaces();
+		surfaces.setCoordinateField(this->coordinates);
+		surfaces.setDataField(this->magnitude);
+		surfaces.setSpectrum(this->spectrum);
+		return true;
+	}
+
+	virtual int run()
+	{
+		double minimum, maximum;
+		// building graphics is needed to get data range
+		if (1 != this->scene.getSpectrumDataRange(this->scenefilter, this->spectrum, 1, &minimum, &maximum))
+			return -1;
+		return this->fm.findMeshByDimension(2).getSize();
+	}
+
+	virtual void tearDown()
+	{
+		this->scene.removeAllGraphics();
+	}
+};
+
+/**
+ * Find line elements by identifier in pseudo-random order, where clustered
+ * identifiers with large gaps make the labels non-contiguous so lookups use
+ * the identifier hash index.
+ */
+class FindElementByIdentifierBenchmark : public Benchmark
+{
+	Context context;
+	Fieldmodule fm;
+	Mesh mesh;
+	std::vector<int> identifiers;
+	bool valid;
+
+public:
+	FindElementByIdentifierBenchmark() :
+		context("benchmark"),
+		valid(true)
+	{
+		this->fm = this->context.getDefaultRegion().getFieldmodule();
+		this->mesh = this->fm.findMeshByDimension(1);
+		Elementtemplate elementtemplate = this->mesh.createElementtemplate();
+		elementtemplate.setElementShapeType(Element::SHAPE_TYPE_LINE);
+		const int elementsCount = 64*meshSize*meshSize;
+		this->identifiers.reserve(elementsCount);
+		this->fm.beginChange();
+		for (int i = 0; i < elementsCount; ++i)
+		{
+			const int identifier = 1 + (i / 100)*100000 + (i % 100);
+			if (!this->mesh.createElement(identifier, elementtemplate).isValid())
+				this->valid = false;
+			this->identifiers.push_back(identifier);
+		}
+		this->fm.endChange();
+		Random random;
+		for (int i = elementsCount - 1; i > 0; --i)
+			std::swap(this->identifiers[i], this->identifiers[static_cast<int>(random.next()*(i + 1))]);
+	}
+
+	virtual const char *getName() const
+	{
+		return "find_element_by_identifier";
+	}
+
+	virtual const char *getOperationName() const
+	{
+		return "lookups";
+	}
+
+	virtual bool setUp()
+	{
+		return this->valid;
+	}
+
+	virtual int run()
+	{
+		const int lookupsCount = static_cast<int>(this->identifiers.size());
+		for (int i = 0; i < lookupsCount; ++i)
+			if (this->mesh.findElementByIdentifier(this->identifiers[i]).getIdentifier() != this->identifiers[i])
+				return -1;
+		return lookupsCount;
+	}
+};
+
+struct Result
+{
+	std::string name;
+	std::string operationName;
+	int operations;
+	double medianSeconds, minimumSeconds, maximumSeconds;
+};
+
+/**
+ * Run benchmark once to warm up then repeatedly, timing each run.
+ * @return  True on success.
+ */
+bool runBenchmark(Benchmark& benchmark, int repeats, Result& result)
+{
+	std::vector<double> seconds;
+	result.name = benchmark.getName();
+	result.operationName = benchmark.getOperationName();
+	result.operations = 0;
+	for (int r = -1; r < repeats; ++r)
+	{
+		if (!benchmark.setUp())
+			return false;
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const int operations = benchmark.run();
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		benchmark.tearDown();
+		if (operations < 0)
+			return false;
+		if (r >= 0)
+		{
+			seconds.push_back(std::chrono::duration<double>(end - start).count());
+			result.operations = operations;
+		}
+	}
+	std::sort(seconds.begin(), seconds.end());
+	result.minimumSeconds = seconds.front();
+	result.maximumSeconds = seconds.back();
+	const size_t middle = seconds.size() / 2;
+	result.medianSeconds = (seconds.size() % 2) ? seconds[middle] :
+		0.5*(seconds[middle - 1] + seconds[middle]);
+	return true;
+}
+
+/** Read median times by benchmark name from a results file written earlier. */
+std::map<std::string, double> readBaseline(const char *fileName)
+{
+	std::map<std::string, double> baseline;
+	std::ifstream in(fileName);
+	std::string line;
+	while (std::getline(in, line))
+	{
+		if ((line.empty()) || (line[0] == '#'))
+			continue;
+		std::istringstream fields(line);
+		std::string name;
+		double medianMilliseconds;
+		if (fields >> name >> medianMilliseconds)
+			baseline[name] = medianMilliseconds;
+	}
+	return baseline;
+}
+
+void printUsage(const char *programName)
+{
+	printf("Usage: %s [options]\n"
+		"  --repeats N      Timed runs per benchmark after one warm-up run (default 5)\n"
+		"  --mesh-size N    Elements along each side of synthetic cube mesh (default 16)\n"
+		"  --filter TEXT    Only run benchmarks with TEXT in their name\n"
+		"  --output FILE    Also write results to FILE for later comparison\n"
+		"  --baseline FILE  Compare median times with results FILE from another build\n"
+		"  --list           List benchmark names and exit\n", programName);
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+	int repeats = 5;
+	const char *filter = 0;
+	const char *outputFileName = 0;
+	const char *baselineFileName = 0;
+	bool listOnly = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = (i + 1 < argc);
+		if ((0 == strcmp(argv[i], "--repeats")) && hasValue)
+			repeats = atoi(argv[++i]);
+		else if ((0 == strcmp(argv[i], "--mesh-size")) && hasValue)
+			meshSize = atoi(argv[++i]);
+		else if ((0 == strcmp(argv[i], "--filter")) && hasValue)
+			filter = argv[++i];
+		else if ((0 == strcmp(argv[i], "--output")) && hasValue)
+			outputFileName = argv[++i];
+		else if ((0 == strcmp(argv[i], "--baseline")) && hasValue)
+			baselineFileName = argv[++i];
+		else if (0 == strcmp(argv[i], "--list"))
+			listOnly = true;
+		else
+		{
+			printUsage(argv[0]);
+			return (0 == strcmp(argv[i], "--help")) ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+	if ((repeats < 1) || (meshSize < 1))
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const char *names[] = { "ex_read_heart", "ex_write_heart", "mesh_create", "define_faces",
+		"field_evaluation", "find_mesh_location", "mesh_integral", "graphics_surfaces",
+		"find_element_by_identifier", "find_mesh_location_walk", "find_mesh_location_no_walk" };
+	const int benchmarksCount = sizeof(names) / sizeof(names[0]);
+	if (listOnly)
+	{
+		for (int b = 0; b < benchmarksCount; ++b)
+			printf("%s\n", names[b]);
+		return EXIT_SUCCESS;
+	}
+
+	std::map<std::string, double> baseline;
+	if (baselineFileName)
+		baseline = readBaseline(baselineFileName);
+	FILE *outputFile = 0;
+	if (outputFileName)
+	{
+		outputFile = fopen(outputFileName, "w");
+		if (!outputFile)
+		{
+			fprintf(stderr, "Could not open output file %s\n", outputFileName);
+			return EXIT_FAILURE;
+		}
+		fprintf(outputFile, "# name\tmedian_ms\tmin_ms\tmax_ms\toperations\tunit\tmesh_size %d\n", meshSize);
+	}
+
+	printf("%-20s %12s %12s %12s %14s %s\n", "benchmark", "median ms", "min ms", "max ms", "ops/s", "ops");
+	int failures = 0;
+	for (int b = 0; b < benchmarksCount; ++b)
+	{
+		if (filter && (0 == strstr(names[b], filter)))
+			continue;
+		// construct only selected benchmarks as setup can be expensive
+		Benchmark *benchmark = 0;
+		switch (b)
+		{
+		case 0: benchmark = new ExReadBenchmark(); break;
+		case 1: benchmark = new ExWriteBenchmark(); break;
+		case 2: benchmark = new MeshCreateBenchmark(); break;
+		case 3: benchmark = new DefineFacesBenchmark(); break;
+		case 4: benchmark = new FieldEvaluationBenchmark(); break;
+		case 5: benchmark = new FindMeshLocationBenchmark(); break;
+		case 6: benchmark = new MeshIntegralBenchmark(); break;
+		case 7: benchmark = new GraphicsSurfacesBenchmark(); break;
+		case 8: benchmark = new FindElementByIdentifierBenchmark(); break;
+		case 9: benchmark = new FindMeshLocationCoherentBenchmark(/*defineFaces*/true, names[b]); break;
+		case 10: benchmark = new FindMeshLocationCoherentBenchmark(/*defineFaces*/false, names[b]); break;
+		}
+		Result result;
+		if (!runBenchmark(*benchmark, repeats, result))
+		{
+			printf("%-20s FAILED\n", names[b]);
+			++failures;
+			delete benchmark;
+			continue;
+		}
+		delete benchmark;
+		const double medianMilliseconds = 1000.0*result.medianSeconds;
+		printf("%-20s %12.3f %12.3f %12.3f %14.1f %d %s",
+			result.name.c_str(), medianMilliseconds, 1000.0*result.minimumSeconds,
+			1000.0*result.maximumSeconds,
+			(result.medianSeconds > 0.0) ? result.operations / result.medianSeconds : 0.0,
+			result.operations, result.operationName.c_str());
+		std::map<std::string, double>::const_iterator baselineIter = baseline.find(result.name);
+		if ((baselineIter != baseline.end()) && (baselineIter->second > 0.0))
+			printf("  (%+.1f%% vs baseline)", 100.0*(medianMilliseconds/baselineIter->second - 1.0));
+		printf("\n");
+		if (outputFile)
+			fprintf(outputFile, "%s\t%.6f\t%.6f\t%.6f\t%d\t%s\n", result.name.c_str(), medianMilliseconds,
+				1000.0*result.minimumSeconds, 1000.0*result.maximumSeconds,
+				result.operations, result.operationName.c_str());
+	}
+	if (outputFile)
+		fclose(outputFile);
+	return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+/*
+ * OpenCMISS-Zinc Library Unit Tests
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <gtest/gtest.h>
+
+#include "zinctestsetupcpp.hpp"
+#include "opencmiss/zinc/element.hpp"
+#include "opencmiss/zinc/fieldcache.hpp"
+#include "opencmiss/zinc/fieldconstant.hpp"
+#include "opencmiss/zinc/fieldmodule.hpp"
+#include "opencmiss/zinc/fieldvectoroperators.hpp"
+#include "opencmiss/zinc/region.hpp"
+
+#include "computed_field/computed_field_update.h"
+
+#include "test_resources.h"
+
+// grid values are assigned one element at a time through
+// Computed_field_finite_element_assign_element_grid_values
+TEST(cmzn_mesh_assign_grid_field_from_source, grid_points)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_GRID_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	// potential has 2x3x4 grid cells, so 60 grid points in the element
+	Field potential = zinc.fm.findFieldByName("potential");
+	EXPECT_TRUE(potential.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	EXPECT_EQ(1, mesh3d.getSize());
+	Element element = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+
+	// unit cube coordinates equal xi, so a different value at every grid point
+	const double weights[3] = { 1.0, 10.0, 100.0 };
+	FieldConstant weightsField = zinc.fm.createFieldConstant(3, weights);
+	EXPECT_TRUE(weightsField.isValid());
+	FieldDotProduct source = zinc.fm.createFieldDotProduct(coordinates, weightsField);
+	EXPECT_TRUE(source.isValid());
+	EXPECT_EQ(1, cmzn_mesh_assign_grid_field_from_source(mesh3d.getId(), potential.getId(),
+		source.getId(), /*conditional_field*/0, /*element_point_ranges_selection*/0, /*time*/0.0));
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double xi[3], value;
+	for (int k = 0; k <= 4; ++k)
+		for (int j = 0; j <= 3; ++j)
+			for (int i = 0; i <= 2; ++i)
+			{
+				xi[0] = i/2.0;
+				xi[1] = j/3.0;
+				xi[2] = k/4.0;
+				EXPECT_EQ(OK, result = cache.setMeshLocation(element, 3, xi));
+				EXPECT_EQ(OK, result = potential.evaluateReal(cache, 1, &value));
+				EXPECT_NEAR(xi[0] + 10.0*xi[1] + 100.0*xi[2], value, 1.0E-10);
+			}
+
+	// false conditional field leaves grid values unchanged
+	const double zero = 0.0;
+	FieldConstant falseField = zinc.fm.createFieldConstant(1, &zero);
+	EXPECT_TRUE(falseField.isValid());
+	const double seven = 7.0;
+	FieldConstant sevenField = zinc.fm.createFieldConstant(1, &seven);
+	EXPECT_TRUE(sevenField.isValid());
+	EXPECT_EQ(1, cmzn_mesh_assign_grid_field_from_source(mesh3d.getId(), potential.getId(),
+		sevenField.getId(), falseField.getId(), /*element_point_ranges_selection*/0, /*time*/0.0));
+	const double centre[3] = { 0.5, 0.5, 0.5 };
+	EXPECT_EQ(OK, result = cache.setMeshLocation(element, 3, centre));
+	EXPECT_EQ(OK, result = potential.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(55.5, value, 1.0E-10);
+
+	// mismatched number of components
+	EXPECT_EQ(0, cmzn_mesh_assign_grid_field_from_source(mesh3d.getId(), potential.getId(),
+		coordinates.getId(), /*conditional_field*/0, /*element_point_ranges_selection*/0, /*time*/0.0));
+	EXPECT_EQ(0, cmzn_mesh_assign_grid_field_from_source(mesh3d.getId(), /*destination_field*/0,
+		source.getId(), /*conditional_field*/0, /*element_point_ranges_selection*/0, /*time*/0.0));
+}
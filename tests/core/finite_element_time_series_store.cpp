@@ -0,0 +1,96 @@
+/*
+ * OpenCMISS-Zinc Library Unit Tests
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "finite_element/finite_element_time_series_store.hpp"
+
+// copying template slots which are zero at all times, as when creating many
+// nodes from a template, must not read any time blocks
+TEST(FE_time_series_store, copy_template_slots)
+{
+	const char *fileName = "time_series_store_template.bin";
+	FE_time_series_store *store = FE_time_series_store::create(fileName, 2);
+	ASSERT_NE(static_cast<FE_time_series_store *>(0), store);
+	const int timeCount = 400;
+	const int valueCount = 3;
+	const int nodeCount = 2000;
+	int templateSlots[valueCount];
+	for (int v = 0; v < valueCount; ++v)
+	{
+		templateSlots[v] = store->allocateSlot(timeCount, /*initialise*/true);
+		EXPECT_EQ(v, templateSlots[v]);
+	}
+	std::vector<int> nodeSlots(nodeCount*valueCount);
+	for (int n = 0; n < nodeCount; ++n)
+	{
+		for (int v = 0; v < valueCount; ++v)
+		{
+			nodeSlots[n*valueCount + v] = store->allocateSlot(timeCount, /*initialise*/false);
+			EXPECT_LE(0, nodeSlots[n*valueCount + v]);
+		}
+		EXPECT_TRUE(store->copySlots(valueCount, templateSlots, &(nodeSlots[n*valueCount])));
+	}
+	EXPECT_EQ(0, store->getNumberOfResidentTimes());
+	EXPECT_EQ((nodeCount + 1)*valueCount, store->getNumberOfSlots());
+
+	// set values of some nodes at all times, release and reallocate their
+	// slots initialised: reused slots must be zero at all times
+	const int setNodeCount = 10;
+	for (int n = 0; n < setNodeCount; ++n)
+		for (int v = 0; v < valueCount; ++v)
+			for (int t = 0; t < timeCount; ++t)
+				EXPECT_TRUE(store->setValue(nodeSlots[n*valueCount + v], t, n*1000.0 + v*0.5 + t));
+	EXPECT_DOUBLE_EQ(7*1000.0 + 1*0.5 + 123, store->getValue(nodeSlots[7*valueCount + 1], 123));
+	std::vector<int> releasedSlots(nodeSlots.begin(), nodeSlots.begin() + setNodeCount*valueCount);
+	std::sort(releasedSlots.begin(), releasedSlots.end());
+	for (size_t i = 0; i < releasedSlots.size(); ++i)
+		store->releaseSlot(releasedSlots[i]);
+	for (int n = 0; n < setNodeCount; ++n)
+		for (int v = 0; v < valueCount; ++v)
+		{
+			const int slot = store->allocateSlot(timeCount, /*initialise*/true);
+			EXPECT_TRUE(std::binary_search(releasedSlots.begin(), releasedSlots.end(), slot));
+			nodeSlots[n*valueCount + v] = slot;
+		}
+	EXPECT_EQ((nodeCount + 1)*valueCount, store->getNumberOfSlots());
+	for (int n = 0; n < setNodeCount; ++n)
+		for (int v = 0; v < valueCount; ++v)
+			for (int t = 0; t < timeCount; t += 7)
+				EXPECT_DOUBLE_EQ(0.0, store->getValue(nodeSlots[n*valueCount + v], t));
+
+	// reused slots allocated uninitialised are zeroed by copying the template
+	for (int v = 0; v < valueCount; ++v)
+		EXPECT_TRUE(store->setValue(nodeSlots[v], 5, 1.5));
+	for (int v = 0; v < valueCount; ++v)
+		store->releaseSlot(nodeSlots[v]);
+	for (int v = 0; v < valueCount; ++v)
+		nodeSlots[v] = store->allocateSlot(timeCount, /*initialise*/false);
+	EXPECT_TRUE(store->copySlots(valueCount, templateSlots, &(nodeSlots[0])));
+	for (int v = 0; v < valueCount; ++v)
+		for (int t = 0; t < timeCount; ++t)
+			EXPECT_DOUBLE_EQ(0.0, store->getValue(nodeSlots[v], t));
+
+	// copying set values reaches times not resident through the file
+	for (int t = 0; t < timeCount; ++t)
+		EXPECT_TRUE(store->setValue(nodeSlots[0], t, -2.0*t));
+	const int lastSlot = nodeSlots[(nodeCount - 1)*valueCount];
+	EXPECT_TRUE(store->copySlots(1, &(nodeSlots[0]), &lastSlot));
+	EXPECT_GE(2, store->getNumberOfResidentTimes());
+	for (int t = timeCount - 1; t >= 0; --t)
+		EXPECT_DOUBLE_EQ(-2.0*t, store->getValue(lastSlot, t));
+	delete store;
+
+	FILE *file = fopen(fileName, "rb");
+	EXPECT_EQ(static_cast<FILE *>(0), file);
+	if (file)
+		fclose(file);
+}
@@ -0,0 +1,195 @@
+/*
+ * OpenCMISS-Zinc Library Unit Tests
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <gtest/gtest.h>
+
+#include "zinctestsetupcpp.hpp"
+#include "opencmiss/zinc/element.hpp"
+#include "opencmiss/zinc/field.hpp"
+#include "opencmiss/zinc/fieldmodule.hpp"
+#include "opencmiss/zinc/graphics.hpp"
+#include "opencmiss/zinc/region.hpp"
+#include "opencmiss/zinc/scene.hpp"
+
+#include "general/debug.h"
+#include "graphics/graphics.h"
+#include "graphics/graphics_object.h"
+#include "graphics/graphics_vertex_array.hpp"
+#include "graphics/scene.hpp"
+
+#include "test_resources.h"
+
+// every attribute type up to the last before the count has its own buffer
+TEST(Graphics_vertex_array, attribute_type_slots)
+{
+	Graphics_vertex_array array(GRAPHICS_VERTEX_ARRAY_TYPE_FLOAT_SEPARATE_DRAW_ARRAYS);
+	for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+	{
+		const GLfloat values[2] = { static_cast<GLfloat>(i), static_cast<GLfloat>(-i) };
+		EXPECT_EQ(1, array.add_float_attribute(
+			static_cast<Graphics_vertex_array_attribute_type>(i), 2, 1, values));
+	}
+	for (int i = 0; i < GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_COUNT; ++i)
+	{
+		GLfloat *buffer = 0;
+		unsigned int values_per_vertex = 0, vertex_count = 0;
+		EXPECT_EQ(1, array.get_float_vertex_buffer(
+			static_cast<Graphics_vertex_array_attribute_type>(i), &buffer, &values_per_vertex, &vertex_count));
+		EXPECT_EQ(2u, values_per_vertex);
+		EXPECT_EQ(1u, vertex_count);
+		ASSERT_NE(static_cast<GLfloat *>(0), buffer);
+		EXPECT_EQ(static_cast<GLfloat>(i), buffer[0]);
+		EXPECT_EQ(static_cast<GLfloat>(-i), buffer[1]);
+	}
+}
+
+TEST(Graphics_vertex_array, reserve_and_free_unused)
+{
+	Graphics_vertex_array array(GRAPHICS_VERTEX_ARRAY_TYPE_FLOAT_SEPARATE_DRAW_ARRAYS);
+	EXPECT_EQ(1, array.reserve_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION, 3, 1000));
+	EXPECT_EQ(0u, array.get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION));
+	EXPECT_EQ(1000*3*sizeof(GLfloat), array.get_memory_size());
+
+	GLfloat positions[10][3];
+	for (int v = 0; v < 10; ++v)
+		for (int c = 0; c < 3; ++c)
+			positions[v][c] = static_cast<GLfloat>(v*3 + c);
+	EXPECT_EQ(1, array.add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION, 3, 10, positions[0]));
+	// adding within the reservation does not reallocate
+	EXPECT_EQ(1000*3*sizeof(GLfloat), array.get_memory_size());
+
+	EXPECT_EQ(1, array.free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION));
+	EXPECT_EQ(10*3*sizeof(GLfloat), array.get_memory_size());
+	EXPECT_EQ(10u, array.get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION));
+	GLfloat *buffer = 0;
+	unsigned int values_per_vertex = 0, vertex_count = 0;
+	EXPECT_EQ(1, array.get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		&buffer, &values_per_vertex, &vertex_count));
+	ASSERT_NE(static_cast<GLfloat *>(0), buffer);
+	for (int i = 0; i < 30; ++i)
+		EXPECT_EQ(positions[0][i], buffer[i]);
+	// already exact: succeeds without change
+	EXPECT_EQ(1, array.free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION));
+	EXPECT_EQ(10*3*sizeof(GLfloat), array.get_memory_size());
+
+	// no buffer for this type
+	EXPECT_EQ(0, array.free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL));
+
+	// buffer with no vertices is released
+	EXPECT_EQ(1, array.reserve_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL, 3, 50));
+	EXPECT_EQ((10 + 50)*3*sizeof(GLfloat), array.get_memory_size());
+	EXPECT_EQ(1, array.free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL));
+	EXPECT_EQ(10*3*sizeof(GLfloat), array.get_memory_size());
+}
+
+TEST(Graphics_vertex_array, interleaved_float_vertex_buffer)
+{
+	Graphics_vertex_array array(GRAPHICS_VERTEX_ARRAY_TYPE_FLOAT_SEPARATE_DRAW_ARRAYS);
+	const GLfloat positions[4][3] =
+		{ { 0.0, 0.0, 0.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 1.0, 1.0, 0.0 } };
+	const GLfloat normals[4][3] =
+		{ { 0.0, 0.0, 1.0 }, { 0.0, 0.0, 2.0 }, { 0.0, 0.0, 3.0 }, { 0.0, 0.0, 4.0 } };
+	const GLfloat data[4] = { 10.0, 20.0, 30.0, 40.0 };
+	EXPECT_EQ(1, array.add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION, 3, 4, positions[0]));
+	EXPECT_EQ(1, array.add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL, 3, 4, normals[0]));
+	EXPECT_EQ(1, array.add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA, 1, 4, data));
+
+	const Graphics_vertex_array_attribute_type vertex_types[3] =
+	{
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA
+	};
+	GLfloat *interleaved = 0;
+	unsigned int values_per_vertex = 0, vertex_count = 0;
+	EXPECT_EQ(1, array.get_interleaved_float_vertex_buffer(3, vertex_types,
+		&interleaved, &values_per_vertex, &vertex_count));
+	EXPECT_EQ(7u, values_per_vertex);
+	EXPECT_EQ(4u, vertex_count);
+	ASSERT_NE(static_cast<GLfloat *>(0), interleaved);
+	for (int v = 0; v < 4; ++v)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			EXPECT_EQ(positions[v][c], interleaved[v*7 + c]);
+			EXPECT_EQ(normals[v][c], interleaved[v*7 + 3 + c]);
+		}
+		EXPECT_EQ(data[v], interleaved[v*7 + 6]);
+	}
+	DEALLOCATE(interleaved);
+
+	// mismatched vertex counts and missing buffers fail
+	EXPECT_EQ(1, array.add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA, 1, 1, data));
+	EXPECT_EQ(0, array.get_interleaved_float_vertex_buffer(3, vertex_types,
+		&interleaved, &values_per_vertex, &vertex_count));
+	EXPECT_EQ(static_cast<GLfloat *>(0), interleaved);
+	const Graphics_vertex_array_attribute_type missing_types[2] =
+	{
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_TANGENT
+	};
+	EXPECT_EQ(0, array.get_interleaved_float_vertex_buffer(2, missing_types,
+		&interleaved, &values_per_vertex, &vertex_count));
+}
+
+namespace {
+
+Graphics_vertex_array *getGraphicsVertexArray(OpenCMISS::Zinc::Graphics &graphics)
+{
+	cmzn_graphics *graphics_internal = graphics.getId();
+	if (!graphics_internal->graphics_object)
+		return 0;
+	return GT_object_get_vertex_set(graphics_internal->graphics_object);
+}
+
+}
+
+// vertex buffers reserved for a surfaces build on a face subset of a mesh are
+// shrunk to the vertices actually generated
+TEST(Graphics_vertex_array, surfaces_build_reservation)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	EXPECT_EQ(CMZN_OK, result = zinc.fm.defineAllFaces());
+	const int faceCount = zinc.fm.findMeshByDimension(2).getSize();
+	EXPECT_EQ(6, faceCount);
+	OpenCMISS::Zinc::Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	OpenCMISS::Zinc::Scene scene = zinc.root_region.getScene();
+	OpenCMISS::Zinc::GraphicsSurfaces allSurfaces = scene.createGraphicsSurfaces();
+	EXPECT_EQ(CMZN_OK, result = allSurfaces.setCoordinateField(coordinates));
+	OpenCMISS::Zinc::GraphicsSurfaces faceSurfaces = scene.createGraphicsSurfaces();
+	EXPECT_EQ(CMZN_OK, result = faceSurfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, result = faceSurfaces.setExterior(true));
+	EXPECT_EQ(CMZN_OK, result = faceSurfaces.setElementFaceType(OpenCMISS::Zinc::Element::FACE_TYPE_XI3_0));
+	EXPECT_EQ(1, build_Scene(scene.getId(), static_cast<cmzn_scenefilter *>(0)));
+
+	Graphics_vertex_array *allArray = getGraphicsVertexArray(allSurfaces);
+	Graphics_vertex_array *faceArray = getGraphicsVertexArray(faceSurfaces);
+	ASSERT_NE(static_cast<Graphics_vertex_array *>(0), allArray);
+	ASSERT_NE(static_cast<Graphics_vertex_array *>(0), faceArray);
+	const unsigned int allVertexCount = allArray->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	const unsigned int faceVertexCount = faceArray->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	EXPECT_LT(0u, faceVertexCount);
+	EXPECT_EQ(faceCount*faceVertexCount, allVertexCount);
+	EXPECT_EQ(faceVertexCount, faceArray->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL));
+
+	// position and normal buffers are already exact after the build
+	Graphics_vertex_array *arrays[2] = { allArray, faceArray };
+	for (int i = 0; i < 2; ++i)
+	{
+		const size_t memorySize = arrays[i]->get_memory_size();
+		EXPECT_EQ(1, arrays[i]->free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION));
+		EXPECT_EQ(1, arrays[i]->free_unused_buffer_memory(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL));
+		EXPECT_EQ(memorySize, arrays[i]->get_memory_size());
+	}
+}
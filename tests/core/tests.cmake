@@ -0,0 +1,13 @@
+# OpenCMISS-Zinc Library Unit Tests
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+SET(CURRENT_TEST core)
+LIST(APPEND CORE_TESTS ${CURRENT_TEST})
+SET(${CURRENT_TEST}_SRC
+    ${CURRENT_TEST}/computed_field_update.cpp
+    ${CURRENT_TEST}/finite_element_time_series_store.cpp
+    ${CURRENT_TEST}/graphics_vertex_array.cpp
+    )
@@ -0,0 +1,105 @@
+/*
+ * OpenCMISS-Zinc Library Unit Tests
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include <opencmiss/zinc/fieldmodule.hpp>
+#include <opencmiss/zinc/region.hpp>
+#include <opencmiss/zinc/streamregion.hpp>
+
+#include "utilities/zinctestsetupcpp.hpp"
+#include "utilities/fileio.hpp"
+
+#include "test_resources.h"
+
+#define EXBINARY_OUTPUT_FOLDER "exbinarytest"
+
+namespace {
+ManageOutputFolder manageOutputFolderExBinary(EXBINARY_OUTPUT_FOLDER);
+}
+
+namespace {
+
+std::string write_region_to_string(Region& region,
+	StreaminformationRegion::FileFormat fileFormat)
+{
+	int result;
+	StreaminformationRegion sir = region.createStreaminformationRegion();
+	EXPECT_EQ(OK, result = sir.setFileFormat(fileFormat));
+	StreamresourceMemory resource = sir.createStreamresourceMemory();
+	EXPECT_EQ(OK, result = region.write(sir));
+	void *buffer = 0;
+	unsigned int bufferSize = 0;
+	EXPECT_EQ(OK, result = resource.getBuffer(&buffer, &bufferSize));
+	return std::string(static_cast<const char *>(buffer), bufferSize);
+}
+
+// checks EX text output of model in resource is unchanged by writing to and
+// reading from binary EX format
+void check_ex_binary_round_trip(TestResources::ResourcesName resourceName)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(TestResources::getLocation(resourceName)));
+	const std::string exText = write_region_to_string(zinc.root_region,
+		StreaminformationRegion::FILE_FORMAT_EX);
+	const std::string exBinary = write_region_to_string(zinc.root_region,
+		StreaminformationRegion::FILE_FORMAT_EX_BINARY);
+	EXPECT_NE(exText, exBinary);
+
+	Region region2 = zinc.context.createRegion();
+	StreaminformationRegion sir2 = region2.createStreaminformationRegion();
+	StreamresourceMemory resource2 = sir2.createStreamresourceMemoryBuffer(exBinary.data(),
+		static_cast<unsigned int>(exBinary.size()));
+	EXPECT_EQ(OK, result = region2.read(sir2));
+	EXPECT_EQ(exText, write_region_to_string(region2, StreaminformationRegion::FILE_FORMAT_EX));
+}
+
+}
+
+TEST(ZincExBinary, round_trip_hermite_scale_factors)
+{
+	check_ex_binary_round_trip(TestResources::FIELDIO_EX_HERMITE_FIGURE8_RESOURCE);
+}
+
+TEST(ZincExBinary, round_trip_grid_values)
+{
+	check_ex_binary_round_trip(TestResources::FIELDMODULE_CUBE_GRID_RESOURCE);
+}
+
+TEST(ZincExBinary, round_trip_groups_and_faces)
+{
+	check_ex_binary_round_trip(TestResources::FIELDMODULE_CUBESQUARELINE_RESOURCE);
+}
+
+TEST(ZincExBinary, round_trip_all_shapes)
+{
+	check_ex_binary_round_trip(TestResources::FIELDMODULE_ALLSHAPES_RESOURCE);
+}
+
+TEST(ZincExBinary, write_read_file)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDIO_EX_HERMITE_FIGURE8_RESOURCE)));
+	const std::string exText = write_region_to_string(zinc.root_region,
+		StreaminformationRegion::FILE_FORMAT_EX);
+
+	StreaminformationRegion sir = zinc.root_region.createStreaminformationRegion();
+	EXPECT_EQ(OK, result = sir.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX_BINARY));
+	StreamresourceFile resource = sir.createStreamresourceFile(EXBINARY_OUTPUT_FOLDER "/figure8.exbin");
+	EXPECT_TRUE(resource.isValid());
+	EXPECT_EQ(OK, result = zinc.root_region.write(sir));
+
+	// binary format is detected when reading
+	Region region2 = zinc.context.createRegion();
+	EXPECT_EQ(OK, result = region2.readFile(EXBINARY_OUTPUT_FOLDER "/figure8.exbin"));
+	EXPECT_EQ(exText, write_region_to_string(region2, StreaminformationRegion::FILE_FORMAT_EX));
+}
@@ -8,6 +8,8 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdio>
+#include <string>
 
 #include <opencmiss/zinc/field.hpp>
 #include <opencmiss/zinc/fieldcache.hpp>
@@ -112,6 +114,39 @@ TEST(ZincRegion, fieldml_cube)
 	check_cube_model(testFm2);
 }
 
+// write node parameters and element connectivity to external binary resource
+TEST(ZincRegion, fieldml_cube_binary)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDIO_FIELDML_CUBE_RESOURCE)));
+	check_cube_model(zinc.fm);
+
+	StreaminformationRegion sir = zinc.root_region.createStreaminformationRegion();
+	EXPECT_EQ(OK, result = sir.setFileFormat(StreaminformationRegion::FILE_FORMAT_FIELDML_BINARY));
+	StreamresourceFile resource = sir.createStreamresourceFile(FIELDML_OUTPUT_FOLDER "/cube_binary.fieldml");
+	EXPECT_TRUE(resource.isValid());
+	EXPECT_EQ(OK, result = zinc.root_region.write(sir));
+	FILE *binaryFile = fopen(FIELDML_OUTPUT_FOLDER "/cube_binary.fieldml.bin", "rb");
+	EXPECT_TRUE(binaryFile != 0);
+	if (binaryFile)
+		fclose(binaryFile);
+
+	// binary resource is found relative to FieldML file
+	Region testRegion = zinc.root_region.createChild("test");
+	EXPECT_EQ(OK, result = testRegion.readFile(FIELDML_OUTPUT_FOLDER "/cube_binary.fieldml"));
+	Fieldmodule testFm = testRegion.getFieldmodule();
+	check_cube_model(testFm);
+
+	// cannot write FieldML to memory
+	StreaminformationRegion sirMemory = zinc.root_region.createStreaminformationRegion();
+	EXPECT_EQ(OK, result = sirMemory.setFileFormat(StreaminformationRegion::FILE_FORMAT_FIELDML_BINARY));
+	StreamresourceMemory memoryResource = sirMemory.createStreamresourceMemory();
+	EXPECT_EQ(ERROR_ARGUMENT, result = zinc.root_region.write(sirMemory));
+}
+
 // Also reads cube model, but tries to read it as EX format which should fail
 TEST(ZincStreaminformationRegion, fileFormat)
 {
@@ -577,6 +612,44 @@ TEST(ZincRegion, mixed_template_squares)
 	check_mixed_template_squares(testFm2);
 }
 
+// Fields not defined on the whole mesh have sparse node parameters, written
+// to the binary resource as DOK (dictionary of keys) arrays with a separate
+// array of node keys per record.
+TEST(ZincRegion, mixed_template_squares_binary)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	create_mixed_template_squares(zinc.fm);
+	check_mixed_template_squares(zinc.fm);
+
+	StreaminformationRegion sir = zinc.root_region.createStreaminformationRegion();
+	EXPECT_EQ(OK, result = sir.setFileFormat(StreaminformationRegion::FILE_FORMAT_FIELDML_BINARY));
+	StreamresourceFile resource = sir.createStreamresourceFile(FIELDML_OUTPUT_FOLDER "/mixed_template_squares_binary.fieldml");
+	EXPECT_TRUE(resource.isValid());
+	EXPECT_EQ(OK, result = zinc.root_region.write(sir));
+
+	// check sparse parameters were written with key arrays
+	std::string fieldmlText;
+	FILE *fieldmlFile = fopen(FIELDML_OUTPUT_FOLDER "/mixed_template_squares_binary.fieldml", "r");
+	EXPECT_TRUE(fieldmlFile != 0);
+	if (fieldmlFile)
+	{
+		char buffer[1024];
+		size_t size;
+		while (0 < (size = fread(buffer, 1, sizeof(buffer), fieldmlFile)))
+			fieldmlText.append(buffer, size);
+		fclose(fieldmlFile);
+	}
+	EXPECT_NE(std::string::npos, fieldmlText.find("DOKArrayData"));
+	EXPECT_NE(std::string::npos, fieldmlText.find(".key.data.source"));
+
+	Region testRegion = zinc.root_region.createChild("test");
+	EXPECT_EQ(OK, result = testRegion.readFile(FIELDML_OUTPUT_FOLDER "/mixed_template_squares_binary.fieldml"));
+	Fieldmodule testFm = testRegion.getFieldmodule();
+	check_mixed_template_squares(testFm);
+}
+
 namespace {
 
 void check_lines_unit_scale_factors_model(Fieldmodule& fm)
@@ -7,6 +7,7 @@
 SET(CURRENT_TEST fieldio)
 LIST(APPEND API_TESTS ${CURRENT_TEST})
 SET(${CURRENT_TEST}_SRC
+	${CURRENT_TEST}/ex_binary.cpp
 	${CURRENT_TEST}/fieldml_basic.cpp
 	${CURRENT_TEST}/fieldml_hermite.cpp
 	utilities/fileio.cpp
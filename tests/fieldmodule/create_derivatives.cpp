@@ -26,7 +26,13 @@
 #include <opencmiss/zinc/differentialoperator.hpp>
 #include <opencmiss/zinc/element.hpp>
 #include <opencmiss/zinc/field.hpp>
+#include <opencmiss/zinc/fieldarithmeticoperators.hpp>
 #include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldcomposite.hpp>
+#include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/logger.hpp>
+#include <opencmiss/zinc/node.hpp>
 
 #include "test_resources.h"
 
@@ -500,3 +506,156 @@ TEST(ZincField, issue_3812_grid_derivatives_non_first_component)
 	for (int i = 0; i < 4; ++i)
 		ASSERT_DOUBLE_EQ(expected_dx_dxi3[i], dx_dxi3[i]);
 }
+
+namespace {
+
+// check second derivatives against central differences of first derivatives
+void checkSecondDerivativesByFiniteDifference(Field& field, Mesh& mesh,
+	Element& element, const double *xi)
+{
+	const int dimension = mesh.getDimension();
+	const int componentsCount = field.getNumberOfComponents();
+	Fieldcache cache = field.getFieldmodule().createFieldcache();
+	const double h = 1.0E-5;
+	double d2f[4], dfPlus[4], dfMinus[4], xiH[3];
+	for (int i = 1; i <= dimension; ++i)
+	{
+		Differentialoperator d_dxi = mesh.getChartDifferentialoperator(1, i);
+		for (int j = 1; j <= dimension; ++j)
+		{
+			Differentialoperator d2_dxi2 = mesh.getChartDifferentialoperator(2, (i - 1)*dimension + j);
+			EXPECT_TRUE(d2_dxi2.isValid());
+			EXPECT_EQ(OK, cache.setMeshLocation(element, dimension, xi));
+			EXPECT_EQ(OK, field.evaluateDerivative(d2_dxi2, cache, componentsCount, d2f));
+			for (int k = 0; k < dimension; ++k)
+				xiH[k] = xi[k];
+			xiH[j - 1] = xi[j - 1] + h;
+			EXPECT_EQ(OK, cache.setMeshLocation(element, dimension, xiH));
+			EXPECT_EQ(OK, field.evaluateDerivative(d_dxi, cache, componentsCount, dfPlus));
+			xiH[j - 1] = xi[j - 1] - h;
+			EXPECT_EQ(OK, cache.setMeshLocation(element, dimension, xiH));
+			EXPECT_EQ(OK, field.evaluateDerivative(d_dxi, cache, componentsCount, dfMinus));
+			for (int c = 0; c < componentsCount; ++c)
+				EXPECT_NEAR((dfPlus[c] - dfMinus[c])/(2.0*h), d2f[c], 1.0E-6);
+		}
+	}
+}
+
+}
+
+TEST(ZincDifferentialoperator, secondDerivatives)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Mesh mesh = zinc.fm.findMeshByDimension(3);
+	EXPECT_TRUE(mesh.isValid());
+
+	EXPECT_FALSE(mesh.getChartDifferentialoperator(2, 0).isValid());
+	EXPECT_FALSE(mesh.getChartDifferentialoperator(2, 10).isValid());
+	EXPECT_FALSE(mesh.getChartDifferentialoperator(3, 1).isValid());
+	Differentialoperator d2_dxi1dxi1 = mesh.getChartDifferentialoperator(2, 1);
+	EXPECT_TRUE(d2_dxi1dxi1.isValid());
+	Differentialoperator d2_dxi1dxi2 = mesh.getChartDifferentialoperator(2, 2);
+	EXPECT_TRUE(d2_dxi1dxi2.isValid());
+	Differentialoperator d2_dxi1dxi3 = mesh.getChartDifferentialoperator(2, 3);
+	EXPECT_TRUE(d2_dxi1dxi3.isValid());
+	Differentialoperator d2_dxi2dxi1 = mesh.getChartDifferentialoperator(2, 4);
+	EXPECT_TRUE(d2_dxi2dxi1.isValid());
+	Differentialoperator d2_dxi2dxi2 = mesh.getChartDifferentialoperator(2, 5);
+	EXPECT_TRUE(d2_dxi2dxi2.isValid());
+
+	// move node 4 so x = xi1 + xi1*xi2*(1 - xi3)
+	Fieldcache cache = zinc.fm.createFieldcache();
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Node node4 = nodes.findNodeByIdentifier(4);
+	EXPECT_TRUE(node4.isValid());
+	EXPECT_EQ(OK, result = cache.setNode(node4));
+	const double newX[3] = { 2.0, 1.0, 0.0 };
+	EXPECT_EQ(OK, result = coordinates.assignReal(cache, 3, newX));
+
+	Element element = mesh.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	const double xi[3] = { 0.5, 0.5, 0.25 };
+	EXPECT_EQ(OK, result = cache.setMeshLocation(element, 3, xi));
+	double values[3];
+	EXPECT_EQ(OK, result = coordinates.evaluateDerivative(d2_dxi1dxi1, cache, 3, values));
+	for (int c = 0; c < 3; ++c)
+		EXPECT_DOUBLE_EQ(0.0, values[c]);
+	EXPECT_EQ(OK, result = coordinates.evaluateDerivative(d2_dxi1dxi2, cache, 3, values));
+	EXPECT_DOUBLE_EQ(0.75, values[0]);
+	EXPECT_DOUBLE_EQ(0.0, values[1]);
+	EXPECT_DOUBLE_EQ(0.0, values[2]);
+	EXPECT_EQ(OK, result = coordinates.evaluateDerivative(d2_dxi2dxi1, cache, 3, values));
+	EXPECT_DOUBLE_EQ(0.75, values[0]);
+	EXPECT_EQ(OK, result = coordinates.evaluateDerivative(d2_dxi1dxi3, cache, 3, values));
+	EXPECT_DOUBLE_EQ(-0.5, values[0]);
+
+	// f = x*y = xi1*xi2 + xi1*xi2*xi2*(1 - xi3)
+	Field x = zinc.fm.createFieldComponent(coordinates, 1);
+	Field y = zinc.fm.createFieldComponent(coordinates, 2);
+	Field f = zinc.fm.createFieldMultiply(x, y);
+	EXPECT_TRUE(f.isValid());
+	EXPECT_EQ(OK, result = f.evaluateDerivative(d2_dxi2dxi2, cache, 1, values));
+	EXPECT_DOUBLE_EQ(0.75, values[0]);
+	EXPECT_EQ(OK, result = f.evaluateDerivative(d2_dxi1dxi2, cache, 1, values));
+	EXPECT_DOUBLE_EQ(1.75, values[0]);
+
+	const double two = 2.0;
+	Field g = zinc.fm.createFieldDivide(
+		zinc.fm.createFieldAdd(f, zinc.fm.createFieldConstant(1, &two)),
+		zinc.fm.createFieldMagnitude(coordinates));
+	checkSecondDerivativesByFiniteDifference(g, mesh, element, xi);
+	const Field sourceFields[2] = { zinc.fm.createFieldDotProduct(coordinates, coordinates), x };
+	Field h = zinc.fm.createFieldConcatenate(2, sourceFields);
+	checkSecondDerivativesByFiniteDifference(h, mesh, element, xi);
+	Field k = zinc.fm.createFieldCrossProduct(coordinates, zinc.fm.createFieldSubtract(
+		zinc.fm.findFieldByName("xi"), coordinates));
+	checkSecondDerivativesByFiniteDifference(k, mesh, element, xi);
+
+	// fields not supporting second derivatives
+	EXPECT_EQ(OK, result = cache.setMeshLocation(element, 3, xi));
+	Field sqrtField = zinc.fm.createFieldSqrt(zinc.fm.createFieldMagnitude(coordinates));
+	EXPECT_EQ(OK, result = sqrtField.evaluateReal(cache, 1, values));
+	EXPECT_EQ(ERROR_NOT_IMPLEMENTED, result = sqrtField.evaluateDerivative(d2_dxi1dxi1, cache, 1, values));
+	Differentialoperator d_dxi1 = mesh.getChartDifferentialoperator(1, 1);
+	EXPECT_EQ(OK, result = sqrtField.evaluateDerivative(d_dxi1, cache, 1, values));
+}
+
+// grid-based components do not support second derivatives, which is reported
+// without logging errors as callers may request them at every point
+TEST(ZincDifferentialoperator, secondDerivativesGridNotImplemented)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_GRID_RESOURCE)));
+	Field potential = zinc.fm.findFieldByName("potential");
+	EXPECT_TRUE(potential.isValid());
+	Mesh mesh = zinc.fm.findMeshByDimension(3);
+	Differentialoperator d2_dxi1dxi1 = mesh.getChartDifferentialoperator(2, 1);
+	EXPECT_TRUE(d2_dxi1dxi1.isValid());
+	Differentialoperator d_dxi1 = mesh.getChartDifferentialoperator(1, 1);
+	EXPECT_TRUE(d_dxi1.isValid());
+
+	Logger logger = zinc.context.getLogger();
+	EXPECT_EQ(OK, result = logger.removeAllMessages());
+	Fieldcache cache = zinc.fm.createFieldcache();
+	Element element = mesh.findElementByIdentifier(1);
+	double value;
+	for (int i = 0; i < 10; ++i)
+	{
+		const double xi[3] = { 0.1*i, 0.25, 0.5 };
+		EXPECT_EQ(OK, result = cache.setMeshLocation(element, 3, xi));
+		EXPECT_EQ(ERROR_NOT_IMPLEMENTED, result = potential.evaluateDerivative(d2_dxi1dxi1, cache, 1, &value));
+		EXPECT_EQ(OK, result = potential.evaluateDerivative(d_dxi1, cache, 1, &value));
+	}
+	EXPECT_EQ(0, logger.getNumberOfMessages());
+}
@@ -20,8 +20,14 @@
 #include <opencmiss/zinc/region.h>
 #include <opencmiss/zinc/status.h>
 
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldnodesetoperators.hpp>
+#include <opencmiss/zinc/node.hpp>
+
 #include "test_resources.h"
 #include "zinctestsetup.hpp"
+#include "zinctestsetupcpp.hpp"
 
 TEST(cmzn_fieldmodule_create_field_nodeset_minimum, invalid_args)
 {
@@ -226,3 +232,97 @@ TEST(cmzn_fieldmodule_create_field_nodeset_maximum, multiplecomponents)
 
 }
 
+// test nodeset operators re-evaluate correctly when only some nodes change,
+// including inside begin/end change and after adding and removing nodes
+TEST(ZincFieldNodesetOperators, partialChanges)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldFiniteElement field = zinc.fm.createFieldFiniteElement(1);
+	EXPECT_TRUE(field.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(OK, nodetemplate.defineField(field));
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int nodeCount = 1000;
+	zinc.fm.beginChange();
+	for (int i = 1; i <= nodeCount; ++i)
+	{
+		Node node = nodes.createNode(i, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(OK, fieldcache.setNode(node));
+		const double value = static_cast<double>(i);
+		EXPECT_EQ(OK, field.assignReal(fieldcache, 1, &value));
+	}
+	zinc.fm.endChange();
+
+	Field sum = zinc.fm.createFieldNodesetSum(field, nodes);
+	Field mean = zinc.fm.createFieldNodesetMean(field, nodes);
+	Field sumSquares = zinc.fm.createFieldNodesetSumSquares(field, nodes);
+	Field minimum = zinc.fm.createFieldNodesetMinimum(field, nodes);
+	Field maximum = zinc.fm.createFieldNodesetMaximum(field, nodes);
+	EXPECT_TRUE(maximum.isValid());
+
+	double expectedSum = 0.5*nodeCount*(nodeCount + 1);
+	double expectedSumSquares = nodeCount*(nodeCount + 1)*(2*nodeCount + 1)/6.0;
+	double value;
+	fieldcache.clearLocation();
+	EXPECT_EQ(OK, sum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+	EXPECT_EQ(OK, sumSquares.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSumSquares, value);
+	EXPECT_EQ(OK, minimum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(1.0, value);
+	EXPECT_EQ(OK, maximum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(static_cast<double>(nodeCount), value);
+
+	// change a single node
+	Fieldcache nodecache = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, nodecache.setNode(nodes.findNodeByIdentifier(500)));
+	const double newValue = 5000.0;
+	EXPECT_EQ(OK, field.assignReal(nodecache, 1, &newValue));
+	expectedSum += 4500.0;
+	expectedSumSquares += 5000.0*5000.0 - 500.0*500.0;
+	EXPECT_EQ(OK, sum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+	EXPECT_EQ(OK, sumSquares.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSumSquares, value);
+	EXPECT_EQ(OK, maximum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(5000.0, value);
+
+	// evaluate in the middle of changes
+	zinc.fm.beginChange();
+	EXPECT_EQ(OK, nodecache.setNode(nodes.findNodeByIdentifier(1)));
+	const double lowValue = -7.0;
+	EXPECT_EQ(OK, field.assignReal(nodecache, 1, &lowValue));
+	expectedSum -= 8.0;
+	EXPECT_EQ(OK, minimum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(-7.0, value);
+	EXPECT_EQ(OK, sum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+	zinc.fm.endChange();
+	EXPECT_EQ(OK, minimum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(-7.0, value);
+	EXPECT_EQ(OK, sum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+
+	// remove the node with the maximum value, add a node in a new block
+	EXPECT_EQ(OK, nodes.destroyNode(nodes.findNodeByIdentifier(500)));
+	Node node = nodes.createNode(100000, nodetemplate);
+	EXPECT_EQ(OK, nodecache.setNode(node));
+	const double addValue = 2.5;
+	EXPECT_EQ(OK, field.assignReal(nodecache, 1, &addValue));
+	expectedSum += 2.5 - 5000.0;
+	EXPECT_EQ(OK, sum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum, value);
+	EXPECT_EQ(OK, mean.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum/nodeCount, value);
+	EXPECT_EQ(OK, maximum.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(static_cast<double>(nodeCount), value);
+
+	// nodes without the field are not terms
+	Nodetemplate emptyNodetemplate = nodes.createNodetemplate();
+	EXPECT_TRUE(nodes.createNode(100001, emptyNodetemplate).isValid());
+	EXPECT_EQ(OK, mean.evaluateReal(fieldcache, 1, &value));
+	EXPECT_DOUBLE_EQ(expectedSum/nodeCount, value);
+}
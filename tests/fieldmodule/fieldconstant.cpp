@@ -7,11 +7,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
 
+#include <opencmiss/zinc/core.h>
 #include <opencmiss/zinc/field.h>
 #include <opencmiss/zinc/fieldarithmeticoperators.h>
 #include <opencmiss/zinc/fieldcache.h>
 #include <opencmiss/zinc/fieldconstant.h>
+#include <opencmiss/zinc/fieldmodule.h>
 #include <opencmiss/zinc/status.h>
 
 #include "zinctestsetup.hpp"
@@ -89,3 +92,77 @@ TEST(cmzn_field_constant, issue_3348_assign)
 	cmzn_field_destroy(&f2);
 	cmzn_field_destroy(&f3);
 }
+
+TEST(cmzn_fieldmodule, profiling)
+{
+	ZincTestSetup zinc;
+
+	const double value1 = 2.0;
+	cmzn_field_id f1 = cmzn_fieldmodule_create_field_constant(zinc.fm, 1, &value1);
+	EXPECT_NE((cmzn_field_id)0, f1);
+	EXPECT_EQ(CMZN_OK, cmzn_field_set_name(f1, "f1"));
+	const double value2 = 1.0;
+	cmzn_field_id f2 = cmzn_fieldmodule_create_field_constant(zinc.fm, 1, &value2);
+	EXPECT_NE((cmzn_field_id)0, f2);
+	cmzn_field_id f3 = cmzn_fieldmodule_create_field_add(zinc.fm, f1, f2);
+	EXPECT_NE((cmzn_field_id)0, f3);
+	EXPECT_EQ(CMZN_OK, cmzn_field_set_name(f3, "sum"));
+
+	EXPECT_FALSE(cmzn_fieldmodule_is_profiling_enabled(zinc.fm));
+	cmzn_fieldcache_id cache = cmzn_fieldmodule_create_fieldcache(zinc.fm);
+	double value = 0.0;
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(f3, cache, 1, &value));
+	int hits = -1, misses = -1;
+	double inclusiveTime = -1.0, exclusiveTime = -1.0;
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_get_field_profile(zinc.fm, f3, &hits, &misses, &inclusiveTime, &exclusiveTime));
+	EXPECT_EQ(0, hits);
+	EXPECT_EQ(0, misses);
+	EXPECT_EQ(0.0, inclusiveTime);
+	EXPECT_EQ(0.0, exclusiveTime);
+
+	// existing caches start profiling when enabled
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_set_profiling_enabled(zinc.fm, true));
+	EXPECT_TRUE(cmzn_fieldmodule_is_profiling_enabled(zinc.fm));
+	EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_time(cache, 1.0));
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(f3, cache, 1, &value));
+	EXPECT_EQ(value1 + value2, value);
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(f3, cache, 1, &value));
+	EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_time(cache, 2.0));
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(f3, cache, 1, &value));
+
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_get_field_profile(zinc.fm, f3, &hits, &misses, &inclusiveTime, &exclusiveTime));
+	EXPECT_EQ(1, hits);
+	EXPECT_EQ(2, misses);
+	EXPECT_LE(0.0, exclusiveTime);
+	EXPECT_LE(exclusiveTime, inclusiveTime);
+	double sourceInclusiveTime = -1.0;
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_get_field_profile(zinc.fm, f1, &hits, &misses, &sourceInclusiveTime, 0));
+	EXPECT_EQ(0, hits);
+	EXPECT_EQ(2, misses);
+	EXPECT_LE(sourceInclusiveTime, inclusiveTime);
+
+	char *report = cmzn_fieldmodule_get_profile_report(zinc.fm);
+	EXPECT_NE((char *)0, report);
+	EXPECT_NE((char *)0, strstr(report, "sum\t3\t1\t2\t"));
+	EXPECT_NE((char *)0, strstr(report, "f1\t2\t0\t2\t"));
+	cmzn_deallocate(report);
+
+	// records are kept when disabled, until reset
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_set_profiling_enabled(zinc.fm, false));
+	EXPECT_EQ(CMZN_OK, cmzn_fieldcache_set_time(cache, 3.0));
+	EXPECT_EQ(CMZN_OK, cmzn_field_evaluate_real(f3, cache, 1, &value));
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_get_field_profile(zinc.fm, f3, &hits, &misses, 0, 0));
+	EXPECT_EQ(1, hits);
+	EXPECT_EQ(2, misses);
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_reset_profiling(zinc.fm));
+	EXPECT_EQ(CMZN_OK, cmzn_fieldmodule_get_field_profile(zinc.fm, f3, &hits, &misses, 0, 0));
+	EXPECT_EQ(0, hits);
+	EXPECT_EQ(0, misses);
+
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_fieldmodule_get_field_profile(zinc.fm, 0, &hits, &misses, 0, 0));
+
+	cmzn_fieldcache_destroy(&cache);
+	cmzn_field_destroy(&f1);
+	cmzn_field_destroy(&f2);
+	cmzn_field_destroy(&f3);
+}
@@ -197,6 +197,151 @@ TEST(ZincFieldImage, create_evaluate)
 	EXPECT_EQ(expectedRGB1[2], outRGB[2]);
 }
 
+// test batch and single evaluation give known texel values and blends for all
+// filter and wrap modes, including points outside the texture
+TEST(ZincFieldImage, evaluateBatch)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	int result;
+	EXPECT_EQ(OK, result = im.readFile(TestResources::getLocation(TestResources::FIELDIMAGE_BLOCKCOLOURS_RESOURCE)));
+	Field xi = im.getDomainField();
+	EXPECT_TRUE(xi.isValid());
+	Fieldcache cache = zinc.fm.createFieldcache();
+	EXPECT_TRUE(cache.isValid());
+
+	// blockcolours is 32x32 texels: (0.2, 0.8) is in an orange block, 0.1 texels
+	// left of the centre of its first texel after a red block; (0.75, 0.2) is
+	// inside a grey block; the border is white; (0.8, 0.8) is in a blue block,
+	// 0.1 texels right of the centre of its last texel before a magenta block,
+	// which mirrored repeat maps 1.2 and -0.8 to
+	const int pointsCount = 4;
+	const double textureCoordinates[pointsCount*2] =
+	{
+		0.2, 0.8,
+		0.75, 0.2,
+		1.2, 0.8,
+		-0.8, 0.8
+	};
+	const double white[3] = { 1.0, 1.0, 1.0 };
+	const double orange[3] = { 1.0, 128.0/255.0, 0.0 };
+	const double orangeRed[3] = { 1.0, 0.9*128.0/255.0, 0.0 };
+	const double grey[3] = { 192.0/255.0, 192.0/255.0, 192.0/255.0 };
+	const double blue[3] = { 0.0, 0.0, 1.0 };
+	const double blueMagenta[3] = { 0.1, 0.0, 1.0 };
+	const FieldImage::FilterMode filterModes[2] = { FieldImage::FILTER_MODE_NEAREST, FieldImage::FILTER_MODE_LINEAR };
+	const FieldImage::WrapMode wrapModes[4] = { FieldImage::WRAP_MODE_CLAMP, FieldImage::WRAP_MODE_EDGE_CLAMP,
+		FieldImage::WRAP_MODE_REPEAT, FieldImage::WRAP_MODE_MIRROR_REPEAT };
+	const double *expectedRGB[2][4][pointsCount] =
+	{
+		{
+			{ orange, grey, white, white },
+			{ orange, grey, white, white },
+			{ orange, grey, orange, orange },
+			{ orange, grey, blue, blue }
+		},
+		{
+			{ orangeRed, grey, white, white },
+			{ orangeRed, grey, white, white },
+			{ orangeRed, grey, orangeRed, orangeRed },
+			{ orangeRed, grey, blueMagenta, blueMagenta }
+		}
+	};
+	double batchRGB[pointsCount*3];
+	double outRGB[3];
+	for (int f = 0; f < 2; ++f)
+	{
+		EXPECT_EQ(OK, result = im.setFilterMode(filterModes[f]));
+		for (int w = 0; w < 4; ++w)
+		{
+			EXPECT_EQ(OK, result = im.setWrapMode(wrapModes[w]));
+			EXPECT_EQ(OK, result = im.evaluateBatch(pointsCount, textureCoordinates, batchRGB));
+			for (int p = 0; p < pointsCount; ++p)
+			{
+				EXPECT_EQ(OK, result = cache.setFieldReal(xi, 2, textureCoordinates + p*2));
+				EXPECT_EQ(OK, result = im.evaluateReal(cache, 3, outRGB));
+				for (int c = 0; c < 3; ++c)
+				{
+					EXPECT_NEAR(expectedRGB[f][w][p][c], batchRGB[p*3 + c], 1.0E-6);
+					EXPECT_NEAR(expectedRGB[f][w][p][c], outRGB[c], 1.0E-6);
+				}
+			}
+		}
+	}
+
+	EXPECT_EQ(OK, result = im.evaluateBatch(0, 0, 0));
+	EXPECT_EQ(ERROR_ARGUMENT, result = im.evaluateBatch(-1, textureCoordinates, batchRGB));
+	EXPECT_EQ(ERROR_ARGUMENT, result = im.evaluateBatch(pointsCount, 0, batchRGB));
+	EXPECT_EQ(ERROR_ARGUMENT, result = im.evaluateBatch(pointsCount, textureCoordinates, 0));
+}
+
+// test batch evaluation of a 16-bit luminance image, including linear blends
+// near the edges which differ between clamp and repeat wrap modes
+TEST(ZincFieldImage, evaluateBatch16Bit)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	int result;
+	EXPECT_EQ(OK, result = im.readFile(TestResources::getLocation(TestResources::FIELDIMAGE_GRAY16_RESOURCE)));
+	EXPECT_EQ(1, result = im.getNumberOfComponents());
+	EXPECT_EQ(4, result = im.getWidthInPixels());
+	EXPECT_EQ(4, result = im.getHeightInPixels());
+
+	// texel (i, j) counting from the bottom left has value 291 + 1024*i + 4096*j
+	// out of 65535. Points are at texel row 1 centre, except the last which is
+	// a quarter texel from the bottom edge at texel column 1 centre.
+	const int pointsCount = 7;
+	const double textureCoordinates[pointsCount*2] =
+	{
+		0.375, 0.375,
+		0.5, 0.375,
+		0.0625, 0.375,
+		0.96875, 0.375,
+		1.25, 0.375,
+		-0.25, 0.375,
+		0.375, 0.0625
+	};
+	const FieldImage::FilterMode filterModes[2] = { FieldImage::FILTER_MODE_NEAREST, FieldImage::FILTER_MODE_LINEAR };
+	const FieldImage::WrapMode wrapModes[4] = { FieldImage::WRAP_MODE_CLAMP, FieldImage::WRAP_MODE_EDGE_CLAMP,
+		FieldImage::WRAP_MODE_REPEAT, FieldImage::WRAP_MODE_MIRROR_REPEAT };
+	const double expectedValues[2][4][pointsCount] =
+	{
+		{
+			{ 5411, 6435, 4387, 7459, 7459, 4387, 1315 },
+			{ 5411, 6435, 4387, 7459, 7459, 4387, 1315 },
+			{ 5411, 6435, 4387, 7459, 5411, 7459, 1315 },
+			{ 5411, 6435, 4387, 7459, 7459, 5411, 1315 }
+		},
+		{
+			// within half a texel of the edge, clamp holds the edge value and
+			// repeat blends with the opposite edge: 0.25*7459 + 0.75*4387 = 5155
+			{ 5411, 5923, 4387, 7459, 7459, 4387, 1315 },
+			{ 5411, 5923, 4387, 7459, 7459, 4387, 1315 },
+			{ 5411, 5923, 5155, 6307, 4899, 6947, 4387 },
+			{ 5411, 5923, 4387, 7459, 6947, 4899, 1315 }
+		}
+	};
+	double values[pointsCount];
+	for (int f = 0; f < 2; ++f)
+	{
+		EXPECT_EQ(OK, result = im.setFilterMode(filterModes[f]));
+		for (int w = 0; w < 4; ++w)
+		{
+			EXPECT_EQ(OK, result = im.setWrapMode(wrapModes[w]));
+			EXPECT_EQ(OK, result = im.evaluateBatch(pointsCount, textureCoordinates, values));
+			for (int p = 0; p < pointsCount; ++p)
+			{
+				// tolerance allows for image libraries reducing to 8 bits per component
+				EXPECT_NEAR(expectedValues[f][w][p]/65535.0, values[p], 0.5/255.0 + 1.0E-6);
+			}
+		}
+	}
+}
+
 TEST(cmzn_field_image, enumerations)
 {
 	ZincTestSetup zinc;
@@ -20,6 +20,8 @@
 #include <opencmiss/zinc/fieldsubobjectgroup.hpp>
 #include <opencmiss/zinc/fieldtrigonometry.hpp>
 #include <opencmiss/zinc/fieldvectoroperators.hpp>
+#include <opencmiss/zinc/logger.hpp>
+#include <opencmiss/zinc/node.hpp>
 #include "zinctestsetupcpp.hpp"
 
 #include "test_resources.h"
@@ -314,6 +316,190 @@ TEST(ZincFieldMeshIntegral, midpoint_quadrature_large_numbers)
 	}
 }
 
+TEST(ZincFieldMeshIntegral, adaptive_quadrature)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	EXPECT_TRUE(mesh3d.isValid());
+	Elementtemplate elementTemplate = mesh3d.createElementtemplate();
+	EXPECT_TRUE(elementTemplate.isValid());
+	EXPECT_EQ(OK, result = elementTemplate.setElementShapeType(Element::SHAPE_TYPE_CUBE));
+	Element element = mesh3d.createElement(-1, elementTemplate);
+	EXPECT_TRUE(element.isValid());
+
+	Field xiField = zinc.fm.findFieldByName("xi");
+	EXPECT_TRUE(xiField.isValid());
+	Field xi1Field = zinc.fm.createFieldComponent(xiField, 1);
+	const double three = 3.0;
+	Field threeField = zinc.fm.createFieldConstant(1, &three);
+	Field integrandField = zinc.fm.createFieldExp(zinc.fm.createFieldMultiply(threeField, xi1Field));
+	EXPECT_TRUE(integrandField.isValid());
+
+	FieldMeshIntegral integralField = zinc.fm.createFieldMeshIntegral(integrandField, xiField, mesh3d);
+	EXPECT_TRUE(integralField.isValid());
+	const int four = 4;
+	EXPECT_EQ(OK, result = integralField.setNumbersOfPoints(1, &four));
+	const double expectedIntegral = (exp(3.0) - 1.0)/3.0;
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double gaussIntegral;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &gaussIntegral));
+	EXPECT_NEAR(expectedIntegral, gaussIntegral, 1.0E-4);
+
+	EXPECT_DOUBLE_EQ(1.0E-6, integralField.getRelativeTolerance());
+	EXPECT_EQ(ERROR_ARGUMENT, integralField.setRelativeTolerance(0.0));
+	EXPECT_EQ(OK, result = integralField.setRelativeTolerance(1.0E-10));
+	EXPECT_DOUBLE_EQ(1.0E-10, integralField.getRelativeTolerance());
+	EXPECT_EQ(OK, result = integralField.setElementQuadratureRule(Element::QUADRATURE_RULE_ADAPTIVE));
+	EXPECT_EQ(Element::QUADRATURE_RULE_ADAPTIVE, integralField.getElementQuadratureRule());
+
+	// subdivides element to meet tolerance
+	double adaptiveIntegral;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &adaptiveIntegral));
+	EXPECT_NEAR(expectedIntegral, adaptiveIntegral, 1.0E-9);
+	EXPECT_LT(fabs(adaptiveIntegral - expectedIntegral), fabs(gaussIntegral - expectedIntegral));
+	// starts from cached level on re-evaluation
+	Fieldcache cache2 = zinc.fm.createFieldcache();
+	double adaptiveIntegral2;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache2, 1, &adaptiveIntegral2));
+	EXPECT_DOUBLE_EQ(adaptiveIntegral, adaptiveIntegral2);
+
+	// smooth integrand is exact at low order
+	const double one = 1.0;
+	FieldMeshIntegral volumeField = zinc.fm.createFieldMeshIntegral(zinc.fm.createFieldConstant(1, &one), xiField, mesh3d);
+	EXPECT_EQ(OK, result = volumeField.setElementQuadratureRule(Element::QUADRATURE_RULE_ADAPTIVE));
+	double volume;
+	EXPECT_EQ(OK, result = volumeField.evaluateReal(cache, 1, &volume));
+	EXPECT_NEAR(1.0, volume, 1.0E-12);
+
+	// squares also adapt
+	FieldMeshIntegralSquares squaresField = zinc.fm.createFieldMeshIntegralSquares(integrandField, xiField, mesh3d);
+	EXPECT_EQ(OK, result = squaresField.setElementQuadratureRule(Element::QUADRATURE_RULE_ADAPTIVE));
+	EXPECT_EQ(OK, result = squaresField.setRelativeTolerance(1.0E-10));
+	double squaresIntegral;
+	EXPECT_EQ(OK, result = squaresField.evaluateReal(cache, 1, &squaresIntegral));
+	EXPECT_NEAR((exp(6.0) - 1.0)/6.0, squaresIntegral, 1.0E-7);
+}
+
+// triangles have no rules above 4 points so must stop there and warn rather
+// than compare identical rules at higher levels and report convergence
+TEST(ZincFieldMeshIntegral, adaptive_quadrature_simplex)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	Elementtemplate elementTemplate = mesh2d.createElementtemplate();
+	EXPECT_EQ(OK, result = elementTemplate.setElementShapeType(Element::SHAPE_TYPE_TRIANGLE));
+	EXPECT_TRUE(mesh2d.createElement(-1, elementTemplate).isValid());
+
+	Field xiField = zinc.fm.findFieldByName("xi");
+	Field xi1Field = zinc.fm.createFieldComponent(xiField, 1);
+	const double three = 3.0;
+	Field integrandField = zinc.fm.createFieldExp(
+		zinc.fm.createFieldMultiply(zinc.fm.createFieldConstant(1, &three), xi1Field));
+	EXPECT_TRUE(integrandField.isValid());
+	FieldMeshIntegral integralField = zinc.fm.createFieldMeshIntegral(integrandField, xiField, mesh2d);
+	EXPECT_TRUE(integralField.isValid());
+	const int four = 4;
+	EXPECT_EQ(OK, result = integralField.setNumbersOfPoints(1, &four));
+	const double expectedIntegral = (exp(3.0) - 1.0)/9.0 - 1.0/3.0;
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double gaussIntegral;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &gaussIntegral));
+	EXPECT_NEAR(expectedIntegral, gaussIntegral, 1.0E-3);
+
+	Logger logger = zinc.context.getLogger();
+	EXPECT_EQ(OK, result = logger.removeAllMessages());
+	EXPECT_EQ(OK, result = integralField.setRelativeTolerance(1.0E-12));
+	EXPECT_EQ(OK, result = integralField.setElementQuadratureRule(Element::QUADRATURE_RULE_ADAPTIVE));
+	Fieldcache cache2 = zinc.fm.createFieldcache();
+	double adaptiveIntegral;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache2, 1, &adaptiveIntegral));
+	EXPECT_DOUBLE_EQ(gaussIntegral, adaptiveIntegral);
+	EXPECT_EQ(1, logger.getNumberOfMessages());
+	EXPECT_EQ(Logger::MESSAGE_TYPE_WARNING, logger.getMessageTypeAtIndex(1));
+
+	// warned only once until settings change
+	Fieldcache cache3 = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache3, 1, &adaptiveIntegral));
+	EXPECT_DOUBLE_EQ(gaussIntegral, adaptiveIntegral);
+	EXPECT_EQ(1, logger.getNumberOfMessages());
+
+	// converges at a lower level with a looser tolerance, without warning
+	EXPECT_EQ(OK, result = logger.removeAllMessages());
+	EXPECT_EQ(OK, result = integralField.setRelativeTolerance(1.0E-2));
+	Fieldcache cache4 = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache4, 1, &adaptiveIntegral));
+	EXPECT_NEAR(expectedIntegral, adaptiveIntegral, 1.0E-2*expectedIntegral);
+	EXPECT_EQ(0, logger.getNumberOfMessages());
+}
+
+TEST(ZincFieldMeshIntegral, geometry_cached)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	EXPECT_TRUE(mesh3d.isValid());
+	Field xField = zinc.fm.createFieldComponent(coordinateField, 1);
+	EXPECT_TRUE(xField.isValid());
+	FieldMeshIntegral integralField = zinc.fm.createFieldMeshIntegral(xField, coordinateField, mesh3d);
+	EXPECT_TRUE(integralField.isValid());
+
+	EXPECT_FALSE(integralField.isGeometryCached());
+	EXPECT_EQ(OK, result = integralField.setGeometryCached(true));
+	EXPECT_TRUE(integralField.isGeometryCached());
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double value;
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(0.5, value, 1.0E-12);
+	// second evaluation uses cached geometry
+	Fieldcache cache2 = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache2, 1, &value));
+	EXPECT_NEAR(0.5, value, 1.0E-12);
+
+	// changing coordinates must discard cached geometry
+	zinc.fm.beginChange();
+	{
+		Nodeset nodeset = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+		Nodeiterator iter = nodeset.createNodeiterator();
+		Node node;
+		double x[3];
+		while ((node = iter.next()).isValid())
+		{
+			EXPECT_EQ(OK, cache.setNode(node));
+			EXPECT_EQ(OK, coordinateField.evaluateReal(cache, 3, x));
+			for (int c = 0; c < 3; ++c)
+				x[c] *= 2.0;
+			EXPECT_EQ(OK, coordinateField.assignReal(cache, 3, x));
+		}
+	}
+	zinc.fm.endChange();
+	cache.clearLocation();
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(8.0, value, 1.0E-12);
+
+	// changing numbers of points must discard cached geometry
+	const int three = 3;
+	EXPECT_EQ(OK, result = integralField.setNumbersOfPoints(1, &three));
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(8.0, value, 1.0E-12);
+
+	EXPECT_EQ(OK, result = integralField.setGeometryCached(false));
+	EXPECT_FALSE(integralField.isGeometryCached());
+	EXPECT_EQ(OK, result = integralField.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(8.0, value, 1.0E-12);
+}
+
 TEST(ZincFieldMeshIntegralSquares, quadrature)
 {
 	ZincTestSetupCpp zinc;
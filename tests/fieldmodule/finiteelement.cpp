@@ -420,6 +420,63 @@ TEST(ZincFieldFiniteElement, node_value_label)
 	ASSERT_DOUBLE_EQ(derivatives2[2], outDerivatives2[2]);
 }
 
+// assigning a finite element field at a node sets the value of all versions
+TEST(ZincFieldFiniteElement, assignRealAllVersions)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	FieldFiniteElement coordinateField = zinc.fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(coordinateField.isValid());
+	Nodeset nodeset = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_TRUE(nodeset.isValid());
+	Nodetemplate nodeTemplate = nodeset.createNodetemplate();
+	EXPECT_TRUE(nodeTemplate.isValid());
+	EXPECT_EQ(OK, result = nodeTemplate.defineField(coordinateField));
+	EXPECT_EQ(OK, result = nodeTemplate.setValueNumberOfVersions(coordinateField, /*componentNumber*/-1, Node::VALUE_LABEL_D_DS1, 2));
+	// all values/derivatives have the same number of versions
+	EXPECT_EQ(2, result = nodeTemplate.getValueNumberOfVersions(coordinateField, /*componentNumber*/-1, Node::VALUE_LABEL_VALUE));
+	Node node = nodeset.createNode(1, nodeTemplate);
+	EXPECT_TRUE(node.isValid());
+
+	FieldNodeValue x_v1 = zinc.fm.createFieldNodeValue(coordinateField, Node::VALUE_LABEL_VALUE, 1);
+	EXPECT_TRUE(x_v1.isValid());
+	FieldNodeValue x_v2 = zinc.fm.createFieldNodeValue(coordinateField, Node::VALUE_LABEL_VALUE, 2);
+	EXPECT_TRUE(x_v2.isValid());
+	FieldNodeValue dx_ds1_v2 = zinc.fm.createFieldNodeValue(coordinateField, Node::VALUE_LABEL_D_DS1, 2);
+	EXPECT_TRUE(dx_ds1_v2.isValid());
+	const double coordinates_v1[3] = { 1.0, 2.0, 3.0 };
+	const double coordinates_v2[3] = { 1.5, 2.5, 3.5 };
+	const double derivatives1_v2[3] = { 0.6, 0.5, 0.4 };
+	{
+		Fieldcache tmpCache = zinc.fm.createFieldcache();
+		EXPECT_EQ(OK, result = tmpCache.setNode(node));
+		EXPECT_EQ(OK, result = x_v1.assignReal(tmpCache, 3, coordinates_v1));
+		EXPECT_EQ(OK, result = x_v2.assignReal(tmpCache, 3, coordinates_v2));
+		EXPECT_EQ(OK, result = dx_ds1_v2.assignReal(tmpCache, 3, derivatives1_v2));
+	}
+
+	Fieldcache cache = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, result = cache.setNode(node));
+	const double newCoordinates[3] = { 4.0, 5.0, 6.0 };
+	EXPECT_EQ(OK, result = coordinateField.assignReal(cache, 3, newCoordinates));
+	// evaluate in new cache so values are not taken from the cache assigned to
+	Fieldcache newCache = zinc.fm.createFieldcache();
+	EXPECT_EQ(OK, result = newCache.setNode(node));
+	double outCoordinates[3], outCoordinates_v1[3], outCoordinates_v2[3], outDerivatives1_v2[3];
+	EXPECT_EQ(OK, result = coordinateField.evaluateReal(newCache, 3, outCoordinates));
+	EXPECT_EQ(OK, result = x_v1.evaluateReal(newCache, 3, outCoordinates_v1));
+	EXPECT_EQ(OK, result = x_v2.evaluateReal(newCache, 3, outCoordinates_v2));
+	EXPECT_EQ(OK, result = dx_ds1_v2.evaluateReal(newCache, 3, outDerivatives1_v2));
+	for (int c = 0; c < 3; ++c)
+	{
+		ASSERT_DOUBLE_EQ(newCoordinates[c], outCoordinates[c]);
+		ASSERT_DOUBLE_EQ(newCoordinates[c], outCoordinates_v1[c]);
+		ASSERT_DOUBLE_EQ(newCoordinates[c], outCoordinates_v2[c]);
+		ASSERT_DOUBLE_EQ(derivatives1_v2[c], outDerivatives1_v2[c]);
+	}
+}
+
 TEST(ZincFieldIsExterior, evaluate3d)
 {
 	ZincTestSetupCpp zinc;
@@ -1286,3 +1343,146 @@ TEST(ZincNodetemplate, define_undefineField)
 	EXPECT_EQ(ERROR_NOT_FOUND, nodetemplate5.defineFieldFromNode(feField, node4));
 	EXPECT_EQ(ERROR_NOT_FOUND, nodetemplate5.setValueNumberOfVersions(feField, -1, Node::VALUE_LABEL_VALUE, 1));
 }
+
+// find mesh location walks across faces from the last element found
+TEST(ZincFieldFindMeshLocation, walkNeighbours)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	EXPECT_EQ(2, mesh3d.getSize());
+	Element element1 = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element1.isValid());
+	Element element2 = mesh3d.findElementByIdentifier(2);
+	EXPECT_TRUE(element2.isValid());
+
+	FieldFindMeshLocation findMeshLocation = zinc.fm.createFieldFindMeshLocation(coordinates, coordinates, mesh3d);
+	EXPECT_TRUE(findMeshLocation.isValid());
+	Fieldcache cache = zinc.fm.createFieldcache();
+
+	// cubes are 10 units wide side by side in x
+	const double x1[3] = { 2.5, 5.0, 7.5 };
+	const double x2[3] = { 17.5, 2.5, 5.0 };
+	const double outside[3] = { 25.0, 5.0, 5.0 };
+	double xi[3];
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, x1));
+	Element element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element1, element);
+	EXPECT_NEAR(0.25, xi[0], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[1], 1.0E-5);
+	EXPECT_NEAR(0.75, xi[2], 1.0E-5);
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, x2));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element2, element);
+	EXPECT_NEAR(0.75, xi[0], 1.0E-5);
+	EXPECT_NEAR(0.25, xi[1], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[2], 1.0E-5);
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, x1));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element1, element);
+	EXPECT_NEAR(0.25, xi[0], 1.0E-5);
+
+	// a point on the shared face is in both cubes: a search of all elements
+	// always finds it in element 1, but the walk stays in the last element
+	const double face[3] = { 10.0, 5.0, 5.0 };
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, x2));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element2, element);
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, face));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element2, element);
+	EXPECT_NEAR(0.0, xi[0], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[1], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[2], 1.0E-5);
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, x1));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element1, element);
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, face));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element1, element);
+	EXPECT_NEAR(1.0, xi[0], 1.0E-5);
+
+	EXPECT_EQ(OK, result = cache.setFieldReal(coordinates, 3, outside));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_FALSE(element.isValid());
+	EXPECT_EQ(OK, result = findMeshLocation.setSearchMode(FieldFindMeshLocation::SEARCH_MODE_NEAREST));
+	element = findMeshLocation.evaluateMeshLocation(cache, 3, xi);
+	EXPECT_EQ(element2, element);
+	EXPECT_NEAR(1.0, xi[0], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[1], 1.0E-5);
+	EXPECT_NEAR(0.5, xi[2], 1.0E-5);
+}
+
+TEST(ZincFieldFindMeshLocation, findBatch)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Mesh mesh3d = zinc.fm.findMeshByDimension(3);
+	Element element1 = mesh3d.findElementByIdentifier(1);
+	EXPECT_TRUE(element1.isValid());
+	Element element2 = mesh3d.findElementByIdentifier(2);
+	EXPECT_TRUE(element2.isValid());
+
+	FieldFindMeshLocation findMeshLocation = zinc.fm.createFieldFindMeshLocation(coordinates, coordinates, mesh3d);
+	EXPECT_TRUE(findMeshLocation.isValid());
+	Fieldcache cache = zinc.fm.createFieldcache();
+
+	// points along x through both cubes in scrambled order, then one outside
+	const int pointsCount = 21;
+	double values[pointsCount*3];
+	for (int p = 0; p < 20; ++p)
+	{
+		values[p*3] = 0.5 + static_cast<double>((p*7) % 20);
+		values[p*3 + 1] = 5.0;
+		values[p*3 + 2] = 2.5;
+	}
+	values[60] = 25.0;
+	values[61] = 5.0;
+	values[62] = 2.5;
+	Element elements[pointsCount];
+	double xi[pointsCount*3];
+	EXPECT_EQ(OK, result = findMeshLocation.findBatch(cache, pointsCount, values, elements, xi));
+	for (int p = 0; p < 20; ++p)
+	{
+		const double x = values[p*3];
+		EXPECT_EQ((x < 10.0) ? element1 : element2, elements[p]);
+		EXPECT_NEAR((x < 10.0) ? x*0.1 : x*0.1 - 1.0, xi[p*3], 1.0E-5);
+		EXPECT_NEAR(0.5, xi[p*3 + 1], 1.0E-5);
+		EXPECT_NEAR(0.25, xi[p*3 + 2], 1.0E-5);
+	}
+	EXPECT_FALSE(elements[20].isValid());
+
+	int batchPointsCount, foundCount, fallbackCount;
+	double averageElementVisits, averageIterations;
+	EXPECT_EQ(OK, result = findMeshLocation.getBatchStatistics(batchPointsCount, foundCount,
+		fallbackCount, averageElementVisits, averageIterations));
+	EXPECT_EQ(pointsCount, batchPointsCount);
+	EXPECT_EQ(20, foundCount);
+	// only the point outside the mesh needs a search of all elements
+	EXPECT_EQ(1, fallbackCount);
+	EXPECT_GT(averageElementVisits, 0.0);
+	EXPECT_LT(averageElementVisits, 2.0);
+	EXPECT_GT(averageIterations, 0.0);
+
+	// nearest mode finds location on boundary for outside point
+	EXPECT_EQ(OK, result = findMeshLocation.setSearchMode(FieldFindMeshLocation::SEARCH_MODE_NEAREST));
+	EXPECT_EQ(OK, result = findMeshLocation.findBatch(cache, pointsCount, values, elements, xi));
+	EXPECT_EQ(element2, elements[20]);
+	EXPECT_NEAR(1.0, xi[60], 1.0E-5);
+	EXPECT_EQ(OK, result = findMeshLocation.getBatchStatistics(batchPointsCount, foundCount,
+		fallbackCount, averageElementVisits, averageIterations));
+	EXPECT_EQ(pointsCount, foundCount);
+
+	EXPECT_EQ(ERROR_ARGUMENT, result = findMeshLocation.findBatch(cache, -1, values, elements, xi));
+	EXPECT_EQ(ERROR_ARGUMENT, result = findMeshLocation.findBatch(cache, pointsCount, 0, elements, xi));
+}
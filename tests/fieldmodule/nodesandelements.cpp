@@ -7,6 +7,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 #include <opencmiss/zinc/core.h>
 #include <opencmiss/zinc/context.h>
@@ -458,3 +461,87 @@ TEST(ZincNodeset, destroyNodes)
 	EXPECT_EQ(OK, nodeset.destroyAllNodes());
 	EXPECT_EQ(0, nodeset.getSize());
 }
+
+namespace {
+
+// Creates line elements with identifiers in the supplied order, then finds
+// each in shuffled order, checks find after changing identifiers, and after
+// destroying every other element. Elements are used as, unlike nodes, their
+// identifiers are indexed by DsLabels.
+void checkFindElementByIdentifier(std::vector<int>& identifiers)
+{
+	ZincTestSetupCpp zinc;
+
+	Mesh mesh = zinc.fm.findMeshByDimension(1);
+	Elementtemplate elementTemplate = mesh.createElementtemplate();
+	EXPECT_TRUE(elementTemplate.isValid());
+	EXPECT_EQ(OK, elementTemplate.setElementShapeType(Element::SHAPE_TYPE_LINE));
+	zinc.fm.beginChange();
+	const int elementCount = static_cast<int>(identifiers.size());
+	for (int i = 0; i < elementCount; ++i)
+		EXPECT_TRUE(mesh.createElement(identifiers[i], elementTemplate).isValid());
+	zinc.fm.endChange();
+	EXPECT_EQ(elementCount, mesh.getSize());
+
+	std::vector<int> findIdentifiers(identifiers);
+	std::mt19937 generator(1234);
+	std::shuffle(findIdentifiers.begin(), findIdentifiers.end(), generator);
+	int foundCount = 0;
+	for (int i = 0; i < elementCount; ++i)
+	{
+		Element element = mesh.findElementByIdentifier(findIdentifiers[i]);
+		if (element.isValid() && (element.getIdentifier() == findIdentifiers[i]))
+			++foundCount;
+	}
+	EXPECT_EQ(elementCount, foundCount);
+
+	// missing identifiers must not be found
+	const int maximumIdentifier = *std::max_element(identifiers.begin(), identifiers.end());
+	EXPECT_FALSE(mesh.findElementByIdentifier(maximumIdentifier + 1).isValid());
+
+	// changing identifiers moves them in the index, and setting one in use fails
+	Element element = mesh.findElementByIdentifier(identifiers[0]);
+	EXPECT_EQ(ERROR_ALREADY_EXISTS, element.setIdentifier(identifiers[1]));
+	EXPECT_EQ(identifiers[0], element.getIdentifier());
+	EXPECT_EQ(OK, element.setIdentifier(maximumIdentifier + 1));
+	EXPECT_FALSE(mesh.findElementByIdentifier(identifiers[0]).isValid());
+	EXPECT_EQ(element, mesh.findElementByIdentifier(maximumIdentifier + 1));
+	EXPECT_EQ(OK, element.setIdentifier(identifiers[0]));
+	EXPECT_EQ(element, mesh.findElementByIdentifier(identifiers[0]));
+	EXPECT_FALSE(mesh.findElementByIdentifier(maximumIdentifier + 1).isValid());
+
+	zinc.fm.beginChange();
+	for (int i = 0; i < elementCount; i += 2)
+		EXPECT_EQ(OK, mesh.destroyElement(mesh.findElementByIdentifier(identifiers[i])));
+	zinc.fm.endChange();
+	for (int i = 0; i < elementCount; ++i)
+		EXPECT_EQ((i % 2) != 0, mesh.findElementByIdentifier(identifiers[i]).isValid());
+}
+
+}
+
+TEST(ZincMesh, findElementByIdentifierDistributions)
+{
+	const int elementCount = 20000;
+	std::vector<int> identifiers;
+	identifiers.reserve(elementCount);
+
+	// sparse: uniform stride
+	for (int i = 0; i < elementCount; ++i)
+		identifiers.push_back(1 + i*7);
+	checkFindElementByIdentifier(identifiers);
+
+	// clustered: runs of consecutive identifiers separated by large gaps
+	identifiers.clear();
+	for (int i = 0; i < elementCount; ++i)
+		identifiers.push_back(1 + (i / 100)*100000 + (i % 100));
+	checkFindElementByIdentifier(identifiers);
+
+	// random: unique identifiers added in random order
+	identifiers.clear();
+	for (int i = 0; i < elementCount; ++i)
+		identifiers.push_back(1 + i*13 + (i % 5));
+	std::mt19937 generator(4321);
+	std::shuffle(identifiers.begin(), identifiers.end(), generator);
+	checkFindElementByIdentifier(identifiers);
+}
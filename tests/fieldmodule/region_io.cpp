@@ -27,6 +27,7 @@
 #include <iostream>     // std::cout, std::ostream, std::hex
 #include <sstream>
 #include <fstream>
+#include <iterator>
 
 #include "test_resources.h"
 
@@ -510,3 +511,99 @@ TEST(region_stream_gzip_input, invalid_args)
 	cmzn_context_destroy(&context);
 
 }
+
+// Multiple file resources are read ahead of parsing; check results match
+// reading the same data from memory resources
+TEST(region_stream_gzip_input, multiple_file_resources)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+
+	cmzn_region_id file_region = cmzn_region_create_child(root_region, "file");
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(file_region);
+	cmzn_streamresource_id sr_exnode = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::HEART_EXNODE_GZ));
+	EXPECT_NE(static_cast<cmzn_streamresource *>(0), sr_exnode);
+	cmzn_streamresource_id sr_exelem = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::HEART_EXELEM_GZ));
+	EXPECT_NE(static_cast<cmzn_streamresource *>(0), sr_exelem);
+	cmzn_streaminformation_set_data_compression_type(si, CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP);
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(file_region, si_region));
+	cmzn_streamresource_destroy(&sr_exnode);
+	cmzn_streamresource_destroy(&sr_exelem);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	cmzn_region_id memory_region = cmzn_region_create_child(root_region, "memory");
+	std::ifstream exnodeFile(TestResources::getLocation(TestResources::HEART_EXNODE_GZ), std::ifstream::binary);
+	std::ifstream exelemFile(TestResources::getLocation(TestResources::HEART_EXELEM_GZ), std::ifstream::binary);
+	ASSERT_TRUE(exnodeFile.is_open() && exelemFile.is_open());
+	std::string exnodeBuffer((std::istreambuf_iterator<char>(exnodeFile)), std::istreambuf_iterator<char>());
+	std::string exelemBuffer((std::istreambuf_iterator<char>(exelemFile)), std::istreambuf_iterator<char>());
+	si = cmzn_region_create_streaminformation_region(memory_region);
+	sr_exnode = cmzn_streaminformation_create_streamresource_memory_buffer(
+		si, exnodeBuffer.data(), static_cast<unsigned int>(exnodeBuffer.size()));
+	sr_exelem = cmzn_streaminformation_create_streamresource_memory_buffer(
+		si, exelemBuffer.data(), static_cast<unsigned int>(exelemBuffer.size()));
+	cmzn_streaminformation_set_data_compression_type(si, CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP);
+	si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(memory_region, si_region));
+	cmzn_streamresource_destroy(&sr_exnode);
+	cmzn_streamresource_destroy(&sr_exelem);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	cmzn_fieldmodule_id file_fm = cmzn_region_get_fieldmodule(file_region);
+	cmzn_fieldmodule_id memory_fm = cmzn_region_get_fieldmodule(memory_region);
+	cmzn_nodeset_id file_nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(file_fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	cmzn_nodeset_id memory_nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(memory_fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	EXPECT_LT(0, cmzn_nodeset_get_size(file_nodes));
+	EXPECT_EQ(cmzn_nodeset_get_size(memory_nodes), cmzn_nodeset_get_size(file_nodes));
+	cmzn_mesh_id file_mesh = cmzn_fieldmodule_find_mesh_by_dimension(file_fm, 3);
+	cmzn_mesh_id memory_mesh = cmzn_fieldmodule_find_mesh_by_dimension(memory_fm, 3);
+	EXPECT_LT(0, cmzn_mesh_get_size(file_mesh));
+	EXPECT_EQ(cmzn_mesh_get_size(memory_mesh), cmzn_mesh_get_size(file_mesh));
+	cmzn_mesh_destroy(&file_mesh);
+	cmzn_mesh_destroy(&memory_mesh);
+	cmzn_nodeset_destroy(&file_nodes);
+	cmzn_nodeset_destroy(&memory_nodes);
+	cmzn_fieldmodule_destroy(&file_fm);
+	cmzn_fieldmodule_destroy(&memory_fm);
+
+	cmzn_region_destroy(&memory_region);
+	cmzn_region_destroy(&file_region);
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
+
+// An uncompressed file with gzip compression type is read as uncompressed,
+// as gzopen does
+TEST(region_stream_gzip_input, uncompressed_file)
+{
+	cmzn_context_id context = cmzn_context_create("test");
+	cmzn_region_id root_region = cmzn_context_get_default_region(context);
+
+	cmzn_streaminformation_id si = cmzn_region_create_streaminformation_region(root_region);
+	cmzn_streamresource_id sr = cmzn_streaminformation_create_streamresource_file(
+		si, TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE));
+	EXPECT_NE(static_cast<cmzn_streamresource *>(0), sr);
+	EXPECT_EQ(CMZN_OK, cmzn_streaminformation_set_data_compression_type(si, CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_GZIP));
+	cmzn_streaminformation_region_id si_region = cmzn_streaminformation_cast_region(si);
+	EXPECT_EQ(CMZN_OK, cmzn_region_read(root_region, si_region));
+	cmzn_streamresource_destroy(&sr);
+	cmzn_streaminformation_region_destroy(&si_region);
+	cmzn_streaminformation_destroy(&si);
+
+	cmzn_fieldmodule_id fm = cmzn_region_get_fieldmodule(root_region);
+	cmzn_nodeset_id nodes = cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
+	EXPECT_EQ(8, cmzn_nodeset_get_size(nodes));
+	cmzn_mesh_id mesh = cmzn_fieldmodule_find_mesh_by_dimension(fm, 3);
+	EXPECT_EQ(1, cmzn_mesh_get_size(mesh));
+	cmzn_mesh_destroy(&mesh);
+	cmzn_nodeset_destroy(&nodes);
+	cmzn_fieldmodule_destroy(&fm);
+
+	cmzn_region_destroy(&root_region);
+	cmzn_context_destroy(&context);
+}
@@ -33,6 +33,7 @@ SET(FIELDMODULE_CUBE_GRID_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/cube_grid.exelem")
 SET(FIELDMODULE_REGION_INPUT_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/region_input.exregion")
 SET(FIELDMODULE_EMBEDDING_ISSUE3614_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/embedding_issue3614.exregion")
 SET(FIELDIMAGE_BLOCKCOLOURS_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/blockcolours.png")
+SET(FIELDIMAGE_GRAY16_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/gray16_4x4.png")
 SET(FIELDMODULE_TWO_CUBES_RESOURCE "${CMAKE_CURRENT_LIST_DIR}/two_cubes.exformat")
 SET(HEART_EXNODE_GZ "${CMAKE_CURRENT_LIST_DIR}/heart.exnode.gz")
 SET(HEART_EXELEM_GZ "${CMAKE_CURRENT_LIST_DIR}/heart.exelem.gz")
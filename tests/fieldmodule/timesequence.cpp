@@ -7,7 +7,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
 
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/node.hpp>
 #include <opencmiss/zinc/timesequence.hpp>
 #include "zinctestsetupcpp.hpp"
 
@@ -39,3 +44,150 @@ TEST(ZincTimesequence, api)
 	ASSERT_DOUBLE_EQ(5.5, outValue = seq3.getTime(4));
 	ASSERT_EQ(4, seq3.getNumberOfTimes());
 }
+
+// test nodal parameters varying with time held in scratch file with only
+// some times resident, evaluated forwards, backwards and in between times
+TEST(ZincTimesequence, pagedStorage)
+{
+	const char *fileName = "paged_timesequence.bin";
+	{
+		ZincTestSetupCpp zinc;
+		int result;
+
+		const int timeCount = 6;
+		double times[timeCount] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+		Timesequence timesequence = zinc.fm.getMatchingTimesequence(timeCount, times);
+		EXPECT_TRUE(timesequence.isValid());
+		EXPECT_EQ(ERROR_ARGUMENT, result = timesequence.setPagedStorage(fileName, 1));
+		EXPECT_EQ(OK, result = timesequence.setPagedStorage(fileName, 3));
+
+		FieldFiniteElement field = zinc.fm.createFieldFiniteElement(2);
+		EXPECT_TRUE(field.isValid());
+		Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+		Nodetemplate nodetemplate = nodes.createNodetemplate();
+		EXPECT_EQ(OK, result = nodetemplate.defineField(field));
+		EXPECT_EQ(OK, result = nodetemplate.setTimesequence(field, timesequence));
+		Fieldcache fieldcache = zinc.fm.createFieldcache();
+		const int nodeCount = 10;
+		zinc.fm.beginChange();
+		for (int n = 1; n <= nodeCount; ++n)
+		{
+			Node node = nodes.createNode(n, nodetemplate);
+			EXPECT_TRUE(node.isValid());
+			EXPECT_EQ(OK, result = fieldcache.setNode(node));
+			for (int t = 0; t < timeCount; ++t)
+			{
+				EXPECT_EQ(OK, result = fieldcache.setTime(times[t]));
+				const double values[2] = { n*100.0 + t, -n*100.0 - t*t };
+				EXPECT_EQ(OK, result = field.assignReal(fieldcache, 2, values));
+			}
+		}
+		zinc.fm.endChange();
+		// can't change storage once in use
+		EXPECT_EQ(ERROR_ARGUMENT, result = timesequence.setPagedStorage(0, 0));
+
+		double values[2];
+		// forwards as for animation, then backwards, with times between
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			for (int s = 0; s <= 2*(timeCount - 1); ++s)
+			{
+				const double time = 0.5*((pass == 0) ? s : 2*(timeCount - 1) - s);
+				EXPECT_EQ(OK, result = fieldcache.setTime(time));
+				const int t1 = static_cast<int>(time);
+				const int t2 = (t1 < timeCount - 1) ? t1 + 1 : t1;
+				const double xi = time - t1;
+				for (int n = 1; n <= nodeCount; ++n)
+				{
+					EXPECT_EQ(OK, result = fieldcache.setNode(nodes.findNodeByIdentifier(n)));
+					EXPECT_EQ(OK, result = field.evaluateReal(fieldcache, 2, values));
+					EXPECT_DOUBLE_EQ(n*100.0 + time, values[0]);
+					EXPECT_DOUBLE_EQ(-n*100.0 - ((1.0 - xi)*t1*t1 + xi*t2*t2), values[1]);
+				}
+			}
+		}
+
+		// removing nodes frees their slots for reuse
+		EXPECT_EQ(OK, result = nodes.destroyAllNodes());
+		Node node = nodes.createNode(1, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(OK, result = fieldcache.setNode(node));
+		EXPECT_EQ(OK, result = fieldcache.setTime(2.0));
+		EXPECT_EQ(OK, result = field.evaluateReal(fieldcache, 2, values));
+		EXPECT_DOUBLE_EQ(0.0, values[0]);
+		EXPECT_DOUBLE_EQ(0.0, values[1]);
+	}
+	// scratch file is removed with time sequence
+	FILE *file = fopen(fileName, "rb");
+	EXPECT_EQ(static_cast<FILE *>(0), file);
+	if (file)
+		fclose(file);
+}
+
+// many nodes created from a template with paged storage over many times,
+// with only 2 times resident; nodes created again reuse slots as zero
+TEST(ZincTimesequence, pagedStorageTemplateNodes)
+{
+	const char *fileName = "paged_timesequence_template.bin";
+	ZincTestSetupCpp zinc;
+	int result;
+
+	const int timeCount = 200;
+	std::vector<double> times(timeCount);
+	for (int t = 0; t < timeCount; ++t)
+		times[t] = 0.1*t;
+	Timesequence timesequence = zinc.fm.getMatchingTimesequence(timeCount, times.data());
+	EXPECT_TRUE(timesequence.isValid());
+	EXPECT_EQ(OK, result = timesequence.setPagedStorage(fileName, 2));
+
+	FieldFiniteElement field = zinc.fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(field.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(OK, result = nodetemplate.defineField(field));
+	EXPECT_EQ(OK, result = nodetemplate.setTimesequence(field, timesequence));
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int nodeCount = 1000;
+	double values[3];
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		zinc.fm.beginChange();
+		for (int n = 1; n <= nodeCount; ++n)
+		{
+			Node node = nodes.createNode(n, nodetemplate);
+			EXPECT_TRUE(node.isValid());
+		}
+		zinc.fm.endChange();
+		EXPECT_EQ(nodeCount, nodes.getSize());
+		for (int n = 1; n <= nodeCount; n += 37)
+		{
+			EXPECT_EQ(OK, result = fieldcache.setNode(nodes.findNodeByIdentifier(n)));
+			for (int t = 0; t < timeCount; t += 13)
+			{
+				EXPECT_EQ(OK, result = fieldcache.setTime(times[t]));
+				EXPECT_EQ(OK, result = field.evaluateReal(fieldcache, 3, values));
+				EXPECT_DOUBLE_EQ(0.0, values[0]);
+				EXPECT_DOUBLE_EQ(0.0, values[1]);
+				EXPECT_DOUBLE_EQ(0.0, values[2]);
+			}
+		}
+		// set values on some nodes before they are destroyed and recreated
+		for (int n = 1; n <= nodeCount; n += 50)
+		{
+			EXPECT_EQ(OK, result = fieldcache.setNode(nodes.findNodeByIdentifier(n)));
+			for (int t = 0; t < timeCount; ++t)
+			{
+				EXPECT_EQ(OK, result = fieldcache.setTime(times[t]));
+				const double setValues[3] = { n + 0.5*t, -1.0*n, 2.0*t };
+				EXPECT_EQ(OK, result = field.assignReal(fieldcache, 3, setValues));
+			}
+		}
+		EXPECT_EQ(OK, result = fieldcache.setNode(nodes.findNodeByIdentifier(51)));
+		EXPECT_EQ(OK, result = fieldcache.setTime(times[17]));
+		EXPECT_EQ(OK, result = field.evaluateReal(fieldcache, 3, values));
+		EXPECT_DOUBLE_EQ(51 + 0.5*17, values[0]);
+		EXPECT_DOUBLE_EQ(-51.0, values[1]);
+		EXPECT_DOUBLE_EQ(34.0, values[2]);
+		EXPECT_EQ(OK, result = nodes.destroyAllNodes());
+	}
+}
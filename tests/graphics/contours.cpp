@@ -16,7 +16,15 @@
 #include <opencmiss/zinc/field.h>
 #include <opencmiss/zinc/fieldconstant.h>
 #include <opencmiss/zinc/graphics.h>
-
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldcomposite.hpp>
+#include <opencmiss/zinc/graphics.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/scene.hpp>
+#include <opencmiss/zinc/scenefilter.hpp>
+#include <opencmiss/zinc/spectrum.hpp>
+
+#include "test_resources.h"
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 
@@ -172,3 +180,90 @@ TEST(cmzn_graphics_contours, range_isovalues_null)
 	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_destroy(&is));
 }
 
+
+// Test contours are correct when rebuilt for new isovalues only visiting
+// elements whose cached isoscalar range spans them, and after field changes
+TEST(ZincGraphicsContours, isovalueElementCulling)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+	// x ranges from 0 to 10 in element 1 and 10 to 20 in element 2
+	Field xField = zinc.fm.createFieldComponent(coordinateField, 1);
+	EXPECT_TRUE(xField.isValid());
+	Spectrum spectrum = zinc.context.getSpectrummodule().getDefaultSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	Scenefilter filter = zinc.context.getScenefiltermodule().getDefaultScenefilter();
+	EXPECT_TRUE(filter.isValid());
+
+	GraphicsContours contours = zinc.scene.createGraphicsContours();
+	EXPECT_TRUE(contours.isValid());
+	EXPECT_EQ(CMZN_OK, contours.setCoordinateField(coordinateField));
+	EXPECT_EQ(CMZN_OK, contours.setIsoscalarField(xField));
+	EXPECT_EQ(CMZN_OK, contours.setDataField(xField));
+	EXPECT_EQ(CMZN_OK, contours.setSpectrum(spectrum));
+
+	const double tolerance = 1.0E-4; // graphics data stored in single precision
+	double minimumValue, maximumValue;
+	for (int dimension = 3; dimension >= 2; --dimension)
+	{
+		EXPECT_EQ(CMZN_OK, contours.setFieldDomainType((3 == dimension) ?
+			Field::DOMAIN_TYPE_MESH3D : Field::DOMAIN_TYPE_MESH2D));
+		double isovalue = 5.0;
+		EXPECT_EQ(CMZN_OK, contours.setListIsovalues(1, &isovalue));
+		EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+		EXPECT_NEAR(5.0, minimumValue, tolerance);
+		EXPECT_NEAR(5.0, maximumValue, tolerance);
+
+		isovalue = 15.0;
+		EXPECT_EQ(CMZN_OK, contours.setListIsovalues(1, &isovalue));
+		EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+		EXPECT_NEAR(15.0, minimumValue, tolerance);
+		EXPECT_NEAR(15.0, maximumValue, tolerance);
+
+		const double isovalues[2] = { 2.5, 17.5 };
+		EXPECT_EQ(CMZN_OK, contours.setListIsovalues(2, isovalues));
+		EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+		EXPECT_NEAR(2.5, minimumValue, tolerance);
+		EXPECT_NEAR(17.5, maximumValue, tolerance);
+
+		EXPECT_EQ(CMZN_OK, contours.setRangeIsovalues(3, 4.0, 16.0));
+		EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+		EXPECT_NEAR(4.0, minimumValue, tolerance);
+		EXPECT_NEAR(16.0, maximumValue, tolerance);
+
+		// outside range of all elements
+		isovalue = 25.0;
+		EXPECT_EQ(CMZN_OK, contours.setListIsovalues(1, &isovalue));
+		EXPECT_EQ(0, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	}
+
+	// move nodes at x = 20 to x = 30 so contour at 25 appears in element 2
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_TRUE(nodes.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int nodeIdentifiers[4] = { 3, 6, 9, 12 };
+	EXPECT_EQ(CMZN_OK, zinc.fm.beginChange());
+	for (int n = 0; n < 4; ++n)
+	{
+		Node node = nodes.findNodeByIdentifier(nodeIdentifiers[n]);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(CMZN_OK, fieldcache.setNode(node));
+		double x[3];
+		EXPECT_EQ(CMZN_OK, coordinateField.evaluateReal(fieldcache, 3, x));
+		EXPECT_DOUBLE_EQ(20.0, x[0]);
+		x[0] = 30.0;
+		EXPECT_EQ(CMZN_OK, coordinateField.assignReal(fieldcache, 3, x));
+	}
+	EXPECT_EQ(CMZN_OK, zinc.fm.endChange());
+	EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	EXPECT_NEAR(25.0, minimumValue, tolerance);
+	EXPECT_NEAR(25.0, maximumValue, tolerance);
+
+	EXPECT_EQ(CMZN_OK, contours.setRangeIsovalues(2, 5.0, 28.0));
+	EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	EXPECT_NEAR(5.0, minimumValue, tolerance);
+	EXPECT_NEAR(28.0, maximumValue, tolerance);
+}
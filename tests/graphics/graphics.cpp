@@ -21,8 +21,17 @@
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 #include "opencmiss/zinc/graphics.hpp"
+#include "opencmiss/zinc/fieldarithmeticoperators.hpp"
+#include "opencmiss/zinc/fieldcache.hpp"
+#include "opencmiss/zinc/fieldcomposite.hpp"
 #include "opencmiss/zinc/fieldconstant.hpp"
+#include "opencmiss/zinc/fieldtime.hpp"
 #include "opencmiss/zinc/font.hpp"
+#include "opencmiss/zinc/node.hpp"
+#include "opencmiss/zinc/scenefilter.hpp"
+#include "opencmiss/zinc/spectrum.hpp"
+#include "opencmiss/zinc/tessellation.hpp"
+#include "opencmiss/zinc/timekeeper.hpp"
 
 #include "test_resources.h"
 
@@ -351,6 +360,135 @@ TEST(ZincGraphics, RenderPointSize)
 	ASSERT_EQ(inSize, outSize = gr.getRenderPointSize());
 }
 
+TEST(ZincGraphics, TimeCache)
+{
+	ZincTestSetupCpp zinc;
+
+	GraphicsSurfaces gr = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(gr.isValid());
+
+	EXPECT_FALSE(gr.isTimeCacheEnabled());
+	EXPECT_EQ(256, gr.getTimeCacheMemoryLimit());
+
+	int result;
+	EXPECT_EQ(ERROR_ARGUMENT, result = gr.setTimeCacheMemoryLimit(0));
+	EXPECT_EQ(OK, result = gr.setTimeCacheMemoryLimit(64));
+	EXPECT_EQ(64, gr.getTimeCacheMemoryLimit());
+	EXPECT_FALSE(gr.isTimeCacheEnabled());
+
+	EXPECT_EQ(OK, result = gr.setTimeCacheEnabled(true));
+	EXPECT_TRUE(gr.isTimeCacheEnabled());
+	EXPECT_EQ(64, gr.getTimeCacheMemoryLimit());
+	EXPECT_EQ(OK, result = gr.setTimeCacheEnabled(false));
+	EXPECT_FALSE(gr.isTimeCacheEnabled());
+
+	cmzn_graphics_id c_gr = cmzn_scene_create_graphics_lines(zinc.scene.getId());
+	EXPECT_NE(static_cast<cmzn_graphics *>(0), c_gr);
+	EXPECT_FALSE(cmzn_graphics_is_time_cache_enabled(c_gr));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_set_time_cache_enabled(c_gr, true));
+	EXPECT_TRUE(cmzn_graphics_is_time_cache_enabled(c_gr));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_time_cache_enabled(0, true));
+	EXPECT_FALSE(cmzn_graphics_is_time_cache_enabled(0));
+	EXPECT_EQ(0, cmzn_graphics_get_time_cache_memory_limit(0));
+	cmzn_graphics_destroy(&c_gr);
+}
+
+namespace {
+
+/** Scale x coordinate of all nodes; caller should hold field changes. */
+void scaleNodeX(Fieldmodule& fm, Field& coordinates, double scale)
+{
+	Fieldcache cache = fm.createFieldcache();
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodeiterator iter = nodes.createNodeiterator();
+	Node node;
+	while ((node = iter.next()).isValid())
+	{
+		double x[3];
+		EXPECT_EQ(OK, cache.setNode(node));
+		EXPECT_EQ(OK, coordinates.evaluateReal(cache, 3, x));
+		x[0] *= scale;
+		EXPECT_EQ(OK, coordinates.assignReal(cache, 3, x));
+	}
+}
+
+/** Get the range of spectrum data in scene at time, building graphics if needed. */
+void getDataRange(Scene& scene, Timekeeper& timekeeper, Spectrum& spectrum,
+	double time, double& minimum, double& maximum)
+{
+	EXPECT_EQ(OK, timekeeper.setTime(time));
+	Scenefilter filter = scene.getScenefiltermodule().getDefaultScenefilter();
+	EXPECT_EQ(1, scene.getSpectrumDataRange(filter, spectrum, 1, &minimum, &maximum));
+}
+
+}
+
+// Field changes held with beginChange do not notify graphics, so a graphics
+// object built before them is distinguishable from one rebuilt after
+TEST(ZincGraphics, TimeCacheRebuild)
+{
+	ZincTestSetupCpp zinc;
+
+	int result;
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	Timekeeper timekeeper = zinc.context.getTimekeepermodule().getDefaultTimekeeper();
+	EXPECT_TRUE(timekeeper.isValid());
+	Field x = zinc.fm.createFieldComponent(coordinates, 1);
+	Field data = zinc.fm.createFieldAdd(x, zinc.fm.createFieldTimeValue(timekeeper));
+	EXPECT_TRUE(data.isValid());
+	Spectrum spectrum = zinc.context.getSpectrummodule().getDefaultSpectrum();
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_EQ(OK, result = surfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(OK, result = surfaces.setDataField(data));
+	EXPECT_EQ(OK, result = surfaces.setSpectrum(spectrum));
+	EXPECT_EQ(OK, result = surfaces.setTimeCacheEnabled(true));
+
+	double minimum, maximum;
+	getDataRange(zinc.scene, timekeeper, spectrum, 0.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(0.0, minimum);
+	EXPECT_DOUBLE_EQ(1.0, maximum);
+	getDataRange(zinc.scene, timekeeper, spectrum, 1.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(1.0, minimum);
+	EXPECT_DOUBLE_EQ(2.0, maximum);
+
+	// revisiting a cached time restores the object built there without
+	// evaluating the changed coordinates
+	zinc.fm.beginChange();
+	scaleNodeX(zinc.fm, coordinates, 3.0);
+	getDataRange(zinc.scene, timekeeper, spectrum, 0.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(0.0, minimum);
+	EXPECT_DOUBLE_EQ(1.0, maximum);
+	// the field change empties the cache so both times are rebuilt
+	zinc.fm.endChange();
+	getDataRange(zinc.scene, timekeeper, spectrum, 0.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(0.0, minimum);
+	EXPECT_DOUBLE_EQ(3.0, maximum);
+	getDataRange(zinc.scene, timekeeper, spectrum, 1.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(1.0, minimum);
+	EXPECT_DOUBLE_EQ(4.0, maximum);
+
+	// with a fine tessellation each graphics object uses more than 1 megabyte,
+	// so storing the object for one time evicts any object cached for another
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int minimumDivisions = 128;
+	EXPECT_EQ(OK, result = tessellation.setMinimumDivisions(1, &minimumDivisions));
+	EXPECT_EQ(OK, result = surfaces.setTessellation(tessellation));
+	EXPECT_EQ(OK, result = surfaces.setTimeCacheMemoryLimit(1));
+	getDataRange(zinc.scene, timekeeper, spectrum, 0.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(3.0, maximum);
+	getDataRange(zinc.scene, timekeeper, spectrum, 1.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(4.0, maximum);
+	zinc.fm.beginChange();
+	scaleNodeX(zinc.fm, coordinates, 2.0);
+	getDataRange(zinc.scene, timekeeper, spectrum, 0.0, minimum, maximum);
+	EXPECT_DOUBLE_EQ(0.0, minimum);
+	EXPECT_DOUBLE_EQ(6.0, maximum);
+	zinc.fm.endChange();
+}
+
 TEST(cmzn_graphics, get_scene)
 {
 	ZincTestSetup zinc;
@@ -7,6 +7,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
 #include <opencmiss/zinc/status.h>
 #include <opencmiss/zinc/core.h>
@@ -22,16 +26,21 @@
 #include <opencmiss/zinc/sceneviewer.h>
 #include <opencmiss/zinc/spectrum.h>
 
+#include <opencmiss/zinc/element.hpp>
 #include <opencmiss/zinc/fieldarithmeticoperators.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
 #include <opencmiss/zinc/fieldcomposite.hpp>
 #include <opencmiss/zinc/fieldconstant.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
 #include <opencmiss/zinc/fieldvectoroperators.hpp>
 #include <opencmiss/zinc/graphics.hpp>
+#include <opencmiss/zinc/node.hpp>
 #include <opencmiss/zinc/scene.hpp>
 #include <opencmiss/zinc/scenefilter.hpp>
 #include <opencmiss/zinc/sceneviewer.hpp>
 #include <opencmiss/zinc/spectrum.hpp>
 #include <opencmiss/zinc/streamscene.hpp>
+#include <opencmiss/zinc/tessellation.hpp>
 
 #include "test_resources.h"
 #include "zinctestsetup.hpp"
@@ -250,6 +259,189 @@ TEST(ZincScene, getSpectrumDataRange)
 	ASSERT_DOUBLE_EQ(0.5, maximumValues[0]);
 }
 
+// test data range is unchanged when reusing data values on shared surface edges
+TEST(ZincScene, getSpectrumDataRangeSharedEdgeEvaluation)
+{
+	ZincTestSetupSpectrumCpp zinc;
+
+	int result;
+
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+	Field magnitudeField = zinc.fm.createFieldMagnitude(coordinateField);
+	EXPECT_TRUE(magnitudeField.isValid());
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_FALSE(surfaces.isSharedEdgeEvaluation());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSharedEdgeEvaluation(true));
+	EXPECT_TRUE(surfaces.isSharedEdgeEvaluation());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinateField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setDataField(magnitudeField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSpectrum(zinc.defaultSpectrum));
+
+	double minimumValues[1], maximumValues[1];
+	Scenefiltermodule sfm = zinc.context.getScenefiltermodule();
+	Scenefilter defaultFilter = sfm.getDefaultScenefilter();
+
+	int maxRanges = zinc.scene.getSpectrumDataRange(defaultFilter,
+		zinc.defaultSpectrum, 1, minimumValues, maximumValues);
+	EXPECT_EQ(1, maxRanges);
+	ASSERT_DOUBLE_EQ(0.0, minimumValues[0]);
+	ASSERT_DOUBLE_EQ(1.7320508f, maximumValues[0]);
+
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSharedEdgeEvaluation(false));
+	EXPECT_FALSE(surfaces.isSharedEdgeEvaluation());
+	maxRanges = zinc.scene.getSpectrumDataRange(defaultFilter,
+		zinc.defaultSpectrum, 1, minimumValues, maximumValues);
+	EXPECT_EQ(1, maxRanges);
+	ASSERT_DOUBLE_EQ(0.0, minimumValues[0]);
+	ASSERT_DOUBLE_EQ(1.7320508f, maximumValues[0]);
+}
+
+namespace {
+
+std::string writeSceneThreejsColours(Scene& scene)
+{
+	StreaminformationScene si = scene.createStreaminformationScene();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_THREEJS));
+	EXPECT_EQ(CMZN_OK, si.setIODataType(si.IO_DATA_TYPE_COLOUR));
+	StreamresourceMemory memory_sr = si.createStreamresourceMemory();
+	EXPECT_EQ(CMZN_OK, scene.write(si));
+	char *memory_buffer = 0;
+	unsigned int size = 0;
+	EXPECT_EQ(CMZN_OK, memory_sr.getBuffer((void**)&memory_buffer, &size));
+	return std::string(memory_buffer, size);
+}
+
+/**
+ * Read the numbers in the named top level array of three.js JSON output.
+ * @return  True if the array was found.
+ */
+bool readThreejsArray(const std::string& output, const char *name, std::vector<double>& values)
+{
+	values.clear();
+	const std::string key = std::string("\"") + name + "\" : [";
+	const size_t keyPosition = output.find(key);
+	if (std::string::npos == keyPosition)
+		return false;
+	const char *text = output.c_str() + keyPosition + key.size();
+	while (true)
+	{
+		char *end = 0;
+		const double value = strtod(text, &end);
+		if (end == text)
+			break;
+		values.push_back(value);
+		text = end;
+		while ((*text == ',') || isspace(*text))
+			++text;
+	}
+	return (*text == ']');
+}
+
+}
+
+// test data values are shared along an edge which two surface elements
+// traverse in opposite directions
+TEST(ZincScene, sharedEdgeEvaluationReversedFaces)
+{
+	ZincTestSetupSpectrumCpp zinc;
+
+	int result;
+
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(2);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(CMZN_OK, result = coordinates.setName("coordinates"));
+	EXPECT_EQ(CMZN_OK, result = coordinates.setTypeCoordinate(true));
+	EXPECT_EQ(CMZN_OK, result = coordinates.setManaged(true));
+
+	Nodeset nodeset = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodeset.createNodetemplate();
+	EXPECT_EQ(CMZN_OK, result = nodetemplate.defineField(coordinates));
+	const double nodeCoordinates[6][2] =
+	{
+		{ 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 }, { 2.0, 0.0 }, { 2.0, 1.0 }
+	};
+	Fieldcache cache = zinc.fm.createFieldcache();
+	for (int n = 0; n < 6; ++n)
+	{
+		Node node = nodeset.createNode(n + 1, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(CMZN_OK, result = cache.setNode(node));
+		EXPECT_EQ(CMZN_OK, result = coordinates.assignReal(cache, 2, nodeCoordinates[n]));
+	}
+
+	Mesh mesh = zinc.fm.findMeshByDimension(2);
+	Elementtemplate elementtemplate = mesh.createElementtemplate();
+	EXPECT_EQ(CMZN_OK, result = elementtemplate.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(CMZN_OK, result = elementtemplate.setNumberOfNodes(4));
+	Elementbasis basis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	const int localNodeIndexes[4] = { 1, 2, 3, 4 };
+	EXPECT_EQ(CMZN_OK, result = elementtemplate.defineFieldSimpleNodal(
+		coordinates, /*componentNumber*/-1, basis, 4, localNodeIndexes));
+	// element 2 is rotated by 180 degrees so its xi1 = 1 face runs from
+	// node 4 to node 2, opposite to the same line on element 1
+	const int elementNodes[2][4] = { { 1, 2, 3, 4 }, { 6, 4, 5, 2 } };
+	for (int e = 0; e < 2; ++e)
+	{
+		for (int n = 0; n < 4; ++n)
+			EXPECT_EQ(CMZN_OK, result = elementtemplate.setNode(n + 1, nodeset.findNodeByIdentifier(elementNodes[e][n])));
+		EXPECT_EQ(CMZN_OK, result = mesh.defineElement(e + 1, elementtemplate));
+	}
+	EXPECT_EQ(CMZN_OK, result = zinc.fm.defineAllFaces());
+	EXPECT_EQ(7, zinc.fm.findMeshByDimension(1).getSize());
+
+	Tessellationmodule tessellationmodule = zinc.context.getTessellationmodule();
+	Tessellation tessellation = tessellationmodule.createTessellation();
+	const int minimumDivisions = 4;
+	EXPECT_EQ(CMZN_OK, result = tessellation.setMinimumDivisions(1, &minimumDivisions));
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setTessellation(tessellation));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSpectrum(zinc.defaultSpectrum));
+	Scenefiltermodule sfm = zinc.context.getScenefiltermodule();
+
+	// y is continuous, so sharing must give the same colours as evaluating
+	// in each element; keying on face xi would take values from the wrong
+	// end of the shared line
+	Field y = zinc.fm.createFieldComponent(coordinates, 2);
+	EXPECT_EQ(CMZN_OK, result = surfaces.setDataField(y));
+	EXPECT_EQ(CMZN_OK, result = zinc.defaultSpectrum.autorange(zinc.scene, sfm.getDefaultScenefilter()));
+	const std::string separateOutput = writeSceneThreejsColours(zinc.scene);
+	EXPECT_NE(std::string::npos, separateOutput.find("\"colors\""));
+	int evaluationCount = -1, reuseCount = -1;
+	EXPECT_EQ(CMZN_OK, result = surfaces.getSharedEdgeStatistics(evaluationCount, reuseCount));
+	EXPECT_EQ(0, evaluationCount);
+	EXPECT_EQ(0, reuseCount);
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSharedEdgeEvaluation(true));
+	const std::string sharedOutput = writeSceneThreejsColours(zinc.scene);
+	EXPECT_EQ(separateOutput, sharedOutput);
+	// 16 edge points in each 4x4 element, of which the 5 on the shared line
+	// are evaluated in element 1 and reused in element 2
+	EXPECT_EQ(CMZN_OK, result = surfaces.getSharedEdgeStatistics(evaluationCount, reuseCount));
+	EXPECT_EQ(27, evaluationCount);
+	EXPECT_EQ(5, reuseCount);
+
+	// xi2 is discontinuous across the shared line, so colours differ only if
+	// element 2 reuses values evaluated in element 1
+	Field xi2 = zinc.fm.createFieldComponent(zinc.fm.findFieldByName("xi"), 2);
+	EXPECT_EQ(CMZN_OK, result = surfaces.setDataField(xi2));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSharedEdgeEvaluation(false));
+	EXPECT_EQ(CMZN_OK, result = zinc.defaultSpectrum.autorange(zinc.scene, sfm.getDefaultScenefilter()));
+	const std::string separateXiOutput = writeSceneThreejsColours(zinc.scene);
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSharedEdgeEvaluation(true));
+	const std::string sharedXiOutput = writeSceneThreejsColours(zinc.scene);
+	EXPECT_NE(separateXiOutput, sharedXiOutput);
+	EXPECT_EQ(CMZN_OK, result = surfaces.getSharedEdgeStatistics(evaluationCount, reuseCount));
+	EXPECT_EQ(27, evaluationCount);
+	EXPECT_EQ(5, reuseCount);
+}
+
 TEST(cmzn_scene, visibility_flag)
 {
 	ZincTestSetup zinc;
@@ -523,6 +715,125 @@ TEST(cmzn_scene, threejs_export)
 	cmzn_graphics_destroy(&surfaces);
 }
 
+TEST(ZincScene, gltfBinaryExport)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinateField));
+
+	char *formatName = cmzn_streaminformation_scene_io_format_enum_to_string(
+		CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY);
+	EXPECT_STREQ("GLTF_BINARY", formatName);
+	EXPECT_EQ(CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_GLTF_BINARY,
+		cmzn_streaminformation_scene_io_format_enum_from_string(formatName));
+	cmzn_deallocate(formatName);
+
+	unsigned int sizes[2] = { 0, 0 };
+	for (int q = 0; q < 2; ++q)
+	{
+		const bool quantised = (1 == q);
+		StreaminformationScene si = zinc.scene.createStreaminformationScene();
+		EXPECT_TRUE(si.isValid());
+		EXPECT_EQ(CMZN_OK, result = si.setIOFormat(si.IO_FORMAT_GLTF_BINARY));
+		EXPECT_EQ(1, result = si.getNumberOfResourcesRequired());
+		EXPECT_FALSE(si.isQuantised());
+		EXPECT_EQ(CMZN_OK, result = si.setQuantised(quantised));
+		EXPECT_EQ(quantised, si.isQuantised());
+		StreamresourceMemory memory_sr = si.createStreamresourceMemory();
+		EXPECT_EQ(CMZN_OK, result = zinc.scene.write(si));
+
+		unsigned char *buffer = 0;
+		unsigned int size = 0;
+		EXPECT_EQ(CMZN_OK, result = memory_sr.getBuffer((void**)&buffer, &size));
+		ASSERT_LT(20u, size);
+		// GLB header: magic, version 2, total length; then JSON chunk length and type
+		EXPECT_EQ(0, memcmp(buffer, "glTF", 4));
+		EXPECT_EQ(2u, buffer[4] + (buffer[5] << 8));
+		EXPECT_EQ(size, static_cast<unsigned int>(buffer[8] + (buffer[9] << 8) + (buffer[10] << 16)));
+		EXPECT_EQ(0, memcmp(buffer + 16, "JSON", 4));
+		const unsigned int jsonSize = buffer[12] + (buffer[13] << 8) + (buffer[14] << 16);
+		EXPECT_EQ(0u, jsonSize % 4);
+		ASSERT_LT(20u + jsonSize + 8u, size);
+		EXPECT_EQ(0, memcmp(buffer + 20 + jsonSize + 4, "BIN", 4));
+		const std::string json(reinterpret_cast<char *>(buffer) + 20, jsonSize);
+		EXPECT_NE(std::string::npos, json.find("\"POSITION\""));
+		EXPECT_NE(std::string::npos, json.find("\"NORMAL\""));
+		EXPECT_NE(std::string::npos, json.find("\"indices\""));
+		EXPECT_EQ(quantised, std::string::npos != json.find("KHR_mesh_quantization"));
+		sizes[q] = size;
+	}
+	EXPECT_LT(sizes[1], sizes[0]);
+}
+
+TEST(ZincScene, threejsExportDataColours)
+{
+	ZincTestSetupSpectrumCpp zinc;
+
+	int result;
+
+	EXPECT_EQ(CMZN_OK, result = zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+
+	// red = x, green = 1 - y, blue only for z >= 0.5 so vertices below
+	// keep the black base colour
+	Spectrum spectrum = zinc.spectrummodule.createSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	EXPECT_EQ(CMZN_OK, result = spectrum.setMaterialOverwrite(true));
+	Spectrumcomponent red = spectrum.createSpectrumcomponent();
+	EXPECT_EQ(CMZN_OK, result = red.setFieldComponent(1));
+	EXPECT_EQ(CMZN_OK, result = red.setColourMappingType(Spectrumcomponent::COLOUR_MAPPING_TYPE_RED));
+	Spectrumcomponent green = spectrum.createSpectrumcomponent();
+	EXPECT_EQ(CMZN_OK, result = green.setFieldComponent(2));
+	EXPECT_EQ(CMZN_OK, result = green.setColourMappingType(Spectrumcomponent::COLOUR_MAPPING_TYPE_GREEN));
+	EXPECT_EQ(CMZN_OK, result = green.setColourReverse(true));
+	Spectrumcomponent blue = spectrum.createSpectrumcomponent();
+	EXPECT_EQ(CMZN_OK, result = blue.setFieldComponent(3));
+	EXPECT_EQ(CMZN_OK, result = blue.setColourMappingType(Spectrumcomponent::COLOUR_MAPPING_TYPE_BLUE));
+	EXPECT_EQ(CMZN_OK, result = blue.setRangeMinimum(0.5));
+	EXPECT_EQ(CMZN_OK, result = blue.setExtendBelow(false));
+
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int minimumDivisions = 4;
+	EXPECT_EQ(CMZN_OK, result = tessellation.setMinimumDivisions(1, &minimumDivisions));
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, result = surfaces.setCoordinateField(coordinateField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setDataField(coordinateField));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setSpectrum(spectrum));
+	EXPECT_EQ(CMZN_OK, result = surfaces.setTessellation(tessellation));
+
+	const std::string output = writeSceneThreejsColours(zinc.scene);
+	std::vector<double> vertices, colours;
+	EXPECT_TRUE(readThreejsArray(output, "vertices", vertices));
+	EXPECT_TRUE(readThreejsArray(output, "colors", colours));
+	const size_t vertexCount = colours.size();
+	EXPECT_LT(static_cast<size_t>(0), vertexCount);
+	ASSERT_EQ(3*vertexCount, vertices.size());
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		const double *x = &vertices[3*v];
+		const double expectedRgb[3] =
+		{
+			x[0],
+			1.0 - x[1],
+			(x[2] < 0.5) ? 0.0 : (x[2] - 0.5)/0.5
+		};
+		const int hex = static_cast<int>(colours[v]);
+		const int rgb[3] = { (hex >> 16) & 255, (hex >> 8) & 255, hex & 255 };
+		// exported colours are rounded to the nearest 1/255
+		for (int c = 0; c < 3; ++c)
+			EXPECT_NEAR(expectedRgb[c]*255.0, rgb[c], 0.51);
+	}
+}
+
 TEST(cmzn_scene, graphics_description_cpp)
 {
 	ZincTestSetupCpp zinc;
@@ -23,11 +23,19 @@
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 #include "opencmiss/zinc/element.hpp"
+#include "opencmiss/zinc/fieldcache.hpp"
+#include "opencmiss/zinc/fieldgroup.hpp"
+#include "opencmiss/zinc/fieldmodule.hpp"
+#include "opencmiss/zinc/fieldsubobjectgroup.hpp"
+#include "opencmiss/zinc/glyph.hpp"
 #include "opencmiss/zinc/graphics.hpp"
 #include "opencmiss/zinc/node.hpp"
+#include "opencmiss/zinc/region.hpp"
 #include "opencmiss/zinc/scenepicker.hpp"
 #include "opencmiss/zinc/scene.hpp"
 #include "opencmiss/zinc/sceneviewer.hpp"
+#include "opencmiss/zinc/tessellation.hpp"
+#include "test_resources.h"
 
 TEST(cmzn_scenepicker_api, valid_args)
 {
@@ -174,3 +182,188 @@ TEST(cmzn_scenepicker_api, valid_args_cpp)
 	result = scenePicker.addPickedNodesToFieldGroup(fieldGroup);
 	EXPECT_EQ(CMZN_OK, result);
 }
+
+// pick with a box in world coordinates, which needs no OpenGL context
+TEST(cmzn_scenepicker_api, picking_volume_box)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	zinc.scene.beginChange();
+	GraphicsPoints points = zinc.scene.createGraphicsPoints();
+	EXPECT_TRUE(points.isValid());
+	EXPECT_EQ(CMZN_OK, points.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, points.setFieldDomainType(Field::DOMAIN_TYPE_NODES));
+	Graphicspointattributes pointattr = points.getGraphicspointattributes();
+	EXPECT_EQ(CMZN_OK, pointattr.setGlyphShapeType(Glyph::SHAPE_TYPE_SPHERE));
+	const double baseSize = 0.2;
+	EXPECT_EQ(CMZN_OK, pointattr.setBaseSize(1, &baseSize));
+	GraphicsLines lines = zinc.scene.createGraphicsLines();
+	EXPECT_TRUE(lines.isValid());
+	EXPECT_EQ(CMZN_OK, lines.setCoordinateField(coordinates));
+	zinc.scene.endChange();
+
+	Scenepicker scenePicker = zinc.scene.createScenepicker();
+	EXPECT_TRUE(scenePicker.isValid());
+	EXPECT_EQ(CMZN_OK, scenePicker.setScene(zinc.scene));
+
+	const double centre[3] = { 1.0, 1.0, 1.0 };
+	const double zeroSize[3] = { 0.1, 0.0, 0.1 };
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, scenePicker.setPickingVolumeBox(0, zeroSize));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, scenePicker.setPickingVolumeBox(centre, 0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, scenePicker.setPickingVolumeBox(centre, zeroSize));
+
+	// box around node 8 at (1, 1, 1), deep enough to reach the surface of
+	// its sphere glyph of radius 0.1
+	const double size[3] = { 0.05, 0.05, 0.3 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(centre, size));
+	double pickingCentre[3];
+	EXPECT_EQ(CMZN_OK, scenePicker.getPickingVolumeCentre(pickingCentre));
+	EXPECT_DOUBLE_EQ(1.0, pickingCentre[0]);
+	EXPECT_DOUBLE_EQ(1.0, pickingCentre[1]);
+	EXPECT_DOUBLE_EQ(1.0, pickingCentre[2]);
+	Node node = scenePicker.getNearestNode();
+	EXPECT_TRUE(node.isValid());
+	EXPECT_EQ(8, node.getIdentifier());
+	Graphics graphics = scenePicker.getNearestNodeGraphics();
+	EXPECT_EQ(points, graphics);
+	Element element = scenePicker.getNearestElement();
+	EXPECT_TRUE(element.isValid());
+	EXPECT_EQ(1, element.getDimension());
+
+	// box around the middle of the line from node 1 to node 2, clear of glyphs
+	const double lineCentre[3] = { 0.5, 0.0, 0.0 };
+	const double lineSize[3] = { 0.1, 0.1, 0.1 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(lineCentre, lineSize));
+	node = scenePicker.getNearestNode();
+	EXPECT_FALSE(node.isValid());
+	element = scenePicker.getNearestElement();
+	EXPECT_TRUE(element.isValid());
+	EXPECT_EQ(1, element.getDimension());
+	graphics = scenePicker.getNearestElementGraphics();
+	EXPECT_EQ(lines, graphics);
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const double xi = 0.5;
+	EXPECT_EQ(CMZN_OK, fieldcache.setMeshLocation(element, 1, &xi));
+	double x[3];
+	EXPECT_EQ(CMZN_OK, coordinates.evaluateReal(fieldcache, 3, x));
+	EXPECT_DOUBLE_EQ(0.5, x[0]);
+	EXPECT_DOUBLE_EQ(0.0, x[1]);
+	EXPECT_DOUBLE_EQ(0.0, x[2]);
+
+	// box enclosing the whole cube picks all nodes and lines
+	const double cubeCentre[3] = { 0.5, 0.5, 0.5 };
+	const double cubeSize[3] = { 1.5, 1.5, 1.5 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(cubeCentre, cubeSize));
+	FieldGroup fieldGroup = zinc.fm.createFieldGroup();
+	EXPECT_EQ(CMZN_OK, scenePicker.addPickedNodesToFieldGroup(fieldGroup));
+	EXPECT_EQ(CMZN_OK, scenePicker.addPickedElementsToFieldGroup(fieldGroup));
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	NodesetGroup nodesetGroup = fieldGroup.getFieldNodeGroup(nodes).getNodesetGroup();
+	EXPECT_EQ(8, nodesetGroup.getSize());
+	Mesh mesh1d = zinc.fm.findMeshByDimension(1);
+	MeshGroup meshGroup = fieldGroup.getFieldElementGroup(mesh1d).getMeshGroup();
+	EXPECT_EQ(12, meshGroup.getSize());
+
+	// graphics moved away by changing the coordinates are no longer picked
+	node = nodes.findNodeByIdentifier(8);
+	EXPECT_EQ(CMZN_OK, fieldcache.setNode(node));
+	const double newX[3] = { 2.0, 2.0, 2.0 };
+	EXPECT_EQ(CMZN_OK, coordinates.assignReal(fieldcache, 3, newX));
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(centre, size));
+	node = scenePicker.getNearestNode();
+	EXPECT_FALSE(node.isValid());
+}
+
+// picking without OpenGL must hit what OpenGL draws: glyph geometry, not its
+// bounding box, and only the triangle edges of wireframe surfaces
+TEST(cmzn_scenepicker_api, picking_volume_box_glyphs_wireframe)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_CUBE_RESOURCE)));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	zinc.scene.beginChange();
+	GraphicsPoints points = zinc.scene.createGraphicsPoints();
+	EXPECT_TRUE(points.isValid());
+	EXPECT_EQ(CMZN_OK, points.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, points.setFieldDomainType(Field::DOMAIN_TYPE_NODES));
+	Graphicspointattributes pointattr = points.getGraphicspointattributes();
+	EXPECT_EQ(CMZN_OK, pointattr.setGlyphShapeType(Glyph::SHAPE_TYPE_CUBE_WIREFRAME));
+	const double baseSize = 0.4;
+	EXPECT_EQ(CMZN_OK, pointattr.setBaseSize(1, &baseSize));
+	// one division so each cube face is 2 triangles meeting on a diagonal
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int one = 1;
+	EXPECT_EQ(CMZN_OK, tessellation.setMinimumDivisions(1, &one));
+	EXPECT_EQ(CMZN_OK, tessellation.setRefinementFactors(1, &one));
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(CMZN_OK, surfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(CMZN_OK, surfaces.setTessellation(tessellation));
+	zinc.scene.endChange();
+
+	Scenepicker scenePicker = zinc.scene.createScenepicker();
+	EXPECT_TRUE(scenePicker.isValid());
+	EXPECT_EQ(CMZN_OK, scenePicker.setScene(zinc.scene));
+	const double size[3] = { 0.05, 0.05, 0.05 };
+
+	// inside the wireframe cube glyph at node 8 but clear of its edges
+	const double insideGlyph[3] = { 1.0, 1.1, 1.1 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(insideGlyph, size));
+	Node node = scenePicker.getNearestNode();
+	EXPECT_FALSE(node.isValid());
+
+	// on an edge of the glyph, which runs from z = 0.8 to 1.2
+	const double glyphEdge[3] = { 1.2, 1.2, 1.1 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(glyphEdge, size));
+	node = scenePicker.getNearestNode();
+	EXPECT_TRUE(node.isValid());
+	EXPECT_EQ(8, node.getIdentifier());
+	EXPECT_EQ(points, scenePicker.getNearestNodeGraphics());
+
+	// within a triangle on face x = 0, away from its edges and both diagonals
+	const double faceInterior[3] = { 0.0, 0.5, 0.15 };
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(faceInterior, size));
+	Element element = scenePicker.getNearestElement();
+	EXPECT_TRUE(element.isValid());
+	EXPECT_EQ(2, element.getDimension());
+	EXPECT_EQ(surfaces, scenePicker.getNearestElementGraphics());
+	const double faceCentre[3] = { 0.0, 0.5, 0.5 };
+	const double faceEdge[3] = { 0.0, 0.5, 0.0 };
+
+	EXPECT_EQ(CMZN_OK, surfaces.setRenderPolygonMode(Graphics::RENDER_POLYGON_MODE_WIREFRAME));
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(faceInterior, size));
+	element = scenePicker.getNearestElement();
+	EXPECT_FALSE(element.isValid());
+	// the face centre is on the diagonal edge shared by its triangles
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(faceCentre, size));
+	element = scenePicker.getNearestElement();
+	EXPECT_TRUE(element.isValid());
+	EXPECT_EQ(2, element.getDimension());
+	EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(faceEdge, size));
+	element = scenePicker.getNearestElement();
+	EXPECT_TRUE(element.isValid());
+	EXPECT_EQ(2, element.getDimension());
+
+	// hit sets: a box over the whole face x = 0 picks the 4 faces sharing
+	// its edges as well as itself, whether wireframe or shaded
+	const double faceBoxCentre[3] = { 0.0, 0.5, 0.5 };
+	const double faceBoxSize[3] = { 0.05, 1.1, 1.1 };
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	for (int shaded = 0; shaded < 2; ++shaded)
+	{
+		EXPECT_EQ(CMZN_OK, surfaces.setRenderPolygonMode((shaded) ?
+			Graphics::RENDER_POLYGON_MODE_SHADED : Graphics::RENDER_POLYGON_MODE_WIREFRAME));
+		EXPECT_EQ(CMZN_OK, scenePicker.setPickingVolumeBox(faceBoxCentre, faceBoxSize));
+		FieldGroup fieldGroup = zinc.fm.createFieldGroup();
+		EXPECT_EQ(CMZN_OK, scenePicker.addPickedElementsToFieldGroup(fieldGroup));
+		MeshGroup meshGroup = fieldGroup.getFieldElementGroup(mesh2d).getMeshGroup();
+		EXPECT_EQ(5, meshGroup.getSize());
+	}
+}
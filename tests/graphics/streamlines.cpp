@@ -18,10 +18,17 @@
 #include <opencmiss/zinc/fieldconstant.h>
 #include <opencmiss/zinc/graphics.h>
 
+#include "test_resources.h"
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
+#include "opencmiss/zinc/fieldarithmeticoperators.hpp"
 #include "opencmiss/zinc/fieldconstant.hpp"
 #include "opencmiss/zinc/graphics.hpp"
+#include "opencmiss/zinc/scene.hpp"
+#include "opencmiss/zinc/scenefilter.hpp"
+#include "opencmiss/zinc/spectrum.hpp"
+
+#include <cmath>
 
 TEST(cmzn_graphics_streamlines, create_cast)
 {
@@ -210,3 +217,81 @@ TEST(cmzn_graphics_streamlines, track_length_cpp)
 	EXPECT_EQ(CMZN_OK, st.setTrackLength(trackLength));
 	EXPECT_DOUBLE_EQ(trackLength, st.getTrackLength());
 }
+
+TEST(cmzn_graphics_streamlines, integration)
+{
+	ZincTestSetup zinc;
+
+	cmzn_graphics_id gr = cmzn_scene_create_graphics_streamlines(zinc.scene);
+	cmzn_graphics_streamlines_id st = cmzn_graphics_cast_streamlines(gr);
+	cmzn_graphics_destroy(&gr);
+	EXPECT_NE(static_cast<cmzn_graphics_streamlines *>(0), st);
+
+	EXPECT_EQ(CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_IMPROVED_EULER, cmzn_graphics_streamlines_get_integration_method(st));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_streamlines_set_integration_method(st, CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45));
+	EXPECT_EQ(CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_RUNGE_KUTTA_45, cmzn_graphics_streamlines_get_integration_method(st));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_streamlines_set_integration_method(st, CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID));
+	EXPECT_EQ(CMZN_GRAPHICS_STREAMLINES_INTEGRATION_METHOD_INVALID, cmzn_graphics_streamlines_get_integration_method(0));
+
+	EXPECT_DOUBLE_EQ(1.0E-4, cmzn_graphics_streamlines_get_integration_tolerance(st));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_streamlines_set_integration_tolerance(st, 1.0E-6));
+	EXPECT_DOUBLE_EQ(1.0E-6, cmzn_graphics_streamlines_get_integration_tolerance(st));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_streamlines_set_integration_tolerance(st, 0.0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_streamlines_set_integration_tolerance(0, 1.0E-6));
+
+	cmzn_graphics_streamlines_destroy(&st);
+}
+
+TEST(ZincGraphicsStreamlines, integration)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(OK, zinc.root_region.readFile(TestResources::getLocation(TestResources::FIELDMODULE_TWO_CUBES_RESOURCE)));
+	// x ranges from 0 to 10 in element 1 and 10 to 20 in element 2
+	Field coordinateField = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinateField.isValid());
+	const double xAxis[3] = { 1.0, 0.0, 0.0 };
+	Field xAxisField = zinc.fm.createFieldConstant(3, xAxis);
+	EXPECT_TRUE(xAxisField.isValid());
+	// stream vector (x, 0, 0) so travel time from x0 to x is ln(x/x0)
+	Field streamVectorField = zinc.fm.createFieldMultiply(coordinateField, xAxisField);
+	EXPECT_TRUE(streamVectorField.isValid());
+	Spectrum spectrum = zinc.context.getSpectrummodule().getDefaultSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	Scenefilter filter = zinc.context.getScenefiltermodule().getDefaultScenefilter();
+	EXPECT_TRUE(filter.isValid());
+
+	GraphicsStreamlines st = zinc.scene.createGraphicsStreamlines();
+	EXPECT_TRUE(st.isValid());
+	EXPECT_EQ(GraphicsStreamlines::INTEGRATION_METHOD_IMPROVED_EULER, st.getIntegrationMethod());
+	EXPECT_DOUBLE_EQ(1.0E-4, st.getIntegrationTolerance());
+	EXPECT_EQ(OK, st.setCoordinateField(coordinateField));
+	EXPECT_EQ(OK, st.setStreamVectorField(streamVectorField));
+	EXPECT_EQ(OK, st.setTrackLength(100.0));
+	EXPECT_EQ(OK, st.setColourDataType(GraphicsStreamlines::COLOUR_DATA_TYPE_TRAVEL_TIME));
+	EXPECT_EQ(OK, st.setSpectrum(spectrum));
+
+	// seeded at element centres x = 5 and 15, tracking to the end of the mesh at x = 20
+	const double expectedMaximumTravelTime = log(4.0);
+	double minimumValue, maximumValue;
+	EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	EXPECT_NEAR(0.0, minimumValue, 1.0E-6);
+	EXPECT_NEAR(expectedMaximumTravelTime, maximumValue, 1.0E-2);
+
+	EXPECT_EQ(OK, st.setIntegrationMethod(GraphicsStreamlines::INTEGRATION_METHOD_RUNGE_KUTTA_45));
+	EXPECT_EQ(GraphicsStreamlines::INTEGRATION_METHOD_RUNGE_KUTTA_45, st.getIntegrationMethod());
+	EXPECT_EQ(OK, st.setIntegrationTolerance(1.0E-6));
+	EXPECT_DOUBLE_EQ(1.0E-6, st.getIntegrationTolerance());
+	EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	EXPECT_NEAR(0.0, minimumValue, 1.0E-6);
+	EXPECT_NEAR(expectedMaximumTravelTime, maximumValue, 1.0E-4);
+
+	// track length limits travel time
+	EXPECT_EQ(OK, st.setTrackLength(0.1));
+	EXPECT_EQ(1, zinc.scene.getSpectrumDataRange(filter, spectrum, 1, &minimumValue, &maximumValue));
+	EXPECT_NEAR(0.0, minimumValue, 1.0E-6);
+	EXPECT_NEAR(0.1, maximumValue, 1.0E-4);
+
+	EXPECT_EQ(ERROR_ARGUMENT, st.setIntegrationMethod(GraphicsStreamlines::INTEGRATION_METHOD_INVALID));
+	EXPECT_EQ(ERROR_ARGUMENT, st.setIntegrationTolerance(-1.0));
+}
@@ -7,10 +7,22 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+#include <opencmiss/zinc/element.hpp>
+#include <opencmiss/zinc/fieldcache.hpp>
+#include <opencmiss/zinc/fieldfiniteelement.hpp>
+#include <opencmiss/zinc/fieldgroup.hpp>
+#include <opencmiss/zinc/fieldsubobjectgroup.hpp>
+#include <opencmiss/zinc/node.hpp>
+#include <opencmiss/zinc/streamregion.hpp>
 
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 
+#include "test_resources.h"
+
 TEST(cmzn_region, build_tree)
 {
 	ZincTestSetup zinc;
@@ -170,3 +182,233 @@ TEST(ZincRegion, append_insert_region)
 	EXPECT_EQ(ERROR_ARGUMENT_CONTEXT, zinc.root_region.appendChild(or1));
 	EXPECT_EQ(ERROR_ARGUMENT_CONTEXT, zinc.root_region.insertChildBefore(or1, r2));
 }
+
+namespace {
+
+void check_cubesquareline_model(Fieldmodule& fm, int expectedNodesCount)
+{
+	int result;
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_EQ(expectedNodesCount, result = nodes.getSize());
+	Mesh mesh3d = fm.findMeshByDimension(3);
+	EXPECT_EQ(1, result = mesh3d.getSize());
+	Mesh mesh2d = fm.findMeshByDimension(2);
+	EXPECT_EQ(7, result = mesh2d.getSize());
+	Mesh mesh1d = fm.findMeshByDimension(1);
+	EXPECT_EQ(16, result = mesh1d.getSize());
+
+	// check face maps survived: 2D element i is on face i of the cube
+	Fieldcache cache = fm.createFieldcache();
+	double value;
+	for (int f = 0; f < 6; ++f)
+	{
+		FieldIsOnFace isOnFaceField = fm.createFieldIsOnFace(
+			static_cast<Element::FaceType>(Element::FACE_TYPE_XI1_0 + f));
+		EXPECT_TRUE(isOnFaceField.isValid());
+		Element element = mesh2d.findElementByIdentifier(f + 1);
+		EXPECT_TRUE(element.isValid());
+		EXPECT_EQ(OK, result = cache.setElement(element));
+		EXPECT_EQ(OK, result = isOnFaceField.evaluateReal(cache, 1, &value));
+		EXPECT_EQ(1.0, value);
+	}
+
+	FieldGroup group = fm.findFieldByName("bob").castGroup();
+	EXPECT_TRUE(group.isValid());
+	MeshGroup meshGroup = group.getFieldElementGroup(mesh2d).getMeshGroup();
+	EXPECT_TRUE(meshGroup.isValid());
+	EXPECT_EQ(3, result = meshGroup.getSize());
+	for (int i = 1; i <= 3; ++i)
+		EXPECT_TRUE(meshGroup.containsElement(mesh2d.findElementByIdentifier(i)));
+	NodesetGroup nodesetGroup = group.getFieldNodeGroup(nodes).getNodesetGroup();
+	EXPECT_TRUE(nodesetGroup.isValid());
+	EXPECT_EQ(1, result = nodesetGroup.getSize());
+}
+
+}
+
+// reading into an empty region takes loaded objects directly instead of
+// merging them; check the result matches reading into a non-empty region
+TEST(ZincRegion, read_into_empty_and_non_empty_region)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	EXPECT_EQ(OK, result = zinc.root_region.readFile(
+		TestResources::getLocation(TestResources::FIELDMODULE_CUBESQUARELINE_RESOURCE)));
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	const int nodesCount = nodes.getSize();
+	EXPECT_LT(0, nodesCount);
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	FieldGroup group = zinc.fm.createFieldGroup();
+	EXPECT_EQ(OK, result = group.setName("bob"));
+	EXPECT_EQ(OK, result = group.setManaged(true));
+	MeshGroup meshGroup = group.createFieldElementGroup(mesh2d).getMeshGroup();
+	for (int i = 1; i <= 3; ++i)
+		EXPECT_EQ(OK, result = meshGroup.addElement(mesh2d.findElementByIdentifier(i)));
+	NodesetGroup nodesetGroup = group.createFieldNodeGroup(nodes).getNodesetGroup();
+	EXPECT_EQ(OK, result = nodesetGroup.addNode(nodes.findNodeByIdentifier(1)));
+	check_cubesquareline_model(zinc.fm, nodesCount);
+
+	StreaminformationRegion sir = zinc.root_region.createStreaminformationRegion();
+	EXPECT_TRUE(sir.isValid());
+	StreamresourceMemory resource = sir.createStreamresourceMemory();
+	EXPECT_TRUE(resource.isValid());
+	EXPECT_EQ(OK, result = zinc.root_region.write(sir));
+	void *buffer;
+	unsigned int bufferSize;
+	EXPECT_EQ(OK, result = resource.getBuffer(&buffer, &bufferSize));
+
+	Region emptyRegion = zinc.root_region.createChild("empty");
+	StreaminformationRegion sir1 = emptyRegion.createStreaminformationRegion();
+	StreamresourceMemory resource1 = sir1.createStreamresourceMemoryBuffer(buffer, bufferSize);
+	EXPECT_EQ(OK, result = emptyRegion.read(sir1));
+	Fieldmodule fm1 = emptyRegion.getFieldmodule();
+	check_cubesquareline_model(fm1, nodesCount);
+	// reading again merges into the now non-empty region without change
+	EXPECT_EQ(OK, result = emptyRegion.read(sir1));
+	check_cubesquareline_model(fm1, nodesCount);
+
+	Region nonEmptyRegion = zinc.root_region.createChild("non_empty");
+	Fieldmodule fm2 = nonEmptyRegion.getFieldmodule();
+	Nodeset nodes2 = fm2.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes2.createNodetemplate();
+	Node node = nodes2.createNode(1000, nodetemplate);
+	EXPECT_TRUE(node.isValid());
+	StreaminformationRegion sir2 = nonEmptyRegion.createStreaminformationRegion();
+	StreamresourceMemory resource2 = sir2.createStreamresourceMemoryBuffer(buffer, bufferSize);
+	EXPECT_EQ(OK, result = nonEmptyRegion.read(sir2));
+	check_cubesquareline_model(fm2, nodesCount + 1);
+}
+
+namespace {
+
+// set number of threads used to write EX files; 0 to restore default
+void setExportThreads(int numberOfThreads)
+{
+	const std::string value = (0 < numberOfThreads) ? std::to_string(numberOfThreads) : "";
+#if defined (_WIN32)
+	_putenv_s("CMZN_EXPORT_THREADS", value.c_str());
+#else
+	if (0 < numberOfThreads)
+		setenv("CMZN_EXPORT_THREADS", value.c_str(), 1);
+	else
+		unsetenv("CMZN_EXPORT_THREADS");
+#endif
+}
+
+std::string writeRegionToString(Region& region)
+{
+	StreaminformationRegion sir = region.createStreaminformationRegion();
+	StreamresourceMemory resource = sir.createStreamresourceMemory();
+	EXPECT_EQ(OK, region.write(sir));
+	void *buffer = 0;
+	unsigned int bufferSize = 0;
+	EXPECT_EQ(OK, resource.getBuffer(&buffer, &bufferSize));
+	return std::string(static_cast<char *>(buffer), bufferSize);
+}
+
+}
+
+// large enough that nodes and elements are formatted in several chunks, with
+// field headers changing within and between chunks
+TEST(ZincRegion, write_large_model_round_trip)
+{
+	ZincTestSetupCpp zinc;
+	int result;
+
+	const int elementsCount1 = 80;
+	const int nodesCount1 = elementsCount1 + 1;
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/2);
+	EXPECT_EQ(OK, result = coordinates.setName("coordinates"));
+	EXPECT_EQ(OK, result = coordinates.setTypeCoordinate(true));
+	EXPECT_EQ(OK, result = coordinates.setManaged(true));
+	FieldFiniteElement pressure = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/1);
+	EXPECT_EQ(OK, result = pressure.setName("pressure"));
+	EXPECT_EQ(OK, result = pressure.setManaged(true));
+	FieldFiniteElement material = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/1);
+	EXPECT_EQ(OK, result = material.setName("material"));
+	EXPECT_EQ(OK, result = material.setManaged(true));
+
+	EXPECT_EQ(OK, result = zinc.fm.beginChange());
+	Fieldcache cache = zinc.fm.createFieldcache();
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate1 = nodes.createNodetemplate();
+	EXPECT_EQ(OK, result = nodetemplate1.defineField(coordinates));
+	Nodetemplate nodetemplate2 = nodes.createNodetemplate();
+	EXPECT_EQ(OK, result = nodetemplate2.defineField(coordinates));
+	EXPECT_EQ(OK, result = nodetemplate2.defineField(pressure));
+	for (int j = 0; j < nodesCount1; ++j)
+		for (int i = 0; i < nodesCount1; ++i)
+		{
+			const int identifier = j*nodesCount1 + i + 1;
+			Node node = nodes.createNode(identifier, (0 == (identifier % 7)) ? nodetemplate2 : nodetemplate1);
+			EXPECT_EQ(OK, result = cache.setNode(node));
+			const double x[2] = { 0.1*i, 0.1*j + 1.0E-7*i };
+			EXPECT_EQ(OK, result = coordinates.assignReal(cache, 2, x));
+			if (0 == (identifier % 7))
+			{
+				const double p = 1.0/identifier;
+				EXPECT_EQ(OK, result = pressure.assignReal(cache, 1, &p));
+			}
+		}
+
+	Mesh mesh = zinc.fm.findMeshByDimension(2);
+	Elementbasis basis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	Elementtemplate elementtemplate1 = mesh.createElementtemplate();
+	EXPECT_EQ(OK, result = elementtemplate1.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(OK, result = elementtemplate1.setNumberOfNodes(4));
+	const int localNodeIndexes[4] = { 1, 2, 3, 4 };
+	EXPECT_EQ(OK, result = elementtemplate1.defineFieldSimpleNodal(coordinates, /*componentNumber*/-1, basis, 4, localNodeIndexes));
+	Elementtemplate elementtemplate2 = mesh.createElementtemplate();
+	EXPECT_EQ(OK, result = elementtemplate2.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(OK, result = elementtemplate2.setNumberOfNodes(4));
+	EXPECT_EQ(OK, result = elementtemplate2.defineFieldSimpleNodal(coordinates, /*componentNumber*/-1, basis, 4, localNodeIndexes));
+	EXPECT_EQ(OK, result = elementtemplate2.defineFieldElementConstant(material, /*componentNumber*/-1));
+	for (int j = 0; j < elementsCount1; ++j)
+		for (int i = 0; i < elementsCount1; ++i)
+		{
+			const int identifier = j*elementsCount1 + i + 1;
+			Elementtemplate& elementtemplate = ((identifier/500) % 2) ? elementtemplate2 : elementtemplate1;
+			const int baseNodeIdentifier = j*nodesCount1 + i + 1;
+			const int nodeIdentifiers[4] = { baseNodeIdentifier, baseNodeIdentifier + 1,
+				baseNodeIdentifier + nodesCount1, baseNodeIdentifier + nodesCount1 + 1 };
+			for (int n = 0; n < 4; ++n)
+				EXPECT_EQ(OK, result = elementtemplate.setNode(n + 1, nodes.findNodeByIdentifier(nodeIdentifiers[n])));
+			Element element = mesh.createElement(identifier, elementtemplate);
+			EXPECT_TRUE(element.isValid());
+			if ((identifier/500) % 2)
+			{
+				EXPECT_EQ(OK, result = cache.setElement(element));
+				const double m = 0.5*identifier;
+				EXPECT_EQ(OK, result = material.assignReal(cache, 1, &m));
+			}
+		}
+	EXPECT_EQ(OK, result = zinc.fm.defineAllFaces());
+	EXPECT_EQ(OK, result = zinc.fm.endChange());
+	EXPECT_EQ(nodesCount1*nodesCount1, nodes.getSize());
+	EXPECT_EQ(elementsCount1*elementsCount1, mesh.getSize());
+
+	// parallel output must be identical to serial output, whatever the number of cores
+	setExportThreads(1);
+	const std::string output = writeRegionToString(zinc.root_region);
+	setExportThreads(4);
+	const std::string parallelOutput = writeRegionToString(zinc.root_region);
+	setExportThreads(3);
+	const std::string parallelOutput3 = writeRegionToString(zinc.root_region);
+	EXPECT_LT(0U, output.size());
+	EXPECT_EQ(output, parallelOutput);
+	EXPECT_EQ(output, parallelOutput3);
+
+	// writing the model read back must give identical output
+	Region region2 = zinc.context.createRegion();
+	StreaminformationRegion sir2 = region2.createStreaminformationRegion();
+	StreamresourceMemory resource2 = sir2.createStreamresourceMemoryBuffer(output.data(),
+		static_cast<unsigned int>(output.size()));
+	EXPECT_EQ(OK, result = region2.read(sir2));
+	Fieldmodule fm2 = region2.getFieldmodule();
+	EXPECT_EQ(nodesCount1*nodesCount1, fm2.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES).getSize());
+	EXPECT_EQ(elementsCount1*elementsCount1, fm2.findMeshByDimension(2).getSize());
+	EXPECT_EQ(mesh.getSize()*2 + elementsCount1*2, fm2.findMeshByDimension(1).getSize());
+	EXPECT_EQ(output, writeRegionToString(region2));
+	setExportThreads(0);
+}
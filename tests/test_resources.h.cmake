@@ -43,7 +43,8 @@ public:
 		GRAPHICS_STREAMLINES_DESCRIPTION_JSON_RESOURCE = 32,
 		GRAPHICS_POINTS_DESCRIPTION_JSON_RESOURCE = 33,
 		FIELDMODULE_CUBESQUARELINE_RESOURCE = 34,
-		REGION_INCORRECT_RESOURCE = 35
+		REGION_INCORRECT_RESOURCE = 35,
+		FIELDIMAGE_GRAY16_RESOURCE = 36
 	};
 
 	TestResources()
@@ -194,6 +195,10 @@ public:
 		{
 			return "@REGION_INCORRECT_RESOURCE@";
 		}
+		if (resourceName == TestResources::FIELDIMAGE_GRAY16_RESOURCE)
+		{
+			return "@FIELDIMAGE_GRAY16_RESOURCE@";
+		}
 
 		return 0;
 	}